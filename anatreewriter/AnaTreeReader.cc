@@ -0,0 +1,172 @@
+#include "AnaTreeReader.h"
+
+#include <TClass.h>
+#include <TFile.h>
+#include <TKey.h>
+#include <TLeaf.h>
+#include <TList.h>
+
+#include <iostream>
+
+AnaTreeReader::AnaTreeReader( const std::string & filename, const std::string & event_tree )
+  : m_event_tree_name( event_tree )
+{
+  m_file = TFile::Open( filename.c_str(), "READ" );
+  if ( !m_file || m_file->IsZombie() ) {
+    std::cerr << "AnaTreeReader::AnaTreeReader - could not open " << filename << std::endl;
+    return;
+  }
+
+  m_event_tree = dynamic_cast< TTree * >( m_file->Get( m_event_tree_name.c_str() ) );
+  if ( !m_event_tree ) {
+    std::cerr << "AnaTreeReader::AnaTreeReader - no " << m_event_tree_name << " in " << filename << std::endl;
+    return;
+  }
+
+  // the event key and the links are always read, nothing else until bound
+  m_event_tree->SetBranchStatus( "*", false );
+  m_event_tree->SetBranchStatus( "event_id", true );
+  m_event_id_leaf = m_event_tree->GetLeaf( "event_id" );
+  if ( HasEventKey( m_event_tree ) ) {
+    m_event_tree->SetBranchStatus( "run_number", true );
+    m_event_tree->SetBranchStatus( "evt_sequence", true );
+    m_run_leaf = m_event_tree->GetLeaf( "run_number" );
+    m_sequence_leaf = m_event_tree->GetLeaf( "evt_sequence" );
+  }
+
+  TIter next( m_file->GetListOfKeys() );
+  while ( TKey * key = static_cast< TKey * >( next() ) ) {
+    const std::string name = key->GetName();
+    TClass * cl = TClass::GetClass( key->GetClassName() );
+    if ( !cl || !cl->InheritsFrom( TTree::Class() ) ) { continue; }
+    if ( name == m_event_tree_name || name == "RunTree" || m_trees.count( name ) ) { continue; }
+
+    SplitTree split;
+    split.tree = dynamic_cast< TTree * >( m_file->Get( name.c_str() ) );
+    if ( !split.tree ) { continue; }
+    split.tree->SetBranchStatus( "*", false );
+    split.tree->SetBranchStatus( "event_id", true );
+    if ( HasEventKey( split.tree ) ) {
+      split.tree->SetBranchStatus( "run_number", true );
+      split.tree->SetBranchStatus( "evt_sequence", true );
+    }
+
+    const std::string link = name + "_entry";
+    if ( m_event_tree->GetBranch( link.c_str() ) ) {
+      m_event_tree->SetBranchStatus( link.c_str(), true );
+      split.link = m_event_tree->GetLeaf( link.c_str() );
+    }
+    m_trees[name] = split;
+  }
+}
+
+AnaTreeReader::~AnaTreeReader()
+{
+  if ( m_file ) {
+    m_file->Close();
+    delete m_file;
+  }
+}
+
+std::vector< std::string > AnaTreeReader::GetSplitTrees() const
+{
+  std::vector< std::string > names;
+  for ( const auto & [ name, split ] : m_trees ) { names.push_back( name ); }
+  return names;
+}
+
+TTree * AnaTreeReader::EnableBranch( const std::string & tree, const std::string & branch )
+{
+  if ( !m_event_tree ) { return nullptr; }
+
+  TTree * t = nullptr;
+  if ( tree == m_event_tree_name ) {
+    t = m_event_tree;
+  } else {
+    auto it = m_trees.find( tree );
+    if ( it == m_trees.end() ) {
+      std::cerr << "AnaTreeReader::Bind - no tree " << tree << std::endl;
+      return nullptr;
+    }
+    t = it->second.tree;
+    if ( !it->second.joined && !it->second.link && !t->GetTreeIndex() ) {
+      // files without links: join on the event key, built once
+      BuildEventIndex( t );
+    }
+    it->second.joined = true;
+  }
+
+  if ( !t->GetBranch( branch.c_str() ) ) {
+    std::cerr << "AnaTreeReader::Bind - no branch " << branch << " in " << tree << std::endl;
+    return nullptr;
+  }
+  t->SetBranchStatus( branch.c_str(), true );
+  return t;
+}
+
+bool AnaTreeReader::GetEvent( const Long64_t entry )
+{
+  if ( !m_event_tree || m_event_tree->GetEntry( entry ) <= 0 ) { return false; }
+  m_event_id = m_event_id_leaf ? static_cast< int >( m_event_id_leaf->GetValue() ) : static_cast< int >( entry );
+  m_run_number = m_run_leaf ? static_cast< int >( m_run_leaf->GetValue() ) : 0;
+  m_evt_sequence = m_sequence_leaf ? static_cast< int >( m_sequence_leaf->GetValue() ) : m_event_id;
+
+  bool ok = true;
+  for ( auto & [ name, split ] : m_trees ) {
+    split.loaded = false;
+    if ( split.joined && !m_lazy ) { ok = Fetch( name ) && ok; }
+  }
+  return ok;
+}
+
+void AnaTreeReader::BuildEventIndex( TTree * tree )
+{
+  if ( HasEventKey( tree ) ) {
+    tree->BuildIndex( "run_number", "evt_sequence" );
+  } else {
+    tree->BuildIndex( "event_id" );
+  }
+}
+
+Long64_t AnaTreeReader::GetEntryWithKey( TTree * tree ) const
+{
+  if ( HasEventKey( tree ) ) {
+    return tree->GetEntryNumberWithIndex( m_run_number, m_evt_sequence );
+  }
+  return tree->GetEntryNumberWithIndex( m_event_id );
+}
+
+bool AnaTreeReader::GetEventByKey( const int run_number, const int evt_sequence )
+{
+  if ( !m_event_tree ) { return false; }
+  if ( !HasEventKey( m_event_tree ) ) {
+    std::cerr << "AnaTreeReader::GetEventByKey - " << m_event_tree_name << " has no run_number / evt_sequence" << std::endl;
+    return false;
+  }
+  if ( !m_event_tree->GetTreeIndex() ) { BuildEventIndex( m_event_tree ); }
+  const Long64_t entry = m_event_tree->GetEntryNumberWithIndex( run_number, evt_sequence );
+  return entry >= 0 && GetEvent( entry );
+}
+
+bool AnaTreeReader::Fetch( const std::string & tree )
+{
+  auto it = m_trees.find( tree );
+  if ( it == m_trees.end() || !it->second.joined ) { return false; }
+  SplitTree & split = it->second;
+  if ( split.loaded ) { return split.entry >= 0; }
+  split.loaded = true;
+
+  // -1 link: the writer skipped this tree for the event
+  const Long64_t entry = split.link ? static_cast< Long64_t >( split.link->GetValue() )
+                                    : GetEntryWithKey( split.tree );
+  if ( entry < 0 ) {
+    split.entry = -1;
+    return false;
+  }
+  if ( entry != split.entry && split.tree->GetEntry( entry ) <= 0 ) {
+    split.entry = -1;
+    return false;
+  }
+  split.entry = entry;
+  return true;
+}
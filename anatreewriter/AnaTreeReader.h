@@ -0,0 +1,104 @@
+#ifndef ANATREEREADER_H
+#define ANATREEREADER_H
+
+#include <TTree.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+class TFile;
+class TLeaf;
+
+class AnaTreeReader
+{
+ public:
+
+  // reads AnaTreeWriter output ( or an OutputMerger merge of it ). Every
+  // branch starts disabled, Bind enables one branch and joins its tree to
+  // the event tree. Split trees are joined through the <tree>_entry links
+  // of the event tree, or through their ( run_number, evt_sequence )
+  // TTreeIndex when the link is missing ( event_id in files written before
+  // the key existed, unique only within one job ). Only joined trees are
+  // read, and only their bound branches.
+  //
+  //   AnaTreeReader reader( "output.root" );
+  //   float zvtx = 0;
+  //   std::vector<float> * jet_pt = nullptr;
+  //   reader.Bind( "EventTree", "zvrtx", &zvtx );
+  //   reader.Bind( "AntiKt_Tower_r04", "jet_pT", &jet_pt );
+  //   reader.SetLazy( true ); // split trees only on Fetch
+  //   for ( Long64_t i = 0; i < reader.GetEntries(); ++i ) {
+  //     reader.GetEvent( i );
+  //     if ( std::abs( zvtx ) > 10 ) { continue; }
+  //     if ( !reader.Fetch( "AntiKt_Tower_r04" ) ) { continue; }
+  //     ...
+  //   }
+
+  AnaTreeReader( const std::string & filename, const std::string & event_tree = "EventTree" );
+
+  ~AnaTreeReader();
+
+  bool IsOpen() const { return m_event_tree != nullptr; }
+
+  // tree is the event tree or a split tree name ( node name, RhoTree )
+  template < class T >
+  bool Bind( const std::string & tree, const std::string & branch, T * address )
+  {
+    TTree * t = EnableBranch( tree, branch );
+    if ( !t ) { return false; }
+    t->SetBranchAddress( branch.c_str(), address );
+    return true;
+  }
+
+  // split trees are read with the event unless lazy, then only on Fetch
+  void SetLazy( const bool b ) { m_lazy = b; }
+
+  Long64_t GetEntries() const { return m_event_tree ? m_event_tree->GetEntries() : 0; }
+  bool GetEvent( const Long64_t entry );
+  // by EventHeader run number and sequence, also in merged files
+  bool GetEventByKey( const int run_number, const int evt_sequence );
+
+  // reads the entry of a joined split tree for the current event, false
+  // when the tree has no entry for it
+  bool Fetch( const std::string & tree );
+
+  int GetEventId() const { return m_event_id; }
+  int GetRunNumber() const { return m_run_number; }
+  int GetEvtSequence() const { return m_evt_sequence; }
+  std::vector< std::string > GetSplitTrees() const;
+
+ private:
+
+  struct SplitTree
+  {
+    TTree * tree { nullptr };
+    TLeaf * link { nullptr }; // <tree>_entry in the event tree
+    bool joined { false };
+    bool loaded { false };
+    Long64_t entry { -1 };
+  };
+
+  TFile * m_file { nullptr };
+  TTree * m_event_tree { nullptr };
+  std::map< std::string, SplitTree > m_trees {};
+
+  std::string m_event_tree_name { "EventTree" };
+  bool m_lazy { false };
+  TLeaf * m_event_id_leaf { nullptr };
+  TLeaf * m_run_leaf { nullptr };
+  TLeaf * m_sequence_leaf { nullptr };
+  int m_event_id { -1 };
+  int m_run_number { 0 };
+  int m_evt_sequence { -1 };
+
+  TTree * EnableBranch( const std::string & tree, const std::string & branch );
+
+  // ( run_number, evt_sequence ) index, event_id for older files
+  static bool HasEventKey( TTree * tree ) { return tree->GetBranch( "evt_sequence" ) != nullptr; }
+  static void BuildEventIndex( TTree * tree );
+  Long64_t GetEntryWithKey( TTree * tree ) const;
+
+};
+
+#endif
@@ -35,6 +35,11 @@
 #include <ffarawobjects/Gl1Packet.h>
 #include <ffarawobjects/Gl1Packetv2.h>
 
+#include <ffaobjects/EventHeader.h>
+#include <eventselection/EventCutRecord.h>
+#include <eventselection/EventSummary.h>
+#include <eventselection/EventSummaryReco.h>
+
 #include <jetbase/Jet.h>
 #include <jetbase/Jetv2.h>
 #include <jetbase/JetContainer.h>
@@ -45,6 +50,7 @@
 
 #include <TTree.h>
 
+#include <cassert>
 #include <cstdlib>
 #include <iostream>
 #include <cstdint>
@@ -58,10 +64,31 @@ AnaTreeWriter::AnaTreeWriter( const std::string  &outputfile )
 
 }
 
+void AnaTreeWriter::set_stream( const std::string & stream, const std::string & selector )
+{
+  m_stream = stream;
+  m_record_node = EventCutRecord::NodeName( selector );
+}
+
 int AnaTreeWriter::Init( PHCompositeNode * /*topNode*/ )
 {
   
-  // create output file
+  // AutoSave and resume work on TTrees, an RNTuple is only readable once committed
+  if ( m_branches.get_backend() == BranchRegistry::kRNTuple && m_checkpoint.enabled() ) {
+    std::cout << "AnaTreeWriter::Init - checkpoints need the TTree backend, disabled" << std::endl;
+    m_checkpoint.set_interval( 0 );
+    m_checkpoint.set_resume( false );
+  }
+
+  // one split tree per node, the tree and entry arrays are fixed size
+  if ( m_calo_nodes.size() > m_calo_tree_id.size() || m_jet_nodes.size() > m_jet_tree_id.size() || m_rho_nodes.size() > m_rho_val.size() ) {
+    std::cout << PHWHERE << " at most " << m_calo_tree_id.size() << " calo, " << m_jet_tree_id.size() << " jet and " << m_rho_val.size() << " rho nodes. Abort." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // create output file, a new part when resuming
+  m_checkpoint.set_verbosity( Verbosity() );
+  m_output_filename = m_checkpoint.begin( m_output_filename );
   PHTFileServer::get().open( m_output_filename, "RECREATE" );
 
   if ( Verbosity () > 0 ) {
@@ -70,6 +97,7 @@ int AnaTreeWriter::Init( PHCompositeNode * /*topNode*/ )
 
   // Reset counters
   m_run_tree = new TTree( "RunTree", "RunTree" );
+  m_run_tree -> Branch( "run_number", &m_run_number, "run_number/I" );
   m_run_tree -> Branch( "num_events", &m_nevents, "num_events/I" );
   m_run_tree -> Branch( "do_min_tower_energy", &m_do_min_tower_energy, "do_min_tower_energy/O" );
   m_run_tree -> Branch( "min_tower_energy", &m_min_tower_energy, "min_tower_energy/F" );
@@ -85,16 +113,24 @@ int AnaTreeWriter::Init( PHCompositeNode * /*topNode*/ )
     m_run_live_scalar.fill(0);
     m_run_scaled_scalar.fill(0);
     m_run_raw_scalar.fill(0);
+    m_run_scalars_set = 0;
+    m_run_trigger_mask = 0;
+    // a resumed part continues from the scalars of the job's first event
+    m_checkpoint.add_counter( "run_scalars_set", &m_run_scalars_set );
+    m_checkpoint.add_counter( "run_trigger_mask", &m_run_trigger_mask );
+    m_checkpoint.add_counter( "run_scalars_live", m_run_live_scalar.data(), m_run_live_scalar.size() );
+    m_checkpoint.add_counter( "run_scalars_scaled", m_run_scaled_scalar.data(), m_run_scaled_scalar.size() );
+    m_checkpoint.add_counter( "run_scalars_raw", m_run_raw_scalar.data(), m_run_raw_scalar.size() );
   }
   
   // create tree
   m_tree = new TTree( "EventTree", "EventTree" );
-  m_tree -> Branch( "event_id", &m_event_id, "event_id/I" );
-  m_event_id = -1;
+  BranchEventKey( m_tree );
+  m_event_id = m_checkpoint.get_resume_event_id();
 
   // zvtx
   if ( !m_zvrtx_node.empty() ) {
-    m_tree -> Branch( "zvrtx", &m_zvtx, "zvrtx/F" );
+    m_branches.add( kZvtx, m_tree, "zvrtx", &m_zvtx, 0 );
     if ( Verbosity() > 0 ) {
       std::cout << "AnaTreeWriter::Init - Registered zvtx" << std::endl;
     }
@@ -102,7 +138,7 @@ int AnaTreeWriter::Init( PHCompositeNode * /*topNode*/ )
 
   // centrality
   if ( !m_cent_node.empty() ) {
-    m_tree->Branch("centrality", &m_centrality, "centrality/I");
+    m_branches.bind( m_tree, "centrality", &m_centrality );
     if ( Verbosity() > 0 ) {
       std::cout << "AnaTreeWriter::Init - Registered centrality" << std::endl;
     }
@@ -111,72 +147,74 @@ int AnaTreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // gl1 info
   if ( !m_gl1_node.empty() ) {
     m_gl1_tree = new TTree( m_gl1_node.c_str(), m_gl1_node.c_str() );
-    m_gl1_tree -> Branch( "event_id", &m_event_id, "event_id/I" );
-    m_gl1_tree -> Branch( "s_triggervec", &s_triggervec, "s_triggervec/l" );
-    m_gl1_tree -> Branch( "l_triggervec", &l_triggervec, "l_triggervec/l" );
-    m_gl1_tree -> Branch( "gl1_trigger_status", &m_gl1_trigger_status, "gl1_trigger_status[64]/O" );
-    m_gl1_tree -> Branch( "gl1_live_scalar", &m_gl1_live_scalar, "gl1_live_scalar[64]/L" );
-    m_gl1_tree -> Branch( "gl1_scaled_scalar", &m_gl1_scaled_scalar, "gl1_scaled_scalar[64]/L" );
-    m_gl1_tree -> Branch( "gl1_raw_scalar", &m_gl1_raw_scalar, "gl1_raw_scalar[64]/L" );
+    BranchEventKey( m_gl1_tree );
+    // set ( and reset ) in GetGL1. The scalars have always been signed
+    // 64 bit leaves ( /L ), booked through int64_t to keep that type
+    m_branches.bind( m_gl1_tree, "s_triggervec", &s_triggervec );
+    m_branches.bind( m_gl1_tree, "l_triggervec", &l_triggervec );
+    m_branches.bind( m_gl1_tree, "gl1_trigger_status", m_gl1_trigger_status.data(), { 64 } );
+    m_branches.bind( m_gl1_tree, "gl1_live_scalar", reinterpret_cast< int64_t * >( m_gl1_live_scalar.data() ), { 64 } );
+    m_branches.bind( m_gl1_tree, "gl1_scaled_scalar", reinterpret_cast< int64_t * >( m_gl1_scaled_scalar.data() ), { 64 } );
+    m_branches.bind( m_gl1_tree, "gl1_raw_scalar", reinterpret_cast< int64_t * >( m_gl1_raw_scalar.data() ), { 64 } );
     if ( Verbosity() > 0 ) {
       std::cout << "AnaTreeWriter::Init - GL1 node: " << m_gl1_node << std::endl;
     }
 
     m_gl1_tree_id = -1;
-    m_tree -> Branch( Form("%s_entry", m_gl1_node.c_str()), &m_gl1_tree_id, Form("%s_entry/I", m_gl1_node.c_str()) );
+    m_branches.bind( m_tree, m_gl1_node + "_entry", &m_gl1_tree_id );
 
   }
 
   // MBD
   if ( !m_mbd_node.empty() ) {
     m_mbd_tree = new TTree( m_mbd_node.c_str(), m_mbd_node.c_str() );
-    m_mbd_tree -> Branch( "event_id", &m_event_id, "event_id/I" );
-    m_mbd_tree -> Branch( "mbd_q_N", &m_mbd_q_N, "mbd_q_N/F" );
-    m_mbd_tree -> Branch( "mbd_q_S", &m_mbd_q_S, "mbd_q_S/F" );
-    m_mbd_tree -> Branch( "mbd_time_N", &m_mbd_time_N, "mbd_time_N/F" );
-    m_mbd_tree -> Branch( "mbd_time_S", &m_mbd_time_S, "mbd_time_S/F" );
-    m_mbd_tree -> Branch( "mbd_npmt_N", &m_mbd_npmt_N, "mbd_npmt_N/F" );
-    m_mbd_tree -> Branch( "mbd_npmt_S", &m_mbd_npmt_S, "mbd_npmt_S/F" );
+    BranchEventKey( m_mbd_tree );
+    m_branches.bind( m_mbd_tree, "mbd_q_N", &m_mbd_q_N );
+    m_branches.bind( m_mbd_tree, "mbd_q_S", &m_mbd_q_S );
+    m_branches.bind( m_mbd_tree, "mbd_time_N", &m_mbd_time_N );
+    m_branches.bind( m_mbd_tree, "mbd_time_S", &m_mbd_time_S );
+    m_branches.bind( m_mbd_tree, "mbd_npmt_N", &m_mbd_npmt_N );
+    m_branches.bind( m_mbd_tree, "mbd_npmt_S", &m_mbd_npmt_S );
     if ( Verbosity() > 0 ) {
       std::cout << "AnaTreeWriter::Init - MBD node: " << m_mbd_node << std::endl;
     }
 
     m_mbd_tree_id = -1;
-    m_tree -> Branch( Form("%s_entry", m_mbd_node.c_str()), &m_mbd_tree_id, Form("%s_entry/I", m_mbd_node.c_str()) );
+    m_branches.bind( m_tree, m_mbd_node + "_entry", &m_mbd_tree_id );
   }
 
   // rho
   if ( m_rho_nodes.size() > 0 ) {
     m_rho_tree = new TTree( "RhoTree", "RhoTree" );
-    m_rho_tree -> Branch( "event_id", &m_event_id, "event_id/I" );
+    BranchEventKey( m_rho_tree );
     for ( unsigned int i = 0; i < m_rho_nodes.size(); ++i ) {
-      m_rho_tree -> Branch( m_rho_nodes[i].c_str(), &m_rho_val[i], (m_rho_nodes[i] + "/F").c_str() );
-      m_rho_tree -> Branch( (m_rho_nodes[i] + "_std").c_str(), &m_std_rho_val[i], (m_rho_nodes[i] + "_std/F").c_str() );
+      m_branches.add( kRho, m_rho_tree, m_rho_nodes[i], &m_rho_val[i], 0 );
+      m_branches.add( kRho, m_rho_tree, m_rho_nodes[i] + "_std", &m_std_rho_val[i], 0 );
       if ( Verbosity() > 0 ) {
         std::cout << "AnaTreeWriter::Init - Registered rho nodes: " << m_rho_nodes[i] << std::endl;
       }
     }
     m_rho_tree_id = -1;
-    m_tree -> Branch( "RhoTree_entry", &m_rho_tree_id, "RhoTree_entry/I" );
+    m_branches.bind( m_tree, "RhoTree_entry", &m_rho_tree_id );
   }
 
   // calo nodes
   for ( unsigned int i = 0; i < m_calo_nodes.size(); ++i ) {
     m_calo_trees[i] = new TTree( m_calo_nodes[i].c_str(), m_calo_nodes[i].c_str() );
-    m_calo_trees[i] -> Branch( "event_id", &m_event_id, "event_id/I" );
-    m_calo_trees[i] -> Branch( "num_towers", &m_num_towers, "num_towers/i" );
-    m_calo_trees[i] -> Branch( "num_towers_fired", &m_num_towers_fired, "num_towers_fired/i" );
-    m_calo_trees[i] -> Branch( "num_towers_dead", &m_num_towers_dead, "num_towers_dead/i" );
-    m_calo_trees[i] -> Branch( "tower_energy", &m_tower_energy );
-    m_calo_trees[i] -> Branch( "tower_energy_time", &m_tower_energy_time );
-    m_calo_trees[i] -> Branch( "tower_status_ieta_iphi", &m_tower_status_ieta_iphi );
+    BranchEventKey( m_calo_trees[i] );
+    m_branches.add( kCalo, m_calo_trees[i], "num_towers", &m_num_towers, 0 );
+    m_branches.add( kCalo, m_calo_trees[i], "num_towers_fired", &m_num_towers_fired, 0 );
+    m_branches.add( kCalo, m_calo_trees[i], "num_towers_dead", &m_num_towers_dead, 0 );
+    m_branches.add( kCalo, m_calo_trees[i], "tower_energy", &m_tower_energy );
+    m_branches.add( kCalo, m_calo_trees[i], "tower_energy_time", &m_tower_energy_time );
+    m_branches.add( kCalo, m_calo_trees[i], "tower_status_ieta_iphi", &m_tower_status_ieta_iphi );
 
     if ( Verbosity() > 0 ) {
       std::cout << "AnaTreeWriter::Init - Registered Calo nodes: " << m_calo_nodes[i] << std::endl;
     }
 
     m_calo_tree_id[i] = -1;
-    m_tree -> Branch( Form("%s_entry", m_calo_nodes[i].c_str()), &m_calo_tree_id[i], Form("%s_entry/I", m_calo_nodes[i].c_str()) );
+    m_branches.bind( m_tree, m_calo_nodes[i] + "_entry", &m_calo_tree_id[i] );
    
 
   }
@@ -185,30 +223,41 @@ int AnaTreeWriter::Init( PHCompositeNode * /*topNode*/ )
   for ( unsigned int i = 0; i < m_jet_nodes.size(); ++i ) {
 
     m_jet_trees[i] = new TTree( m_jet_nodes[i].c_str(), m_jet_nodes[i].c_str() );
-    m_jet_trees[i] -> Branch( "event_id", &m_event_id, "event_id/I" );
-    m_jet_trees[i] -> Branch( "num_jets", &m_num_jets, "num_jets/I" );
-    m_jet_trees[i] -> Branch( "jet_energy", &m_jet_energy );
-    m_jet_trees[i] -> Branch( "jet_eta", &m_jet_eta );
-    m_jet_trees[i] -> Branch( "jet_phi", &m_jet_phi );
-    m_jet_trees[i] -> Branch( "jet_pT", &m_jet_pT );
-    m_jet_trees[i] -> Branch( "jet_eT", &m_jet_eT );
-    m_jet_trees[i] -> Branch( "jet_ntowers", &m_jet_ntowers );
-    m_jet_trees[i] -> Branch( "jet_ntowers_cemc", &m_jet_ntowers_cemc );
-    m_jet_trees[i] -> Branch( "jet_ntowers_hcalin", &m_jet_ntowers_hcalin );
-    m_jet_trees[i] -> Branch( "jet_ntowers_hcalout", &m_jet_ntowers_hcalout );
-    m_jet_trees[i] -> Branch( "jet_energy_hcalin", &m_jet_energy_hcalin );
-    m_jet_trees[i] -> Branch( "jet_energy_hcalout", &m_jet_energy_hcalout );
-    m_jet_trees[i] -> Branch( "jet_energy_cemc", &m_jet_energy_cemc );
+    BranchEventKey( m_jet_trees[i] );
+    m_branches.add( kJet, m_jet_trees[i], "num_jets", &m_num_jets, 0 );
+    m_branches.add( kJet, m_jet_trees[i], "jet_energy", &m_jet_energy );
+    m_branches.add( kJet, m_jet_trees[i], "jet_eta", &m_jet_eta );
+    m_branches.add( kJet, m_jet_trees[i], "jet_phi", &m_jet_phi );
+    m_branches.add( kJet, m_jet_trees[i], "jet_pT", &m_jet_pT );
+    m_branches.add( kJet, m_jet_trees[i], "jet_eT", &m_jet_eT );
+    m_branches.add( kJet, m_jet_trees[i], "jet_ntowers", &m_jet_ntowers );
+    m_branches.add( kJet, m_jet_trees[i], "jet_ntowers_cemc", &m_jet_ntowers_cemc );
+    m_branches.add( kJet, m_jet_trees[i], "jet_ntowers_hcalin", &m_jet_ntowers_hcalin );
+    m_branches.add( kJet, m_jet_trees[i], "jet_ntowers_hcalout", &m_jet_ntowers_hcalout );
+    m_branches.add( kJet, m_jet_trees[i], "jet_energy_hcalin", &m_jet_energy_hcalin );
+    m_branches.add( kJet, m_jet_trees[i], "jet_energy_hcalout", &m_jet_energy_hcalout );
+    m_branches.add( kJet, m_jet_trees[i], "jet_energy_cemc", &m_jet_energy_cemc );
 
     if ( Verbosity() > 0 ) {
       std::cout << "AnaTreeWriter::Init - Registered Jet nodes: " << m_jet_nodes[i] << std::endl;
     }
 
     m_jet_tree_id[i] = -1;
-    m_tree -> Branch( Form("%s_entry", m_jet_nodes[i].c_str()), &m_jet_tree_id[i], Form("%s_entry/I", m_jet_nodes[i].c_str()) );
+    m_branches.bind( m_tree, m_jet_nodes[i] + "_entry", &m_jet_tree_id[i] );
 
   }
 
+  // start the first event from the reset values
+  m_branches.reset();
+
+  // event tree first, its entries go to the checkpoint record
+  m_checkpoint.add_tree( m_tree );
+  for ( unsigned int i = 0; i < m_jet_nodes.size(); ++i ) { m_checkpoint.add_tree( m_jet_trees[i] ); }
+  for ( unsigned int i = 0; i < m_calo_nodes.size(); ++i ) { m_checkpoint.add_tree( m_calo_trees[i] ); }
+  if ( !m_gl1_node.empty() ) { m_checkpoint.add_tree( m_gl1_tree ); }
+  if ( !m_mbd_node.empty() ) { m_checkpoint.add_tree( m_mbd_tree ); }
+  if ( m_rho_nodes.size() > 0 ) { m_checkpoint.add_tree( m_rho_tree ); }
+
 
   if ( Verbosity () > 0 ){
     std::cout << "AnaTreeWriter::Init - done" << std::endl;
@@ -217,15 +266,41 @@ int AnaTreeWriter::Init( PHCompositeNode * /*topNode*/ )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int AnaTreeWriter::InitRun( PHCompositeNode * /*topNode*/ )
+{
+  m_nodes.clear();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int AnaTreeWriter::process_event( PHCompositeNode *topNode )
 {
 
+  if ( m_checkpoint.skip_event() ) { // written by the part we resume from
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  if ( !m_stream.empty() ) { // events of other streams are not written and not counted
+    auto record = m_nodes.get<EventCutRecord>( topNode, m_record_node );
+    if ( !record ) {
+      std::cout << PHWHERE << " " << m_record_node << " node missing, needed for stream " << m_stream << ". Abort." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    const int istream = record->find_stream( m_stream );
+    if ( istream < 0 ) { // stream names are not written out, the selector has to run in this job
+      std::cout << PHWHERE << " stream " << m_stream << " not defined in " << m_record_node << ". Abort." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    if ( !( ( record->get_stream_mask() >> istream ) & 1U ) ) { return Fun4AllReturnCodes::EVENT_OK; }
+  }
+
   m_event_id++; 
 
   if(Verbosity() > 1) {
     std::cout << "AnaTreeWriter::process_event - Process event " << m_event_id << std::endl;
   }
 
+  GetEventKey( topNode );
+
   if ( !m_cent_node.empty() ) { // get centrality
     auto res = GetCentInfo(topNode);
     if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
@@ -261,7 +336,8 @@ int AnaTreeWriter::process_event( PHCompositeNode *topNode )
     if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
   }
     
-  m_tree->Fill();
+  m_branches.fill( m_tree );
+  m_checkpoint.filled( m_event_id );
   
   return Fun4AllReturnCodes::EVENT_OK;
 
@@ -276,23 +352,24 @@ int AnaTreeWriter::End( PHCompositeNode * /*topNode*/ )
   }
 
   PHTFileServer::get().cd(m_output_filename); 
-  m_tree->Write();
+  WriteIndexedTree( m_tree );
   for ( unsigned int i = 0; i < m_jet_nodes.size(); ++i ) {
-    m_jet_trees[i]->Write();
+    WriteIndexedTree( m_jet_trees[i] );
   }
   for ( unsigned int i = 0; i < m_calo_nodes.size(); ++i ) {
-    m_calo_trees[i]->Write();
+    WriteIndexedTree( m_calo_trees[i] );
   }
   if ( !m_gl1_node.empty() ) {
-    m_gl1_tree->Write();
+    WriteIndexedTree( m_gl1_tree );
   }
   if ( !m_mbd_node.empty() ) {
-    m_mbd_tree->Write();
+    WriteIndexedTree( m_mbd_tree );
   }
   if ( m_rho_nodes.size() > 0 ) {
-    m_rho_tree->Write();
+    WriteIndexedTree( m_rho_tree );
   }
   for (unsigned int i = 0; i < 64; ++i) {
+    m_run_trigger_status[i] = (m_run_trigger_mask >> i) & 0x1;
     uint64_t live_i = m_run_live_scalar[i];
     uint64_t scaled_i = m_run_scaled_scalar[i];
     uint64_t raw_i = m_run_raw_scalar[i];
@@ -303,9 +380,13 @@ int AnaTreeWriter::End( PHCompositeNode * /*topNode*/ )
     m_run_scaled_scalar[i] = scaled_f-scaled_i;
     m_run_raw_scalar[i] = raw_f-raw_i;
   }
-  m_nevents = m_event_id+1;
+  // event ids continue across resumed parts, only the part that
+  // completes writes the RunTree and counts the whole job
+  m_nevents = m_event_id + 1;
+  m_run_number = recoConsts::instance()->get_IntFlag( "RUNNUMBER" );
   m_run_tree->Fill();
   m_run_tree->Write();
+  m_checkpoint.finish();
 
   if ( Verbosity () > 0 ) {
     std::cout << "AnaTreeWriter::EndRun - done" << std::endl;
@@ -314,53 +395,54 @@ int AnaTreeWriter::End( PHCompositeNode * /*topNode*/ )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-int AnaTreeWriter::ResetEvent( PHCompositeNode * /*topNode*/ )
-{ 
- 
-  // zvtx
-  m_zvtx = 0;
+void AnaTreeWriter::BranchEventKey( TTree * tree )
+{
+  // event_id counts events of this job, ( run_number, evt_sequence ) is
+  // unique across jobs and survives OutputMerger
+  m_branches.bind( tree, "event_id", &m_event_id );
+  m_branches.bind( tree, "run_number", &m_event_run );
+  m_branches.bind( tree, "evt_sequence", &m_event_sequence );
+}
 
-  // gl1
-  m_gl1_trigger_status.fill(false);
-  m_gl1_raw_scalar.fill(0);
-  m_gl1_scaled_scalar.fill(0);
-  m_gl1_live_scalar.fill(0);
+void AnaTreeWriter::GetEventKey( PHCompositeNode *topNode )
+{
+  auto header = m_nodes.get<EventHeader>( topNode, m_eventheader_node );
+  if ( header ) {
+    m_event_run = header->get_RunNumber();
+    m_event_sequence = header->get_EvtSequence();
+    return;
+  }
 
-  // jets
-  m_num_jets = 0;
-  m_jet_eta.clear();
-  m_jet_phi.clear();
-  m_jet_eT.clear();
-  m_jet_pT.clear();
-  m_jet_energy.clear();
-  m_jet_ntowers.clear();
-  m_jet_energy_cemc.clear();
-  m_jet_energy_hcalin.clear();
-  m_jet_energy_hcalout.clear();
-  m_jet_ntowers_cemc.clear();
-  m_jet_ntowers_hcalin.clear();
-  m_jet_ntowers_hcalout.clear();
-
-  // calo
-  m_num_towers = 0;
-  m_num_towers_fired = 0;
-  m_num_towers_dead = 0;
-  m_tower_energy.clear();
-  m_tower_energy_time.clear();
-  m_tower_status_ieta_iphi.clear();
-
-  // mbd
-  m_rho_val.fill(0.0);
-  m_std_rho_val.fill(0.0);
+  // same fallback as EventSelector, only unique within the job
+  if ( m_event_id == m_checkpoint.get_resume_event_id() + 1 ) {
+    std::cout << PHWHERE << " " << m_eventheader_node << " node missing, evt_sequence is the event counter" << std::endl;
+  }
+  m_event_run = recoConsts::instance()->get_IntFlag( "RUNNUMBER" );
+  m_event_sequence = m_event_id;
+}
 
-  return Fun4AllReturnCodes::EVENT_OK;
+void AnaTreeWriter::WriteIndexedTree( TTree * tree )
+{
+  // every tree carries the event key, the index lets readers join on it
+  // without scanning ( AnaTreeReader, TTree::GetEntryWithIndex ). An
+  // RNTuple has no index, readers join on the key columns
+  if ( m_build_index && m_branches.get_backend() == BranchRegistry::kTTree && tree->GetEntries() > 0 ) {
+    tree->BuildIndex( "run_number", "evt_sequence" );
+  }
+  m_branches.write( tree );
+}
 
+int AnaTreeWriter::ResetEvent( PHCompositeNode * /*topNode*/ )
+{ 
+  // gl1 arrays are reset in GetGL1
+  m_branches.reset();
+  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int AnaTreeWriter::GetGL1( PHCompositeNode *topNode )
 {
 
-  auto gl1 = findNode::getClass< Gl1Packetv2 >( topNode, m_gl1_node );
+  auto gl1 = m_nodes.get<Gl1Packetv2>( topNode, m_gl1_node );
   if( !gl1 ) {
     std::cout << PHWHERE << " No GL1 packet found!" << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
@@ -384,47 +466,50 @@ int AnaTreeWriter::GetGL1( PHCompositeNode *topNode )
   }
   
   // update run trigger status
-  for (unsigned int i = 0; i < 64; ++i) {
-    if (m_gl1_trigger_status[i]) {
-      m_run_trigger_status[i] = true;
-    }
-  }
+  m_run_trigger_mask |= s_triggervec;
 
-  if ( m_event_id == 0 ) { // get first event scalars
+  if ( !m_run_scalars_set ) { // get first event scalars
     for (unsigned int i = 0; i < 64; ++i) {
       m_run_live_scalar[i] = m_gl1_live_scalar[i];
       m_run_scaled_scalar[i] = m_gl1_scaled_scalar[i];
       m_run_raw_scalar[i] = m_gl1_raw_scalar[i];
     }
+    m_run_scalars_set = 1;
   }
 
-  m_gl1_tree->Fill();
+  m_branches.fill( m_gl1_tree );
   m_gl1_tree_id++;
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+EventSummary * AnaTreeWriter::GetEventSummary( PHCompositeNode *topNode )
+{
+  // only used when EventSummaryReco did not fill the summary first
+  EventSummaryReco::InputNodes inputs;
+  if ( !m_zvrtx_node.empty() ) { inputs.vertex = m_zvrtx_node; }
+  if ( !m_cent_node.empty() ) { inputs.centrality = m_cent_node; }
+  if ( !m_mbd_node.empty() ) { inputs.mbd = m_mbd_node; }
+
+  auto summary = EventSummaryReco::GetSummary( topNode, m_nodes, "EventSummary", inputs );
+  if ( !summary ) {
+    std::cout << PHWHERE << " EventSummary node missing, doing nothing." << std::endl;
+  }
+  return summary;
+}
+
 int AnaTreeWriter::GetZvtx( PHCompositeNode *topNode )
 {
     // get zvtx
-    auto vertexmap = findNode::getClass<GlobalVertexMap>( topNode, m_zvrtx_node );
-    if ( !vertexmap  || vertexmap->empty() ) {
+    auto summary = GetEventSummary( topNode );
+    if ( !summary || summary->get_vertex_status() == EventSummary::kVERTEX_MISSING ) {
       std::cout << PHWHERE << "" << m_zvrtx_node << " node missing, doing nothing." << std::endl;
       return Fun4AllReturnCodes::ABORTRUN;
     }
 
-    auto vtx = vertexmap->begin()->second;
-    m_zvtx = NAN;
-    if ( vtx ) {
-      m_zvtx = vtx->get_z();
-    } 
-
-    if ( std::isnan(m_zvtx) || m_zvtx > 1e3) {
-      static bool once = true;
-      if (once) {
-        once = false;
-        std::cout << PHWHERE << "vertex is " << m_zvtx << ". Drop all tower inputs (further vertex warning will be suppressed)." << std::endl;
-      }
+    // bad vertices are reported once by EventSummaryReco
+    m_zvtx = summary->get_zvtx();
+    if ( !summary->has_good_vertex() ) {
       return Fun4AllReturnCodes::ABORTEVENT;
     }
 
@@ -439,17 +524,13 @@ int AnaTreeWriter::GetZvtx( PHCompositeNode *topNode )
 int AnaTreeWriter::GetCentInfo( PHCompositeNode *topNode )
 {
   // get centrality
-  auto cent_node = findNode::getClass< CentralityInfo >( topNode, m_cent_node );
-  if ( !cent_node ) {
+  auto summary = GetEventSummary( topNode );
+  if ( !summary || !summary->has( EventSummary::kCENTRALITY ) ) {
     std::cout << PHWHERE << m_cent_node << " node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
   
-  if ( cent_node -> has_centrality_bin(CentralityInfo::PROP::mbd_NS) ) {
-    m_centrality = (int)(cent_node->get_centrality_bin(CentralityInfo::PROP::mbd_NS));
-  } else if ( cent_node -> has_centile(CentralityInfo::PROP::mbd_NS) ){
-    m_centrality = (int)(cent_node->get_centile(CentralityInfo::PROP::mbd_NS));
-  } 
+  m_centrality = summary->get_centrality();
   
   if (  m_centrality < 0 ) {
     std::cerr << PHWHERE << "CentralityInfo Node missing centrality information" << std::endl;
@@ -467,14 +548,9 @@ int AnaTreeWriter::GetCaloInfo( PHCompositeNode *topNode ,  const int idx)
 {
   const std::string & node_name = m_calo_nodes[idx];
 
-  m_num_towers = 0;
-  m_num_towers_fired = 0;
-  m_num_towers_dead = 0;
-  m_tower_energy.clear();
-  m_tower_energy_time.clear();
-  m_tower_status_ieta_iphi.clear();
+  m_branches.reset( kCalo );
 
-  auto towers = findNode::getClass< TowerInfoContainer >( topNode, node_name );
+  auto towers = m_nodes.get<TowerInfoContainer>( topNode, node_name );
   if ( !towers ) {
     std::cout << PHWHERE << " Input node "<< node_name << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN; // fatal error
@@ -513,7 +589,7 @@ int AnaTreeWriter::GetCaloInfo( PHCompositeNode *topNode ,  const int idx)
     std::cout << "AnaTreeWriter::GetCaloInfo - Calo " << node_name << " - Num Towers: " << m_num_towers << ", Num Towers Fired: " << m_num_towers_fired << ", Num Towers Dead: " << m_num_towers_dead << std::endl;
   }
   
-  m_calo_trees[idx]->Fill();
+  m_branches.fill( m_calo_trees[idx] );
   m_calo_tree_id[idx]++;
 
 
@@ -524,28 +600,27 @@ int AnaTreeWriter::GetCaloInfo( PHCompositeNode *topNode ,  const int idx)
 int AnaTreeWriter::GetMbdInfo( PHCompositeNode *topNode )
 {
   // get MBD info
-  auto mbd = findNode::getClass<MbdOutV2>( topNode, m_mbd_node );
-  if ( !mbd ) {
-    static bool once = true;
-    if ( once ) {
-      std::cout << PHWHERE << m_mbd_node << " node missing, supressing further warnings." << std::endl;
-      once = false;
-    }
+  auto summary = GetEventSummary( topNode );
+  if ( !summary ) {
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  if ( !summary->has( EventSummary::kMBD ) ) {
+    // reported once by EventSummaryReco
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
-  m_mbd_q_N = mbd->get_q(k_mbd_north_code);
-  m_mbd_q_S = mbd->get_q(k_mbd_south_code);
-  m_mbd_time_N = mbd->get_time(k_mbd_north_code);
-  m_mbd_time_S = mbd->get_time(k_mbd_south_code);
-  m_mbd_npmt_N = mbd->get_npmt(k_mbd_north_code);
-  m_mbd_npmt_S = mbd->get_npmt(k_mbd_south_code);
+  m_mbd_q_N = summary->get_mbd_q(k_mbd_north_code);
+  m_mbd_q_S = summary->get_mbd_q(k_mbd_south_code);
+  m_mbd_time_N = summary->get_mbd_t(k_mbd_north_code);
+  m_mbd_time_S = summary->get_mbd_t(k_mbd_south_code);
+  m_mbd_npmt_N = summary->get_mbd_npmt(k_mbd_north_code);
+  m_mbd_npmt_S = summary->get_mbd_npmt(k_mbd_south_code);
 
   if ( Verbosity() > 1 ) {
     std::cout << "AnaTreeWriter::GetMbdInfo - MBD info N:(q,t,n), S:(q,t,n) = (" << m_mbd_q_N << ", " << m_mbd_time_N << ", " << m_mbd_npmt_N << "), (" << m_mbd_q_S << ", " << m_mbd_time_S << ", " << m_mbd_npmt_S << ")" << std::endl;
   }
 
-  m_mbd_tree->Fill();
+  m_branches.fill( m_mbd_tree );
   m_mbd_tree_id++;
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -555,19 +630,7 @@ int AnaTreeWriter::GetJetInfo( PHCompositeNode *topNode , const int idx)
 
   const std::string & node_name = m_jet_nodes[idx];
 
-  m_num_jets = 0;
-  m_jet_eta.clear();
-  m_jet_phi.clear();
-  m_jet_eT.clear();
-  m_jet_pT.clear();
-  m_jet_energy.clear();
-  m_jet_ntowers.clear();
-  m_jet_energy_cemc.clear();
-  m_jet_energy_hcalin.clear();
-  m_jet_energy_hcalout.clear();
-  m_jet_ntowers_cemc.clear();
-  m_jet_ntowers_hcalin.clear();
-  m_jet_ntowers_hcalout.clear();
+  m_branches.reset( kJet );
 
 
   // find "_Sub1" in the node name
@@ -582,9 +645,9 @@ int AnaTreeWriter::GetJetInfo( PHCompositeNode *topNode , const int idx)
   }
 
 
-  auto towersEM3 = findNode::getClass< TowerInfoContainer >( topNode, jet_calo_cemc_node );
-  auto towersIH3 = findNode::getClass< TowerInfoContainer >( topNode, jet_calo_hcalin_node);
-  auto towersOH3 = findNode::getClass< TowerInfoContainer >( topNode, jet_calo_hcalout_node);
+  auto towersEM3 = m_nodes.get<TowerInfoContainer>( topNode, jet_calo_cemc_node );
+  auto towersIH3 = m_nodes.get<TowerInfoContainer>( topNode, jet_calo_hcalin_node);
+  auto towersOH3 = m_nodes.get<TowerInfoContainer>( topNode, jet_calo_hcalout_node);
   bool do_frac = true;
   if( !towersEM3 || !towersIH3 || !towersOH3 ){
     std::cout
@@ -594,7 +657,7 @@ int AnaTreeWriter::GetJetInfo( PHCompositeNode *topNode , const int idx)
   }
 
   
-  auto jets = findNode::getClass<JetContainer>( topNode, node_name );
+  auto jets = m_nodes.get<JetContainer>( topNode, node_name );
   if ( !jets ) {
     std::cout << PHWHERE << " Input node "<< node_name << " Node missing, doing nothing." << std::endl;
     exit(-1); // fatal error
@@ -679,7 +742,7 @@ int AnaTreeWriter::GetJetInfo( PHCompositeNode *topNode , const int idx)
   }
 
 
-  m_jet_trees[idx]->Fill();
+  m_branches.fill( m_jet_trees[idx] );
   m_jet_tree_id[idx]++;
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -692,7 +755,7 @@ int AnaTreeWriter::GetRhoInfo( PHCompositeNode *topNode )
   // get rho nodes
   for ( unsigned int i = 0; i < m_rho_nodes.size(); ++i ) {
 
-    auto rho = findNode::getClass<TowerRhov1>(topNode, m_rho_nodes[i]);
+    auto rho = m_nodes.get<TowerRhov1>(topNode, m_rho_nodes[i]);
     if ( !rho ) {
       std::cout << PHWHERE << " Input node " << m_rho_nodes[i] << " Node missing, doing nothing." << std::endl;
       return Fun4AllReturnCodes::ABORTRUN;
@@ -702,7 +765,7 @@ int AnaTreeWriter::GetRhoInfo( PHCompositeNode *topNode )
     m_std_rho_val[i] = rho->get_sigma();
   }
 
-  m_rho_tree->Fill();
+  m_branches.fill( m_rho_tree );
   m_rho_tree_id++;
   return Fun4AllReturnCodes::EVENT_OK;
 }
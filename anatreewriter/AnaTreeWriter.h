@@ -3,6 +3,11 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+#include <eventselection/TreeCheckpoint.h>
+
+#include "BranchRegistry.h"
+
 #include <string>
 #include <vector>
 #include <array>
@@ -10,6 +15,7 @@
 #include <cmath>
 
 class PHCompositeNode;
+class EventSummary;
 class TTree;
 
 class AnaTreeWriter : public SubsysReco
@@ -23,6 +29,8 @@ class AnaTreeWriter : public SubsysReco
   ~AnaTreeWriter() override {};
 
   int Init( PHCompositeNode * /*topNode*/) override;
+
+  int InitRun( PHCompositeNode * /*topNode*/ ) override;
   
   int process_event( PHCompositeNode * topNode ) override;
   
@@ -31,6 +39,10 @@ class AnaTreeWriter : public SubsysReco
   int ResetEvent( PHCompositeNode * /*topNode*/ ) override;
 
   // add info to the tree ! default are not added
+  // only write events accepted by stream of the EventSelector named
+  // selector, one writer ( and output file ) per stream
+  void set_stream ( const std::string & stream, const std::string & selector = "EventSelector" );
+
   void add_gl1_node ( const std::string & name = "GL1Packet"){  m_gl1_node = name; }
   void add_mbd_node ( const std::string & name = "MbdOut" ) { m_mbd_node = name; }
   void add_zvrtx_node ( const std::string & name = "GlobalVertexMap" ){ m_zvrtx_node = name; }
@@ -45,11 +57,36 @@ class AnaTreeWriter : public SubsysReco
 
   void add_rho_node ( const std::string & name ) { m_rho_nodes.push_back(name); }
 
+  // TTreeIndex on ( run_number, evt_sequence ) for the event tree and
+  // every split tree ( default on ), the key is taken from EventHeader
+  void set_build_index ( const bool b ) { m_build_index = b; }
+  void set_event_header_node ( const std::string & name ) { m_eventheader_node = name; }
+
+  // AutoSave the trees every nevents ( or nseconds ), see TreeCheckpoint
+  void set_checkpoint ( const unsigned int nevents, const unsigned int nseconds = 0 ) { m_checkpoint.set_interval( nevents, nseconds ); }
+  // continue a killed job from its last checkpoint
+  void set_resume ( const bool b ) { m_checkpoint.set_resume( b ); }
+
+  // write the event and split trees as RNTuples, pages compressed on
+  // nthreads implicit MT threads ( 0 single threaded ). TTrees by
+  // default. No checkpoints and no index, AnaTreeReader reads TTrees
+  void use_rntuple ( const bool b = true, const unsigned int nthreads = 0 ) { m_branches.set_backend( b ? BranchRegistry::kRNTuple : BranchRegistry::kTTree, nthreads ); }
+
  private:
+
+  // per run node handles
+  NodeCache m_nodes {};
+
+  // periodic AutoSave and resume
+  TreeCheckpoint m_checkpoint {};
     
   // output file name
   std::string m_output_filename { "" };
 
+  // stream filter, empty writes every event
+  std::string m_stream { "" };
+  std::string m_record_node { "" };
+
   // node names
   std::string m_gl1_node {""};
   std::string m_mbd_node { "" };
@@ -62,19 +99,36 @@ class AnaTreeWriter : public SubsysReco
   TTree * m_run_tree {nullptr};
   // event counters
   int m_nevents {0};
-  std::array< uint64_t, 64 > m_run_trigger_status {};
+  int m_run_number {0};
+  std::array< bool, 64 > m_run_trigger_status {};
   std::array< uint64_t, 64 > m_run_live_scalar {};
   std::array< uint64_t, 64 > m_run_scaled_scalar {};
   std::array< uint64_t, 64 > m_run_raw_scalar {};
+  // first GL1 event seen ( its scalars are in m_run_*_scalar until End )
+  // and triggers fired, carried to resumed parts by the checkpoint
+  uint64_t m_run_scalars_set { 0 };
+  uint64_t m_run_trigger_mask { 0 };
+
+  bool m_build_index { true };
+  std::string m_eventheader_node { "EventHeader" };
+  void BranchEventKey( TTree * tree );
+  void GetEventKey( PHCompositeNode *topNode );
+  void WriteIndexedTree( TTree * tree );
+
+  // per event output columns, booked in Init and reset per block
+  enum BLOCK { kZvtx = 0, kRho, kCalo, kJet };
+  BranchRegistry m_branches {};
 
   // event tree
   TTree * m_tree {nullptr};
   int m_event_id {-1};
+  int m_event_run {0};
+  int m_event_sequence {-1};
   int m_gl1_tree_id {-1};
   int m_mbd_tree_id {-1};
   int m_rho_tree_id {-1};
-  std::array<int, 8> m_calo_tree_id {};
-  std::array<int, 8> m_jet_tree_id {};
+  std::array<int, 16> m_calo_tree_id {};
+  std::array<int, 16> m_jet_tree_id {};
 
   // centrality info
   int m_centrality {-1};
@@ -139,6 +193,8 @@ class AnaTreeWriter : public SubsysReco
   std::vector < float > m_jet_energy_hcalout {};
   std::vector < float > m_jet_energy_cemc {};
 
+  // vertex, centrality and MBD all come from the EventSummary node
+  EventSummary * GetEventSummary( PHCompositeNode *topNode );
   int GetZvtx( PHCompositeNode *topNode );
   int GetGL1( PHCompositeNode *topNode );
   int GetCaloInfo( PHCompositeNode *topNode , const int idx );
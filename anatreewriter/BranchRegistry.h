@@ -0,0 +1,365 @@
+#ifndef BRANCHREGISTRY_H
+#define BRANCHREGISTRY_H
+
+#include <RVersion.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+// RNTuple writing through a bare model with bound entries needs 6.32,
+// older ROOT builds only have the TTree backend
+#if ROOT_VERSION_CODE >= ROOT_VERSION( 6, 32, 0 )
+#define BRANCHREGISTRY_RNTUPLE
+#include <ROOT/REntry.hxx>
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef BRANCHREGISTRY_RNTUPLE
+// RNTuple left ROOT::Experimental in 6.36
+#if ROOT_VERSION_CODE >= ROOT_VERSION( 6, 36, 0 )
+namespace BranchRegistryNTuple = ROOT;
+#else
+namespace BranchRegistryNTuple = ROOT::Experimental;
+#endif
+#endif
+
+// Output columns of a writer, declared once by the block that fills them.
+//
+// add() books the branch on a tree and remembers the buffer with its
+// reset value, a null address makes the registry own the buffer. The
+// same buffer can be booked on several trees ( one tree per jet node )
+// and is reset once. reset() only touches what was declared, so a block
+// that was never enabled costs nothing per event; reset( block ) clears
+// one block, for buffers refilled several times per event.
+//
+// The columns are written either as TTree branches or, with
+// set_backend( kRNTuple ), as fields of an RNTuple named after the
+// booked tree, in the file the tree was created in. std::vector columns
+// ( also nested ones ) become RNTuple collections and fixed arrays
+// become array fields. With the RNTuple backend the writer calls fill()
+// and write() instead of TTree::Fill() and TTree::Write(), the TTree
+// itself stays an empty in-memory handle, and every column of the tree
+// has to be booked here, bind() books the ones the writer sets itself.
+class BranchRegistry
+{
+ public:
+
+  enum BACKEND
+  {
+    kTTree = 0,
+    kRNTuple = 1
+  };
+
+  BranchRegistry() {}
+  ~BranchRegistry() {}
+
+  // before the first add(). nthreads > 0 compresses RNTuple pages on
+  // that many implicit MT threads, which enables ROOT implicit MT for
+  // the whole process
+  void set_backend( const BACKEND backend, const unsigned int nthreads = 0 )
+  {
+#ifdef BRANCHREGISTRY_RNTUPLE
+    m_backend = backend;
+    m_nthreads = nthreads;
+#else
+    if ( backend == kRNTuple )
+    {
+      std::cout << "BranchRegistry::set_backend - RNTuple needs ROOT 6.32, writing TTrees" << std::endl;
+    }
+    m_backend = kTTree;
+    m_nthreads = nthreads;
+#endif
+  }
+  BACKEND get_backend() const { return m_backend; }
+
+  // column the writer sets itself ( event_id, entry indices ), never reset
+  template < class T >
+  T * bind( TTree * tree, const std::string & name, T * address, const std::vector < int > & dims = {} )
+  {
+    Book( tree, name, address, dims );
+    return address;
+  }
+
+  // reset values take the buffer type, add( k, tree, "zvtx", &m_zvtx, -999 )
+  template < class T > struct Value { typedef T type; };
+
+  // scalar, leaf name/T
+  template < class T >
+  T * add( const int block, TTree * tree, const std::string & name, T * address, const typename Value< T >::type reset_value )
+  {
+    return add( block, tree, name, address, std::vector < int > {}, reset_value );
+  }
+
+  // fixed size array, leaf name[d0][d1].../T
+  template < class T >
+  T * add( const int block, TTree * tree, const std::string & name, T * address, const std::vector < int > & dims, const typename Value< T >::type reset_value )
+  {
+    std::size_t n = 1;
+    for ( const int d : dims ) { n *= d; }
+
+    if ( !address || !m_columns.count( address ) )
+    {
+      auto column = std::make_unique< FixedColumn < T > >( n, reset_value, address );
+      address = column->first;
+      Register( block, address, std::move( column ) );
+    }
+    Book( tree, name, address, dims );
+    return address;
+  }
+
+  // std::vector object branch, cleared on reset
+  template < class T >
+  std::vector < T > * add( const int block, TTree * tree, const std::string & name, std::vector < T > * address )
+  {
+    if ( !address || !m_columns.count( address ) )
+    {
+      auto column = std::make_unique< VectorColumn < T > >( address );
+      address = column->vector;
+      Register( block, address, std::move( column ) );
+    }
+    if ( m_backend == kTTree )
+    {
+      tree->Branch( name.c_str(), address );
+    }
+#ifdef BRANCHREGISTRY_RNTUPLE
+    else
+    {
+      Table & table = GetTable( tree );
+      table.model->AddField( std::make_unique< BranchRegistryNTuple::RField < std::vector < T > > >( name ) );
+      table.bindings.emplace_back( name, address );
+    }
+#endif
+    return address;
+  }
+
+  // TTree::Fill, or one RNTuple entry from the bound buffers. The
+  // RNTuple writer is created on the first fill, its model is frozen
+  // from then on
+  void fill( TTree * tree )
+  {
+    if ( m_backend == kTTree )
+    {
+      tree->Fill();
+      return;
+    }
+#ifdef BRANCHREGISTRY_RNTUPLE
+    Table & table = GetTable( tree );
+    if ( !table.writer ) { Open( table ); }
+    table.writer->Fill( *table.entry );
+    ++table.entries;
+#endif
+  }
+
+  // TTree::Write into the current directory, or commit the RNTuple to
+  // the file it was booked in. Before the file is closed
+  void write( TTree * tree )
+  {
+    if ( m_backend == kTTree )
+    {
+      tree->Write();
+      return;
+    }
+#ifdef BRANCHREGISTRY_RNTUPLE
+    Table & table = GetTable( tree );
+    if ( !table.writer ) { Open( table ); }
+    table.entry.reset();
+    table.writer.reset();
+#endif
+  }
+
+  long long get_entries( TTree * tree )
+  {
+    if ( m_backend == kTTree ) { return tree->GetEntries(); }
+#ifdef BRANCHREGISTRY_RNTUPLE
+    return GetTable( tree ).entries;
+#else
+    return 0;
+#endif
+  }
+
+  void reset()
+  {
+    for ( auto & block : m_blocks )
+    {
+      for ( auto & column : block ) { column->reset(); }
+    }
+  }
+
+  void reset( const int block )
+  {
+    if ( block < 0 || block >= static_cast< int >( m_blocks.size() ) ) { return; }
+    for ( auto & column : m_blocks[block] ) { column->reset(); }
+  }
+
+  // declared buffers, a buffer booked on several trees counts once
+  std::size_t size() const { return m_columns.size(); }
+
+ private:
+
+  struct Column
+  {
+    virtual ~Column() {}
+    virtual void reset() = 0;
+  };
+
+  template < class T >
+  struct FixedColumn : public Column
+  {
+    FixedColumn( const std::size_t size, const T value, T * address )
+      : n( size ), reset_value( value )
+    {
+      if ( !address )
+      {
+        owned.reset( new T[n] );
+        address = owned.get();
+        std::fill( address, address + n, reset_value );
+      }
+      first = address;
+    }
+    void reset() override { std::fill( first, first + n, reset_value ); }
+
+    T * first { nullptr };
+    std::size_t n { 1 };
+    T reset_value {};
+    std::unique_ptr< T[] > owned {};
+  };
+
+  template < class T >
+  struct VectorColumn : public Column
+  {
+    explicit VectorColumn( std::vector < T > * address )
+    {
+      if ( !address )
+      {
+        owned = std::make_unique< std::vector < T > >();
+        address = owned.get();
+      }
+      vector = address;
+    }
+    void reset() override { vector->clear(); }
+
+    std::vector < T > * vector { nullptr };
+    std::unique_ptr< std::vector < T > > owned {};
+  };
+
+  template < class T >
+  void Book( TTree * tree, const std::string & name, T * address, const std::vector < int > & dims )
+  {
+    if ( m_backend == kTTree )
+    {
+      std::string leaf = name;
+      for ( const int d : dims ) { leaf += "[" + std::to_string( d ) + "]"; }
+      leaf += "/";
+      leaf += leaf_code( address );
+      tree->Branch( name.c_str(), address, leaf.c_str() );
+      return;
+    }
+#ifdef BRANCHREGISTRY_RNTUPLE
+    // float[24][64] is laid out as std::array< std::array< float, 64 >, 24 >
+    std::unique_ptr< BranchRegistryNTuple::RFieldBase > field = std::make_unique< BranchRegistryNTuple::RField < T > >( dims.empty() ? name : "_0" );
+    for ( std::size_t i = dims.size(); i-- > 0; )
+    {
+      field = std::make_unique< BranchRegistryNTuple::RArrayField >( i == 0 ? name : "_0", std::move( field ), dims[i] );
+    }
+    Table & table = GetTable( tree );
+    table.model->AddField( std::move( field ) );
+    table.bindings.emplace_back( name, address );
+#endif
+  }
+
+#ifdef BRANCHREGISTRY_RNTUPLE
+  struct Table
+  {
+    std::string name {};
+    TFile * file { nullptr };
+    std::unique_ptr< BranchRegistryNTuple::RNTupleModel > model {};
+    std::vector < std::pair < std::string, void * > > bindings {};
+    std::unique_ptr< BranchRegistryNTuple::RNTupleWriter > writer {};
+    std::unique_ptr< BranchRegistryNTuple::REntry > entry {};
+    long long entries { 0 };
+  };
+
+  // one RNTuple per booked tree, the tree is detached so closing the
+  // file doesn't write an empty TTree of the same name
+  Table & GetTable( TTree * tree )
+  {
+    auto it = m_tables.find( tree );
+    if ( it != m_tables.end() ) { return it->second; }
+    Table & table = m_tables[tree];
+    table.name = tree->GetName();
+    table.file = tree->GetCurrentFile();
+    table.model = BranchRegistryNTuple::RNTupleModel::CreateBare();
+    tree->SetDirectory( nullptr );
+    return table;
+  }
+
+  void Open( Table & table )
+  {
+    if ( !table.file )
+    {
+      std::cout << "BranchRegistry::Open - no output file for " << table.name << std::endl;
+      return;
+    }
+    BranchRegistryNTuple::RNTupleWriteOptions options {};
+    if ( m_nthreads > 0 )
+    {
+      if ( !ROOT::IsImplicitMTEnabled() ) { ROOT::EnableImplicitMT( m_nthreads ); }
+      options.SetUseImplicitMT( BranchRegistryNTuple::RNTupleWriteOptions::EImplicitMT::kDefault );
+    }
+    else
+    {
+      options.SetUseImplicitMT( BranchRegistryNTuple::RNTupleWriteOptions::EImplicitMT::kOff );
+    }
+    table.writer = BranchRegistryNTuple::RNTupleWriter::Append( std::move( table.model ), table.name, *table.file, options );
+    table.entry = table.writer->CreateEntry();
+    for ( auto & [ name, address ] : table.bindings )
+    {
+      table.entry->BindRawPtr( name, address );
+    }
+  }
+
+  std::map< TTree *, Table > m_tables {};
+#endif
+
+  void Register( const int block, const void * address, std::unique_ptr< Column > column )
+  {
+    if ( block >= static_cast< int >( m_blocks.size() ) ) { m_blocks.resize( block + 1 ); }
+    m_columns[address] = column.get();
+    m_blocks[block].push_back( std::move( column ) );
+  }
+
+  // leaf type codes of TTree::Branch leaf lists
+  static char leaf_code( const char * ) { return 'B'; }
+  static char leaf_code( const unsigned char * ) { return 'b'; }
+  static char leaf_code( const short * ) { return 'S'; }
+  static char leaf_code( const unsigned short * ) { return 's'; }
+  static char leaf_code( const int * ) { return 'I'; }
+  static char leaf_code( const unsigned int * ) { return 'i'; }
+  static char leaf_code( const long * ) { return 'L'; }
+  static char leaf_code( const unsigned long * ) { return 'l'; }
+  static char leaf_code( const long long * ) { return 'L'; }
+  static char leaf_code( const unsigned long long * ) { return 'l'; }
+  static char leaf_code( const float * ) { return 'F'; }
+  static char leaf_code( const double * ) { return 'D'; }
+  static char leaf_code( const bool * ) { return 'O'; }
+
+  BACKEND m_backend { kTTree };
+  unsigned int m_nthreads { 0 };
+  std::vector < std::vector < std::unique_ptr< Column > > > m_blocks {};
+  std::unordered_map< const void *, Column * > m_columns {};
+};
+
+#endif
@@ -0,0 +1,229 @@
+#include "CaloReduction.h"
+
+#include <eventselection/NodeCache.h>
+
+#include <calobase/RawTowerGeom.h>
+#include <calobase/RawTowerGeomContainer.h>
+#include <calobase/TowerInfo.h>
+#include <calobase/TowerInfoContainer.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+  const double k_radius_cemc = 93.5;
+  const double k_radius_hcalin = 127.503;
+  const double k_radius_hcalout = 225.87;
+
+  bool contains( const std::string & s, const std::string & key ) { return s.find( key ) != std::string::npos; }
+}
+
+unsigned int CaloReduction::add_node( const std::string & towerinfo_node, const std::string & geo_node )
+{
+  Calo calo;
+  calo.towerinfo_node = towerinfo_node;
+
+  // radius of the calorimeter the towers belong to, retowered CEMC stays at the CEMC radius
+  if ( contains( towerinfo_node, "CEMC" ) ) { calo.radius = k_radius_cemc; }
+  else if ( contains( towerinfo_node, "HCALIN" ) ) { calo.radius = k_radius_hcalin; }
+  else if ( contains( towerinfo_node, "HCALOUT" ) ) { calo.radius = k_radius_hcalout; }
+  else { calo.radius = k_radius_cemc; }
+
+  calo.geo_node = geo_node;
+  if ( calo.geo_node.empty() )
+  {
+    if ( contains( towerinfo_node, "HCALIN" ) || contains( towerinfo_node, "CEMC_RETOWER" ) ) { calo.geo_node = "TOWERGEOM_HCALIN"; }
+    else if ( contains( towerinfo_node, "HCALOUT" ) ) { calo.geo_node = "TOWERGEOM_HCALOUT"; }
+    else if ( contains( towerinfo_node, "CEMC" ) ) { calo.geo_node = "TOWERGEOM_CEMC"; }
+  }
+
+  if ( contains( calo.geo_node, "HCALIN" ) ) { calo.geo_caloid = RawTowerDefs::CalorimeterId::HCALIN; }
+  else if ( contains( calo.geo_node, "HCALOUT" ) ) { calo.geo_caloid = RawTowerDefs::CalorimeterId::HCALOUT; }
+  else if ( contains( calo.geo_node, "CEMC" ) ) { calo.geo_caloid = RawTowerDefs::CalorimeterId::CEMC; }
+  else
+  {
+    std::cout << PHWHERE << " Warning: cannot determine calo id from geo node name " << calo.geo_node << ", " << towerinfo_node << " is skipped." << std::endl;
+  }
+
+  // full granularity CEMC, everything else is on the HCAL grid
+  const bool fine = calo.geo_caloid == RawTowerDefs::CalorimeterId::CEMC;
+  calo.result.ieta_avgE.assign( fine ? 96 : 24, 0.0 );
+  calo.result.iphi_avgE.assign( fine ? 256 : 64, 0.0 );
+  calo.ieta_count.assign( calo.result.ieta_avgE.size(), 0 );
+  calo.iphi_count.assign( calo.result.iphi_avgE.size(), 0 );
+
+  m_calos.push_back( calo );
+  return m_calos.size() - 1;
+}
+
+void CaloReduction::clear_geometry()
+{
+  for ( auto & calo : m_calos )
+  {
+    calo.has_geometry = false;
+  }
+}
+
+void CaloReduction::reset()
+{
+  for ( auto & calo : m_calos )
+  {
+    Result & r = calo.result;
+    r.sumE = 0.0;
+    r.sumEt = 0.0;
+    r.ntowers = 0;
+    r.nmasked = 0;
+    std::fill( r.ieta_avgE.begin(), r.ieta_avgE.end(), 0.0 );
+    std::fill( r.iphi_avgE.begin(), r.iphi_avgE.end(), 0.0 );
+    std::fill( calo.ieta_count.begin(), calo.ieta_count.end(), 0 );
+    std::fill( calo.iphi_count.begin(), calo.iphi_count.end(), 0 );
+  }
+}
+
+bool CaloReduction::CacheGeometry( Calo & calo, PHCompositeNode * topNode, NodeCache & nodes )
+{
+  auto towerinfos = nodes.get<TowerInfoContainer>( topNode, calo.towerinfo_node );
+  auto geocont = nodes.get<RawTowerGeomContainer>( topNode, calo.geo_node );
+  if ( !towerinfos ) { return false; }
+  if ( !geocont )
+  {
+    std::cout << PHWHERE << " RawTowerGeomContainer node " << calo.geo_node << " missing, skipping." << std::endl;
+    return false;
+  }
+
+  const unsigned int ntowers = towerinfos->size();
+  calo.channel_slot.assign( ntowers, -1 );
+  calo.channel_ieta.assign( ntowers, -1 );
+  calo.channel_iphi.assign( ntowers, -1 );
+
+  std::vector < double > channel_eta( ntowers, 0.0 );
+  std::vector < double > ring_eta;
+  std::vector < bool > ring_set;
+  bool uniform = true;
+  for ( unsigned int ich = 0; ich < ntowers; ++ich )
+  {
+    const unsigned int key = towerinfos->encode_key( ich );
+    const int ieta = towerinfos->getTowerEtaBin( key );
+    const int iphi = towerinfos->getTowerPhiBin( key );
+    auto tower_geom = geocont->get_tower_geometry( RawTowerDefs::encode_towerid( calo.geo_caloid, ieta, iphi ) );
+    if ( !tower_geom ) { continue; } // no geometry, never summed
+
+    calo.channel_ieta[ich] = ieta;
+    calo.channel_iphi[ich] = iphi;
+    channel_eta[ich] = tower_geom->get_eta();
+
+    if ( ieta >= static_cast< int >( ring_eta.size() ) )
+    {
+      ring_eta.resize( ieta + 1, 0.0 );
+      ring_set.resize( ieta + 1, false );
+    }
+    if ( !ring_set[ieta] )
+    {
+      ring_eta[ieta] = channel_eta[ich];
+      ring_set[ieta] = true;
+    }
+    else if ( ring_eta[ieta] != channel_eta[ich] )
+    {
+      uniform = false;
+    }
+  }
+
+  if ( uniform )
+  {
+    calo.slot_eta = ring_eta;
+    for ( unsigned int ich = 0; ich < ntowers; ++ich ) { calo.channel_slot[ich] = calo.channel_ieta[ich]; }
+  }
+  else
+  {
+    calo.slot_eta = channel_eta;
+    for ( unsigned int ich = 0; ich < ntowers; ++ich ) { calo.channel_slot[ich] = calo.channel_ieta[ich] < 0 ? -1 : static_cast< int >( ich ); }
+  }
+
+  if ( m_verbosity > 0 )
+  {
+    std::cout << "CaloReduction::CacheGeometry - " << calo.towerinfo_node << ": " << ntowers << " towers, "
+              << calo.slot_eta.size() << ( uniform ? " eta rings" : " tower etas" ) << ", R = " << calo.radius << std::endl;
+  }
+  calo.has_geometry = true;
+  return true;
+}
+
+void CaloReduction::process( PHCompositeNode * topNode, NodeCache & nodes, const float zvrtx )
+{
+  reset();
+
+  for ( auto & calo : m_calos )
+  {
+    if ( calo.geo_caloid == RawTowerDefs::CalorimeterId::NONE ) { continue; }
+
+    auto towerinfos = nodes.get<TowerInfoContainer>( topNode, calo.towerinfo_node );
+    if ( !towerinfos ) { continue; }
+    if ( !calo.has_geometry || calo.channel_slot.size() != towerinfos->size() )
+    {
+      if ( !CacheGeometry( calo, topNode, nodes ) ) { continue; }
+    }
+
+    // eta after the vertex shift, once per slot
+    m_cosh.resize( calo.slot_eta.size() );
+    for ( unsigned int islot = 0; islot < calo.slot_eta.size(); ++islot )
+    {
+      const double z0 = sinh( calo.slot_eta[islot] ) * calo.radius;
+      const double z = z0 - zvrtx;
+      m_cosh[islot] = cosh( asinh( z / calo.radius ) );
+    }
+
+    Result & r = calo.result;
+    const unsigned int neta = r.ieta_avgE.size();
+    const unsigned int nphi = r.iphi_avgE.size();
+    const unsigned int ntowers = calo.channel_slot.size();
+    for ( unsigned int ich = 0; ich < ntowers; ++ich )
+    {
+      const int slot = calo.channel_slot[ich];
+      if ( slot < 0 ) { continue; }
+
+      auto tower = towerinfos->get_tower_at_channel( ich );
+      if ( !tower->get_isGood() || std::isnan( tower->get_energy() ) )
+      {
+        ++r.nmasked;
+        continue;
+      }
+
+      const double E = tower->get_energy();
+      r.sumE += E;
+      r.sumEt += E / m_cosh[slot];
+      ++r.ntowers;
+
+      const unsigned int ieta = calo.channel_ieta[ich];
+      const unsigned int iphi = calo.channel_iphi[ich];
+      if ( ieta < neta )
+      {
+        r.ieta_avgE[ieta] += E;
+        ++calo.ieta_count[ieta];
+      }
+      if ( iphi < nphi )
+      {
+        r.iphi_avgE[iphi] += E;
+        ++calo.iphi_count[iphi];
+      }
+    }
+
+    for ( unsigned int i = 0; i < neta; ++i )
+    {
+      if ( calo.ieta_count[i] ) { r.ieta_avgE[i] /= calo.ieta_count[i]; }
+    }
+    for ( unsigned int i = 0; i < nphi; ++i )
+    {
+      if ( calo.iphi_count[i] ) { r.iphi_avgE[i] /= calo.iphi_count[i]; }
+    }
+
+    if ( m_verbosity > 1 )
+    {
+      std::cout << PHWHERE << " - " << calo.towerinfo_node << ": sum_e = " << r.sumEt << ", masked = " << r.nmasked << std::endl;
+    }
+  }
+}
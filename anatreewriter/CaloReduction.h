@@ -0,0 +1,80 @@
+#ifndef CALOREDUCTION_H
+#define CALOREDUCTION_H
+
+#include <calobase/RawTowerDefs.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class NodeCache;
+
+// per event tower summaries of several TowerInfo nodes, one pass over
+// each container. The calorimeter, its radius and the geometry node are
+// resolved when the node is added. Tower eta is read from the geometry
+// once per run and the vertex shift is evaluated once per eta ring, so
+// the tower loop itself is a divide and a few adds.
+class CaloReduction
+{
+ public:
+
+  struct Result
+  {
+    float sumE { 0.0 };
+    float sumEt { 0.0 };             // vertex corrected eT, towers at the calo radius
+    unsigned int ntowers { 0 };      // good towers
+    unsigned int nmasked { 0 };      // bad status or nan energy
+    std::vector < float > ieta_avgE {};
+    std::vector < float > iphi_avgE {};
+  };
+
+  CaloReduction() {}
+  ~CaloReduction() {}
+
+  // geo_node empty: TOWERGEOM of the calo in the node name, HCALIN for
+  // retowered CEMC. Returns the index of the node
+  unsigned int add_node( const std::string & towerinfo_node, const std::string & geo_node = "" );
+
+  // geometry is cached per run, call from InitRun
+  void clear_geometry();
+
+  void reset();
+  void process( PHCompositeNode * topNode, NodeCache & nodes, const float zvrtx );
+
+  unsigned int size() const { return m_calos.size(); }
+  const std::string & get_node( const unsigned int i ) const { return m_calos.at( i ).towerinfo_node; }
+  // results keep their address, safe as branch buffers
+  Result & get( const unsigned int i ) { return m_calos.at( i ).result; }
+  const Result & get( const unsigned int i ) const { return m_calos.at( i ).result; }
+
+  void set_verbosity( const int v ) { m_verbosity = v; }
+
+ private:
+
+  struct Calo
+  {
+    std::string towerinfo_node {};
+    std::string geo_node {};
+    RawTowerDefs::CalorimeterId geo_caloid { RawTowerDefs::CalorimeterId::NONE };
+    double radius { 0.0 };
+    Result result {};
+
+    // per run: every channel points at a slot with one eta, the eta ring
+    // when all towers of a ring share it ( the usual case ), else its own
+    bool has_geometry { false };
+    std::vector < int > channel_slot {};
+    std::vector < int > channel_ieta {};
+    std::vector < int > channel_iphi {};
+    std::vector < double > slot_eta {};
+    std::vector < unsigned int > ieta_count {};
+    std::vector < unsigned int > iphi_count {};
+  };
+
+  std::vector < Calo > m_calos {};
+  std::vector < double > m_cosh {}; // per slot, per event
+  int m_verbosity { 0 };
+
+  bool CacheGeometry( Calo & calo, PHCompositeNode * topNode, NodeCache & nodes );
+};
+
+#endif
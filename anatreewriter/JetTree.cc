@@ -41,6 +41,9 @@
 #include <g4main/PHG4Particle.h>
 #include <g4main/PHG4VtxPoint.h>
 
+#include <eventselection/EventSummary.h>
+#include <eventselection/EventSummaryReco.h>
+
 #include <mbd/MbdOut.h>
 #include <mbd/MbdOutV1.h>
 #include <mbd/MbdOutV2.h>
@@ -79,6 +82,17 @@
 int JetTree::Init( PHCompositeNode * /*topNode*/ )
 {
   
+  // AutoSave and resume work on TTrees, an RNTuple is only readable once committed
+  if ( m_branches.get_backend() == BranchRegistry::kRNTuple && m_checkpoint.enabled() )
+  {
+    std::cout << "JetTree::Init - checkpoints need the TTree backend, disabled" << std::endl;
+    m_checkpoint.set_interval( 0 );
+    m_checkpoint.set_resume( false );
+  }
+
+  // a new part when resuming
+  m_checkpoint.set_verbosity( Verbosity() );
+  m_output_filename = m_checkpoint.begin( m_output_filename );
   PHTFileServer::get().open( m_output_filename, "RECREATE" );
 
   if ( Verbosity () > 0 ) 
@@ -86,52 +100,57 @@ int JetTree::Init( PHCompositeNode * /*topNode*/ )
     std::cout << "JetTree::Init - opening file " << m_output_filename << std::endl;
   } 
 
-  m_event_id = -1;
+  m_event_id = m_checkpoint.get_resume_event_id();
 
   m_tree = new TTree( "T", "T" );
-  m_tree -> Branch( "event_id", &m_event_id, "event_id/I" );
+  m_checkpoint.add_tree( m_tree );
+  m_branches.bind( m_tree, "event_id", &m_event_id );
   if ( !m_zvrtx_node.empty() ) 
   {
-    m_tree -> Branch( "zvrtx", &m_zvrtx, "zvrtx/F" );
+    m_branches.add( kZvtx, m_tree, "zvrtx", &m_zvtx, -999 );
   }
   if ( !m_cent_node.empty() ) 
   {
-    m_tree -> Branch( "cent", &m_cent, "cent/I" );
+    m_branches.add( kCent, m_tree, "cent", &m_cent, -1 );
   }
   if ( !m_header_node.empty() )
   {
-    m_tree -> Branch( "b", &m_b, "b/F" );
-    m_tree -> Branch( "ep_angle", &m_ep_angle, "ep_angle/F" );
-    m_tree -> Branch( "ecc", &m_ecc, "ecc/F" );
-    m_tree -> Branch( "ncoll", &m_ncoll, "ncoll/F" );
-    m_tree -> Branch( "npart", &m_npart, "npart/F" );
-    m_tree -> Branch( "psiN", m_psin, Form("psiN[%d]/F", (int)k_max_psin) );    
+    m_branches.add( kEventHeader, m_tree, "b", &m_b, -999 );
+    m_branches.add( kEventHeader, m_tree, "ep_angle", &m_ep_angle, -999 );
+    m_branches.add( kEventHeader, m_tree, "ecc", &m_ecc, -999 );
+    m_branches.add( kEventHeader, m_tree, "ncoll", &m_ncoll, -999 );
+    m_branches.add( kEventHeader, m_tree, "npart", &m_npart, -999 );
+    m_psin = m_branches.add( kEventHeader, m_tree, "psiN", m_psin, { k_max_psin }, -999 );
   }
   for ( unsigned int i = 0; i <m_ncalo_nodes; ++i ) 
   {
+    // CaloReduction resets its results itself
     const std::string & calo_node = m_calo_nodes[i];
     const std::string & calo_nick = m_calo_nicknames_map[calo_node];
-    m_tree -> Branch( Form("%s_sumE", calo_nick.c_str()), &m_calo_sumE_map[calo_node], Form("%s_sumE/F", calo_nick.c_str()) );
-    m_tree -> Branch( Form("%s_sumEt", calo_nick.c_str()), &m_calo_sumEt_map[calo_node], Form("%s_sumEt/F", calo_nick.c_str()) );
-    m_tree -> Branch( Form("%s_ieta_avgE", calo_nick.c_str()), &m_calo_ieta_avgE_map[calo_node], Form("%s_ieta_avgE[%d]/F", calo_nick.c_str(), k_ieta) );
-    m_tree -> Branch( Form("%s_iphi_avgE", calo_nick.c_str()), &m_calo_iphi_avgE_map[calo_node], Form("%s_iphi_avgE[%d]/F", calo_nick.c_str(), k_iphi) );
+    CaloReduction::Result & calo = m_calo.get( m_calo_index_map[calo_node] );
+    m_branches.bind( m_tree, calo_nick + "_sumE", &calo.sumE );
+    m_branches.bind( m_tree, calo_nick + "_sumEt", &calo.sumEt );
+    m_branches.bind( m_tree, calo_nick + "_nmasked", &calo.nmasked );
+    m_branches.bind( m_tree, calo_nick + "_ieta_avgE", calo.ieta_avgE.data(), { (int) calo.ieta_avgE.size() } );
+    m_branches.bind( m_tree, calo_nick + "_iphi_avgE", calo.iphi_avgE.data(), { (int) calo.iphi_avgE.size() } );
   }
   for ( unsigned int i = 0; i < m_nrho_nodes; ++i ) 
   {
     const std::string & rho_node = m_rho_nodes[i];
     const std::string & rho_nick = m_rho_nicknames_map[rho_node];
-    m_tree -> Branch( Form("%s_mu", rho_nick.c_str()), &m_rho_map[rho_node], Form("%s_mu/F", rho_nick.c_str()) );
-    m_tree -> Branch( Form("%s_sigma", rho_nick.c_str()), &m_rho_sigma_map[rho_node], Form("%s_sigma/F", rho_nick.c_str()) );
+    m_rho_map[rho_node] = m_branches.add( kRho, m_tree, rho_nick + "_mu", static_cast< float * >( nullptr ), 0 );
+    m_rho_sigma_map[rho_node] = m_branches.add( kRho, m_tree, rho_nick + "_sigma", static_cast< float * >( nullptr ), 0 );
   }
   for ( unsigned int i = 0; i < m_ntowerbkgd_nodes; ++i ) 
   {
     const std::string & towerbkgd_node = m_towerbkgd_nodes[i];
     const std::string & towerbkgd_nick = m_towerbkgd_nicknames_map[towerbkgd_node];
-    m_tree -> Branch( Form("%s_cemc", towerbkgd_nick.c_str()), &m_towerbkgd_cemc_map[towerbkgd_node].data(), Form("%s_cemc[%d]/F", towerbkgd_nick.c_str(), k_ieta) );
-    m_tree -> Branch( Form("%s_hcalin", towerbkgd_nick.c_str()), &m_towerbkgd_hcalin_map[towerbkgd_node].data(), Form("%s_hcalin[%d]/F", towerbkgd_nick.c_str(), k_ieta) );
-    m_tree -> Branch( Form("%s_hcalout", towerbkgd_nick.c_str()), &m_towerbkgd_hcalout_map[towerbkgd_node].data(), Form("%s_hcalout[%d]/F", towerbkgd_nick.c_str(), k_ieta) );
-    m_tree -> Branch( Form("%s_v2", towerbkgd_nick.c_str()), &m_towerbkgd_v2_map[towerbkgd_node], Form("%s_v2/F", towerbkgd_nick.c_str()) );
-    m_tree -> Branch( Form("%s_flowfail", towerbkgd_nick.c_str()), &m_towerbkgd_flowfail_map[towerbkgd_node], Form("%s_flowfail/I", towerbkgd_nick.c_str()) );
+    TowerBkgdColumns & towerbkgd = m_towerbkgd_map[towerbkgd_node];
+    towerbkgd.cemc = m_branches.add( kTowerBkgd, m_tree, towerbkgd_nick + "_cemc", towerbkgd.cemc, { k_ieta }, 0 );
+    towerbkgd.hcalin = m_branches.add( kTowerBkgd, m_tree, towerbkgd_nick + "_hcalin", towerbkgd.hcalin, { k_ieta }, 0 );
+    towerbkgd.hcalout = m_branches.add( kTowerBkgd, m_tree, towerbkgd_nick + "_hcalout", towerbkgd.hcalout, { k_ieta }, 0 );
+    towerbkgd.v2 = m_branches.add( kTowerBkgd, m_tree, towerbkgd_nick + "_v2", towerbkgd.v2, 0 );
+    towerbkgd.flowfail = m_branches.add( kTowerBkgd, m_tree, towerbkgd_nick + "_flowfail", towerbkgd.flowfail, 0 );
   }
   for ( unsigned int i = 0; i < m_njet_nodes ; ++i ) 
   {
@@ -139,44 +158,47 @@ int JetTree::Init( PHCompositeNode * /*topNode*/ )
     const std::string & jet_nick = m_jet_nicknames_map[jet_node];
     const float jet_R = m_jetR_map[jet_node];
     const JET_TYPE jet_type = m_jet_type_map[jet_node];
-
-    m_tree -> Branch( Form("%s_R", jet_nick.c_str()), &jet_R, Form("%s_R/F", jet_nick.c_str()) );
-    m_tree -> Branch( Form("%s_pT", jet_nick.c_str()), &m_jet_pT[jet_node] );
-    m_tree -> Branch( Form("%s_E", jet_nick.c_str()), &m_jet_E[jet_node] );
-    m_tree -> Branch( Form("%s_eta", jet_nick.c_str()), &m_jet_eta[jet_node] );
-    m_tree -> Branch( Form("%s_phi", jet_nick.c_str()), &m_jet_phi[jet_node] );
+    JetColumns & jet = m_jet_columns[jet_node];
+
+    // constant column, reset to R every event
+    m_branches.add( kJet, m_tree, jet_nick + "_R", static_cast< float * >( nullptr ), jet_R );
+    jet.pT = m_branches.add( kJet, m_tree, jet_nick + "_pT", jet.pT );
+    jet.E = m_branches.add( kJet, m_tree, jet_nick + "_E", jet.E );
+    jet.eta = m_branches.add( kJet, m_tree, jet_nick + "_eta", jet.eta );
+    jet.phi = m_branches.add( kJet, m_tree, jet_nick + "_phi", jet.phi );
     if ( jet_type == JET_TYPE::TRUTH )
     {
       continue; // for truth jets, only fill basic kinematics for now
     }
     if ( jet_type == JET_TYPE::SEED )
     { 
-      m_tree -> Branch( Form("%s_maxD", jet_nick.c_str()), &m_jet_maxD[jet_node] );
-      m_tree -> Branch( Form("%s_avgD", jet_nick.c_str()), &m_jet_avgD[jet_node] );
-      m_tree -> Branch( Form("%s_supercomp_eT", jet_nick.c_str()), &m_jet_supercomp_eT[jet_node] );
+      jet.maxD = m_branches.add( kJet, m_tree, jet_nick + "_maxD", jet.maxD );
+      jet.avgD = m_branches.add( kJet, m_tree, jet_nick + "_avgD", jet.avgD );
+      jet.supercomp_eT = m_branches.add( kJet, m_tree, jet_nick + "_supercomp_eT", jet.supercomp_eT );
     }
     if ( jet_type == JET_TYPE::SUB1 )
     {
-      m_tree -> Branch( Form("%s_unsub_pT", jet_nick.c_str()), &m_jet_unsub_pT[jet_node] );
-      m_tree -> Branch( Form("%s_unsub_E", jet_nick.c_str()), &m_jet_unsub_E[jet_node] );
+      jet.unsub_pT = m_branches.add( kJet, m_tree, jet_nick + "_unsub_pT", jet.unsub_pT );
+      jet.unsub_E = m_branches.add( kJet, m_tree, jet_nick + "_unsub_E", jet.unsub_E );
     }
     if ( jet_type == JET_TYPE::RAW )
     {
-      m_tree -> Branch( Form("%s_area_layer", jet_nick.c_str()), &m_jet_area_layer[jet_node] );
-      m_tree -> Branch( Form("%s_E_layer", jet_nick.c_str()), &m_jet_E_layer[jet_node] );
-      m_tree -> Branch( Form("%s_N_layer", jet_nick.c_str()), &m_jet_N_layer[jet_node] );
+      jet.area_layer = m_branches.add( kJet, m_tree, jet_nick + "_area_layer", jet.area_layer );
+      jet.E_layer = m_branches.add( kJet, m_tree, jet_nick + "_E_layer", jet.E_layer );
+      jet.N_layer = m_branches.add( kJet, m_tree, jet_nick + "_N_layer", jet.N_layer );
     }
-    m_tree -> Branch( Form("%s_comp_ieta", jet_nick.c_str()), &m_jet_comp_ieta[jet_node] );
-    m_tree -> Branch( Form("%s_comp_iphi", jet_nick.c_str()), &m_jet_comp_iphi[jet_node] );
-    m_tree -> Branch( Form("%s_comp_caloid", jet_nick.c_str()), &m_jet_comp_caloid[jet_node] );
-    m_tree -> Branch( Form("%s_comp_E", jet_nick.c_str()), &m_jet_comp_E[jet_node] );
-    m_tree -> Branch( Form("%s_comp_eta", jet_nick.c_str()), &m_jet_comp_eta[jet_node] );
-    m_tree -> Branch( Form("%s_comp_phi", jet_nick.c_str()), &m_jet_comp_phi[jet_node] );
+    jet.comp_ieta = m_branches.add( kJet, m_tree, jet_nick + "_comp_ieta", jet.comp_ieta );
+    jet.comp_iphi = m_branches.add( kJet, m_tree, jet_nick + "_comp_iphi", jet.comp_iphi );
+    jet.comp_caloid = m_branches.add( kJet, m_tree, jet_nick + "_comp_caloid", jet.comp_caloid );
+    jet.comp_E = m_branches.add( kJet, m_tree, jet_nick + "_comp_E", jet.comp_E );
+    jet.comp_eta = m_branches.add( kJet, m_tree, jet_nick + "_comp_eta", jet.comp_eta );
+    jet.comp_phi = m_branches.add( kJet, m_tree, jet_nick + "_comp_phi", jet.comp_phi );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "JetTree::Init - Registered jet node: " << jet_node << " with R = " << jet_R << " and type = " << jet_type << std::endl;
     }
   }
+  m_branches.reset();
 
   
   if ( Verbosity () > 0 )
@@ -187,9 +209,23 @@ int JetTree::Init( PHCompositeNode * /*topNode*/ )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int JetTree::InitRun( PHCompositeNode * /*topNode*/ )
+{
+  m_nodes.clear();
+  m_calo.clear_geometry();
+  m_super_towers.clear_geometry();
+  m_ue_table.clear_geometry();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int JetTree::process_event( PHCompositeNode *topNode )
 {
 
+  if ( m_checkpoint.skip_event() ) 
+  { // written by the part we resume from
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
   m_event_id++; 
 
   
@@ -210,28 +246,42 @@ int JetTree::process_event( PHCompositeNode *topNode )
     if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
   }
 
-  if ( !m_eventhead_node.empty() ) 
+  if ( !m_header_node.empty() ) 
   { // get event header info
     auto res = GetEventHeaderInfo(topNode);
     if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
   }
 
-  for ( unsigned int i = 0; i < m_sub1jet_nodes.size(); ++i ) 
-  { // reset sub1 jet info
-    auto res = GetSub1JetInfo(topNode, i);
+  if ( m_nrho_nodes > 0 )
+  {
+    auto res = GetRhoInfo(topNode);
+    if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
+  }
+
+  if ( m_ntowerbkgd_nodes > 0 )
+  {
+    auto res = GetTowerBkgdInfo(topNode);
     if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
   }
 
-  for ( unsigned int i = 0; i < m_truthjet_nodes.size(); ++i ) 
-  { // reset truth jet info
-    auto res = GetTruthJetInfo(topNode, i);
+  for ( const auto & jet_node : m_jet_nodes )
+  {
+    int res = Fun4AllReturnCodes::EVENT_OK;
+    switch ( m_jet_type_map[jet_node] )
+    {
+      case JET_TYPE::RAW: res = GetRawJetInfo(topNode, jet_node); break;
+      case JET_TYPE::SUB1: res = GetSub1JetInfo(topNode, jet_node); break;
+      case JET_TYPE::TRUTH: res = GetTruthJetInfo(topNode, jet_node); break;
+      case JET_TYPE::SEED: res = GetSeedInfo(topNode, jet_node); break;
+    }
     if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
   }
 
   GetCaloInfo(topNode);
 
   // fill tree
-  m_tree->Fill();
+  m_branches.fill( m_tree );
+  m_checkpoint.filled( m_event_id );
   
   return Fun4AllReturnCodes::EVENT_OK;
 
@@ -248,7 +298,7 @@ int JetTree::End( PHCompositeNode * /*topNode*/ )
 
   PHTFileServer::get().cd(m_output_filename); 
 
-  m_tree->Write();
+  m_branches.write( m_tree );
   
 
   if ( Verbosity() > 0 ) 
@@ -256,6 +306,7 @@ int JetTree::End( PHCompositeNode * /*topNode*/ )
     std::cout << "JetTree::EndRun - Writing run tree" << std::endl;
   }
   PHTFileServer::get().close();
+  m_checkpoint.finish();
  
   if ( Verbosity () > 0 ) 
   {
@@ -265,33 +316,37 @@ int JetTree::End( PHCompositeNode * /*topNode*/ )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+EventSummary * JetTree::GetEventSummary( PHCompositeNode *topNode )
+{
+  // only used when EventSummaryReco did not fill the summary first
+  EventSummaryReco::InputNodes inputs;
+  if ( !m_zvrtx_node.empty() ) { inputs.vertex = m_zvrtx_node; }
+  if ( !m_cent_node.empty() ) { inputs.centrality = m_cent_node; }
+
+  auto summary = EventSummaryReco::GetSummary( topNode, m_nodes, "EventSummary", inputs );
+  if ( !summary )
+  {
+    std::cout << PHWHERE << " EventSummary node missing, Abort!." << std::endl;
+  }
+  return summary;
+}
+
 int JetTree::GetZvtx( PHCompositeNode *topNode )
 {
     // get zvtx
-    ResetZvtx();
-    auto vertexmap = findNode::getClass<GlobalVertexMap>( topNode, m_zvrtx_node );
-    if ( !vertexmap  || vertexmap->empty() ) 
+    auto summary = GetEventSummary( topNode );
+    if ( !summary ) { return Fun4AllReturnCodes::ABORTRUN; }
+
+    // missing vertices are counted and reported by EventSummaryReco
+    if ( summary->get_vertex_status() == EventSummary::kVERTEX_MISSING ) 
     {
-      std::cout << PHWHERE << "" << m_zvrtx_node << " node missing, skipping event." << std::endl;
       return Fun4AllReturnCodes::EVENT_OK;
     }
-  
-    
-    auto vtx = vertexmap->begin()->second;
-    m_zvtx = NAN;
-    if ( vtx ) 
-    {
-      m_zvtx = vtx->get_z();
-    } 
 
-    if ( std::isnan(m_zvtx) || m_zvtx > 1e3) 
+    m_zvtx = summary->get_zvtx();
+    if ( !summary->has_good_vertex() ) 
     {
-      static bool once = true;
-      if (once) 
-      {
-        once = false;
-        std::cout << PHWHERE << "vertex is " << m_zvtx << ". Drop all tower inputs (further vertex warning will be suppressed)." << std::endl;
-      }
+      // drop all tower inputs
       return Fun4AllReturnCodes::ABORTEVENT;
     }
 
@@ -307,23 +362,14 @@ int JetTree::GetZvtx( PHCompositeNode *topNode )
 int JetTree::GetCentInfo( PHCompositeNode *topNode )
 {
   // get centrality
-  ResetCent();
-  auto cent_node = findNode::getClass< CentralityInfo >( topNode, m_cent_node );
-  if ( !cent_node ) 
+  auto summary = GetEventSummary( topNode );
+  if ( !summary || !summary->has( EventSummary::kCENTRALITY ) ) 
   {
     std::cout << PHWHERE << m_cent_node << " node missing, Abort!." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  if ( cent_node ) 
-  {
-    m_cent = (int)(cent_node->get_centrality_bin(CentralityInfo::PROP::mbd_NS));
-  } 
-  else 
-  {
-    std::cout << PHWHERE << "CentralityInfo is missing." << std::endl;
-  }
-  
+  m_cent = summary->get_centrality();
 
   if ( Verbosity() > 1 ) 
   {
@@ -336,46 +382,204 @@ int JetTree::GetCentInfo( PHCompositeNode *topNode )
 int JetTree::GetEventHeaderInfo( PHCompositeNode *topNode )
 {
   // get event header info
-  ResetEventHeader();
-  auto eventhead = findNode::getClass<EventHeader>( topNode, m_eventhead_node );
-  if ( !eventhead ) 
+  auto summary = GetEventSummary( topNode );
+  if ( !summary || !summary->has( EventSummary::kEVENTHEADER ) ) 
   {
-    std::cout << PHWHERE << " Input node " << m_eventhead_node << " Node missing, doing nothing." << std::endl;
+    std::cout << PHWHERE << " EventHeader Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  m_b = eventhead->get_ImpactParameter();
-  m_ep_angle = eventhead->get_EventPlaneAngle();
-  m_ecc = eventhead->get_eccentricity();
-  m_psi1 = eventhead->get_FlowPsiN(1);
-  m_psi2 = eventhead->get_FlowPsiN(2);
-  m_psi3 = eventhead->get_FlowPsiN(3);
-  m_psi4 = eventhead->get_FlowPsiN(4);
-  m_psi5 = eventhead->get_FlowPsiN(5);
-  m_psi6 = eventhead->get_FlowPsiN(6);
-  m_ncoll = eventhead->get_ncoll();
-  m_npart = eventhead->get_npart();
+  m_b = summary->get_b();
+  m_ep_angle = summary->get_ep_angle();
+  m_ecc = summary->get_ecc();
+  for ( int n = 1; n <= k_max_psin; ++n )
+  {
+    m_psin[n - 1] = summary->get_psi(n);
+  }
+  m_ncoll = summary->get_ncoll();
+  m_npart = summary->get_npart();
   
   if ( Verbosity() > 1 ) 
   {
-    std::cout << PHWHERE << " - b = " << m_b << ", ep_angle = " << m_ep_angle << ", ecc = " << m_ecc << ", psi2 = " << m_psi2 << ", ncoll = " << m_ncoll << ", npart = " << m_npart << std::endl;
+    std::cout << PHWHERE << " - b = " << m_b << ", ep_angle = " << m_ep_angle << ", ecc = " << m_ecc << ", psi2 = " << m_psin[1] << ", ncoll = " << m_ncoll << ", npart = " << m_npart << std::endl;
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-int JetTree::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
+int JetTree::GetRhoInfo( PHCompositeNode *topNode )
 {
+  for ( const auto & rho_node : m_rho_nodes )
+  {
+    auto rho = m_nodes.get<TowerRhov1>( topNode, rho_node );
+    if ( !rho )
+    {
+      std::cout << PHWHERE << " Input node " << rho_node << " Node missing, doing nothing." << std::endl;
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
 
-  const std::string & node_name = m_sub1jet_nodes[idx];
- 
-  ResetSub1Jet();
-  ResetTowerBkgd();
+    *m_rho_map[rho_node] = rho->get_rho();
+    *m_rho_sigma_map[rho_node] = rho->get_sigma();
+
+    if ( Verbosity() > 1 )
+    {
+      std::cout << PHWHERE << " - Rho from " << rho_node << " = " << *m_rho_map[rho_node] << " +/- " << *m_rho_sigma_map[rho_node] << std::endl;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int JetTree::GetTowerBkgdInfo( PHCompositeNode *topNode )
+{
+  for ( const auto & towerbkgd_node : m_towerbkgd_nodes )
+  {
+    auto tower_background = m_nodes.get<TowerBackgroundv1>( topNode, towerbkgd_node );
+    if ( !tower_background )
+    {
+      std::cout << PHWHERE << " TowerBackgroundv1 node " << towerbkgd_node << " is missing, skipping." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN; // fatal error
+    }
+
+    TowerBkgdColumns & towerbkgd = m_towerbkgd_map[towerbkgd_node];
+    *towerbkgd.v2 = tower_background->get_v2();
+    *towerbkgd.flowfail = tower_background->get_flow_failure_flag() ? 1 : 0;
+    float * layers[3] = { towerbkgd.cemc, towerbkgd.hcalin, towerbkgd.hcalout };
+    for ( int ilayer = 0; ilayer < 3; ++ilayer )
+    {
+      const std::vector<float> ue = tower_background->get_UE(ilayer);
+      const int n = std::min( (int) ue.size(), (int) k_ieta );
+      std::copy( ue.begin(), ue.begin() + n, layers[ilayer] );
+    }
+
+    if ( Verbosity() > 1 )
+    {
+      std::cout << PHWHERE << " - Tower background from " << towerbkgd_node << ", v2: " << *towerbkgd.v2 << ", flow failure: " << *towerbkgd.flowfail << std::endl;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int JetTree::GetRawJetInfo( PHCompositeNode *topNode, const std::string & jet_node )
+{
+  // get tower info containers
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_CEMC_RETOWER" );
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALIN" );
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALOUT" );
+  if( !towerinfosIH3 || !towerinfosOH3 || !towerinfosEM3 )
+  {
+    std::cout
+      << PHWHERE
+      << " One of the following nodes is missing: "
+      << "TOWERINFO_CALIB_CEMC_RETOWER, "
+      << "TOWERINFO_CALIB_HCALIN, "
+      << "TOWERINFO_CALIB_HCALOUT."
+      << " Skipping raw jet filling."
+      << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN; // fatal error
+  }
+
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>( topNode, "TOWERGEOM_HCALIN" );
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>( topNode, "TOWERGEOM_HCALOUT" );
+  if ( !geomIH || !geomOH )
+  {
+    std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN; // fatal error
+  }
+
+  auto jets = m_nodes.get<JetContainer>( topNode, jet_node );
+  if ( !jets )
+  {
+    std::cout << PHWHERE << " Input node " << jet_node << " Node missing, doing nothing." << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  // eta x phi area of one tower of the 24 x 64 grid
+  const float tower_area = ( 2.2 / k_ieta ) * ( 2.0 * M_PI / k_iphi );
+
+  JetColumns & columns = m_jet_columns[jet_node];
+  for ( auto jet : *jets )
+  {
+    std::vector<int> tower_ieta {};
+    std::vector<int> tower_iphi {};
+    std::vector<int> tower_caloid {};
+    std::vector<float> tower_E {};
+    std::vector<float> tower_eta {};
+    std::vector<float> tower_phi {};
+    // cemc, hcalin, hcalout
+    std::vector<float> layer_E ( 3, 0.0 );
+    std::vector<int> layer_N ( 3, 0 );
+
+    for ( const auto &comp : jet->get_comp_vec() )
+    {
+      TowerInfoContainer * towerinfos = nullptr;
+      RawTowerGeomContainer * geom = geomIH;
+      int grid_layer = 0;
+      int layer = 0;
+      if ( comp.first == Jet::SRC::CEMC_TOWERINFO || comp.first == Jet::SRC::CEMC_TOWERINFO_RETOWER ) { towerinfos = towerinfosEM3; layer = 0; }
+      else if ( comp.first == Jet::SRC::HCALIN_TOWERINFO ) { towerinfos = towerinfosIH3; layer = 1; }
+      else if ( comp.first == Jet::SRC::HCALOUT_TOWERINFO ) { towerinfos = towerinfosOH3; geom = geomOH; grid_layer = 1; layer = 2; }
+      else
+      {
+        std::cout << PHWHERE << " Warning: jet constituent caloid " << comp.first << " not recognized, skipping." << std::endl;
+        continue;
+      }
+
+      auto tower = towerinfos->get_tower_at_channel( comp.second );
+      if ( !tower || !tower->get_isGood() ) { continue; } // skip bad towers
+
+      unsigned int towerkey = towerinfos->encode_key( comp.second );
+      int this_comp_ieta = towerinfos->getTowerEtaBin(towerkey);
+      int this_comp_iphi = towerinfos->getTowerPhiBin(towerkey);
+      float this_comp_eta = 0;
+      float this_comp_phi = 0;
+      double this_comp_cosh = 1;
+      m_super_towers.get_geometry( grid_layer, this_comp_ieta, this_comp_iphi, geom, this_comp_eta, this_comp_phi, this_comp_cosh );
+      float this_comp_E = tower->get_energy();
+
+      layer_E[layer] += this_comp_E;
+      layer_N[layer]++;
+
+      tower_ieta.push_back(this_comp_ieta);
+      tower_iphi.push_back(this_comp_iphi);
+      tower_caloid.push_back(comp.first);
+      tower_E.push_back(this_comp_E);
+      tower_eta.push_back(this_comp_eta);
+      tower_phi.push_back(this_comp_phi);
+    } // end loop over constituents
+
+    std::vector<float> layer_area ( 3, 0.0 );
+    for ( int layer = 0; layer < 3; ++layer ) { layer_area[layer] = layer_N[layer] * tower_area; }
+
+    columns.E->push_back(jet->get_e());
+    columns.eta->push_back(jet->get_eta());
+    columns.phi->push_back(jet->get_phi());
+    columns.pT->push_back(jet->get_pt());
+    columns.area_layer->push_back(layer_area);
+    columns.E_layer->push_back(layer_E);
+    columns.N_layer->push_back(layer_N);
+    columns.comp_ieta->push_back(tower_ieta);
+    columns.comp_iphi->push_back(tower_iphi);
+    columns.comp_caloid->push_back(tower_caloid);
+    columns.comp_E->push_back(tower_E);
+    columns.comp_eta->push_back(tower_eta);
+    columns.comp_phi->push_back(tower_phi);
+  } // end loop over jets
+
+  if ( Verbosity() > 0 )
+  {
+    std::cout << PHWHERE << " - Found " << jets->size() << " raw jets in node " << jet_node << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int JetTree::GetSub1JetInfo( PHCompositeNode *topNode, const std::string & jet_node )
+{
 
   // get tower info containers
-  auto towerinfosEM3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1");
-  auto towerinfosIH3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_HCALIN_SUB1" );
-  auto towerinfosOH3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1" );
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1");
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALIN_SUB1" );
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1" );
   if( !towerinfosIH3 || !towerinfosOH3 || !towerinfosEM3 )
   {
     std::cout
@@ -390,61 +594,34 @@ int JetTree::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
   }
   
   // get geometry containers
-  auto geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  auto geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
   if ( !geomIH || !geomOH ) 
   {
     std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
   
-  // get raw jets
-  auto jets = findNode::getClass<JetContainer>( topNode, node_name );
+  // get sub1 jets
+  auto jets = m_nodes.get<JetContainer>( topNode, jet_node );
   if ( !jets )
   {
-    std::cout << PHWHERE << " Input node " << node_name << " Node missing, doing nothing." << std::endl;
+    std::cout << PHWHERE << " Input node " << jet_node << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTEVENT; 
   }
 
-  auto tower_background_sub1 = findNode::getClass<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub1");
-  if ( !tower_background_sub1 )
-  {
-    std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
-    return Fun4AllReturnCodes::ABORTRUN; // fatal error
-  }
-
-  auto tower_background_sub2 = findNode::getClass<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub2");
+  auto tower_background_sub2 = m_nodes.get<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub2");
   if ( !tower_background_sub2 )
   {
     std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
 
-  for ( int ilayer = 0 ; ilayer < 3; ilayer++ )
-  {
-    std::vector<float> this_ue_sub1 = tower_background_sub1->get_UE(ilayer);
-    std::vector<float> this_ue_sub2 = tower_background_sub2->get_UE(ilayer);
-    for ( int ieta = 0; ieta < 24; ieta++ )
-    {
-      if ( ilayer == 0 ) 
-      {
-        m_sub1_towerbkgd_cemc[ieta] = this_ue_sub1[ieta];
-        m_sub2_towerbkgd_cemc[ieta] = this_ue_sub2[ieta];
-      }
-      else if ( ilayer == 1 ) 
-      {
-        m_sub1_towerbkgd_hcalin[ieta] = this_ue_sub1[ieta];
-        m_sub2_towerbkgd_hcalin[ieta] = this_ue_sub2[ieta];
-      }
-      else if ( ilayer == 2 ) 
-      {
-        m_sub1_towerbkgd_hcalout[ieta] = this_ue_sub1[ieta];
-        m_sub2_towerbkgd_hcalout[ieta] = this_ue_sub2[ieta];
-      }
-    }
-  } // end loop over layers
-
+  // per tower background with the v2 modulation
+  if ( !m_ue_table.has_geometry() ) { m_ue_table.set_geometry( geomIH, geomOH ); }
+  m_ue_table.fill( tower_background_sub2 );
 
+  JetColumns & columns = m_jet_columns[jet_node];
   for ( auto jet : *jets )
   {
 
@@ -462,95 +639,38 @@ int JetTree::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
     std::vector<float> tower_E {};
     std::vector<float> tower_eta {};
     std::vector<float> tower_phi {};
-    std::vector<int> tower_status {};
 
     for ( const auto &comp : jet->get_comp_vec() )
     {
-      int this_comp_ieta = -999;
-      int this_comp_iphi = -999;
-      float this_comp_E = 0;
-      float this_comp_eta = 0;
-      float this_comp_phi = 0;
-      int this_comp_status = -1;
       int this_comp_caloid = comp.first;
 
       bool is_hcalin = ( comp.first == Jet::SRC::HCALIN_TOWERINFO || comp.first == Jet::SRC::HCALIN_TOWERINFO_SUB1 );
       bool is_hcalout = ( comp.first == Jet::SRC::HCALOUT_TOWERINFO || comp.first == Jet::SRC::HCALOUT_TOWERINFO_SUB1 );
       bool is_cemc = ( comp.first == Jet::SRC::CEMC_TOWERINFO || comp.first == Jet::SRC::CEMC_TOWERINFO_RETOWER || comp.first == Jet::SRC::CEMC_TOWERINFO_SUB1);
-      if ( is_cemc )
-      {
-        auto tower = towerinfosEM3->get_tower_at_channel( comp.second );
-        assert(tower);
-        unsigned int towerkey = towerinfosEM3->encode_key( comp.second );
-        this_comp_ieta = towerinfosEM3->getTowerEtaBin(towerkey);
-        this_comp_iphi = towerinfosEM3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALIN,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomIH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
-        this_comp_E = tower->get_energy();
-        this_comp_status = tower->get_isGood();
-
-        float this_ue = m_sub2_towerbkgd_cemc[this_comp_ieta];
-        float this_unsub_pt = ( this_comp_E + this_ue ) / cosh(this_comp_eta);
-        unsub_px += this_unsub_pt * cos(this_comp_phi);
-        unsub_py += this_unsub_pt * sin(this_comp_phi);
-        unsub_E += ( this_comp_E + this_ue );
-      }
-      else if ( is_hcalin )
-      {
-        auto tower = towerinfosIH3->get_tower_at_channel( comp.second );
-        assert(tower);
-        unsigned int towerkey = towerinfosIH3->encode_key( comp.second );
-        this_comp_ieta = towerinfosIH3->getTowerEtaBin(towerkey);
-        this_comp_iphi = towerinfosIH3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALIN,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomIH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
-        this_comp_E = tower->get_energy();
-        this_comp_status = tower->get_isGood();
-
-        float this_ue = m_sub2_towerbkgd_hcalin[this_comp_ieta];
-        float this_unsub_pt = ( this_comp_E + this_ue ) / cosh(this_comp_eta);
-        unsub_px += this_unsub_pt * cos(this_comp_phi);
-        unsub_py += this_unsub_pt * sin(this_comp_phi);
-        unsub_E += ( this_comp_E + this_ue );
-      }
-      else if ( is_hcalout )
-      {
-        auto tower = towerinfosOH3->get_tower_at_channel( comp.second );
-        assert(tower);
-        unsigned int towerkey = towerinfosOH3->encode_key( comp.second );
-        this_comp_ieta = towerinfosOH3->getTowerEtaBin(towerkey);
-        this_comp_iphi = towerinfosOH3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALOUT,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomOH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
-        this_comp_E = tower->get_energy();
-        this_comp_status = tower->get_isGood();
-        float this_ue = m_sub2_towerbkgd_hcalout[this_comp_ieta];
-        float this_unsub_pt = ( this_comp_E + this_ue ) / cosh(this_comp_eta);
-        unsub_px += this_unsub_pt * cos(this_comp_phi);
-        unsub_py += this_unsub_pt * sin(this_comp_phi);
-        unsub_E += ( this_comp_E + this_ue );
-      }
+      TowerInfoContainer * towerinfos = nullptr;
+      int layer = UETable::CEMC;
+      if ( is_cemc ) { towerinfos = towerinfosEM3; layer = UETable::CEMC; }
+      else if ( is_hcalin ) { towerinfos = towerinfosIH3; layer = UETable::HCALIN; }
+      else if ( is_hcalout ) { towerinfos = towerinfosOH3; layer = UETable::HCALOUT; }
       else
       {
         std::cout << PHWHERE << " Warning: jets constituent caloid " << comp.first << " not recognized, skipping." << std::endl;
         continue;
       }
 
+      auto tower = towerinfos->get_tower_at_channel( comp.second );
+      assert(tower);
+      unsigned int towerkey = towerinfos->encode_key( comp.second );
+      int this_comp_ieta = towerinfos->getTowerEtaBin(towerkey);
+      int this_comp_iphi = towerinfos->getTowerPhiBin(towerkey);
+      float this_comp_eta = m_ue_table.get_eta( layer, this_comp_ieta, this_comp_iphi );
+      float this_comp_phi = m_ue_table.get_phi( layer, this_comp_ieta, this_comp_iphi );
+      float this_comp_E = tower->get_energy();
+      int this_comp_status = tower->get_isGood();
+
+      // modulated background of this tower back on top
+      m_ue_table.unsubtract( layer, this_comp_ieta, this_comp_iphi, this_comp_E, unsub_px, unsub_py, unsub_E );
+
       if ( this_comp_status != 1 ) 
       {
         continue; // skip bad towers
@@ -563,32 +683,30 @@ int JetTree::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
       tower_E.push_back(this_comp_E);
       tower_eta.push_back(this_comp_eta);
       tower_phi.push_back(this_comp_phi);
-      tower_status.push_back(this_comp_status);
       
     } // end loop over constituents
 
 
     float unsub_pt = sqrt( (unsub_px * unsub_px) + (unsub_py * unsub_py) );
-    m_sub1_jet_E.push_back(this_e);
-    m_sub1_jet_eta.push_back(this_eta);
-    m_sub1_jet_phi.push_back(this_phi);
-    m_sub1_jet_pT.push_back(this_pt);
-    m_sub1_jet_unsub_pT.push_back(unsub_pt);
-    m_sub1_jet_unsub_E.push_back(unsub_E);
-    m_sub1_jet_comp_ieta.push_back(tower_ieta);
-    m_sub1_jet_comp_iphi.push_back(tower_iphi);
-    m_sub1_jet_comp_caloid.push_back(tower_caloid);
-    m_sub1_jet_comp_status.push_back(tower_status);
-    m_sub1_jet_comp_E.push_back(tower_E);
-    m_sub1_jet_comp_eta.push_back(tower_eta);
-    m_sub1_jet_comp_phi.push_back(tower_phi); 
+    columns.E->push_back(this_e);
+    columns.eta->push_back(this_eta);
+    columns.phi->push_back(this_phi);
+    columns.pT->push_back(this_pt);
+    columns.unsub_pT->push_back(unsub_pt);
+    columns.unsub_E->push_back(unsub_E);
+    columns.comp_ieta->push_back(tower_ieta);
+    columns.comp_iphi->push_back(tower_iphi);
+    columns.comp_caloid->push_back(tower_caloid);
+    columns.comp_E->push_back(tower_E);
+    columns.comp_eta->push_back(tower_eta);
+    columns.comp_phi->push_back(tower_phi); 
 
 
   } // end loop over jets
 
   if ( Verbosity() > 0 ) 
   {
-    std::cout << PHWHERE << " - Found " << jets->size() << " sub1 jets in node " << node_name << std::endl;
+    std::cout << PHWHERE << " - Found " << jets->size() << " sub1 jets in node " << jet_node << std::endl;
   }
 
 
@@ -597,21 +715,18 @@ int JetTree::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
 
 }
 
-int JetTree::GetTruthJetInfo( PHCompositeNode *topNode , const int idx)
+int JetTree::GetTruthJetInfo( PHCompositeNode *topNode, const std::string & jet_node )
 {
 
-  const std::string & node_name = m_truthjet_nodes[idx];
- 
-  ResetTruthJet();
-
   // get truth jets
-  auto jets = findNode::getClass<JetContainer>( topNode, node_name );
+  auto jets = m_nodes.get<JetContainer>( topNode, jet_node );
   if ( !jets )
   {
-    std::cout << PHWHERE << " Input node " << node_name << " Node missing, doing nothing." << std::endl;
+    std::cout << PHWHERE << " Input node " << jet_node << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTEVENT; 
   }
 
+  JetColumns & columns = m_jet_columns[jet_node];
   for ( auto jet : *jets )
   {
 
@@ -620,16 +735,16 @@ int JetTree::GetTruthJetInfo( PHCompositeNode *topNode , const int idx)
     float this_phi = jet->get_phi();
     float this_e = jet->get_e();
 
-    m_truth_jet_E.push_back(this_e);
-    m_truth_jet_eta.push_back(this_eta);
-    m_truth_jet_phi.push_back(this_phi);
-    m_truth_jet_pT.push_back(this_pt);
+    columns.E->push_back(this_e);
+    columns.eta->push_back(this_eta);
+    columns.phi->push_back(this_phi);
+    columns.pT->push_back(this_pt);
 
   } // end loop over jets
 
   if ( Verbosity() > 0 ) 
   {
-    std::cout << PHWHERE << " - Found " << jets->size() << " truth jets in node " << node_name << std::endl;
+    std::cout << PHWHERE << " - Found " << jets->size() << " truth jets in node " << jet_node << std::endl;
   }
 
 
@@ -638,126 +753,129 @@ int JetTree::GetTruthJetInfo( PHCompositeNode *topNode , const int idx)
 
 }
 
-void JetTree::SumCaloE( PHCompositeNode *topNode, const std::string &towerinfo_node, const std::string &geo_node, const float zvrtx, float &sum_e )
+int JetTree::GetSeedInfo( PHCompositeNode *topNode, const std::string & jet_node )
 {
-  sum_e = 0.0;
-  auto towerinfos = findNode::getClass< TowerInfoContainer >( topNode, towerinfo_node );
-  if ( !towerinfos ) 
-  {
-    return;
-  }
-  auto geocont = findNode::getClass<RawTowerGeomContainer>(topNode, geo_node);
-  if ( !geocont )
+  // get tower info containers
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_CEMC_RETOWER" );
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALIN" );
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALOUT" );
+  if( !towerinfosIH3 || !towerinfosOH3 || !towerinfosEM3 )
   {
-    std::cout << PHWHERE << " RawTowerGeomContainer node " << geo_node << " missing, skipping." << std::endl;
-    return;
+    std::cout
+      << PHWHERE
+      << " One of the following nodes is missing: "
+      << "TOWERINFO_CALIB_CEMC_RETOWER, "
+      << "TOWERINFO_CALIB_HCALIN, "
+      << "TOWERINFO_CALIB_HCALOUT."
+      << " Skipping seed filling."
+      << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
 
-  RawTowerDefs::CalorimeterId geocaloid{RawTowerDefs::CalorimeterId::NONE};
-
-  const double CALO_RADII[3] = {93.5, 127.503, 225.87};
-  int calo_id = 0;
-  if ( towerinfo_node.find("CEMC") != std::string::npos ) 
-  {
-    calo_id = 0;
-  }
-  else if ( towerinfo_node.find("HCALIN") != std::string::npos ) 
-  {
-    calo_id = 1;
-  }
-  else if ( towerinfo_node.find("HCALOUT") != std::string::npos ) 
-  {
-    calo_id = 2;
-  }
-  
-  const double this_R = CALO_RADII[calo_id];
-  
-  if ( geo_node.find("HCALIN") != std::string::npos ) 
-  {
-    geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
-  }
-  else if ( geo_node.find("HCALOUT") != std::string::npos ) 
-  {
-    geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
-  }
-  else if ( geo_node.find("CEMC") != std::string::npos ) 
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>( topNode, "TOWERGEOM_HCALIN" );
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>( topNode, "TOWERGEOM_HCALOUT" );
+  if ( !geomIH || !geomOH )
   {
-    geocaloid = RawTowerDefs::CalorimeterId::CEMC;
+    std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
-  else 
+
+  auto seeds = m_nodes.get<JetContainer>( topNode, jet_node );
+  if ( !seeds )
   {
-    std::cout << PHWHERE << " Warning: cannot determine calo id from geo node name " << geo_node << ", skipping." << std::endl;
-    return;
+    std::cout << PHWHERE << " Input node " << jet_node << " Node missing, doing nothing." << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
   }
-  
-  // std::cout << PHWHERE << " - Calo id = " << calo_id << ", R = " << this_R << std::endl;
 
-  auto ntowers = towerinfos->size();
-  for ( unsigned int ich = 0; ich < ntowers; ich++ ) 
+  JetColumns & columns = m_jet_columns[jet_node];
+  for ( auto seed : *seeds )
   {
-    auto tower = towerinfos->get_tower_at_channel(ich);
-    assert(tower);
+    if ( seed->get_pt() < m_jet_minpT_map[jet_node] || seed->get_e() < m_jet_minE_map[jet_node] ) { continue; }
 
-    unsigned int key = towerinfos -> encode_key(ich);
-    int ieta = towerinfos -> getTowerEtaBin(key);
-    int iphi = towerinfos -> getTowerPhiBin(key);
-    const RawTowerDefs::keytype geokey = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
+    m_super_towers.clear();
+    std::vector<int> tower_ieta {};
+    std::vector<int> tower_iphi {};
+    std::vector<int> tower_caloid {};
+    std::vector<float> tower_E {};
+    std::vector<float> tower_eta {};
+    std::vector<float> tower_phi {};
+    std::vector<float> super_tower_E {};
 
-    if ( ! tower->get_isGood() ) 
-    {
-      continue; // skip bad towers
-    }
-    if (std::isnan(tower->get_energy()) ) 
+    for ( const auto &comp : seed->get_comp_vec() )
     {
-      continue; // skip towers with bad energy
-    }
+      TowerInfoContainer * towerinfos = nullptr;
+      RawTowerGeomContainer * geom = geomIH;
+      int layer = 0;
+      if ( comp.first == 13 || comp.first == 28 ) { towerinfos = towerinfosEM3; }
+      else if ( comp.first == 5 || comp.first == 26 ) { towerinfos = towerinfosIH3; }
+      else if ( comp.first == 7 || comp.first == 27 ) { towerinfos = towerinfosOH3; geom = geomOH; layer = 1; }
+      else
+      {
+        std::cout << PHWHERE << " Warning: seed constituent caloid " << comp.first << " not recognized, skipping." << std::endl;
+        continue;
+      }
 
-    auto tower_geom = geocont -> get_tower_geometry(geokey);
-    assert(tower_geom);
+      auto tower = towerinfos->get_tower_at_channel( comp.second );
+      if ( !tower || !tower->get_isGood() ) { continue; } // skip bad towers
 
-    double eta = tower_geom -> get_eta();
-    double E = tower -> get_energy();
-    double z0 = sinh(eta) * this_R;
-    double z = z0 - zvrtx;
-    double eta_shifted = asinh(z / this_R);  // eta after shift from
-    double eT = E / cosh(eta_shifted);
-    
+      unsigned int towerkey = towerinfos->encode_key( comp.second );
+      int this_comp_ieta = towerinfos->getTowerEtaBin(towerkey);
+      int this_comp_iphi = towerinfos->getTowerPhiBin(towerkey);
+      float this_comp_eta = 0;
+      float this_comp_phi = 0;
+      double this_comp_cosh = 1;
+      m_super_towers.get_geometry( layer, this_comp_ieta, this_comp_iphi, geom, this_comp_eta, this_comp_phi, this_comp_cosh );
+      float this_comp_E = tower->get_energy();
+      m_super_towers.add( this_comp_ieta, this_comp_iphi, this_comp_E / this_comp_cosh );
 
-    sum_e += eT;
-  } 
+      tower_ieta.push_back(this_comp_ieta);
+      tower_iphi.push_back(this_comp_iphi);
+      tower_caloid.push_back(comp.first);
+      tower_E.push_back(this_comp_E);
+      tower_eta.push_back(this_comp_eta);
+      tower_phi.push_back(this_comp_phi);
+    } // end loop over constituents
 
-  if ( Verbosity() > 1 ) 
+    float sum_eT = 0;
+    float max_eT = 0;
+    float mean_eT = 0;
+    m_super_towers.get_stats( sum_eT, max_eT, mean_eT, super_tower_E );
+
+    columns.E->push_back(seed->get_e());
+    columns.eta->push_back(seed->get_eta());
+    columns.phi->push_back(seed->get_phi());
+    columns.pT->push_back(seed->get_pt());
+    columns.maxD->push_back(max_eT);
+    columns.avgD->push_back(mean_eT);
+    columns.supercomp_eT->push_back(super_tower_E);
+    columns.comp_ieta->push_back(tower_ieta);
+    columns.comp_iphi->push_back(tower_iphi);
+    columns.comp_caloid->push_back(tower_caloid);
+    columns.comp_E->push_back(tower_E);
+    columns.comp_eta->push_back(tower_eta);
+    columns.comp_phi->push_back(tower_phi);
+  } // end loop over seeds
+
+  if ( Verbosity() > 0 )
   {
-    std::cout << PHWHERE << " - " << towerinfo_node << ": sum_e = " << sum_e << std::endl;
+    std::cout << PHWHERE << " - Found " << columns.E->size() << " seeds in node " << jet_node << std::endl;
   }
 
-  return;
+  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int JetTree::GetCaloInfo( PHCompositeNode *topNode )
 {
-  ResetCaloInfo();
-
-  SumCaloE( topNode, "TOWERINFO_CALIB_CEMC_RETOWER", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_cemc );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALIN", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_hcalin );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALOUT", "TOWERGEOM_HCALOUT", m_zvtx, m_sumeT_hcalout );
-  SumCaloE( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_cemc_sub1 );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALIN_SUB1", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_hcalin_sub1 );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1","TOWERGEOM_HCALOUT", m_zvtx,  m_sumeT_hcalout_sub1 );
-  SumCaloE( topNode, "TOWERINFO_CALIB_ORIGINAL_CEMC", "TOWERGEOM_CEMC", m_zvtx, m_sumeT_cemc_org );
-  SumCaloE( topNode, "TOWERINFO_CALIB_ORIGINAL_HCALIN", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_hcalin_org );
-  SumCaloE( topNode, "TOWERINFO_CALIB_ORIGINAL_HCALOUT", "TOWERGEOM_HCALOUT", m_zvtx, m_sumeT_hcalout_org );
+  m_calo.set_verbosity( Verbosity() );
+  m_calo.process( topNode, m_nodes, m_zvtx );
 
   if ( Verbosity() > 1 ) 
   {
-    std::cout << PHWHERE << " - sumeT_cemc = " << m_sumeT_cemc << ", sumeT_hcalin = " << m_sumeT_hcalin << ", sumeT_hcalout = " << m_sumeT_hcalout << std::endl;
+    for ( unsigned int i = 0; i < m_ncalo_nodes; ++i )
+    {
+      const auto & calo = m_calo.get( m_calo_index_map[m_calo_nodes[i]] );
+      std::cout << PHWHERE << " - " << m_calo_nodes[i] << ": sumE = " << calo.sumE << ", sumEt = " << calo.sumEt << ", masked = " << calo.nmasked << std::endl;
+    }
   }
   return Fun4AllReturnCodes::EVENT_OK;
 }
-
-
-
-
-
-
-   
\ No newline at end of file
@@ -4,12 +4,21 @@
 #include <fun4all/SubsysReco.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <eventselection/NodeCache.h>
+#include <eventselection/TreeCheckpoint.h>
+
+#include "BranchRegistry.h"
+#include "CaloReduction.h"
+#include "SuperTowerGrid.h"
+#include "UETable.h"
+
 #include <string>
 #include <vector>
 #include <map>
 #include <utility>
 
 class PHCompositeNode;
+class EventSummary;
 class TTree;
 
 class JetTree : public SubsysReco
@@ -30,9 +39,14 @@ class JetTree : public SubsysReco
   ~JetTree() override {}
 
   int Init( PHCompositeNode * /*topNode*/) override;
+  int InitRun( PHCompositeNode * /*topNode*/ ) override;
   int process_event( PHCompositeNode * topNode ) override;
   int End( PHCompositeNode * /*topNode*/ ) override;
-  int ResetEvent( PHCompositeNode * /*topNode*/ ) override;
+  int ResetEvent( PHCompositeNode * /*topNode*/ ) override
+  {
+    m_branches.reset();
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
 
   void set_zvrtx_node( const std::string & name = "GlobalVertexMap" ){ m_zvrtx_node = name; }
   
@@ -40,23 +54,19 @@ class JetTree : public SubsysReco
   
   void set_header_node( const std::string & name =  "EventHeader"){ m_header_node = name; }
 
-  void add_calo_node( const std::string & name, const std::string & nickname ) 
+  // geo_node empty: taken from the calo in the node name, see CaloReduction
+  void add_calo_node( const std::string & name, const std::string & nickname, const std::string & geo_node = "" ) 
   { 
     m_calo_nodes.push_back(name); 
     m_calo_nicknames_map[name] = nickname;
-    m_calo_sumE_map[name] = 0.0;
-    m_calo_sumEt_map[name] = 0.0;
-    m_calo_ieta_avgE_map[name] = std::vector < float > (k_ieta, 0.0);
-    m_calo_iphi_avgE_map[name] = std::vector < float > (k_iphi, 0.0);
-    m_ncalo_node = m_calo_nodes.size();
+    m_calo_index_map[name] = m_calo.add_node(name, geo_node);
+    m_ncalo_nodes = m_calo_nodes.size();
   }
 
   void add_rho_node( const std::string & name , const std::string & nickname )
   {
     m_rho_nodes.push_back(name);
     m_rho_nicknames_map[name] = nickname;
-    m_rho_map[name] = 0.0;
-    m_rho_sigma_map[name] = 0.0;
     m_nrho_nodes = m_rho_nodes.size();
   }
 
@@ -64,11 +74,6 @@ class JetTree : public SubsysReco
   {
     m_towerbkgd_nodes.push_back(name);
     m_towerbkgd_nicknames_map[name] = nickname;
-    m_towerbkgd_v2_map[name] = 0.0;
-    m_towerbkgd_flowfail_map[name] = 0;
-    m_towerbkgd_cemc_map[name] = std::vector < float > (k_ieta, 0.0);
-    m_towerbkgd_hcalin_map[name] = std::vector < float > (k_ieta, 0.0);
-    m_towerbkgd_hcalout_map[name] = std::vector < float > (k_ieta, 0.0);
     m_ntowerbkgd_nodes = m_towerbkgd_nodes.size();
   }    
 
@@ -88,32 +93,7 @@ class JetTree : public SubsysReco
       m_jet_minE_map[name] = -999.0; // for seeds, do not apply energy cut by default since they can be very low energy
       m_jet_doetacut_map[name] = false; // for seeds, do not apply eta cut by default since they can be outside of acceptance
     }
-    
-    // initialize jet info maps
-    m_jet_E[name] = std::vector < float > {};
-    m_jet_eta[name] = std::vector < float > {};
-    m_jet_phi[name] = std::vector < float > {};
-    m_jet_pT[name] = std::vector < float > {};
-
-    m_jet_unsub_pT[name] = std::vector < float > {};
-    m_jet_unsub_E[name] = std::vector < float > {};
-    
-    m_jet_area_layer[name] = std::vector < std::vector < float > > {};
-    m_jet_E_layer[name] = std::vector < std::vector < float > > {};
-    m_jet_N_layer[name] = std::vector < std::vector < int > > {};
-
 
-    m_jet_maxD[name] = std::vector < float > {};
-    m_jet_avgD[name] = std::vector < float > {};
-    m_jet_supercomp_eT[name] = std::vector < std::vector < float > > {};
-    
-    m_jet_comp_ieta[name] = std::vector < std::vector < int > > {};
-    m_jet_comp_iphi[name] = std::vector < std::vector < int > > {};
-    m_jet_comp_caloid[name] = std::vector < std::vector < int > > {};
-
-    m_jet_comp_E[name] = std::vector < std::vector < float > > {};
-    m_jet_comp_eta[name] = std::vector < std::vector < float > > {};
-    m_jet_comp_phi[name] = std::vector < std::vector < float > > {};
     m_njet_nodes = m_jet_nodes.size();
   }
   void set_minpt_jet_node( const std::string & name, const float minpT )
@@ -129,94 +109,104 @@ class JetTree : public SubsysReco
     m_jet_doetacut_map[name] = doetacut;
   }
 
+  // AutoSave the tree every nevents ( or nseconds ), see TreeCheckpoint
+  void set_checkpoint( const unsigned int nevents, const unsigned int nseconds = 0 ) { m_checkpoint.set_interval( nevents, nseconds ); }
+  // continue a killed job from its last checkpoint
+  void set_resume( const bool b ) { m_checkpoint.set_resume( b ); }
+
+  // write the tree as an RNTuple, pages compressed on nthreads implicit
+  // MT threads ( 0 single threaded ). TTree by default
+  void use_rntuple( const bool b = true, const unsigned int nthreads = 0 ) { m_branches.set_backend( b ? BranchRegistry::kRNTuple : BranchRegistry::kTTree, nthreads ); }
+
  private:
+
+  // per run node handles
+  NodeCache m_nodes {};
+
+  // periodic AutoSave and resume
+  TreeCheckpoint m_checkpoint {};
     
   std::string m_output_filename { "" };
 
-  std::string m_zvrtx_node { "GlobalVertexMap" };
-  float m_zvrtx { 0.0 };
-  void _reset_zvrtx()
+  // per event output columns, booked in Init. Arrays and vectors are
+  // owned by the registry, the blocks below keep the returned buffers
+  enum BLOCK
   {
-    m_zrvtx = -999;
-  }
+    kZvtx = 0,
+    kCent,
+    kEventHeader,
+    kRho,
+    kTowerBkgd,
+    kJet
+  };
+  BranchRegistry m_branches {};
+
+  std::string m_zvrtx_node { "GlobalVertexMap" };
+  float m_zvtx { 0.0 };
 
   std::string m_cent_node { "" };
   int m_cent {-1};
-  void _reset_cent()
-  {
-    m_cent = -1;
-  }
 
   std::string m_header_node { "" };
   float m_b { 0.0 };
   float m_ep_angle { 0.0 };
+  float m_ecc { 0.0 };
   float m_ncoll { 0.0 };
   float m_npart { 0.0 };
   static const int k_max_psin = 6;
-  float m_psin[k_max_psin];
-  void _reset_header()
-  {
-    m_b = -999;
-    m_ep_angle = -999;
-    m_ncoll = -999;
-    m_npart = -999;
-    memset(m_psin, -999, sizeof(m_psin));
-  }
+  float * m_psin { nullptr }; // psiN[k_max_psin]
 
   static const int k_ieta = 24;
   static const int k_iphi = 64;
   unsigned int m_ncalo_nodes { 0 };
   std::vector< std::string > m_calo_nodes {};
   std::map< std::string, std::string > m_calo_nicknames_map {};
-  std::map< std::string, float > m_calo_sumE_map {};
-  std::map< std::string, float > m_calo_sumEt_map {};
-  std::map< std::string, std::vector < float > > m_calo_ieta_avgE_map {};
-  std::map< std::string, std::vector < float > > m_calo_iphi_avgE_map {};
-  void _reset_calo_maps()
-  {
-    for ( auto & calo : m_calo_nodes )
-    {
-      m_calo_sumE_map[calo] = 0.0;
-      m_calo_sumEt_map[calo] = 0.0;
-      m_calo_ieta_avgE_map[calo] = std::vector < float > (k_ieta, 0.0);
-      m_calo_iphi_avgE_map[calo] = std::vector < float > (k_iphi, 0.0);
-    }
-  }
+  // sumE, sumEt, masked counts and ieta / iphi profiles of every calo
+  // node, one pass per container in GetCaloInfo. Reset by CaloReduction
+  CaloReduction m_calo {};
+  std::map< std::string, unsigned int > m_calo_index_map {};
 
   unsigned int m_nrho_nodes { 0 };
   std::vector< std::string > m_rho_nodes {};
   std::map< std::string, std::string > m_rho_nicknames_map {};
-  std::map< std::string, float > m_rho_map {};
-  std::map< std::string, float > m_rho_sigma_map {};
-  void _reset_rho_maps()
-  {
-    for ( auto & rho : m_rho_nodes )
-    {
-      m_rho_map[rho] = 0.0;
-      m_rho_sigma_map[rho] = 0.0;
-    }
-  }
+  std::map< std::string, float * > m_rho_map {};
+  std::map< std::string, float * > m_rho_sigma_map {};
 
+  struct TowerBkgdColumns
+  {
+    float * cemc { nullptr };    // [k_ieta]
+    float * hcalin { nullptr };  // [k_ieta]
+    float * hcalout { nullptr }; // [k_ieta]
+    float * v2 { nullptr };
+    int * flowfail { nullptr };
+  };
   unsigned int m_ntowerbkgd_nodes { 0 };
   std::vector< std::string > m_towerbkgd_nodes {};
   std::map< std::string, std::string > m_towerbkgd_nicknames_map {};
-  std::map< std::string, std::vector < float > > m_towerbkgd_cemc_map {};
-  std::map< std::string, std::vector < float > > m_towerbkgd_hcalin_map {};
-  std::map< std::string, std::vector < float > > m_towerbkgd_hcalout_map {};
-  std::map< std::string, float > m_towerbkgd_v2_map {};
-  std::map< std::string, int > m_towerbkgd_flowfail_map {};
-  void _reset_towerbkgd_maps()
-  {
-    for ( auto & towerbkgd : m_towerbkgd_nodes )
-    {
-      m_towerbkgd_cemc_map[towerbkgd] = std::vector < float > (k_ieta, 0.0);
-      m_towerbkgd_hcalin_map[towerbkgd] = std::vector < float > (k_ieta, 0.0);
-      m_towerbkgd_hcalout_map[towerbkgd] = std::vector < float > (k_ieta, 0.0);
-      m_towerbkgd_v2_map[towerbkgd] = 0.0;
-      m_towerbkgd_flowfail_map[towerbkgd] = 0;
-    }
-  }
-
+  std::map< std::string, TowerBkgdColumns > m_towerbkgd_map {};
+
+  // columns of one jet node, which ones are booked depends on its type
+  struct JetColumns
+  {
+    std::vector < float > * E { nullptr };
+    std::vector < float > * phi { nullptr };
+    std::vector < float > * eta { nullptr };
+    std::vector < float > * pT { nullptr };
+    std::vector < float > * unsub_pT { nullptr };             // SUB1
+    std::vector < float > * unsub_E { nullptr };              // SUB1
+    std::vector < std::vector < float > > * area_layer { nullptr }; // RAW, cemc / hcalin / hcalout
+    std::vector < std::vector < float > > * E_layer { nullptr };    // RAW
+    std::vector < std::vector < int > > * N_layer { nullptr };      // RAW
+    std::vector < float > * maxD { nullptr };                 // SEED
+    std::vector < float > * avgD { nullptr };                 // SEED
+    std::vector < std::vector < float > > * supercomp_eT { nullptr }; // SEED
+    std::vector < std::vector < int > > * comp_ieta { nullptr };
+    std::vector < std::vector < int > > * comp_iphi { nullptr };
+    std::vector < std::vector < int > > * comp_caloid { nullptr };
+    std::vector < std::vector < float > > * comp_E { nullptr };
+    std::vector < std::vector < float > > * comp_eta { nullptr };
+    std::vector < std::vector < float > > * comp_phi { nullptr };
+  };
   unsigned int m_njet_nodes { 0 };
   std::vector< std::string > m_jet_nodes {};
   std::map< std::string, std::string > m_jet_nicknames_map {};
@@ -226,86 +216,28 @@ class JetTree : public SubsysReco
   std::map< std::string, float > m_jet_minpT_map {};
   std::map< std::string, float > m_jet_minE_map {};
   std::map< std::string, bool >  m_jet_doetacut_map {};
-  // variables to be filled for jets
-  std::map< std::string, std::vector < float > > m_jet_E {};
-  std::map< std::string, std::vector < float > > m_jet_phi {};
-  std::map< std::string, std::vector < float > > m_jet_eta {};
-  std::map< std::string, std::vector < float > > m_jet_pT {};
-  std::map< std::string, std::vector < float > > m_jet_unsub_pT {};
-  std::map< std::string, std::vector < float > > m_jet_unsub_E {};
-  std::map< std::string, std::vector < std::vector < float > > > m_jet_area_layer {};
-  std::map< std::string, std::vector < std::vector < float > > > m_jet_E_layer {};
-  std::map< std::string, std::vector < std::vector < int > > > m_jet_N_layer {};
-  std::map< std::string, std::vector < float > > m_jet_maxD {};
-  std::map< std::string, std::vector < float > > m_jet_avgD {};
-  std::map< std::string, std::vector < std::vector < float > > > m_jet_supercomp_eT {};
-
-  std::map< std::string, std::vector < std::vector < int > > > m_jet_comp_ieta {};
-  std::map< std::string, std::vector < std::vector < int > > > m_jet_comp_iphi {};
-  std::map< std::string, std::vector < std::vector < int > > > m_jet_comp_caloid {};
-
-  std::map< std::string, std::vector < std::vector < float > > > m_jet_comp_E {};
-  std::map< std::string, std::vector < std::vector < float > > > m_jet_comp_eta {};
-  std::map< std::string, std::vector < std::vector < float > > > m_jet_comp_phi {};
-  void _reset_jet_maps_for_node( std::string & jet_node )
-  {
-    m_jet_E[jet_node].clear();
-    m_jet_phi[jet_node].clear();
-    m_jet_eta[jet_node].clear();
-    m_jet_pT[jet_node].clear();
-
-    m_jet_unsub_pT[jet_node].clear();
-    m_jet_unsub_E[jet_node].clear();
-    
-    m_jet_area_layer[jet_node].clear();
-    m_jet_E_layer[jet_node].clear();
-    m_jet_N_layer[jet_node].clear();
-
-    m_jet_maxD[jet_node].clear();
-    m_jet_avgD[jet_node].clear();
-    m_jet_supercomp_eT[jet_node].clear();
-
-    m_jet_comp_ieta[jet_node].clear();
-    m_jet_comp_iphi[jet_node].clear();
-    m_jet_comp_caloid[jet_node].clear();
-    
-    m_jet_comp_E[jet_node].clear();
-    m_jet_comp_eta[jet_node].clear();
-    m_jet_comp_phi[jet_node].clear();
-  }
-  void _reset_jet_maps()
-  {
-    for ( auto & jet_node : m_jet_nodes )
-    {
-      _reset_jet_maps_for_node( jet_node );
-    }
-  }
+  std::map< std::string, JetColumns > m_jet_columns {};
+  // super tower sums of SEED type nodes, reused for every seed
+  SuperTowerGrid m_super_towers {};
+  // sub2 background per tower, used to unsubtract the sub1 jets
+  UETable m_ue_table {};
 
   TTree * m_tree { nullptr };
   int m_event_id {-1};
-  void _reset_all()
-  {
-    m_event_id++;
-    _reset_zvrtx();
-    _reset_cent();
-    _reset_header();
-    _reset_calo_maps();
-    _reset_rho_maps();
-    _reset_towerbkgd_maps();
-    _reset_jet_maps();
-  }
- 
-
 
+  // vertex, centrality and event header all come from the EventSummary node
+  EventSummary * GetEventSummary( PHCompositeNode *topNode );
   int GetZvtx( PHCompositeNode *topNode );
   int GetCentInfo( PHCompositeNode *topNode );
   int GetEventHeaderInfo( PHCompositeNode *topNode );
-  int GetSub1JetInfo( PHCompositeNode *topNode , const int idx );
-  int GetTruthJetInfo( PHCompositeNode *topNode , const int idx );
-  int GetEventPlaneInfo( PHCompositeNode *topNode );
+  int GetRhoInfo( PHCompositeNode *topNode );
+  int GetTowerBkgdInfo( PHCompositeNode *topNode );
+  int GetRawJetInfo( PHCompositeNode *topNode, const std::string & jet_node );
+  int GetSub1JetInfo( PHCompositeNode *topNode, const std::string & jet_node );
+  int GetTruthJetInfo( PHCompositeNode *topNode, const std::string & jet_node );
   int GetCaloInfo( PHCompositeNode *topNode );
-  void SumCaloE( PHCompositeNode *topNode, const std::string &towerinfo_node, const std::string &geo_node, const float zvrtx, float &sum_e );
-  
+  int GetSeedInfo( PHCompositeNode *topNode, const std::string & jet_node );
+
   
 
 };
@@ -43,6 +43,9 @@
 #include <g4main/PHG4VtxPoint.h>
 
 
+#include <eventselection/EventSummary.h>
+#include <eventselection/EventSummaryReco.h>
+
 #include <mbd/MbdOut.h>
 #include <mbd/MbdOutV1.h>
 #include <mbd/MbdOutV2.h>
@@ -86,6 +89,17 @@
 int SimTree::Init( PHCompositeNode * /*topNode*/ )
 {
   
+  // AutoSave and resume work on TTrees, an RNTuple is only readable once committed
+  if ( m_branches.get_backend() == BranchRegistry::kRNTuple && m_checkpoint.enabled() )
+  {
+    std::cout << "SimTree::Init - checkpoints need the TTree backend, disabled" << std::endl;
+    m_checkpoint.set_interval( 0 );
+    m_checkpoint.set_resume( false );
+  }
+
+  // a new part when resuming
+  m_checkpoint.set_verbosity( Verbosity() );
+  m_output_filename = m_checkpoint.begin( m_output_filename );
   PHTFileServer::get().open( m_output_filename, "RECREATE" );
 
   if ( Verbosity () > 0 ) 
@@ -93,136 +107,158 @@ int SimTree::Init( PHCompositeNode * /*topNode*/ )
     std::cout << "SimTree::Init - opening file " << m_output_filename << std::endl;
   } 
 
-  m_event_id = -1;
+  m_event_id = m_checkpoint.get_resume_event_id();
 
   m_tree = new TTree( "T", "T" );
+  m_checkpoint.add_tree( m_tree );
 
-  m_tree -> Branch( "event_id", &m_event_id, "event_id/I" );
+  m_branches.bind( m_tree, "event_id", &m_event_id );
   if ( !m_zvrtx_node.empty() )
   {
-    m_tree -> Branch( "zvrtx", &m_zvtx, "zvrtx/F" );
+    m_branches.add( kZvtx, m_tree, "zvrtx", &m_zvtx, -999 );
   }
   if ( !m_cent_node.empty() )
   {
-    m_tree -> Branch( "cent", &m_cent, "cent/I" );
+    m_branches.add( kCent, m_tree, "cent", &m_cent, -1 );
   }
 
   if ( !m_eventhead_node.empty() ) 
   {
-    m_tree -> Branch( "b", &m_b, "b/F" );
-    m_tree -> Branch( "ep_angle", &m_ep_angle, "ep_angle/F" );
-    m_tree -> Branch( "ecc", &m_ecc, "ecc/F" );
-    m_tree -> Branch( "psi1", &m_psi1, "psi1/F" );
-    m_tree -> Branch( "psi2", &m_psi2, "psi2/F" );
-    m_tree -> Branch( "psi3", &m_psi3, "psi3/F" );
-    m_tree -> Branch( "psi4", &m_psi4, "psi4/F" );
-    m_tree -> Branch( "psi5", &m_psi5, "psi5/F" );
-    m_tree -> Branch( "psi6", &m_psi6, "psi6/F" );
-    m_tree -> Branch( "ncoll", &m_ncoll, "ncoll/F" );
-    m_tree -> Branch( "npart", &m_npart, "npart/F" );
+    m_branches.add( kEventHeader, m_tree, "b", &m_b, -999 );
+    m_branches.add( kEventHeader, m_tree, "ep_angle", &m_ep_angle, -999 );
+    m_branches.add( kEventHeader, m_tree, "ecc", &m_ecc, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi1", &m_psi1, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi2", &m_psi2, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi3", &m_psi3, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi4", &m_psi4, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi5", &m_psi5, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi6", &m_psi6, -999 );
+    m_branches.add( kEventHeader, m_tree, "ncoll", &m_ncoll, -999 );
+    m_branches.add( kEventHeader, m_tree, "npart", &m_npart, -999 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "SimTree::Init - Event header node: " << m_eventhead_node << std::endl;
     }
   }
   
-  m_tree -> Branch( "sumeT_cemc", &m_sumeT_cemc, "sumeT_cemc/F" );
-  m_tree -> Branch( "sumeT_hcalin", &m_sumeT_hcalin, "sumeT_hcalin/F" );
-  m_tree -> Branch( "sumeT_hcalout", &m_sumeT_hcalout, "sumeT_hcalout/F" );
+  // calo sums, reduced together in GetCaloInfo
+  m_calo_sums.clear();
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_CEMC_RETOWER", "TOWERGEOM_HCALIN" ), &m_sumeT_cemc } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_HCALIN", "TOWERGEOM_HCALIN" ), &m_sumeT_hcalin } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_HCALOUT", "TOWERGEOM_HCALOUT" ), &m_sumeT_hcalout } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_CEMC_RETOWER_SUB1", "TOWERGEOM_HCALIN" ), &m_sumeT_cemc_sub1 } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_HCALIN_SUB1", "TOWERGEOM_HCALIN" ), &m_sumeT_hcalin_sub1 } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_HCALOUT_SUB1", "TOWERGEOM_HCALOUT" ), &m_sumeT_hcalout_sub1 } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_ORIGINAL_CEMC", "TOWERGEOM_CEMC" ), &m_sumeT_cemc_org } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_ORIGINAL_HCALIN", "TOWERGEOM_HCALIN" ), &m_sumeT_hcalin_org } );
+  m_calo_sums.push_back( { m_calo.add_node( "TOWERINFO_CALIB_ORIGINAL_HCALOUT", "TOWERGEOM_HCALOUT" ), &m_sumeT_hcalout_org } );
+  m_calo.set_verbosity( Verbosity() );
+
+  m_branches.add( kCalo, m_tree, "sumeT_cemc", &m_sumeT_cemc, 0 );
+  m_branches.add( kCalo, m_tree, "sumeT_hcalin", &m_sumeT_hcalin, 0 );
+  m_branches.add( kCalo, m_tree, "sumeT_hcalout", &m_sumeT_hcalout, 0 );
   
-  m_tree -> Branch( "sumeT_cemc_sub1", &m_sumeT_cemc_sub1, "sumeT_cemc_sub1/F" );
-  m_tree -> Branch( "sumeT_hcalin_sub1", &m_sumeT_hcalin_sub1, "sumeT_hcalin_sub1/F" );
-  m_tree -> Branch( "sumeT_hcalout_sub1", &m_sumeT_hcalout_sub1, "sumeT_hcalout_sub1/F" );
+  m_branches.add( kCalo, m_tree, "sumeT_cemc_sub1", &m_sumeT_cemc_sub1, 0 );
+  m_branches.add( kCalo, m_tree, "sumeT_hcalin_sub1", &m_sumeT_hcalin_sub1, 0 );
+  m_branches.add( kCalo, m_tree, "sumeT_hcalout_sub1", &m_sumeT_hcalout_sub1, 0 );
 
-  m_tree -> Branch( "sumeT_cemc_org", &m_sumeT_cemc_org, "sumeT_cemc_org/F" );
-  m_tree -> Branch( "sumeT_hcalin_org", &m_sumeT_hcalin_org, "sumeT_hcalin_org/F" );
-  m_tree -> Branch( "sumeT_hcalout_org", &m_sumeT_hcalout_org, "sumeT_hcalout_org/F" );
+  m_branches.add( kCalo, m_tree, "sumeT_cemc_org", &m_sumeT_cemc_org, 0 );
+  m_branches.add( kCalo, m_tree, "sumeT_hcalin_org", &m_sumeT_hcalin_org, 0 );
+  m_branches.add( kCalo, m_tree, "sumeT_hcalout_org", &m_sumeT_hcalout_org, 0 );
 
   if ( m_do_rho ) 
   {
-    m_tree -> Branch( "rhoM_cemc", &m_rhoM_cemc, "rhoM_cemc/F" );
-    m_tree -> Branch( "rhoM_hcalin", &m_rhoM_hcalin, "rhoM_hcalin/F" );
-    m_tree -> Branch( "rhoM_hcalout", &m_rhoM_hcalout, "rhoM_hcalout/F" );
-    m_tree -> Branch( "rhoM", &m_rhoM, "rhoM/F" );
-
-    m_tree -> Branch( "rhoA_cemc", &m_rhoA_cemc, "rhoA_cemc/F" );
-    m_tree -> Branch( "rhoA_hcalin", &m_rhoA_hcalin, "rhoA_hcalin/F" );
-    m_tree -> Branch( "rhoA_hcalout", &m_rhoA_hcalout, "rhoA_hcalout/F" );
-    m_tree -> Branch( "rhoA", &m_rhoA, "rhoA/F" );
+    m_branches.add( kRho, m_tree, "rhoM_cemc", &m_rhoM_cemc, 0 );
+    m_branches.add( kRho, m_tree, "rhoM_hcalin", &m_rhoM_hcalin, 0 );
+    m_branches.add( kRho, m_tree, "rhoM_hcalout", &m_rhoM_hcalout, 0 );
+    m_branches.add( kRho, m_tree, "rhoM", &m_rhoM, 0 );
+
+    m_branches.add( kRho, m_tree, "rhoA_cemc", &m_rhoA_cemc, 0 );
+    m_branches.add( kRho, m_tree, "rhoA_hcalin", &m_rhoA_hcalin, 0 );
+    m_branches.add( kRho, m_tree, "rhoA_hcalout", &m_rhoA_hcalout, 0 );
+    m_branches.add( kRho, m_tree, "rhoA", &m_rhoA, 0 );
   }
   if ( m_do_towerbkgd ) 
   {
-    m_tree -> Branch( "sub1_towerbkgd_cemc", m_sub1_towerbkgd_cemc, Form("sub1_towerbkgd_cemc[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub1_towerbkgd_hcalin", m_sub1_towerbkgd_hcalin, Form("sub1_towerbkgd_hcalin[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub1_towerbkgd_hcalout", m_sub1_towerbkgd_hcalout, Form("sub1_towerbkgd_hcalout[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub2_towerbkgd_cemc", m_sub2_towerbkgd_cemc, Form("sub2_towerbkgd_cemc[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub2_towerbkgd_hcalin", m_sub2_towerbkgd_hcalin, Form("sub2_towerbkgd_hcalin[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub2_towerbkgd_hcalout", m_sub2_towerbkgd_hcalout, Form("sub2_towerbkgd_hcalout[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub1_v2", &m_sub1_v2, "sub1_v2/F" );
-    m_tree -> Branch( "sub2_v2", &m_sub2_v2, "sub2_v2/F" );
-    m_tree -> Branch( "sub1_flowfaliure", &m_sub1_flowfaliure, "sub1_flowfaliure/I" );
-    m_tree -> Branch( "sub2_flowfaliure", &m_sub2_flowfaliure, "sub2_flowfaliure/I" );
-    m_tree -> Branch( "sub1_psi2", &m_sub1_psi2, "sub1_psi2/F" );
-    m_tree -> Branch( "sub2_psi2", &m_sub2_psi2, "sub2_psi2/F" );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_towerbkgd_cemc", &m_sub1_towerbkgd_cemc[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_towerbkgd_hcalin", &m_sub1_towerbkgd_hcalin[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_towerbkgd_hcalout", &m_sub1_towerbkgd_hcalout[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_towerbkgd_cemc", &m_sub2_towerbkgd_cemc[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_towerbkgd_hcalin", &m_sub2_towerbkgd_hcalin[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_towerbkgd_hcalout", &m_sub2_towerbkgd_hcalout[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_v2", &m_sub1_v2, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_v2", &m_sub2_v2, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_flowfaliure", &m_sub1_flowfaliure, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_flowfaliure", &m_sub2_flowfaliure, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_psi2", &m_sub1_psi2, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_psi2", &m_sub2_psi2, 0 );
   }
   if ( !m_sub1jet_node.empty() ) 
   {
-    m_tree  -> Branch( "jet_E", &m_sub1_jet_E );
-    m_tree  -> Branch( "jet_phi", &m_sub1_jet_phi );
-    m_tree  -> Branch( "jet_eta", &m_sub1_jet_eta );
-    m_tree  -> Branch( "jet_pT", &m_sub1_jet_pT );
-    m_tree  -> Branch( "jet_unsub_pT", &m_sub1_jet_unsub_pT );
-    m_tree  -> Branch( "jet_unsub_E", &m_sub1_jet_unsub_E );
+    m_branches.add( kSub1Jet, m_tree, "jet_E", &m_sub1_jet_E );
+    m_branches.add( kSub1Jet, m_tree, "jet_phi", &m_sub1_jet_phi );
+    m_branches.add( kSub1Jet, m_tree, "jet_eta", &m_sub1_jet_eta );
+    m_branches.add( kSub1Jet, m_tree, "jet_pT", &m_sub1_jet_pT );
+    m_branches.add( kSub1Jet, m_tree, "jet_unsub_pT", &m_sub1_jet_unsub_pT );
+    m_branches.add( kSub1Jet, m_tree, "jet_unsub_E", &m_sub1_jet_unsub_E );
   }
   if ( !m_truthjet_node.empty() ) 
   {
-    m_tree  -> Branch("truth_jet_E", &m_truth_jet_E );
-    m_tree  -> Branch("truth_jet_phi", &m_truth_jet_phi );
-    m_tree  -> Branch("truth_jet_eta", &m_truth_jet_eta );
-    m_tree  -> Branch("truth_jet_pT", &m_truth_jet_pT );
+    m_branches.add( kTruthJet, m_tree, "truth_jet_E", &m_truth_jet_E );
+    m_branches.add( kTruthJet, m_tree, "truth_jet_phi", &m_truth_jet_phi );
+    m_branches.add( kTruthJet, m_tree, "truth_jet_eta", &m_truth_jet_eta );
+    m_branches.add( kTruthJet, m_tree, "truth_jet_pT", &m_truth_jet_pT );
   }
   if ( !m_rawjet_node.empty() ) 
   {
-    m_tree  -> Branch("raw_jet_E", &m_raw_jet_E );
-    m_tree  -> Branch("raw_jet_phi", &m_raw_jet_phi );
-    m_tree  -> Branch("raw_jet_eta", &m_raw_jet_eta );
-    m_tree  -> Branch("raw_jet_pT", &m_raw_jet_pT );
+    m_branches.add( kRawJet, m_tree, "raw_jet_E", &m_raw_jet_E );
+    m_branches.add( kRawJet, m_tree, "raw_jet_phi", &m_raw_jet_phi );
+    m_branches.add( kRawJet, m_tree, "raw_jet_eta", &m_raw_jet_eta );
+    m_branches.add( kRawJet, m_tree, "raw_jet_pT", &m_raw_jet_pT );
   }
   if ( !m_multjet_node.empty() ) 
   {
-    m_tree  -> Branch("mult_jet_E", &m_mult_jet_E );
-    m_tree  -> Branch("mult_jet_phi", &m_mult_jet_phi );
-    m_tree  -> Branch("mult_jet_eta", &m_mult_jet_eta );
-    m_tree  -> Branch("mult_jet_pT", &m_mult_jet_pT ); 
+    m_branches.add( kMultJet, m_tree, "mult_jet_E", &m_mult_jet_E );
+    m_branches.add( kMultJet, m_tree, "mult_jet_phi", &m_mult_jet_phi );
+    m_branches.add( kMultJet, m_tree, "mult_jet_eta", &m_mult_jet_eta );
+    m_branches.add( kMultJet, m_tree, "mult_jet_pT", &m_mult_jet_pT );
   }
   if ( !m_areajet_node.empty() ) 
   {
-    m_tree  -> Branch("area_jet_E", &m_area_jet_E );
-    m_tree  -> Branch("area_jet_phi", &m_area_jet_phi );
-    m_tree  -> Branch("area_jet_eta", &m_area_jet_eta );
-    m_tree  -> Branch("area_jet_pT", &m_area_jet_pT ); 
+    m_branches.add( kAreaJet, m_tree, "area_jet_E", &m_area_jet_E );
+    m_branches.add( kAreaJet, m_tree, "area_jet_phi", &m_area_jet_phi );
+    m_branches.add( kAreaJet, m_tree, "area_jet_eta", &m_area_jet_eta );
+    m_branches.add( kAreaJet, m_tree, "area_jet_pT", &m_area_jet_pT );
+  }
+  if ( m_do_jet_matching && !m_truthjet_node.empty() ) 
+  {
+    if ( !m_rawjet_node.empty() ) { BranchJetMatch( "raw", "raw_jet_", m_raw_match ); }
+    if ( !m_multjet_node.empty() ) { BranchJetMatch( "mult", "mult_jet_", m_mult_match ); }
+    if ( !m_areajet_node.empty() ) { BranchJetMatch( "area", "area_jet_", m_area_match ); }
+    if ( !m_sub1jet_node.empty() ) { BranchJetMatch( "sub1", "jet_", m_sub1_match ); }
   }
 
   if ( !m_eventplane_node.empty() ) 
   {
-    m_tree -> Branch( "psi_shifted_NS", &m_psi_shifted_NS);
-    m_tree -> Branch( "psi_shifted_S", &m_psi_shifted_S);
-    m_tree -> Branch( "psi_shifted_N", &m_psi_shifted_N);
-    m_tree -> Branch( "psi_NS", &m_psi_NS);
-    m_tree -> Branch( "psi_S", &m_psi_S);
-    m_tree -> Branch( "psi_N", &m_psi_N);
+    m_branches.add( kEventPlane, m_tree, "psi_shifted_NS", &m_psi_shifted_NS );
+    m_branches.add( kEventPlane, m_tree, "psi_shifted_S", &m_psi_shifted_S );
+    m_branches.add( kEventPlane, m_tree, "psi_shifted_N", &m_psi_shifted_N );
+    m_branches.add( kEventPlane, m_tree, "psi_NS", &m_psi_NS );
+    m_branches.add( kEventPlane, m_tree, "psi_S", &m_psi_S );
+    m_branches.add( kEventPlane, m_tree, "psi_N", &m_psi_N );
   }
   if ( !m_g4truth_node.empty() )
   {
-    m_tree -> Branch( "g4truth_zvtx", &m_g4truth_zvtx, "g4truth_zvtx/F" );
-    m_tree -> Branch( "m_g4truth_v2reco", &m_g4truth_v2reco );
-    m_tree -> Branch( "m_g4truth_v3reco", &m_g4truth_v3reco );
-    m_tree -> Branch( "m_g4truth_v4reco", &m_g4truth_v4reco );
-    m_tree -> Branch( "m_g4truth_v5reco", &m_g4truth_v5reco );
-    m_tree -> Branch( "m_g4truth_v6reco", &m_g4truth_v6reco );
+    m_branches.add( kG4Truth, m_tree, "g4truth_zvtx", &m_g4truth_zvtx, -999 );
+    m_branches.add( kG4Truth, m_tree, "m_g4truth_v2reco", &m_g4truth_v2reco, -999 );
+    m_branches.add( kG4Truth, m_tree, "m_g4truth_v3reco", &m_g4truth_v3reco, -999 );
+    m_branches.add( kG4Truth, m_tree, "m_g4truth_v4reco", &m_g4truth_v4reco, -999 );
+    m_branches.add( kG4Truth, m_tree, "m_g4truth_v5reco", &m_g4truth_v5reco, -999 );
+    m_branches.add( kG4Truth, m_tree, "m_g4truth_v6reco", &m_g4truth_v6reco, -999 );
   }
-  
 
+  // start the first event from the reset values
+  m_branches.reset();
 
   if ( Verbosity () > 0 )
   {
@@ -232,9 +268,21 @@ int SimTree::Init( PHCompositeNode * /*topNode*/ )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int SimTree::InitRun( PHCompositeNode * /*topNode*/ )
+{
+  m_nodes.clear();
+  m_calo.clear_geometry();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int SimTree::process_event( PHCompositeNode *topNode )
 {
 
+  if ( m_checkpoint.skip_event() ) 
+  { // written by the part we resume from
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
   m_event_id++; 
 
   
@@ -289,11 +337,17 @@ int SimTree::process_event( PHCompositeNode *topNode )
     if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
   }
 
+  if ( m_do_jet_matching && !m_truthjet_node.empty() )
+  { // truth -> reco jet matching
+    MatchJets();
+  }
+
 
   GetCaloInfo(topNode);
 
   // fill tree
-  m_tree->Fill();
+  m_branches.fill( m_tree );
+  m_checkpoint.filled( m_event_id );
   
   return Fun4AllReturnCodes::EVENT_OK;
 
@@ -310,7 +364,7 @@ int SimTree::End( PHCompositeNode * /*topNode*/ )
 
   PHTFileServer::get().cd(m_output_filename); 
 
-  m_tree->Write();
+  m_branches.write( m_tree );
   
 
   if ( Verbosity() > 0 ) 
@@ -318,6 +372,7 @@ int SimTree::End( PHCompositeNode * /*topNode*/ )
     std::cout << "SimTree::EndRun - Writing run tree" << std::endl;
   }
   PHTFileServer::get().close();
+  m_checkpoint.finish();
  
   if ( Verbosity () > 0 ) 
   {
@@ -327,64 +382,63 @@ int SimTree::End( PHCompositeNode * /*topNode*/ )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-int SimTree::GetZvtx( PHCompositeNode *topNode )
+EventSummary * SimTree::GetEventSummary( PHCompositeNode *topNode )
 {
-  // get zvtx
-  ResetZvtx();
-  auto vertexmap = findNode::getClass<GlobalVertexMap>( topNode, m_zvrtx_node );
-  if ( !vertexmap  || vertexmap->empty() ) 
+  // only used when EventSummaryReco did not fill the summary first
+  EventSummaryReco::InputNodes inputs;
+  if ( !m_zvrtx_node.empty() ) { inputs.vertex = m_zvrtx_node; }
+  if ( !m_cent_node.empty() ) { inputs.centrality = m_cent_node; }
+  if ( !m_eventhead_node.empty() ) { inputs.eventheader = m_eventhead_node; }
+
+  auto summary = EventSummaryReco::GetSummary( topNode, m_nodes, "EventSummary", inputs );
+  if ( !summary )
   {
-    std::cout << PHWHERE << "" << m_zvrtx_node << " node missing, skipping event." << std::endl;
-    return Fun4AllReturnCodes::EVENT_OK;
+    std::cout << PHWHERE << " EventSummary node missing, Abort!." << std::endl;
   }
-   
-  auto vtx = vertexmap->begin()->second;
-  m_zvtx = NAN;
-  if ( vtx ) 
-  {
-    m_zvtx = vtx->get_z();
-  } 
+  return summary;
+}
 
-  if ( std::isnan(m_zvtx) || m_zvtx > 1e3) 
-  {
-    static bool once = true;
-    if (once) 
+int SimTree::GetZvtx( PHCompositeNode *topNode )
+{
+    // get zvtx
+    m_branches.reset( kZvtx );
+    auto summary = GetEventSummary( topNode );
+    if ( !summary ) { return Fun4AllReturnCodes::ABORTRUN; }
+
+    // missing vertices are counted and reported by EventSummaryReco
+    if ( summary->get_vertex_status() == EventSummary::kVERTEX_MISSING ) 
     {
-      once = false;
-      std::cout << PHWHERE << "vertex is " << m_zvtx << ". Drop all tower inputs (further vertex warning will be suppressed)." << std::endl;
+      return Fun4AllReturnCodes::EVENT_OK;
     }
-    return Fun4AllReturnCodes::ABORTEVENT;
-  }
 
+    m_zvtx = summary->get_zvtx();
+    if ( !summary->has_good_vertex() ) 
+    {
+      // drop all tower inputs
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
 
-  if ( Verbosity() > 1 ) 
-  {
-    std::cout << PHWHERE << " - zvtx = " << m_zvtx << std::endl;
-  }
 
-  return Fun4AllReturnCodes::EVENT_OK;
+    if ( Verbosity() > 1 ) 
+    {
+      std::cout << PHWHERE << " - zvtx = " << m_zvtx << std::endl;
+    }
+
+    return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int SimTree::GetCentInfo( PHCompositeNode *topNode )
 {
   // get centrality
-  ResetCent();
-  auto cent_node = findNode::getClass< CentralityInfo >( topNode, m_cent_node );
-  if ( !cent_node ) 
+  m_branches.reset( kCent );
+  auto summary = GetEventSummary( topNode );
+  if ( !summary || !summary->has( EventSummary::kCENTRALITY ) ) 
   {
     std::cout << PHWHERE << m_cent_node << " node missing, Abort!." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  if ( cent_node ) 
-  {
-    m_cent = (int)(cent_node->get_centrality_bin(CentralityInfo::PROP::mbd_NS));
-  } 
-  else 
-  {
-    std::cout << PHWHERE << "CentralityInfo is missing." << std::endl;
-  }
-  
+  m_cent = summary->get_centrality();
 
   if ( Verbosity() > 1 ) 
   {
@@ -397,25 +451,25 @@ int SimTree::GetCentInfo( PHCompositeNode *topNode )
 int SimTree::GetEventHeaderInfo( PHCompositeNode *topNode )
 {
   // get event header info
-  ResetEventHeader();
-  auto eventhead = findNode::getClass<EventHeader>( topNode, m_eventhead_node );
-  if ( !eventhead ) 
+  m_branches.reset( kEventHeader );
+  auto summary = GetEventSummary( topNode );
+  if ( !summary || !summary->has( EventSummary::kEVENTHEADER ) ) 
   {
     std::cout << PHWHERE << " Input node " << m_eventhead_node << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  m_b = eventhead->get_ImpactParameter();
-  m_ep_angle = eventhead->get_EventPlaneAngle();
-  m_ecc = eventhead->get_eccentricity();
-  m_psi1 = eventhead->get_FlowPsiN(1);
-  m_psi2 = eventhead->get_FlowPsiN(2);
-  m_psi3 = eventhead->get_FlowPsiN(3);
-  m_psi4 = eventhead->get_FlowPsiN(4);
-  m_psi5 = eventhead->get_FlowPsiN(5);
-  m_psi6 = eventhead->get_FlowPsiN(6);
-  m_ncoll = eventhead->get_ncoll();
-  m_npart = eventhead->get_npart();
+  m_b = summary->get_b();
+  m_ep_angle = summary->get_ep_angle();
+  m_ecc = summary->get_ecc();
+  m_psi1 = summary->get_psi(1);
+  m_psi2 = summary->get_psi(2);
+  m_psi3 = summary->get_psi(3);
+  m_psi4 = summary->get_psi(4);
+  m_psi5 = summary->get_psi(5);
+  m_psi6 = summary->get_psi(6);
+  m_ncoll = summary->get_ncoll();
+  m_npart = summary->get_npart();
   
   if ( Verbosity() > 1 ) 
   {
@@ -429,12 +483,12 @@ int SimTree::GetSub1JetInfo( PHCompositeNode *topNode)
 {
 
  
-  ResetSub1Jet();
-  ResetTowerBkgd();
+  m_branches.reset( kSub1Jet );
+  m_branches.reset( kTowerBkgd );
 
-  auto towerinfosEM3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1");
-  auto towerinfosIH3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_HCALIN_SUB1" );
-  auto towerinfosOH3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1" );
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1");
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALIN_SUB1" );
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1" );
   if( !towerinfosIH3 || !towerinfosOH3 || !towerinfosEM3 )
   {
     std::cout
@@ -449,8 +503,8 @@ int SimTree::GetSub1JetInfo( PHCompositeNode *topNode)
   }
   
   // get geometry containers
-  auto geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  auto geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
   if ( !geomIH || !geomOH ) 
   {
     std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
@@ -458,21 +512,21 @@ int SimTree::GetSub1JetInfo( PHCompositeNode *topNode)
   }
   
   // get raw jets
-  auto jets = findNode::getClass<JetContainer>( topNode, m_sub1jet_node );
+  auto jets = m_nodes.get<JetContainer>( topNode, m_sub1jet_node );
   if ( !jets )
   {
     std::cout << PHWHERE << " Input node " << m_sub1jet_node << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTEVENT; 
   }
 
-  auto tower_background_sub1 = findNode::getClass<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub1");
+  auto tower_background_sub1 = m_nodes.get<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub1");
   if ( !tower_background_sub1 )
   {
     std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
 
-  auto tower_background_sub2 = findNode::getClass<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub2");
+  auto tower_background_sub2 = m_nodes.get<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub2");
   if ( !tower_background_sub2 )
   {
     std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
@@ -666,10 +720,10 @@ int SimTree::GetTruthJetInfo( PHCompositeNode *topNode)
 {
 
  
-  ResetTruthJet();
+  m_branches.reset( kTruthJet );
 
   // get truth jets
-  auto jets = findNode::getClass<JetContainer>( topNode, m_truthjet_node );
+  auto jets = m_nodes.get<JetContainer>( topNode, m_truthjet_node );
   if ( !jets )
   {
     std::cout << PHWHERE << " Input node " << m_truthjet_node << " Node missing, doing nothing." << std::endl;
@@ -704,19 +758,19 @@ int SimTree::GetRawJetInfo( PHCompositeNode *topNode)
 {
 
  
-  ResetRawJet();
-  ResetMultJet();
-  ResetAreaJet();
-  ResetRho();
+  m_branches.reset( kRawJet );
+  m_branches.reset( kMultJet );
+  m_branches.reset( kAreaJet );
+  m_branches.reset( kRho );
   
-  auto rhoM_cemc = findNode::getClass<TowerRhov1>(topNode, "TowerRho_MULT_CEMC" );
-  auto rhoM_hcalin = findNode::getClass<TowerRhov1>(topNode, "TowerRho_MULT_HCALIN" );
-  auto rhoM_hcalout = findNode::getClass<TowerRhov1>(topNode, "TowerRho_MULT_HCALOUT" );
-  auto rhoA_cemc = findNode::getClass<TowerRhov1>(topNode, "TowerRho_AREA_CEMC" );
-  auto rhoA_hcalin = findNode::getClass<TowerRhov1>(topNode, "TowerRho_AREA_HCALIN" );
-  auto rhoA_hcalout = findNode::getClass<TowerRhov1>(topNode, "TowerRho_AREA_HCALOUT" );
-  auto rhoM = findNode::getClass<TowerRhov1>(topNode, "TowerRho_MULT" );
-  auto rhoA = findNode::getClass<TowerRhov1>(topNode, "TowerRho_AREA" );
+  auto rhoM_cemc = m_nodes.get<TowerRhov1>(topNode, "TowerRho_MULT_CEMC" );
+  auto rhoM_hcalin = m_nodes.get<TowerRhov1>(topNode, "TowerRho_MULT_HCALIN" );
+  auto rhoM_hcalout = m_nodes.get<TowerRhov1>(topNode, "TowerRho_MULT_HCALOUT" );
+  auto rhoA_cemc = m_nodes.get<TowerRhov1>(topNode, "TowerRho_AREA_CEMC" );
+  auto rhoA_hcalin = m_nodes.get<TowerRhov1>(topNode, "TowerRho_AREA_HCALIN" );
+  auto rhoA_hcalout = m_nodes.get<TowerRhov1>(topNode, "TowerRho_AREA_HCALOUT" );
+  auto rhoM = m_nodes.get<TowerRhov1>(topNode, "TowerRho_MULT" );
+  auto rhoA = m_nodes.get<TowerRhov1>(topNode, "TowerRho_AREA" );
   if ( !rhoM_cemc || !rhoM_hcalin || !rhoM_hcalout || !rhoM ) {
     std::cout << PHWHERE << " One of the following nodes is missing: TowerRho_MULT_CEMC, TowerRho_MULT_HCALIN, TowerRho_MULT_HCALOUT, TowerRho_MULT. Skipping rho filling." << std::endl;
   }
@@ -738,7 +792,7 @@ int SimTree::GetRawJetInfo( PHCompositeNode *topNode)
 
 
   // get raw jets
-  auto jets = findNode::getClass<JetContainer>( topNode, m_rawjet_node );
+  auto jets = m_nodes.get<JetContainer>( topNode, m_rawjet_node );
   if ( !jets )
   {
     std::cout << PHWHERE << " Input node " << m_rawjet_node << " Node missing, doing nothing." << std::endl;
@@ -762,7 +816,7 @@ int SimTree::GetRawJetInfo( PHCompositeNode *topNode)
 
   if ( !m_multjet_node.empty() ) 
   {
-    auto multjets = findNode::getClass<JetContainer>( topNode, m_multjet_node );
+    auto multjets = m_nodes.get<JetContainer>( topNode, m_multjet_node );
     if (!multjets )
     {
       std::cout << PHWHERE << " Input node " << m_multjet_node << " Node missing, skipping mult jets." << std::endl;
@@ -787,7 +841,7 @@ int SimTree::GetRawJetInfo( PHCompositeNode *topNode)
   }
   if ( !m_areajet_node.empty() ) 
   {
-    auto areajets = findNode::getClass<JetContainer>( topNode, m_areajet_node );
+    auto areajets = m_nodes.get<JetContainer>( topNode, m_areajet_node );
     if (!areajets )
     {
       std::cout << PHWHERE << " Input node " << m_areajet_node << " Node missing, skipping area jets." << std::endl;
@@ -820,115 +874,76 @@ int SimTree::GetRawJetInfo( PHCompositeNode *topNode)
 
 }
 
-void SimTree::SumCaloE( PHCompositeNode *topNode, const std::string &towerinfo_node, const std::string &geo_node, const float zvrtx, float &sum_e )
+void SimTree::BranchJetMatch( const std::string & tag, const std::string & reco_prefix, JetMatch & match )
 {
-  sum_e = 0.0;
-  auto towerinfos = findNode::getClass< TowerInfoContainer >( topNode, towerinfo_node );
-  if ( !towerinfos ) 
-  {
-    return;
-  }
-  auto geocont = findNode::getClass<RawTowerGeomContainer>(topNode, geo_node);
-  if ( !geocont )
+  m_branches.add( kJetMatch, m_tree, "truth_jet_" + tag + "_match", &match.match );
+  m_branches.add( kJetMatch, m_tree, "truth_jet_" + tag + "_dR", &match.dR );
+  m_branches.add( kJetMatch, m_tree, "truth_jet_" + tag + "_dpT", &match.dpT );
+  m_branches.add( kJetMatch, m_tree, reco_prefix + "truth_match", &match.reco_match );
+}
+
+void SimTree::MatchJets()
+{
+  // truth jets above the floor, shared by every reco collection
+  m_match_truth_idx.clear();
+  m_match_truth_eta.clear();
+  m_match_truth_phi.clear();
+  for ( unsigned int i = 0; i < m_truth_jet_pT.size(); ++i )
   {
-    std::cout << PHWHERE << " RawTowerGeomContainer node " << geo_node << " missing, skipping." << std::endl;
-    return;
+    if ( m_truth_jet_pT[i] < m_match_truth_pt_min ) { continue; }
+    m_match_truth_idx.push_back( i );
+    m_match_truth_eta.push_back( m_truth_jet_eta[i] );
+    m_match_truth_phi.push_back( m_truth_jet_phi[i] );
   }
 
-  RawTowerDefs::CalorimeterId geocaloid{RawTowerDefs::CalorimeterId::NONE};
+  if ( !m_rawjet_node.empty() ) { MatchJets( m_raw_jet_eta, m_raw_jet_phi, m_raw_jet_pT, m_raw_match ); }
+  if ( !m_multjet_node.empty() ) { MatchJets( m_mult_jet_eta, m_mult_jet_phi, m_mult_jet_pT, m_mult_match ); }
+  if ( !m_areajet_node.empty() ) { MatchJets( m_area_jet_eta, m_area_jet_phi, m_area_jet_pT, m_area_match ); }
+  if ( !m_sub1jet_node.empty() ) { MatchJets( m_sub1_jet_eta, m_sub1_jet_phi, m_sub1_jet_pT, m_sub1_match ); }
+}
 
-  const double CALO_RADII[3] = {93.5, 127.503, 225.87};
-  int calo_id = 0;
-  if ( towerinfo_node.find("CEMC") != std::string::npos ) 
-  {
-    calo_id = 0;
-  }
-  else if ( towerinfo_node.find("HCALIN") != std::string::npos ) 
-  {
-    calo_id = 1;
-  }
-  else if ( towerinfo_node.find("HCALOUT") != std::string::npos ) 
-  {
-    calo_id = 2;
-  }
-  
-  const double this_R = CALO_RADII[calo_id];
-  
-  if ( geo_node.find("HCALIN") != std::string::npos ) 
-  {
-    geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
-  }
-  else if ( geo_node.find("HCALOUT") != std::string::npos ) 
-  {
-    geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
-  }
-  else if ( geo_node.find("CEMC") != std::string::npos ) 
-  {
-    geocaloid = RawTowerDefs::CalorimeterId::CEMC;
-  }
-  else 
+void SimTree::MatchJets( const std::vector < float > & eta, const std::vector < float > & phi, const std::vector < float > & pT, JetMatch & match )
+{
+  m_match_reco_idx.clear();
+  m_match_reco_eta.clear();
+  m_match_reco_phi.clear();
+  for ( unsigned int i = 0; i < pT.size(); ++i )
   {
-    std::cout << PHWHERE << " Warning: cannot determine calo id from geo node name " << geo_node << ", skipping." << std::endl;
-    return;
+    if ( pT[i] < m_match_reco_pt_min ) { continue; }
+    m_match_reco_idx.push_back( i );
+    m_match_reco_eta.push_back( eta[i] );
+    m_match_reco_phi.push_back( phi[i] );
   }
-  
-  // std::cout << PHWHERE << " - Calo id = " << calo_id << ", R = " << this_R << std::endl;
-
-  auto ntowers = towerinfos->size();
-  for ( unsigned int ich = 0; ich < ntowers; ich++ ) 
-  {
-    auto tower = towerinfos->get_tower_at_channel(ich);
-    assert(tower);
-
-    unsigned int key = towerinfos -> encode_key(ich);
-    int ieta = towerinfos -> getTowerEtaBin(key);
-    int iphi = towerinfos -> getTowerPhiBin(key);
-    const RawTowerDefs::keytype geokey = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
-
-    if ( ! tower->get_isGood() ) 
-    {
-      continue; // skip bad towers
-    }
-    if (std::isnan(tower->get_energy()) ) 
-    {
-      continue; // skip towers with bad energy
-    }
-
-    auto tower_geom = geocont -> get_tower_geometry(geokey);
-    assert(tower_geom);
 
-    double eta = tower_geom -> get_eta();
-    double E = tower -> get_energy();
-    double z0 = sinh(eta) * this_R;
-    double z = z0 - zvrtx;
-    double eta_shifted = asinh(z / this_R);  // eta after shift from
-    double eT = E / cosh(eta_shifted);
-    
-
-    sum_e += eT;
-  } 
+  // grid hashed, closest pairs first, see JetMatcher
+  m_matcher.Match( m_match_truth_eta, m_match_truth_phi, m_match_reco_eta, m_match_reco_phi,
+                   m_match_a_to_b, m_match_a_dR, m_match_b_to_a );
 
-  if ( Verbosity() > 1 ) 
+  match.match.assign( m_truth_jet_pT.size(), -1 );
+  match.dR.assign( m_truth_jet_pT.size(), -1 );
+  match.dpT.assign( m_truth_jet_pT.size(), -999 );
+  match.reco_match.assign( pT.size(), -1 );
+  for ( unsigned int ia = 0; ia < m_match_a_to_b.size(); ++ia )
   {
-    std::cout << PHWHERE << " - " << towerinfo_node << ": sum_e = " << sum_e << std::endl;
+    if ( m_match_a_to_b[ia] < 0 ) { continue; }
+    const int itruth = m_match_truth_idx[ia];
+    const int ireco = m_match_reco_idx[m_match_a_to_b[ia]];
+    match.match[itruth] = ireco;
+    match.dR[itruth] = m_match_a_dR[ia];
+    match.dpT[itruth] = pT[ireco] - m_truth_jet_pT[itruth];
+    match.reco_match[ireco] = itruth;
   }
-
-  return;
 }
 
 int SimTree::GetCaloInfo( PHCompositeNode *topNode )
 {
-  ResetCaloInfo();
-
-  SumCaloE( topNode, "TOWERINFO_CALIB_CEMC_RETOWER", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_cemc );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALIN", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_hcalin );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALOUT", "TOWERGEOM_HCALOUT", m_zvtx, m_sumeT_hcalout );
-  SumCaloE( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_cemc_sub1 );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALIN_SUB1", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_hcalin_sub1 );
-  SumCaloE( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1","TOWERGEOM_HCALOUT", m_zvtx,  m_sumeT_hcalout_sub1 );
-  SumCaloE( topNode, "TOWERINFO_CALIB_ORIGINAL_CEMC", "TOWERGEOM_CEMC", m_zvtx, m_sumeT_cemc_org );
-  SumCaloE( topNode, "TOWERINFO_CALIB_ORIGINAL_HCALIN", "TOWERGEOM_HCALIN", m_zvtx, m_sumeT_hcalin_org );
-  SumCaloE( topNode, "TOWERINFO_CALIB_ORIGINAL_HCALOUT", "TOWERGEOM_HCALOUT", m_zvtx, m_sumeT_hcalout_org );
+  m_branches.reset( kCalo );
+
+  m_calo.process( topNode, m_nodes, m_zvtx );
+  for ( auto & [ idx, sum ] : m_calo_sums )
+  {
+    *sum = m_calo.get( idx ).sumEt;
+  }
 
   if ( Verbosity() > 1 ) 
   {
@@ -939,9 +954,9 @@ int SimTree::GetCaloInfo( PHCompositeNode *topNode )
 
 int SimTree::GetG4TruthInfo( PHCompositeNode *topNode )
 {
-  ResetG4Truth();
+  m_branches.reset( kG4Truth );
 
-  PHG4TruthInfoContainer * truthinfo = findNode::getClass<PHG4TruthInfoContainer>( topNode, m_g4truth_node );
+  PHG4TruthInfoContainer * truthinfo = m_nodes.get<PHG4TruthInfoContainer>( topNode, m_g4truth_node );
   if ( !truthinfo )  {
     std::cout << PHWHERE << " Input node "<< m_g4truth_node << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
@@ -978,8 +993,8 @@ int SimTree::GetG4TruthInfo( PHCompositeNode *topNode )
 
 int SimTree::GetEventPlaneInfo( PHCompositeNode *topNode )
 {
-  ResetEventPlane();
-  auto m_evpmap  = findNode::getClass<EventplaneinfoMap>(topNode,  m_eventplane_node );
+  m_branches.reset( kEventPlane );
+  auto m_evpmap  = m_nodes.get<EventplaneinfoMap>(topNode,  m_eventplane_node );
   if ( !m_evpmap  || m_evpmap->empty() ) {
     std::cout << PHWHERE << "EventplaneinfoMap node missing, doing nothing." << std::endl;
   } else {
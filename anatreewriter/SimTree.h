@@ -4,6 +4,14 @@
 #include <fun4all/SubsysReco.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <eventselection/NodeCache.h>
+#include <eventselection/TreeCheckpoint.h>
+
+#include <commonutils/JetMatcher.h>
+
+#include "BranchRegistry.h"
+#include "CaloReduction.h"
+
 #include <string>
 #include <vector>
 #include <array>
@@ -14,6 +22,7 @@
 #include <cstring>
 
 class PHCompositeNode;
+class EventSummary;
 class TTree;
 class TRandom3;
 
@@ -38,6 +47,8 @@ class SimTree : public SubsysReco
 
 
   int Init( PHCompositeNode * /*topNode*/) override;
+
+  int InitRun( PHCompositeNode * /*topNode*/ ) override;
   
   int process_event( PHCompositeNode * topNode ) override;
   
@@ -45,14 +56,7 @@ class SimTree : public SubsysReco
   
   int ResetEvent( PHCompositeNode * /*topNode*/ ) override 
   {
-    ResetZvtx();
-    ResetCent();
-    ResetEventHeader();
-    ResetSub1Jet();
-    ResetTruthJet();
-    ResetCaloInfo();
-    ResetRawJet();
-    ResetG4Truth();
+    m_branches.reset();
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
@@ -66,6 +70,16 @@ class SimTree : public SubsysReco
   void add_multjet_node ( const std::string & name ) { m_multjet_node = name; }
   void add_areajet_node ( const std::string & name ) { m_areajet_node = name; }
 
+  // truth -> raw/mult/area/sub1 matching at write time. Jets below the pT
+  // floors are never matched, matched pairs are closer than dR_max
+  void do_jet_matching( const bool do_match = true, const float dR_max = 0.3, const float truth_pt_min = 0.0, const float reco_pt_min = 0.0 )
+  {
+    m_do_jet_matching = do_match;
+    m_matcher.set_dR_max( dR_max );
+    m_match_truth_pt_min = truth_pt_min;
+    m_match_reco_pt_min = reco_pt_min;
+  }
+
   void do_towerbkgd( const bool do_bkgd = true ) { m_do_towerbkgd = do_bkgd; }
   void do_rho( const bool do_rho = true ) { m_do_rho = do_rho; }
 
@@ -73,7 +87,22 @@ class SimTree : public SubsysReco
   void add_ep_info ( const std::string &name = "EventPlaneInfo" ) { m_eventplane_node = name; }
 
 
+  // AutoSave the tree every nevents ( or nseconds ), see TreeCheckpoint
+  void set_checkpoint( const unsigned int nevents, const unsigned int nseconds = 0 ) { m_checkpoint.set_interval( nevents, nseconds ); }
+  // continue a killed job from its last checkpoint
+  void set_resume( const bool b ) { m_checkpoint.set_resume( b ); }
+
+  // write the event trees as RNTuples, pages compressed on nthreads
+  // implicit MT threads ( 0 single threaded ). TTrees by default
+  void use_rntuple( const bool b = true, const unsigned int nthreads = 0 ) { m_branches.set_backend( b ? BranchRegistry::kRNTuple : BranchRegistry::kTTree, nthreads ); }
+
  private:
+
+  // per run node handles
+  NodeCache m_nodes {};
+
+  // periodic AutoSave and resume
+  TreeCheckpoint m_checkpoint {};
     
   // output file name
   std::string m_output_filename { "" };
@@ -82,6 +111,26 @@ class SimTree : public SubsysReco
   TTree * m_tree {nullptr};
   int m_event_id {-1};
 
+  // per event output columns, booked in Init and reset per block
+  enum BLOCK
+  {
+    kZvtx = 0,
+    kCent,
+    kEventHeader,
+    kCalo,
+    kRho,
+    kTowerBkgd,
+    kSub1Jet,
+    kTruthJet,
+    kRawJet,
+    kMultJet,
+    kAreaJet,
+    kJetMatch,
+    kEventPlane,
+    kG4Truth
+  };
+  BranchRegistry m_branches {};
+
   float m_sumeT_cemc { 0.0 };
   float m_sumeT_hcalin { 0.0 };
   float m_sumeT_hcalout { 0.0 };
@@ -91,34 +140,17 @@ class SimTree : public SubsysReco
   float m_sumeT_cemc_org { 0.0 };
   float m_sumeT_hcalin_org { 0.0 };
   float m_sumeT_hcalout_org { 0.0 };
+  // all nine sums in one reduction, index in m_calo -> branch
+  CaloReduction m_calo {};
+  std::vector < std::pair < unsigned int, float * > > m_calo_sums {};
 
-  void ResetCaloInfo()
-  {
-    m_sumeT_cemc = 0.0;
-    m_sumeT_hcalin = 0.0;
-    m_sumeT_hcalout = 0.0;
-    m_sumeT_cemc_sub1 = 0.0;
-    m_sumeT_hcalin_sub1 = 0.0;
-    m_sumeT_hcalout_sub1 = 0.0;
-    m_sumeT_cemc_org = 0.0;
-    m_sumeT_hcalin_org = 0.0;
-    m_sumeT_hcalout_org = 0.0;    
-  }
 
   std::string m_zvrtx_node { "" };
   float m_zvtx { 0.0 };
-  void ResetZvtx()
-  {
-    m_zvtx = -999;
-  }
 
   // centrality info
   std::string m_cent_node { "" };
   int m_cent {-1};
-  void ResetCent()
-  {
-    m_cent = -1;
-  }
 
   // event header info
   std::string m_eventhead_node { "" };
@@ -133,20 +165,6 @@ class SimTree : public SubsysReco
   float m_psi6 { 0.0 };
   float m_ncoll { 0.0 };
   float m_npart { 0.0 };
-  void ResetEventHeader()
-  {
-    m_b = -999;
-    m_ep_angle = -999;
-    m_ecc = -999;
-    m_psi1 = -999;
-    m_psi2 = -999;
-    m_psi3 = -999;
-    m_psi4 = -999;
-    m_psi5 = -999;
-    m_psi6 = -999;
-    m_ncoll = -999;
-    m_npart = -999;
-  }
 
   // sub1 jet info
   std::string m_sub1jet_node { "" };
@@ -163,22 +181,6 @@ class SimTree : public SubsysReco
   std::vector < std::vector < float > > m_sub1_jet_comp_E {};
   std::vector < std::vector < float > > m_sub1_jet_comp_eta {};
   std::vector < std::vector < float > > m_sub1_jet_comp_phi {};
-  void ResetSub1Jet()
-  {
-    m_sub1_jet_E.clear();
-    m_sub1_jet_phi.clear();
-    m_sub1_jet_eta.clear();
-    m_sub1_jet_pT.clear();
-    m_sub1_jet_unsub_pT.clear();
-    m_sub1_jet_unsub_E.clear();
-    m_sub1_jet_comp_ieta.clear();
-    m_sub1_jet_comp_iphi.clear();
-    m_sub1_jet_comp_caloid.clear();
-    m_sub1_jet_comp_status.clear();
-    m_sub1_jet_comp_E.clear();
-    m_sub1_jet_comp_eta.clear();
-    m_sub1_jet_comp_phi.clear();
-  }
 
   static const int k_ieta = 24;
   static const int k_iphi = 64;
@@ -218,41 +220,6 @@ class SimTree : public SubsysReco
   float m_rhoA_hcalin_std { 0.0 };
   float m_rhoA_hcalout_std { 0.0 };
   float m_rhoA_std { 0.0 };
-  void ResetTowerBkgd()
-  {
-    memset(m_sub1_towerbkgd_cemc, 0, sizeof(m_sub1_towerbkgd_cemc));
-    memset(m_sub1_towerbkgd_hcalin, 0, sizeof(m_sub1_towerbkgd_hcalin));
-    memset(m_sub1_towerbkgd_hcalout, 0, sizeof(m_sub1_towerbkgd_hcalout));
-    memset(m_sub2_towerbkgd_cemc, 0, sizeof(m_sub2_towerbkgd_cemc));
-    memset(m_sub2_towerbkgd_hcalin, 0, sizeof(m_sub2_towerbkgd_hcalin));
-    memset(m_sub2_towerbkgd_hcalout, 0, sizeof(m_sub2_towerbkgd_hcalout));
-    m_sub1_v2 = 0.0;
-    m_sub2_v2 = 0.0;
-    m_sub1_flowfaliure = 0;
-    m_sub2_flowfaliure = 0;
-  }
-  void ResetRho()
-  {
-    m_rhoM_cemc = 0.0;
-    m_rhoM_hcalin = 0.0;
-    m_rhoM_hcalout = 0.0;
-    m_rhoM = 0.0;
-    
-    m_rhoA_cemc = 0.0;
-    m_rhoA_hcalin = 0.0;
-    m_rhoA_hcalout = 0.0;
-    m_rhoA = 0.0;
-
-    m_rhoM_cemc_std = 0.0;
-    m_rhoM_hcalin_std = 0.0;
-    m_rhoM_hcalout_std = 0.0;
-    m_rhoM_std = 0.0;
-
-    m_rhoA_cemc_std = 0.0;
-    m_rhoA_hcalin_std = 0.0;
-    m_rhoA_hcalout_std = 0.0;
-    m_rhoA_std = 0.0;    
-  }
 
   // truth jet info
   std::string m_truthjet_node { "" };
@@ -260,13 +227,6 @@ class SimTree : public SubsysReco
   std::vector < float > m_truth_jet_phi {};
   std::vector < float > m_truth_jet_eta {};
   std::vector < float > m_truth_jet_pT {};
-  void ResetTruthJet()
-  {
-    m_truth_jet_E.clear();
-    m_truth_jet_phi.clear();
-    m_truth_jet_eta.clear();
-    m_truth_jet_pT.clear();
-  }
 
   std::string m_rawjet_node { "" };
   std::vector < float > m_raw_jet_E {};
@@ -285,29 +245,38 @@ class SimTree : public SubsysReco
   std::vector < float > m_area_jet_phi {};
   std::vector < float > m_area_jet_eta {};
   std::vector < float > m_area_jet_pT {};
-  void ResetRawJet()
-  {
-    m_raw_jet_E.clear();
-    m_raw_jet_phi.clear();
-    m_raw_jet_eta.clear();
-    m_raw_jet_pT.clear();
-    
-  }
-  void ResetMultJet()
-  {
-    m_mult_jet_E.clear();
-    m_mult_jet_phi.clear();
-    m_mult_jet_eta.clear();
-    m_mult_jet_pT.clear();
-  }
-  void ResetAreaJet()
-  {
-    m_area_jet_E.clear();
-    m_area_jet_phi.clear();
-    m_area_jet_eta.clear();
-    m_area_jet_pT.clear();
-  }
   
+  // truth -> reco matches, indexed by truth jet
+  //   match   : index in the reco collection, -1 if unmatched
+  //   dR      : dR of the match, -1 if unmatched
+  //   dpT     : reco pT - truth pT, -999 if unmatched
+  //   reco_match : truth index per reco jet, -1 if unmatched
+  struct JetMatch
+  {
+    std::vector < int > match {};
+    std::vector < float > dR {};
+    std::vector < float > dpT {};
+    std::vector < int > reco_match {};
+  };
+  bool m_do_jet_matching { false };
+  float m_match_truth_pt_min { 0.0 };
+  float m_match_reco_pt_min { 0.0 };
+  JetMatcher m_matcher {};
+  JetMatch m_raw_match {};
+  JetMatch m_mult_match {};
+  JetMatch m_area_match {};
+  JetMatch m_sub1_match {};
+  // scratch for the jets above the pT floors
+  std::vector < int > m_match_truth_idx {};
+  std::vector < float > m_match_truth_eta {};
+  std::vector < float > m_match_truth_phi {};
+  std::vector < int > m_match_reco_idx {};
+  std::vector < float > m_match_reco_eta {};
+  std::vector < float > m_match_reco_phi {};
+  std::vector < int > m_match_a_to_b {};
+  std::vector < float > m_match_a_dR {};
+  std::vector < int > m_match_b_to_a {};
+
   std::string m_g4truth_node { "" };
   float m_g4truth_zvtx { 0.0 };
   float m_g4truth_v2reco { 0.0 };
@@ -315,15 +284,6 @@ class SimTree : public SubsysReco
   float m_g4truth_v4reco { 0.0 };
   float m_g4truth_v5reco { 0.0 };
   float m_g4truth_v6reco { 0.0 };
-  void ResetG4Truth()
-  {
-    m_g4truth_v2reco = -999;
-    m_g4truth_v3reco = -999;
-    m_g4truth_v4reco = -999;
-    m_g4truth_v5reco = -999;
-    m_g4truth_v6reco = -999;
-    m_g4truth_zvtx = -999;
-  }
 
   std::string m_eventplane_node { "" };
   std::vector< float > m_psi_shifted_NS {};
@@ -332,27 +292,22 @@ class SimTree : public SubsysReco
   std::vector< float > m_psi_S {};
   std::vector< float > m_psi_shifted_N {};
   std::vector< float > m_psi_N {};
-  void ResetEventPlane()
-  {
-    m_psi_shifted_NS.clear();
-    m_psi_NS.clear();
-    m_psi_shifted_S.clear();
-    m_psi_S.clear();
-    m_psi_shifted_N.clear();
-    m_psi_N.clear();
-  }
 
  
+  // vertex, centrality and event header all come from the EventSummary node
+  EventSummary * GetEventSummary( PHCompositeNode *topNode );
   int GetZvtx( PHCompositeNode *topNode );
   int GetCentInfo( PHCompositeNode *topNode );
   int GetEventHeaderInfo( PHCompositeNode *topNode );
   int GetSub1JetInfo( PHCompositeNode *topNode );
   int GetTruthJetInfo( PHCompositeNode *topNode );
+  void BranchJetMatch( const std::string & tag, const std::string & reco_prefix, JetMatch & match );
+  void MatchJets( const std::vector < float > & eta, const std::vector < float > & phi, const std::vector < float > & pT, JetMatch & match );
+  void MatchJets();
   int GetRawJetInfo( PHCompositeNode *topNode );
   int GetRhoInfo( PHCompositeNode *topNode );
   int GetEventPlaneInfo( PHCompositeNode *topNode );
   int GetCaloInfo( PHCompositeNode *topNode );
-  void SumCaloE( PHCompositeNode *topNode, const std::string &towerinfo_node, const std::string &geo_node, const float zvrtx, float &sum_e );
   
   int GetG4TruthInfo( PHCompositeNode *topNode );  
 
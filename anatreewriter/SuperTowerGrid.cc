@@ -0,0 +1,92 @@
+#include "SuperTowerGrid.h"
+
+#include <calobase/RawTowerDefs.h>
+#include <calobase/RawTowerGeom.h>
+#include <calobase/RawTowerGeomContainer.h>
+
+#include <algorithm>
+#include <cmath>
+
+SuperTowerGrid::SuperTowerGrid()
+  : m_cell_eT( k_ncells, 0.0 )
+  , m_cell_used( k_ncells, false )
+  , m_geometry( k_nlayers * k_ncells )
+{
+  m_touched.reserve( k_ncells );
+}
+
+void SuperTowerGrid::clear_geometry()
+{
+  for ( auto & g : m_geometry )
+  {
+    g.known = false;
+  }
+}
+
+bool SuperTowerGrid::get_geometry( const int layer, const int ieta, const int iphi, RawTowerGeomContainer * geom,
+                                   float & eta, float & phi, double & cosh_eta )
+{
+  eta = 0;
+  phi = 0;
+  cosh_eta = 1;
+  if ( layer < 0 || layer >= k_nlayers || ieta < 0 || ieta >= k_neta || iphi < 0 || iphi >= k_nphi ) { return false; }
+
+  Geometry & g = m_geometry[( layer * k_neta + ieta ) * k_nphi + iphi];
+  if ( !g.known )
+  {
+    const auto caloid = layer == 0 ? RawTowerDefs::CalorimeterId::HCALIN : RawTowerDefs::CalorimeterId::HCALOUT;
+    auto tower_geom = geom->get_tower_geometry( RawTowerDefs::encode_towerid( caloid, ieta, iphi ) );
+    if ( !tower_geom ) { return false; }
+    g.eta = tower_geom->get_eta();
+    g.phi = tower_geom->get_phi();
+    g.cosh_eta = cosh( g.eta );
+    g.known = true;
+  }
+  eta = g.eta;
+  phi = g.phi;
+  cosh_eta = g.cosh_eta;
+  return true;
+}
+
+void SuperTowerGrid::clear()
+{
+  for ( const int icell : m_touched )
+  {
+    m_cell_eT[icell] = 0.0;
+    m_cell_used[icell] = false;
+  }
+  m_touched.clear();
+}
+
+void SuperTowerGrid::add( const int ieta, const int iphi, const double eT )
+{
+  if ( ieta < 0 || ieta >= k_neta || iphi < 0 || iphi >= k_nphi ) { return; }
+  const int icell = ieta * k_nphi + iphi;
+  if ( !m_cell_used[icell] )
+  {
+    m_cell_used[icell] = true;
+    m_touched.push_back( icell );
+  }
+  m_cell_eT[icell] += eT;
+}
+
+void SuperTowerGrid::get_stats( float & sum, float & max, float & mean, std::vector < float > & super_E )
+{
+  // ieta major order, as 1000*ieta+iphi keys used to give
+  std::sort( m_touched.begin(), m_touched.end() );
+
+  sum = 0;
+  max = 0;
+  mean = 0;
+  super_E.clear();
+  for ( const int icell : m_touched )
+  {
+    sum += m_cell_eT[icell];
+    max = std::max< double >( m_cell_eT[icell], max );
+    super_E.push_back( m_cell_eT[icell] );
+  }
+  if ( !m_touched.empty() )
+  {
+    mean = sum / m_touched.size();
+  }
+}
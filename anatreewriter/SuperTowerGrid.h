@@ -0,0 +1,60 @@
+#ifndef SUPERTOWERGRID_H
+#define SUPERTOWERGRID_H
+
+#include <vector>
+
+class RawTowerGeomContainer;
+
+// eT sums of seed / jet constituents per 24x64 super tower ( CEMC
+// retowered + HCALIN + HCALOUT at the same ieta, iphi ). The grid and a
+// list of touched cells are kept between seeds, clear() only zeroes the
+// touched cells, so one seed costs O(constituents) and never allocates.
+//
+// Tower eta, phi and cosh(eta) are looked up in the geometry the first
+// time a tower is seen in a run and cached per layer ( 0 HCALIN geometry,
+// 1 HCALOUT geometry ).
+class SuperTowerGrid
+{
+ public:
+
+  static const int k_neta = 24;
+  static const int k_nphi = 64;
+
+  SuperTowerGrid();
+  ~SuperTowerGrid() {}
+
+  // geometry cache, call from InitRun
+  void clear_geometry();
+
+  // false when the tower is outside the grid or has no geometry
+  bool get_geometry( const int layer, const int ieta, const int iphi, RawTowerGeomContainer * geom,
+                     float & eta, float & phi, double & cosh_eta );
+
+  // per seed
+  void clear();
+  void add( const int ieta, const int iphi, const double eT );
+
+  // statistics of the touched super towers, super_E in ieta major order
+  unsigned int size() const { return m_touched.size(); }
+  void get_stats( float & sum, float & max, float & mean, std::vector < float > & super_E );
+
+ private:
+
+  static const int k_ncells = k_neta * k_nphi;
+  static const int k_nlayers = 2;
+
+  std::vector < double > m_cell_eT {};
+  std::vector < bool > m_cell_used {};
+  std::vector < int > m_touched {};
+
+  struct Geometry
+  {
+    bool known { false };
+    float eta { 0.0 };
+    float phi { 0.0 };
+    double cosh_eta { 1.0 };
+  };
+  std::vector < Geometry > m_geometry {};
+};
+
+#endif
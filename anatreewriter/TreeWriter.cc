@@ -53,6 +53,10 @@
 #include <ffarawobjects/Gl1Packet.h>
 #include <ffarawobjects/Gl1Packetv2.h>
 
+#include <eventselection/EventCutRecord.h>
+#include <eventselection/EventSummary.h>
+#include <eventselection/EventSummaryReco.h>
+
 #include <jetbase/Jet.h>
 #include <jetbase/Jetv2.h>
 #include <jetbase/JetContainer.h>
@@ -79,10 +83,57 @@
 #include <cassert>
 
 
+void TreeWriter::set_stream( const std::string & stream, const std::string & selector )
+{
+  m_stream = stream;
+  m_record_node = EventCutRecord::NodeName( selector );
+}
+
+TreeWriter::CaloColumns TreeWriter::BookCalo( const int block, const std::string & prefix )
+{
+  CaloColumns calo {};
+  calo.E = m_branches.add( block, m_tree, prefix + "_E", calo.E, { k_ieta, k_iphi }, 0 );
+  calo.isgood = m_branches.add( block, m_tree, prefix + "_isgood", calo.isgood, { k_ieta, k_iphi }, 0 );
+  calo.time = m_branches.add( block, m_tree, prefix + "_time", calo.time, { k_ieta, k_iphi }, 0 );
+  calo.eta = m_branches.add( block, m_tree, prefix + "_eta", calo.eta, { k_ieta, k_iphi }, 0 );
+  calo.phi = m_branches.add( block, m_tree, prefix + "_phi", calo.phi, { k_ieta, k_iphi }, 0 );
+  return calo;
+}
+
+void TreeWriter::BookJet( const int block, TTree * tree, const std::string & prefix, JetColumns & jet )
+{
+  // null on the first tree, the registry allocates, later trees share it
+  jet.E = m_branches.add( block, tree, prefix + "_E", jet.E );
+  jet.phi = m_branches.add( block, tree, prefix + "_phi", jet.phi );
+  jet.eta = m_branches.add( block, tree, prefix + "_eta", jet.eta );
+  jet.pT = m_branches.add( block, tree, prefix + "_pT", jet.pT );
+}
+
+void TreeWriter::BookJetComponents( const int block, TTree * tree, const std::string & prefix, JetColumns & jet )
+{
+  jet.comp_ieta = m_branches.add( block, tree, prefix + "_comp_ieta", jet.comp_ieta );
+  jet.comp_iphi = m_branches.add( block, tree, prefix + "_comp_iphi", jet.comp_iphi );
+  jet.comp_caloid = m_branches.add( block, tree, prefix + "_comp_caloid", jet.comp_caloid );
+  jet.comp_status = m_branches.add( block, tree, prefix + "_comp_status", jet.comp_status );
+  jet.comp_E = m_branches.add( block, tree, prefix + "_comp_E", jet.comp_E );
+  jet.comp_eta = m_branches.add( block, tree, prefix + "_comp_eta", jet.comp_eta );
+  jet.comp_phi = m_branches.add( block, tree, prefix + "_comp_phi", jet.comp_phi );
+}
+
 int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
 {
   
-  // create output file
+  // AutoSave and resume work on TTrees, an RNTuple is only readable once committed
+  if ( m_branches.get_backend() == BranchRegistry::kRNTuple && m_checkpoint.enabled() )
+  {
+    std::cout << "TreeWriter::Init - checkpoints need the TTree backend, disabled" << std::endl;
+    m_checkpoint.set_interval( 0 );
+    m_checkpoint.set_resume( false );
+  }
+
+  // create output file, a new part when resuming
+  m_checkpoint.set_verbosity( Verbosity() );
+  m_output_filename = m_checkpoint.begin( m_output_filename );
   PHTFileServer::get().open( m_output_filename, "RECREATE" );
 
   if ( Verbosity () > 0 ) 
@@ -92,19 +143,20 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
 
   // Reset counters
   m_run_tree = new TTree( "RunTree", "RunTree" );
+  m_run_tree -> Branch( "run_number", &m_run_number, "run_number/I" );
   m_run_tree -> Branch( "num_events", &m_nevents, "num_events/I" );
   m_run_tree -> Branch( "weight", &m_weight, "weight/F" );
 
   // create tree
   m_tree = new TTree( "EventTree", "EventTree" );
-  m_tree -> Branch( "event_id", &m_event_id, "event_id/I" );
-  m_event_id = -1;
+  m_branches.bind( m_tree, "event_id", &m_event_id );
+  m_event_id = m_checkpoint.get_resume_event_id();
 
   // gl1 info
   if ( !m_gl1_node.empty() ) 
   {
-    m_tree -> Branch( "s_triggervec", &s_triggervec, "s_triggervec/l" );
-    m_tree -> Branch( "l_triggervec", &l_triggervec, "l_triggervec/l" );
+    m_branches.add( kGL1, m_tree, "s_triggervec", &s_triggervec, 0 );
+    m_branches.add( kGL1, m_tree, "l_triggervec", &l_triggervec, 0 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - GL1 node: " << m_gl1_node << std::endl;
@@ -114,7 +166,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // zvtx
   if ( !m_zvrtx_node.empty() ) 
   {
-    m_tree -> Branch( "zvrtx", &m_zvtx, "zvrtx/F" );
+    m_branches.add( kZvtx, m_tree, "zvrtx", &m_zvtx, -999 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered zvtx" << std::endl;
@@ -124,7 +176,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // centrality
   if ( !m_cent_node.empty() ) 
   {
-    m_tree->Branch("cent", &m_cent, "cent/I");
+    m_branches.add( kCent, m_tree, "cent", &m_cent, -1 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered centrality" << std::endl;
@@ -134,12 +186,12 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // eventplane info
   if ( !m_eventplane_node.empty() )
   {
-    m_tree -> Branch( "psi_shifted_NS", &m_psi_shifted_NS);
-    m_tree -> Branch( "psi_shifted_S", &m_psi_shifted_S);
-    m_tree -> Branch( "psi_shifted_N", &m_psi_shifted_N);
-    m_tree -> Branch( "psi_NS", &m_psi_NS);
-    m_tree -> Branch( "psi_S", &m_psi_S);
-    m_tree -> Branch( "psi_N", &m_psi_N);
+    m_branches.add( kEventPlane, m_tree, "psi_shifted_NS", &m_psi_shifted_NS );
+    m_branches.add( kEventPlane, m_tree, "psi_shifted_S", &m_psi_shifted_S );
+    m_branches.add( kEventPlane, m_tree, "psi_shifted_N", &m_psi_shifted_N );
+    m_branches.add( kEventPlane, m_tree, "psi_NS", &m_psi_NS );
+    m_branches.add( kEventPlane, m_tree, "psi_S", &m_psi_S );
+    m_branches.add( kEventPlane, m_tree, "psi_N", &m_psi_N );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered Event Plane nodes: " << m_eventplane_node << std::endl;
@@ -149,11 +201,11 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // sepd infoK
   if ( !m_sepd_node.empty() )
   {
-    m_tree -> Branch( "sepd_energy", &m_sepd_energy);
-    m_tree -> Branch( "sepd_isgood", &m_sepd_isgood);
-    m_tree -> Branch( "sepd_arm", &m_sepd_arm);
-    m_tree -> Branch( "sepd_radius", &m_sepd_radius);
-    m_tree -> Branch( "sepd_phi", &m_sepd_phi);
+    m_branches.add( kSepd, m_tree, "sepd_energy", &m_sepd_energy );
+    m_branches.add( kSepd, m_tree, "sepd_isgood", &m_sepd_isgood );
+    m_branches.add( kSepd, m_tree, "sepd_arm", &m_sepd_arm );
+    m_branches.add( kSepd, m_tree, "sepd_radius", &m_sepd_radius );
+    m_branches.add( kSepd, m_tree, "sepd_phi", &m_sepd_phi );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered sEPD nodes: " << m_sepd_node << std::endl;
@@ -163,17 +215,17 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // event header info
   if ( !m_eventhead_node.empty() ) 
   {
-    m_tree -> Branch( "b", &m_b, "b/F" );
-    m_tree -> Branch( "ep_angle", &m_ep_angle, "ep_angle/F" );
-    m_tree -> Branch( "ecc", &m_ecc, "ecc/F" );
-    m_tree -> Branch( "psi1", &m_psi1, "psi1/F" );
-    m_tree -> Branch( "psi2", &m_psi2, "psi2/F" );
-    m_tree -> Branch( "psi3", &m_psi3, "psi3/F" );
-    m_tree -> Branch( "psi4", &m_psi4, "psi4/F" );
-    m_tree -> Branch( "psi5", &m_psi5, "psi5/F" );
-    m_tree -> Branch( "psi6", &m_psi6, "psi6/F" );
-    m_tree -> Branch( "ncoll", &m_ncoll, "ncoll/F" );
-    m_tree -> Branch( "npart", &m_npart, "npart/F" );
+    m_branches.add( kEventHeader, m_tree, "b", &m_b, -999 );
+    m_branches.add( kEventHeader, m_tree, "ep_angle", &m_ep_angle, -999 );
+    m_branches.add( kEventHeader, m_tree, "ecc", &m_ecc, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi1", &m_psi1, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi2", &m_psi2, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi3", &m_psi3, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi4", &m_psi4, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi5", &m_psi5, -999 );
+    m_branches.add( kEventHeader, m_tree, "psi6", &m_psi6, -999 );
+    m_branches.add( kEventHeader, m_tree, "ncoll", &m_ncoll, -999 );
+    m_branches.add( kEventHeader, m_tree, "npart", &m_npart, -999 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Event header node: " << m_eventhead_node << std::endl;
@@ -183,12 +235,12 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // MBD
   if ( !m_mbd_node.empty() ) 
   {
-    m_tree -> Branch( "mbd_q_N", &m_mbd_q_N, "mbd_q_N/F" );
-    m_tree -> Branch( "mbd_q_S", &m_mbd_q_S, "mbd_q_S/F" );
-    m_tree -> Branch( "mbd_t_N", &m_mbd_t_N, "mbd_t_N/F" );
-    m_tree -> Branch( "mbd_t_S", &m_mbd_t_S, "mbd_t_S/F" );
-    m_tree -> Branch( "mbd_n_N", &m_mbd_n_N, "mbd_n_N/F" );
-    m_tree -> Branch( "mbd_n_S", &m_mbd_n_S, "mbd_n_S/F" );
+    m_branches.add( kMbd, m_tree, "mbd_q_N", &m_mbd_q_N, -999 );
+    m_branches.add( kMbd, m_tree, "mbd_q_S", &m_mbd_q_S, -999 );
+    m_branches.add( kMbd, m_tree, "mbd_t_N", &m_mbd_t_N, -999 );
+    m_branches.add( kMbd, m_tree, "mbd_t_S", &m_mbd_t_S, -999 );
+    m_branches.add( kMbd, m_tree, "mbd_n_N", &m_mbd_n_N, -999 );
+    m_branches.add( kMbd, m_tree, "mbd_n_S", &m_mbd_n_S, -999 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - MBD node: " << m_mbd_node << std::endl;
@@ -198,11 +250,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // cemc
   if ( !m_cemc_node.empty() ) 
   {
-    m_tree -> Branch( "cemc_E", &m_cemc_E, Form("cemc_E[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_isgood", &m_cemc_isgood, Form("cemc_isgood[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_time", &m_cemc_time, Form("cemc_time[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_eta", &m_cemc_eta, Form("cemc_eta[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_phi", &m_cemc_phi, Form("cemc_phi[%d][%d]/F", k_ieta, k_iphi) );
+    m_cemc = BookCalo( kCalo, "cemc" );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered CEMC" << std::endl;
@@ -213,11 +261,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // hcalin
   if ( !m_hcalin_node.empty() )
   {
-    m_tree -> Branch( "hcalin_E", &m_hcalin_E, Form("hcalin_E[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_isgood", &m_hcalin_isgood, Form("hcalin_isgood[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_time", &m_hcalin_time, Form("hcalin_time[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_eta", &m_hcalin_eta, Form("hcalin_eta[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_phi", &m_hcalin_phi, Form("hcalin_phi[%d][%d]/F", k_ieta, k_iphi) );
+    m_hcalin = BookCalo( kCalo, "hcalin" );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered HCALIN" << std::endl;
@@ -227,11 +271,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // hcalout
   if ( !m_hcalout_node.empty() )
   {
-    m_tree -> Branch( "hcalout_E", &m_hcalout_E, Form("hcalout_E[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalout_isgood", &m_hcalout_isgood, Form("hcalout_isgood[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalout_time", &m_hcalout_time, Form("hcalout_time[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalout_eta", &m_hcalout_eta, Form("hcalout_eta[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalout_phi", &m_hcalout_phi, Form("hcalout_phi[%d][%d]/F", k_ieta, k_iphi) );
+    m_hcalout = BookCalo( kCalo, "hcalout" );
     if ( Verbosity() >  0 ) 
     {
       std::cout << "TreeWriter::Init - Registered HCALOUT" << std::endl;
@@ -241,11 +281,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // cemc sub1
   if ( !m_cemc_sub1_node.empty() ) 
   {
-    m_tree -> Branch( "cemc_sub1_E", &m_cemc_sub1_E, Form("cemc_sub1_E[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_sub1_isgood", &m_cemc_sub1_isgood, Form("cemc_sub1_isgood[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_sub1_time", &m_cemc_sub1_time, Form("cemc_sub1_time[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_sub1_eta", &m_cemc_sub1_eta, Form("cemc_sub1_eta[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "cemc_sub1_phi", &m_cemc_sub1_phi, Form("cemc_sub1_phi[%d][%d]/F", k_ieta, k_iphi) );
+    m_cemc_sub1 = BookCalo( kCaloSub1, "cemc_sub1" );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered CEMC sub1" << std::endl;
@@ -255,11 +291,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // hcalin sub1
   if ( !m_hcalin_sub1_node.empty() )
   {
-    m_tree -> Branch( "hcalin_sub1_E", &m_hcalin_sub1_E, Form("hcalin_sub1_E[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_sub1_isgood", &m_hcalin_sub1_isgood, Form("hcalin_sub1_isgood[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_sub1_time", &m_hcalin_sub1_time, Form("hcalin_sub1_time[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_sub1_eta", &m_hcalin_sub1_eta, Form("hcalin_sub1_eta[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalin_sub1_phi", &m_hcalin_sub1_phi, Form("hcalin_sub1_phi[%d][%d]/F", k_ieta, k_iphi) );
+    m_hcalin_sub1 = BookCalo( kCaloSub1, "hcalin_sub1" );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered HCALIN sub1" << std::endl;
@@ -269,11 +301,7 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // hcalout sub1
   if ( !m_hcalout_sub1_node.empty() )
   {
-    m_tree -> Branch( "hcalout_sub1_E", &m_hcalout_sub1_E, Form("hcalout_sub1_E[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalout_sub1_isgood", &m_hcalout_sub1_isgood, Form("hcalout_sub1_isgood[%d][%d]/F", k_ieta, k_iphi) );   
-    m_tree -> Branch( "hcalout_sub1_time", &m_hcalout_sub1_time, Form("hcalout_sub1_time[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalout_sub1_eta", &m_hcalout_sub1_eta, Form("hcalout_sub1_eta[%d][%d]/F", k_ieta, k_iphi) );
-    m_tree -> Branch( "hcalout_sub1_phi", &m_hcalout_sub1_phi, Form("hcalout_sub1_phi[%d][%d]/F", k_ieta, k_iphi) );
+    m_hcalout_sub1 = BookCalo( kCaloSub1, "hcalout_sub1" );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered HCALOUT sub1" << std::endl;
@@ -283,8 +311,8 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // rho
   for ( unsigned int i = 0; i < m_rho_nodes.size(); ++i ) 
   {
-    m_tree -> Branch( m_rho_nodes[i].c_str(), &m_rho_val[i], (m_rho_nodes[i] + "/F").c_str() );
-    m_tree -> Branch( (m_rho_nodes[i] + "_std").c_str(), &m_std_rho_val[i], (m_rho_nodes[i] + "_std/F").c_str() );
+    m_branches.add( kRho, m_tree, m_rho_nodes[i], &m_rho_val[i], -1 );
+    m_branches.add( kRho, m_tree, m_rho_nodes[i] + "_std", &m_std_rho_val[i], -1 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered rho nodes: " << m_rho_nodes[i] << std::endl;
@@ -296,38 +324,35 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   // towrer background
   if ( m_do_towerbkgd )
   {
-    m_tree -> Branch( "sub1_towerbkgd_cemc", &m_sub1_towerbkgd_cemc, Form("sub1_towerbkgd_cemc[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub1_towerbkgd_hcalin", &m_sub1_towerbkgd_hcalin, Form("sub1_towerbkgd_hcalin[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub1_towerbkgd_hcalout", &m_sub1_towerbkgd_hcalout, Form("sub1_towerbkgd_hcalout[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub2_towerbkgd_cemc", &m_sub2_towerbkgd_cemc, Form("sub2_towerbkgd_cemc[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub2_towerbkgd_hcalin", &m_sub2_towerbkgd_hcalin, Form("sub2_towerbkgd_hcalin[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub2_towerbkgd_hcalout", &m_sub2_towerbkgd_hcalout, Form("sub2_towerbkgd_hcalout[%d]/F", k_ieta) );
-    m_tree -> Branch( "sub1_v2", &m_sub1_v2, "sub1_v2/F" );
-    m_tree -> Branch( "sub2_v2", &m_sub2_v2, "sub2_v2/F" );
-    m_tree -> Branch( "sub1_flowfaliure", &m_sub1_flowfaliure, "sub1_flowfaliure/I" );
-    m_tree -> Branch( "sub2_flowfaliure", &m_sub2_flowfaliure, "sub2_flowfaliure/I" );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_towerbkgd_cemc", &m_sub1_towerbkgd_cemc[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_towerbkgd_hcalin", &m_sub1_towerbkgd_hcalin[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_towerbkgd_hcalout", &m_sub1_towerbkgd_hcalout[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_towerbkgd_cemc", &m_sub2_towerbkgd_cemc[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_towerbkgd_hcalin", &m_sub2_towerbkgd_hcalin[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_towerbkgd_hcalout", &m_sub2_towerbkgd_hcalout[0], { k_ieta }, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_v2", &m_sub1_v2, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_v2", &m_sub2_v2, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_psi2", &m_sub1_psi2, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_psi2", &m_sub2_psi2, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub1_flowfaliure", &m_sub1_flowfaliure, 0 );
+    m_branches.add( kTowerBkgd, m_tree, "sub2_flowfaliure", &m_sub2_flowfaliure, 0 );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "TreeWriter::Init - Registered tower background info" << std::endl;
     }
   }
+  if ( m_write_ue_table )
+  {
+    m_branches.add( kUETable, m_tree, "sub2_ue_table", m_ue_table.data(), { UETable::k_nlayers, UETable::k_neta, UETable::k_nphi }, 0 );
+  }
   // seeds
   if ( !m_rawseed_node.empty() ) 
   {
-    m_tree -> Branch( "raw_seed_E", &m_raw_seed_E );
-    m_tree -> Branch( "raw_seed_phi", &m_raw_seed_phi );
-    m_tree -> Branch( "raw_seed_eta", &m_raw_seed_eta );
-    m_tree -> Branch( "raw_seed_pT", &m_raw_seed_pT );
-    m_tree -> Branch( "raw_seed_avg_super_E", &m_mean_super_tower_E );
-    m_tree -> Branch( "raw_seed_max_super_E", &m_max_super_tower_E );
-    m_tree -> Branch( "raw_seed_comp_ieta", &m_raw_seed_comp_ieta );
-    m_tree -> Branch( "raw_seed_comp_iphi", &m_raw_seed_comp_iphi );
-    m_tree -> Branch( "raw_seed_comp_caloid", &m_raw_seed_comp_caloid );
-    m_tree -> Branch( "raw_seed_comp_status", &m_raw_seed_comp_status );
-    m_tree -> Branch( "raw_seed_comp_E", &m_raw_seed_comp_E );
-    m_tree -> Branch( "raw_seed_comp_eta", &m_raw_seed_comp_eta );
-    m_tree -> Branch( "raw_seed_comp_phi", &m_raw_seed_comp_phi );
-    m_tree -> Branch( "raw_seed_super_tower_E", &m_raw_seed_super_tower_E );
+    BookJet( kSeed, m_tree, "raw_seed", m_raw_seed );
+    m_raw_seed.avg_super_E = m_branches.add( kSeed, m_tree, "raw_seed_avg_super_E", m_raw_seed.avg_super_E );
+    m_raw_seed.max_super_E = m_branches.add( kSeed, m_tree, "raw_seed_max_super_E", m_raw_seed.max_super_E );
+    BookJetComponents( kSeed, m_tree, "raw_seed", m_raw_seed );
+    m_raw_seed.super_tower_E = m_branches.add( kSeed, m_tree, "raw_seed_super_tower_E", m_raw_seed.super_tower_E );
 
     if ( Verbosity() > 0 ) 
     {
@@ -340,18 +365,9 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   {
 
     m_raw_jet_trees[i] = new TTree( m_rawjet_nodes[i].c_str(), m_rawjet_nodes[i].c_str() );
-    m_raw_jet_trees[i] -> Branch( "event_id", &m_event_id, "event_id/I" );
-    m_raw_jet_trees[i] -> Branch( "jet_E", &m_raw_jet_E );
-    m_raw_jet_trees[i] -> Branch( "jet_phi", &m_raw_jet_phi );
-    m_raw_jet_trees[i] -> Branch( "jet_eta", &m_raw_jet_eta );
-    m_raw_jet_trees[i] -> Branch( "jet_pT", &m_raw_jet_pT );
-    m_raw_jet_trees[i] -> Branch( "jet_comp_ieta", &m_raw_jet_comp_ieta );
-    m_raw_jet_trees[i] -> Branch( "jet_comp_iphi", &m_raw_jet_comp_iphi );
-    m_raw_jet_trees[i] -> Branch( "jet_comp_caloid", &m_raw_jet_comp_caloid );
-    m_raw_jet_trees[i] -> Branch( "jet_comp_status", &m_raw_jet_comp_status );
-    m_raw_jet_trees[i] -> Branch( "jet_comp_E", &m_raw_jet_comp_E );
-    m_raw_jet_trees[i] -> Branch( "jet_comp_eta", &m_raw_jet_comp_eta );
-    m_raw_jet_trees[i] -> Branch( "jet_comp_phi", &m_raw_jet_comp_phi );
+    m_branches.bind( m_raw_jet_trees[i], "event_id", &m_event_id );
+    BookJet( kRawJet, m_raw_jet_trees[i], "jet", m_raw_jet );
+    BookJetComponents( kRawJet, m_raw_jet_trees[i], "jet", m_raw_jet );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "AnaTreeWriter::Init - Registered Jet nodes: " << m_rawjet_nodes[i] << std::endl;
@@ -362,20 +378,11 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   for ( unsigned int i = 0; i < m_sub1jet_nodes.size(); ++i ) 
   {
     m_sub1_jet_trees[i] = new TTree( m_sub1jet_nodes[i].c_str(), m_sub1jet_nodes[i].c_str() );
-    m_sub1_jet_trees[i] -> Branch( "event_id", &m_event_id, "event_id/I" );
-    m_sub1_jet_trees[i] -> Branch( "jet_E", &m_sub1_jet_E );
-    m_sub1_jet_trees[i] -> Branch( "jet_phi", &m_sub1_jet_phi );
-    m_sub1_jet_trees[i] -> Branch( "jet_eta", &m_sub1_jet_eta );
-    m_sub1_jet_trees[i] -> Branch( "jet_pT", &m_sub1_jet_pT );
-    m_sub1_jet_trees[i] -> Branch( "jet_unsub_pT", &m_sub1_jet_unsub_pT );
-    m_sub1_jet_trees[i] -> Branch( "jet_unsub_E", &m_sub1_jet_unsub_E );
-    m_sub1_jet_trees[i] -> Branch( "jet_comp_ieta", &m_sub1_jet_comp_ieta );
-    m_sub1_jet_trees[i] -> Branch( "jet_comp_iphi", &m_sub1_jet_comp_iphi );
-    m_sub1_jet_trees[i] -> Branch( "jet_comp_caloid", &m_sub1_jet_comp_caloid );
-    m_sub1_jet_trees[i] -> Branch( "jet_comp_status", &m_sub1_jet_comp_status );
-    m_sub1_jet_trees[i] -> Branch( "jet_comp_E", &m_sub1_jet_comp_E );
-    m_sub1_jet_trees[i] -> Branch( "jet_comp_eta", &m_sub1_jet_comp_eta );
-    m_sub1_jet_trees[i] -> Branch( "jet_comp_phi", &m_sub1_jet_comp_phi );
+    m_branches.bind( m_sub1_jet_trees[i], "event_id", &m_event_id );
+    BookJet( kSub1Jet, m_sub1_jet_trees[i], "jet", m_sub1_jet );
+    m_sub1_jet.unsub_pT = m_branches.add( kSub1Jet, m_sub1_jet_trees[i], "jet_unsub_pT", m_sub1_jet.unsub_pT );
+    m_sub1_jet.unsub_E = m_branches.add( kSub1Jet, m_sub1_jet_trees[i], "jet_unsub_E", m_sub1_jet.unsub_E );
+    BookJetComponents( kSub1Jet, m_sub1_jet_trees[i], "jet", m_sub1_jet );
     if ( Verbosity() > 0 ) 
     {
       std::cout << "AnaTreeWriter::Init - Registered Jet nodes: " << m_sub1jet_nodes[i] << std::endl;
@@ -386,11 +393,8 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   for ( unsigned int i = 0; i < m_truthjet_nodes.size(); ++i ) 
   {
     m_truth_jet_trees[i] = new TTree( m_truthjet_nodes[i].c_str(), m_truthjet_nodes[i].c_str() );
-    m_truth_jet_trees[i] -> Branch( "event_id", &m_event_id, "event_id/I" );
-    m_truth_jet_trees[i] -> Branch( "jet_E", &m_truth_jet_E );
-    m_truth_jet_trees[i] -> Branch( "jet_phi", &m_truth_jet_phi );
-    m_truth_jet_trees[i] -> Branch( "jet_eta", &m_truth_jet_eta );
-    m_truth_jet_trees[i] -> Branch( "jet_pT", &m_truth_jet_pT );
+    m_branches.bind( m_truth_jet_trees[i], "event_id", &m_event_id );
+    BookJet( kTruthJet, m_truth_jet_trees[i], "jet", m_truth_jet );
 
     if ( Verbosity() > 0 ) 
     {
@@ -400,28 +404,28 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
 
   if ( !m_g4truth_node.empty() )
   {
-    m_tree -> Branch( "g4truth_zvtx", &m_g4truth_zvtx, "g4truth_zvtx/F" );
-    m_tree -> Branch( "g4truth_id", &m_g4truth_id );
-    m_tree -> Branch( "g4truth_status", &m_g4truth_status );
-    m_tree -> Branch( "g4truth_px", &m_g4truth_px );
-    m_tree -> Branch( "g4truth_py", &m_g4truth_py );
-    m_tree -> Branch( "g4truth_pz", &m_g4truth_pz );
-    m_tree -> Branch( "g4truth_E", &m_g4truth_E );
-    m_tree -> Branch( "g4truth_eta", &m_g4truth_eta );
-    m_tree -> Branch( "g4truth_phi", &m_g4truth_phi );
-    m_tree -> Branch( "g4truth_pT", &m_g4truth_pT );
+    m_branches.add( kG4Truth, m_tree, "g4truth_zvtx", &m_g4truth_zvtx, -999 );
+    m_branches.add( kG4Truth, m_tree, "g4truth_id", &m_g4truth_id );
+    m_branches.add( kG4Truth, m_tree, "g4truth_status", &m_g4truth_status );
+    m_branches.add( kG4Truth, m_tree, "g4truth_px", &m_g4truth_px );
+    m_branches.add( kG4Truth, m_tree, "g4truth_py", &m_g4truth_py );
+    m_branches.add( kG4Truth, m_tree, "g4truth_pz", &m_g4truth_pz );
+    m_branches.add( kG4Truth, m_tree, "g4truth_E", &m_g4truth_E );
+    m_branches.add( kG4Truth, m_tree, "g4truth_eta", &m_g4truth_eta );
+    m_branches.add( kG4Truth, m_tree, "g4truth_phi", &m_g4truth_phi );
+    m_branches.add( kG4Truth, m_tree, "g4truth_pT", &m_g4truth_pT );
     if ( m_do_flow )
     {
-      m_tree -> Branch( "g4truth_v2", &m_g4truth_v2 );
-      m_tree -> Branch( "g4truth_v3", &m_g4truth_v3 );
-      m_tree -> Branch( "g4truth_v4", &m_g4truth_v4 );
-      m_tree -> Branch( "g4truth_v5", &m_g4truth_v5 );
-      m_tree -> Branch( "g4truth_v6", &m_g4truth_v6 );
-      m_tree -> Branch( "m_g4truth_v2reco", &m_g4truth_v2reco );
-      m_tree -> Branch( "m_g4truth_v3reco", &m_g4truth_v3reco );
-      m_tree -> Branch( "m_g4truth_v4reco", &m_g4truth_v4reco );
-      m_tree -> Branch( "m_g4truth_v5reco", &m_g4truth_v5reco );
-      m_tree -> Branch( "m_g4truth_v6reco", &m_g4truth_v6reco );
+      m_branches.add( kG4Truth, m_tree, "g4truth_v2", &m_g4truth_v2 );
+      m_branches.add( kG4Truth, m_tree, "g4truth_v3", &m_g4truth_v3 );
+      m_branches.add( kG4Truth, m_tree, "g4truth_v4", &m_g4truth_v4 );
+      m_branches.add( kG4Truth, m_tree, "g4truth_v5", &m_g4truth_v5 );
+      m_branches.add( kG4Truth, m_tree, "g4truth_v6", &m_g4truth_v6 );
+      m_branches.add( kG4Truth, m_tree, "m_g4truth_v2reco", &m_g4truth_v2reco, -999 );
+      m_branches.add( kG4Truth, m_tree, "m_g4truth_v3reco", &m_g4truth_v3reco, -999 );
+      m_branches.add( kG4Truth, m_tree, "m_g4truth_v4reco", &m_g4truth_v4reco, -999 );
+      m_branches.add( kG4Truth, m_tree, "m_g4truth_v5reco", &m_g4truth_v5reco, -999 );
+      m_branches.add( kG4Truth, m_tree, "m_g4truth_v6reco", &m_g4truth_v6reco, -999 );
     }
   
     if ( Verbosity() > 0 ) 
@@ -431,6 +435,16 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   }
 
   m_rand = new TRandom3(0);
+
+  // start the first event from the reset values
+  m_branches.reset();
+
+  // event tree first, its entries go to the checkpoint record
+  m_checkpoint.add_tree( m_tree );
+  for ( unsigned int i = 0; i < m_rawjet_nodes.size(); ++i ) { m_checkpoint.add_tree( m_raw_jet_trees[i] ); }
+  for ( unsigned int i = 0; i < m_sub1jet_nodes.size(); ++i ) { m_checkpoint.add_tree( m_sub1_jet_trees[i] ); }
+  for ( unsigned int i = 0; i < m_truthjet_nodes.size(); ++i ) { m_checkpoint.add_tree( m_truth_jet_trees[i] ); }
+
   if ( Verbosity () > 0 )
   {
     std::cout << "TreeWriter::Init - done" << std::endl;
@@ -439,9 +453,39 @@ int TreeWriter::Init( PHCompositeNode * /*topNode*/ )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int TreeWriter::InitRun( PHCompositeNode * /*topNode*/ )
+{
+  m_nodes.clear();
+  m_super_towers.clear_geometry();
+  m_ue_table.clear_geometry();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int TreeWriter::process_event( PHCompositeNode *topNode )
 {
 
+  if ( m_checkpoint.skip_event() ) 
+  { // written by the part we resume from
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  if ( !m_stream.empty() ) 
+  { // events of other streams are not written and not counted
+    auto record = m_nodes.get<EventCutRecord>( topNode, m_record_node );
+    if ( !record ) 
+    {
+      std::cout << PHWHERE << " " << m_record_node << " node missing, needed for stream " << m_stream << ". Abort." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    const int istream = record->find_stream( m_stream );
+    if ( istream < 0 ) 
+    { // stream names are not written out, the selector has to run in this job
+      std::cout << PHWHERE << " stream " << m_stream << " not defined in " << m_record_node << ". Abort." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    if ( !( ( record->get_stream_mask() >> istream ) & 1U ) ) { return Fun4AllReturnCodes::EVENT_OK; }
+  }
+
   m_event_id++; 
 
   
@@ -531,6 +575,12 @@ int TreeWriter::process_event( PHCompositeNode *topNode )
   }
   
 
+  if ( m_sub1jet_nodes.size() > 0 || m_write_ue_table )
+  { // per tower background, once per event
+    auto res = GetUETable(topNode);
+    if ( res != Fun4AllReturnCodes::EVENT_OK ) { return res; }
+  }
+
   for ( unsigned int i = 0; i < m_sub1jet_nodes.size(); ++i ) 
   { // reset sub1 jet info
     auto res = GetSub1JetInfo(topNode, i);
@@ -550,7 +600,8 @@ int TreeWriter::process_event( PHCompositeNode *topNode )
   }
 
   // fill tree
-  m_tree->Fill();
+  m_branches.fill( m_tree );
+  m_checkpoint.filled( m_event_id );
   
   return Fun4AllReturnCodes::EVENT_OK;
 
@@ -567,21 +618,24 @@ int TreeWriter::End( PHCompositeNode * /*topNode*/ )
 
   PHTFileServer::get().cd(m_output_filename); 
 
-  m_tree->Write();
+  m_branches.write( m_tree );
   for ( unsigned int i = 0; i < m_rawjet_nodes.size(); ++i ) 
   {
-    m_raw_jet_trees[i]->Write();
+    m_branches.write( m_raw_jet_trees[i] );
   }
   for ( unsigned int i = 0; i < m_sub1jet_nodes.size(); ++i ) 
   {
-    m_sub1_jet_trees[i]->Write();
+    m_branches.write( m_sub1_jet_trees[i] );
   }
   for (unsigned int i = 0; i < m_truthjet_nodes.size(); ++i ) 
   {
-    m_truth_jet_trees[i]->Write();
+    m_branches.write( m_truth_jet_trees[i] );
   }
 
-  m_nevents = m_event_id+1;
+  // event ids continue across resumed parts, only the part that
+  // completes writes the RunTree and counts the whole job
+  m_nevents = m_event_id + 1;
+  m_run_number = recoConsts::instance()->get_IntFlag( "RUNNUMBER" );
   m_run_tree->Fill();
   m_run_tree->Write();
 
@@ -591,6 +645,7 @@ int TreeWriter::End( PHCompositeNode * /*topNode*/ )
     std::cout << "TreeWriter::EndRun - Writing run tree" << std::endl;
   }
   PHTFileServer::get().close();
+  m_checkpoint.finish();
  
   if ( Verbosity () > 0 ) 
   {
@@ -603,8 +658,8 @@ int TreeWriter::End( PHCompositeNode * /*topNode*/ )
 int TreeWriter::GetGL1( PHCompositeNode *topNode )
 {
 
-  ResetGL1();
-  auto gl1 = findNode::getClass< Gl1Packetv2 >( topNode, m_gl1_node );
+  m_branches.reset( kGL1 );
+  auto gl1 = m_nodes.get<Gl1Packetv2>( topNode, m_gl1_node );
   if( !gl1 ) 
   {
     std::cout << PHWHERE << " No GL1 packet found! Abort." << std::endl;
@@ -623,40 +678,40 @@ int TreeWriter::GetGL1( PHCompositeNode *topNode )
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+EventSummary * TreeWriter::GetEventSummary( PHCompositeNode *topNode )
+{
+  // only used when EventSummaryReco did not fill the summary first
+  EventSummaryReco::InputNodes inputs;
+  if ( !m_zvrtx_node.empty() ) { inputs.vertex = m_zvrtx_node; }
+  if ( !m_cent_node.empty() ) { inputs.centrality = m_cent_node; }
+  if ( !m_mbd_node.empty() ) { inputs.mbd = m_mbd_node; }
+  if ( !m_eventhead_node.empty() ) { inputs.eventheader = m_eventhead_node; }
+
+  auto summary = EventSummaryReco::GetSummary( topNode, m_nodes, "EventSummary", inputs );
+  if ( !summary )
+  {
+    std::cout << PHWHERE << " EventSummary node missing, Abort!." << std::endl;
+  }
+  return summary;
+}
+
 int TreeWriter::GetZvtx( PHCompositeNode *topNode )
 {
     // get zvtx
-    ResetZvtx();
-    auto vertexmap = findNode::getClass<GlobalVertexMap>( topNode, m_zvrtx_node );
-    if ( !vertexmap  || vertexmap->empty() ) 
+    m_branches.reset( kZvtx );
+    auto summary = GetEventSummary( topNode );
+    if ( !summary ) { return Fun4AllReturnCodes::ABORTRUN; }
+
+    // missing vertices are counted and reported by EventSummaryReco
+    if ( summary->get_vertex_status() == EventSummary::kVERTEX_MISSING ) 
     {
-      std::cout << PHWHERE << "" << m_zvrtx_node << " node missing, skipping event." << std::endl;
       return Fun4AllReturnCodes::EVENT_OK;
     }
-    // for 
-    // loop over all global vertices and identify
-    // for ( size_t i = 0; i < vertexmap->size(); ++i ) 
-    // {
-    //   auto vtxpair = vertexmap->get(i);
-    //   std::cout << "Vertex ID: " << vtxpair->get_id() << " Details (x,y,z): \n" ;
-    //   vtxpair->identify();
-    // }
-    
-    auto vtx = vertexmap->begin()->second;
-    m_zvtx = NAN;
-    if ( vtx ) 
-    {
-      m_zvtx = vtx->get_z();
-    } 
 
-    if ( std::isnan(m_zvtx) || m_zvtx > 1e3) 
+    m_zvtx = summary->get_zvtx();
+    if ( !summary->has_good_vertex() ) 
     {
-      static bool once = true;
-      if (once) 
-      {
-        once = false;
-        std::cout << PHWHERE << "vertex is " << m_zvtx << ". Drop all tower inputs (further vertex warning will be suppressed)." << std::endl;
-      }
+      // drop all tower inputs
       return Fun4AllReturnCodes::ABORTEVENT;
     }
 
@@ -672,23 +727,15 @@ int TreeWriter::GetZvtx( PHCompositeNode *topNode )
 int TreeWriter::GetCentInfo( PHCompositeNode *topNode )
 {
   // get centrality
-  ResetCent();
-  auto cent_node = findNode::getClass< CentralityInfo >( topNode, m_cent_node );
-  if ( !cent_node ) 
+  m_branches.reset( kCent );
+  auto summary = GetEventSummary( topNode );
+  if ( !summary || !summary->has( EventSummary::kCENTRALITY ) ) 
   {
     std::cout << PHWHERE << m_cent_node << " node missing, Abort!." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  if ( cent_node ) 
-  {
-    m_cent = (int)(cent_node->get_centrality_bin(CentralityInfo::PROP::mbd_NS));
-  } 
-  else 
-  {
-    std::cout << PHWHERE << "CentralityInfo is missing." << std::endl;
-  }
-  
+  m_cent = summary->get_centrality();
 
   if ( Verbosity() > 1 ) 
   {
@@ -702,25 +749,21 @@ int TreeWriter::GetMbdInfo( PHCompositeNode *topNode )
 {
   
   // get MBD info
-  ResetMbd();
-  auto mbd = findNode::getClass<MbdOutV2>( topNode, m_mbd_node );
-  if ( !mbd ) 
+  m_branches.reset( kMbd );
+  auto summary = GetEventSummary( topNode );
+  if ( !summary ) { return Fun4AllReturnCodes::ABORTRUN; }
+  if ( !summary->has( EventSummary::kMBD ) ) 
   {
-    static bool once = true;
-    if ( once ) 
-    {
-      std::cout << PHWHERE << m_mbd_node << " node missing, supressing further warnings." << std::endl;
-      once = false;
-    }
+    // reported once by EventSummaryReco
     return Fun4AllReturnCodes::EVENT_OK; // skipping event
   }
 
-  m_mbd_q_N = mbd->get_q(k_mbd_north_code);
-  m_mbd_q_S = mbd->get_q(k_mbd_south_code);
-  m_mbd_t_N = mbd->get_time(k_mbd_north_code);
-  m_mbd_t_S = mbd->get_time(k_mbd_south_code);
-  m_mbd_n_N = mbd->get_npmt(k_mbd_north_code);
-  m_mbd_n_S = mbd->get_npmt(k_mbd_south_code);
+  m_mbd_q_N = summary->get_mbd_q(k_mbd_north_code);
+  m_mbd_q_S = summary->get_mbd_q(k_mbd_south_code);
+  m_mbd_t_N = summary->get_mbd_t(k_mbd_north_code);
+  m_mbd_t_S = summary->get_mbd_t(k_mbd_south_code);
+  m_mbd_n_N = summary->get_mbd_npmt(k_mbd_north_code);
+  m_mbd_n_S = summary->get_mbd_npmt(k_mbd_south_code);
   
 
   if ( Verbosity() > 1 )
@@ -735,25 +778,25 @@ int TreeWriter::GetMbdInfo( PHCompositeNode *topNode )
 int TreeWriter::GetEventHeaderInfo( PHCompositeNode *topNode )
 {
   // get event header info
-  ResetEventHeader();
-  auto eventhead = findNode::getClass<EventHeader>( topNode, m_eventhead_node );
-  if ( !eventhead ) 
+  m_branches.reset( kEventHeader );
+  auto summary = GetEventSummary( topNode );
+  if ( !summary || !summary->has( EventSummary::kEVENTHEADER ) ) 
   {
     std::cout << PHWHERE << " Input node " << m_eventhead_node << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  m_b = eventhead->get_ImpactParameter();
-  m_ep_angle = eventhead->get_EventPlaneAngle();
-  m_ecc = eventhead->get_eccentricity();
-  m_psi1 = eventhead->get_FlowPsiN(1);
-  m_psi2 = eventhead->get_FlowPsiN(2);
-  m_psi3 = eventhead->get_FlowPsiN(3);
-  m_psi4 = eventhead->get_FlowPsiN(4);
-  m_psi5 = eventhead->get_FlowPsiN(5);
-  m_psi6 = eventhead->get_FlowPsiN(6);
-  m_ncoll = eventhead->get_ncoll();
-  m_npart = eventhead->get_npart();
+  m_b = summary->get_b();
+  m_ep_angle = summary->get_ep_angle();
+  m_ecc = summary->get_ecc();
+  m_psi1 = summary->get_psi(1);
+  m_psi2 = summary->get_psi(2);
+  m_psi3 = summary->get_psi(3);
+  m_psi4 = summary->get_psi(4);
+  m_psi5 = summary->get_psi(5);
+  m_psi6 = summary->get_psi(6);
+  m_ncoll = summary->get_ncoll();
+  m_npart = summary->get_npart();
   
   if ( Verbosity() > 1 ) 
   {
@@ -766,12 +809,12 @@ int TreeWriter::GetEventHeaderInfo( PHCompositeNode *topNode )
 int TreeWriter::GetRhoInfo( PHCompositeNode *topNode )
 {
 
-  ResetRhoArrays();
+  m_branches.reset( kRho );
   // get rho nodes
   for ( unsigned int i = 0; i < m_rho_nodes.size(); ++i ) 
   {
 
-    auto rho = findNode::getClass<TowerRhov1>(topNode, m_rho_nodes[i]);
+    auto rho = m_nodes.get<TowerRhov1>(topNode, m_rho_nodes[i]);
     if ( !rho ) 
     {
       std::cout << PHWHERE << " Input node " << m_rho_nodes[i] << " Node missing, doing nothing." << std::endl;
@@ -797,12 +840,12 @@ int TreeWriter::GetRhoInfo( PHCompositeNode *topNode )
 int TreeWriter::GetRawCaloInfo( PHCompositeNode *topNode )
 {
 
-  ResetCaloArrays();
+  m_branches.reset( kCalo );
 
   // get tower info containers
-  auto towerinfosEM3 = findNode::getClass< TowerInfoContainer >( topNode, m_cemc_node);
-  auto towerinfosIH3 = findNode::getClass< TowerInfoContainer >( topNode, m_hcalin_node);
-  auto towerinfosOH3 = findNode::getClass< TowerInfoContainer >( topNode, m_hcalout_node);
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, m_cemc_node);
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, m_hcalin_node);
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, m_hcalout_node);
   if( !towerinfosIH3 && !m_cemc_node.empty() )
   {
     std::cout << PHWHERE << " TowerInfoContainer for CEMC is missing, doing nothing." << std::endl;
@@ -820,9 +863,9 @@ int TreeWriter::GetRawCaloInfo( PHCompositeNode *topNode )
   }
 
   // get geometry containers
-  auto geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  auto geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
-  auto geomEM = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
+  auto geomEM = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
   if ( !geomIH && !m_hcalin_node.empty() )
   {
     std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN is missing, doing nothing." << std::endl;
@@ -840,7 +883,7 @@ int TreeWriter::GetRawCaloInfo( PHCompositeNode *topNode )
   }
 
   // fill EMCal
-  if ( towerinfosEM3 )
+  if ( towerinfosEM3 && m_cemc.booked() )
   {
    
     unsigned int ntowers = towerinfosEM3->size();
@@ -858,15 +901,11 @@ int TreeWriter::GetRawCaloInfo( PHCompositeNode *topNode )
       float this_E = tower->get_energy();
       float this_time = tower->get_time();
 
-      m_cemc_E[ieta][iphi] = this_E;
-      m_cemc_isgood[ieta][iphi] = this_isgood;
-      m_cemc_time[ieta][iphi] = this_time;
-      m_cemc_eta[ieta][iphi] = this_eta;
-      m_cemc_phi[ieta][iphi] = this_phi;
+      m_cemc.set( ieta, iphi, this_E, this_isgood, this_time, this_eta, this_phi );
     }
   }
   // fill HCalIN
-  if ( towerinfosIH3 )
+  if ( towerinfosIH3 && m_hcalin.booked() )
   {
     unsigned int ntowers = towerinfosIH3->size();
     for ( unsigned int ichannel = 0; ichannel < ntowers; ichannel++ ) 
@@ -883,15 +922,11 @@ int TreeWriter::GetRawCaloInfo( PHCompositeNode *topNode )
       float this_E = tower->get_energy();
       float this_time = tower->get_time();
 
-      m_hcalin_E[ieta][iphi] = this_E;
-      m_hcalin_isgood[ieta][iphi] = this_isgood;
-      m_hcalin_time[ieta][iphi] = this_time;
-      m_hcalin_eta[ieta][iphi] = this_eta;
-      m_hcalin_phi[ieta][iphi] = this_phi;
+      m_hcalin.set( ieta, iphi, this_E, this_isgood, this_time, this_eta, this_phi );
     }
   }
   // fill HCalOUT
-  if ( towerinfosOH3 )
+  if ( towerinfosOH3 && m_hcalout.booked() )
   {
     unsigned int ntowers = towerinfosOH3->size();
     for ( unsigned int ichannel = 0; ichannel < ntowers; ichannel++ ) 
@@ -907,11 +942,7 @@ int TreeWriter::GetRawCaloInfo( PHCompositeNode *topNode )
       float this_E = tower->get_energy();
       float this_time = tower->get_time();
 
-      m_hcalout_E[ieta][iphi] = this_E;
-      m_hcalout_isgood[ieta][iphi] = this_isgood;
-      m_hcalout_time[ieta][iphi] = this_time;
-      m_hcalout_eta[ieta][iphi] = this_eta;
-      m_hcalout_phi[ieta][iphi] = this_phi;
+      m_hcalout.set( ieta, iphi, this_E, this_isgood, this_time, this_eta, this_phi );
     }
   }
   
@@ -928,13 +959,13 @@ int TreeWriter::GetRawCaloInfo( PHCompositeNode *topNode )
 int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
 {
 
-  ResetCaloSub1Arrays();
+  m_branches.reset( kCaloSub1 );
     
   
   // get tower info containers
-  auto towerinfosEM3 = findNode::getClass< TowerInfoContainer >( topNode, m_cemc_sub1_node);
-  auto towerinfosIH3 = findNode::getClass< TowerInfoContainer >( topNode, m_hcalin_sub1_node);
-  auto towerinfosOH3 = findNode::getClass< TowerInfoContainer >( topNode, m_hcalout_sub1_node);
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, m_cemc_sub1_node);
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, m_hcalin_sub1_node);
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, m_hcalout_sub1_node);
   if( !towerinfosIH3 && !m_cemc_sub1_node.empty() )
   {
     std::cout << PHWHERE << " TowerInfoContainer for CEMC sub1 is missing, doing nothing." << std::endl;
@@ -952,9 +983,9 @@ int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
   }
   
   // get geometry containers
-  auto geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  auto geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
-  auto geomEM = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
+  auto geomEM = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
   if ( !geomIH && !m_hcalin_sub1_node.empty() )
   {
     std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN is missing, doing nothing." << std::endl;
@@ -973,7 +1004,7 @@ int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
 
 
   // fill EMCal
-  if ( towerinfosEM3 )
+  if ( towerinfosEM3 && m_cemc_sub1.booked() )
   {
    
     unsigned int ntowers = towerinfosEM3->size();
@@ -991,15 +1022,11 @@ int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
       float this_E = tower->get_energy();
       float this_time = tower->get_time();
 
-      m_cemc_sub1_E[ieta][iphi] = this_E;
-      m_cemc_sub1_isgood[ieta][iphi] = this_isgood;
-      m_cemc_sub1_time[ieta][iphi] = this_time;
-      m_cemc_sub1_eta[ieta][iphi] = this_eta;
-      m_cemc_sub1_phi[ieta][iphi] = this_phi;
+      m_cemc_sub1.set( ieta, iphi, this_E, this_isgood, this_time, this_eta, this_phi );
     }
   }
   // fill HCalIN
-  if ( towerinfosIH3 )
+  if ( towerinfosIH3 && m_hcalin_sub1.booked() )
   {
     unsigned int ntowers = towerinfosIH3->size();
     for ( unsigned int ichannel = 0; ichannel < ntowers; ichannel++ ) 
@@ -1016,15 +1043,11 @@ int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
       float this_E = tower->get_energy();
       float this_time = tower->get_time();
 
-      m_hcalin_sub1_E[ieta][iphi] = this_E;
-      m_hcalin_sub1_isgood[ieta][iphi] = this_isgood;
-      m_hcalin_sub1_time[ieta][iphi] = this_time;
-      m_hcalin_sub1_eta[ieta][iphi] = this_eta;
-      m_hcalin_sub1_phi[ieta][iphi] = this_phi;
+      m_hcalin_sub1.set( ieta, iphi, this_E, this_isgood, this_time, this_eta, this_phi );
     }
   }
   // fill HCalOUT
-  if ( towerinfosOH3 )
+  if ( towerinfosOH3 && m_hcalout_sub1.booked() )
   {
     unsigned int ntowers = towerinfosOH3->size();
     for ( unsigned int ichannel = 0; ichannel < ntowers; ichannel++ ) 
@@ -1040,11 +1063,7 @@ int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
       float this_E = tower->get_energy();
       float this_time = tower->get_time();
 
-      m_hcalout_sub1_E[ieta][iphi] = this_E;
-      m_hcalout_sub1_isgood[ieta][iphi] = this_isgood;
-      m_hcalout_sub1_time[ieta][iphi] = this_time;
-      m_hcalout_sub1_eta[ieta][iphi] = this_eta;
-      m_hcalout_sub1_phi[ieta][iphi] = this_phi;
+      m_hcalout_sub1.set( ieta, iphi, this_E, this_isgood, this_time, this_eta, this_phi );
     }
   }
   
@@ -1061,7 +1080,7 @@ int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
 // int TreeWriter::GetTowerBkgdInfo( PHCompositeNode *topNode )
 // {
 
-//   ResetTowerBkgd();
+//   m_branches.reset( kTowerBkgd );
   
 //   auto tower_background_sub1 = findNode::getClass<TowerBackgroundv1>(topNode, m_towerbkgd_node_sub1);
 //   if ( !tower_background_sub1 )
@@ -1113,15 +1132,15 @@ int TreeWriter::GetSubCaloInfo( PHCompositeNode *topNode )
 int TreeWriter::GetTowerBkgdInfo( PHCompositeNode *topNode )
 {
 
-  ResetTowerBkgd();
+  m_branches.reset( kTowerBkgd );
   
-  auto tower_background_sub1 = findNode::getClass<TowerBackgroundv1>(topNode, m_towerbkgd_node_sub1);
+  auto tower_background_sub1 = m_nodes.get<TowerBackgroundv1>(topNode, m_towerbkgd_node_sub1);
   if ( !tower_background_sub1 )
   {
     std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
-  auto tower_background_sub2 = findNode::getClass<TowerBackgroundv1>(topNode, m_towerbkgd_node_sub2);
+  auto tower_background_sub2 = m_nodes.get<TowerBackgroundv1>(topNode, m_towerbkgd_node_sub2);
   if ( !tower_background_sub2 )
   {
     std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
@@ -1130,6 +1149,8 @@ int TreeWriter::GetTowerBkgdInfo( PHCompositeNode *topNode )
 
   m_sub1_v2 = tower_background_sub1->get_v2();
   m_sub2_v2 = tower_background_sub2->get_v2();
+  m_sub1_psi2 = tower_background_sub1->get_Psi2();
+  m_sub2_psi2 = tower_background_sub2->get_Psi2();
   m_sub1_flowfaliure = tower_background_sub1->get_flow_failure_flag() == true ? 1 : 0;
   m_sub2_flowfaliure = tower_background_sub2->get_flow_failure_flag() == true ? 1 : 0;
   for ( int ilayer = 0 ; ilayer < 3; ilayer++ )
@@ -1171,12 +1192,12 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
 {
 
 
-  ResetRawSeed();
+  m_branches.reset( kSeed );
 
   // get tower info containers
-  auto towerinfosEM3 = findNode::getClass< TowerInfoContainer >( topNode, m_cemc_node);
-  auto towerinfosIH3 = findNode::getClass< TowerInfoContainer >( topNode, m_hcalin_node);
-  auto towerinfosOH3 = findNode::getClass< TowerInfoContainer >( topNode, m_hcalout_node);
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, m_cemc_node);
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, m_hcalin_node);
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, m_hcalout_node);
   if( !towerinfosIH3 || !towerinfosOH3 || !towerinfosEM3 )
   {
     std::cout
@@ -1191,15 +1212,15 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
   }
   
   // get geometry containers
-  auto geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  auto geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
   if ( !geomIH || !geomOH ) 
   {
     std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
   
-  auto seeds = findNode::getClass<JetContainer>( topNode, m_rawseed_node );
+  auto seeds = m_nodes.get<JetContainer>( topNode, m_rawseed_node );
   if ( !seeds )
   {
     std::cout << PHWHERE << " Input node " << m_rawseed_node << " Node missing, doing nothing." << std::endl;
@@ -1215,7 +1236,7 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
     float this_phi = seed->get_phi();
     float this_e = seed->get_e();
 
-    std::map < int, double > constituent_ETsum {} ;
+    m_super_towers.clear();
     std::vector<int> tower_ieta {};
     std::vector<int> tower_iphi {};
     std::vector<int> tower_caloid {};
@@ -1233,6 +1254,7 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
       float this_comp_eT = 0;
       float this_comp_eta = 0;
       float this_comp_phi = 0;
+      double this_comp_cosh = 1;
       int this_comp_status = -1;
       int this_comp_caloid = comp.first;
 
@@ -1246,15 +1268,9 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
         unsigned int towerkey = towerinfosEM3->encode_key( comp.second );
         this_comp_ieta = towerinfosEM3->getTowerEtaBin(towerkey);
         this_comp_iphi = towerinfosEM3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALIN,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomIH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
+        m_super_towers.get_geometry( 0, this_comp_ieta, this_comp_iphi, geomIH, this_comp_eta, this_comp_phi, this_comp_cosh );
         this_comp_E = tower->get_energy();
-        this_comp_eT = this_comp_E / cosh(this_comp_eta);
+        this_comp_eT = this_comp_E / this_comp_cosh;
         this_comp_status = tower->get_isGood();
       }
       else if ( is_hcalin )
@@ -1264,15 +1280,9 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
         unsigned int towerkey = towerinfosIH3->encode_key( comp.second );
         this_comp_ieta = towerinfosIH3->getTowerEtaBin(towerkey);
         this_comp_iphi = towerinfosIH3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALIN,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomIH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
+        m_super_towers.get_geometry( 0, this_comp_ieta, this_comp_iphi, geomIH, this_comp_eta, this_comp_phi, this_comp_cosh );
         this_comp_E = tower->get_energy();
-        this_comp_eT = this_comp_E / cosh(this_comp_eta);
+        this_comp_eT = this_comp_E / this_comp_cosh;
         this_comp_status = tower->get_isGood();
       }
       else if ( is_hcalout )
@@ -1282,15 +1292,9 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
         unsigned int towerkey = towerinfosOH3->encode_key( comp.second );
         this_comp_ieta = towerinfosOH3->getTowerEtaBin(towerkey);
         this_comp_iphi = towerinfosOH3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALOUT,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomOH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
+        m_super_towers.get_geometry( 1, this_comp_ieta, this_comp_iphi, geomOH, this_comp_eta, this_comp_phi, this_comp_cosh );
         this_comp_E = tower->get_energy();
-        this_comp_eT = this_comp_E / cosh(this_comp_eta);
+        this_comp_eT = this_comp_E / this_comp_cosh;
         this_comp_status = tower->get_isGood();
       }
       else
@@ -1305,8 +1309,7 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
       }
 
 
-      int comp_ikey = (1000 * this_comp_ieta) + this_comp_iphi;
-      constituent_ETsum[comp_ikey] += this_comp_eT;
+      m_super_towers.add( this_comp_ieta, this_comp_iphi, this_comp_eT );
 
 
       tower_ieta.push_back(this_comp_ieta);
@@ -1319,39 +1322,25 @@ int TreeWriter::GetSeedInfo( PHCompositeNode *topNode )
       
     } // end loop over constituents
 
-    float constituent_max_ET = 0;
     float constituent_sum_ET = 0;
-    int nconstituents = 0;
-    for (auto &map_iter : constituent_ETsum)
-    {
-      nconstituents++;
-      constituent_sum_ET += map_iter.second;
-      constituent_max_ET = std::max<double>(map_iter.second, constituent_max_ET);
-      super_tower_E.push_back(map_iter.second);
-    }
-    
+    float constituent_max_ET = 0;
     float mean_constituent_ET = 0;
-    if ( nconstituents != 0 ) 
-    {
-      mean_constituent_ET = constituent_sum_ET / nconstituents;
-    }
-
-    
-  
-    m_raw_seed_E.push_back(this_e);
-    m_raw_seed_eta.push_back(this_eta);
-    m_raw_seed_phi.push_back(this_phi);
-    m_raw_seed_pT.push_back(this_pt);
-    m_raw_seed_comp_ieta.push_back(tower_ieta);
-    m_raw_seed_comp_iphi.push_back(tower_iphi);
-    m_raw_seed_comp_caloid.push_back(tower_caloid);
-    m_raw_seed_comp_status.push_back(tower_status);
-    m_raw_seed_comp_E.push_back(tower_E);
-    m_raw_seed_comp_eta.push_back(tower_eta);
-    m_raw_seed_comp_phi.push_back(tower_phi);
-    m_raw_seed_super_tower_E.push_back(super_tower_E);
-    m_mean_super_tower_E.push_back(mean_constituent_ET);
-    m_max_super_tower_E.push_back(constituent_max_ET);
+    m_super_towers.get_stats( constituent_sum_ET, constituent_max_ET, mean_constituent_ET, super_tower_E );
+
+    m_raw_seed.E->push_back(this_e);
+    m_raw_seed.eta->push_back(this_eta);
+    m_raw_seed.phi->push_back(this_phi);
+    m_raw_seed.pT->push_back(this_pt);
+    m_raw_seed.comp_ieta->push_back(tower_ieta);
+    m_raw_seed.comp_iphi->push_back(tower_iphi);
+    m_raw_seed.comp_caloid->push_back(tower_caloid);
+    m_raw_seed.comp_status->push_back(tower_status);
+    m_raw_seed.comp_E->push_back(tower_E);
+    m_raw_seed.comp_eta->push_back(tower_eta);
+    m_raw_seed.comp_phi->push_back(tower_phi);
+    m_raw_seed.super_tower_E->push_back(super_tower_E);
+    m_raw_seed.avg_super_E->push_back(mean_constituent_ET);
+    m_raw_seed.max_super_E->push_back(constituent_max_ET);
 
   } // end loop over seeds
 
@@ -1370,12 +1359,12 @@ int TreeWriter::GetRawJetInfo( PHCompositeNode *topNode , const int idx)
 
   const std::string & node_name = m_rawjet_nodes[idx];
  
-  ResetRawJet();
+  m_branches.reset( kRawJet );
 
   // get tower info containers
-  auto towerinfosEM3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_CEMC_RETOWER");
-  auto towerinfosIH3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_HCALIN" );
-  auto towerinfosOH3 = findNode::getClass< TowerInfoContainer >( topNode,  "TOWERINFO_CALIB_HCALOUT" );
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_CEMC_RETOWER");
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALIN" );
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode,  "TOWERINFO_CALIB_HCALOUT" );
   if( !towerinfosIH3 || !towerinfosOH3 || !towerinfosEM3 )
   {
     std::cout
@@ -1390,8 +1379,8 @@ int TreeWriter::GetRawJetInfo( PHCompositeNode *topNode , const int idx)
   }
   
   // get geometry containers
-  auto geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  auto geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
+  auto geomIH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  auto geomOH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
   if ( !geomIH || !geomOH ) 
   {
     std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
@@ -1399,7 +1388,7 @@ int TreeWriter::GetRawJetInfo( PHCompositeNode *topNode , const int idx)
   }
   
   // get raw jets
-  auto jets = findNode::getClass<JetContainer>( topNode, node_name );
+  auto jets = m_nodes.get<JetContainer>( topNode, node_name );
   if ( !jets )
   {
     std::cout << PHWHERE << " Input node " << node_name << " Node missing, doing nothing." << std::endl;
@@ -1509,17 +1498,17 @@ int TreeWriter::GetRawJetInfo( PHCompositeNode *topNode , const int idx)
     } // end loop over constituents
 
 
-    m_raw_jet_E.push_back(this_e);
-    m_raw_jet_eta.push_back(this_eta);
-    m_raw_jet_phi.push_back(this_phi);
-    m_raw_jet_pT.push_back(this_pt);
-    m_raw_jet_comp_ieta.push_back(tower_ieta);
-    m_raw_jet_comp_iphi.push_back(tower_iphi);
-    m_raw_jet_comp_caloid.push_back(tower_caloid);
-    m_raw_jet_comp_status.push_back(tower_status);
-    m_raw_jet_comp_E.push_back(tower_E);
-    m_raw_jet_comp_eta.push_back(tower_eta);
-    m_raw_jet_comp_phi.push_back(tower_phi);
+    m_raw_jet.E->push_back(this_e);
+    m_raw_jet.eta->push_back(this_eta);
+    m_raw_jet.phi->push_back(this_phi);
+    m_raw_jet.pT->push_back(this_pt);
+    m_raw_jet.comp_ieta->push_back(tower_ieta);
+    m_raw_jet.comp_iphi->push_back(tower_iphi);
+    m_raw_jet.comp_caloid->push_back(tower_caloid);
+    m_raw_jet.comp_status->push_back(tower_status);
+    m_raw_jet.comp_E->push_back(tower_E);
+    m_raw_jet.comp_eta->push_back(tower_eta);
+    m_raw_jet.comp_phi->push_back(tower_phi);
 
   } // end loop over jets
 
@@ -1528,24 +1517,54 @@ int TreeWriter::GetRawJetInfo( PHCompositeNode *topNode , const int idx)
     std::cout << PHWHERE << " - Found " << jets->size() << " raw jets in node " << node_name << std::endl;
   }
 
-  m_raw_jet_trees[idx]->Fill();
+  m_branches.fill( m_raw_jet_trees[idx] );
 
   
   return Fun4AllReturnCodes::EVENT_OK;
 
 }
 
+int TreeWriter::GetUETable( PHCompositeNode *topNode )
+{
+  if ( !m_ue_table.has_geometry() )
+  {
+    auto geomIH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+    auto geomOH = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
+    if ( !geomIH || !geomOH ) 
+    {
+      std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN; // fatal error
+    }
+    m_ue_table.set_geometry( geomIH, geomOH );
+  }
+
+  auto tower_background_sub2 = m_nodes.get<TowerBackgroundv1>(topNode, m_towerbkgd_node_sub2);
+  if ( !tower_background_sub2 )
+  {
+    std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN; // fatal error
+  }
+  m_ue_table.fill( tower_background_sub2 );
+
+  if ( Verbosity() > 1 ) 
+  {
+    std::cout << PHWHERE << " - UE table from " << m_towerbkgd_node_sub2 << ", v2 = " << m_ue_table.get_v2() << ", Psi2 = " << m_ue_table.get_psi2() << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int TreeWriter::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
 {
 
   const std::string & node_name = m_sub1jet_nodes[idx];
  
-  ResetSub1Jet();
+  m_branches.reset( kSub1Jet );
 
   // get tower info containers
-  auto towerinfosEM3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1");
-  auto towerinfosIH3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_HCALIN_SUB1" );
-  auto towerinfosOH3 = findNode::getClass< TowerInfoContainer >( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1" );
+  auto towerinfosEM3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1");
+  auto towerinfosIH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALIN_SUB1" );
+  auto towerinfosOH3 = m_nodes.get<TowerInfoContainer>( topNode, "TOWERINFO_CALIB_HCALOUT_SUB1" );
   if( !towerinfosIH3 || !towerinfosOH3 || !towerinfosEM3 )
   {
     std::cout
@@ -1559,62 +1578,14 @@ int TreeWriter::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
     return Fun4AllReturnCodes::ABORTRUN; // fatal error
   }
   
-  // get geometry containers
-  auto geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  auto geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT"); 
-  if ( !geomIH || !geomOH ) 
-  {
-    std::cout << PHWHERE << " RawTowerGeomContainer for HCALIN or HCALOUT is missing, doing nothing." << std::endl;
-    return Fun4AllReturnCodes::ABORTRUN; // fatal error
-  }
-  
   // get raw jets
-  auto jets = findNode::getClass<JetContainer>( topNode, node_name );
+  auto jets = m_nodes.get<JetContainer>( topNode, node_name );
   if ( !jets )
   {
     std::cout << PHWHERE << " Input node " << node_name << " Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTEVENT; 
   }
 
-  auto tower_background_sub1 = findNode::getClass<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub1");
-  if ( !tower_background_sub1 )
-  {
-    std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
-    return Fun4AllReturnCodes::ABORTRUN; // fatal error
-  }
-
-  auto tower_background_sub2 = findNode::getClass<TowerBackgroundv1>(topNode, "TowerInfoBackground_Sub2");
-  if ( !tower_background_sub2 )
-  {
-    std::cout << PHWHERE << " TowerBackgroundv1 node is missing, skipping." << std::endl;
-    return Fun4AllReturnCodes::ABORTRUN; // fatal error
-  }
-
-  for ( int ilayer = 0 ; ilayer < 3; ilayer++ )
-  {
-    std::vector<float> this_ue_sub1 = tower_background_sub1->get_UE(ilayer);
-    std::vector<float> this_ue_sub2 = tower_background_sub2->get_UE(ilayer);
-    for ( int ieta = 0; ieta < 24; ieta++ )
-    {
-      if ( ilayer == 0 ) 
-      {
-        m_sub1_towerbkgd_cemc[ieta] = this_ue_sub1[ieta];
-        m_sub2_towerbkgd_cemc[ieta] = this_ue_sub2[ieta];
-      }
-      else if ( ilayer == 1 ) 
-      {
-        m_sub1_towerbkgd_hcalin[ieta] = this_ue_sub1[ieta];
-        m_sub2_towerbkgd_hcalin[ieta] = this_ue_sub2[ieta];
-      }
-      else if ( ilayer == 2 ) 
-      {
-        m_sub1_towerbkgd_hcalout[ieta] = this_ue_sub1[ieta];
-        m_sub2_towerbkgd_hcalout[ieta] = this_ue_sub2[ieta];
-      }
-    }
-  } // end loop over layers
-
-
   for ( auto jet : *jets )
   {
 
@@ -1636,91 +1607,35 @@ int TreeWriter::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
 
     for ( const auto &comp : jet->get_comp_vec() )
     {
-      int this_comp_ieta = -999;
-      int this_comp_iphi = -999;
-      float this_comp_E = 0;
-      float this_comp_eta = 0;
-      float this_comp_phi = 0;
-      int this_comp_status = -1;
       int this_comp_caloid = comp.first;
 
       bool is_hcalin = ( comp.first == Jet::SRC::HCALIN_TOWERINFO || comp.first == Jet::SRC::HCALIN_TOWERINFO_SUB1 );
       bool is_hcalout = ( comp.first == Jet::SRC::HCALOUT_TOWERINFO || comp.first == Jet::SRC::HCALOUT_TOWERINFO_SUB1 );
       bool is_cemc = ( comp.first == Jet::SRC::CEMC_TOWERINFO || comp.first == Jet::SRC::CEMC_TOWERINFO_RETOWER || comp.first == Jet::SRC::CEMC_TOWERINFO_SUB1);
-      if ( is_cemc )
-      {
-        auto tower = towerinfosEM3->get_tower_at_channel( comp.second );
-        assert(tower);
-        unsigned int towerkey = towerinfosEM3->encode_key( comp.second );
-        this_comp_ieta = towerinfosEM3->getTowerEtaBin(towerkey);
-        this_comp_iphi = towerinfosEM3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALIN,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomIH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
-        this_comp_E = tower->get_energy();
-        this_comp_status = tower->get_isGood();
-
-        float this_ue = m_sub2_towerbkgd_cemc[this_comp_ieta];
-        float this_unsub_pt = ( this_comp_E + this_ue ) / cosh(this_comp_eta);
-        unsub_px += this_unsub_pt * cos(this_comp_phi);
-        unsub_py += this_unsub_pt * sin(this_comp_phi);
-        unsub_E += ( this_comp_E + this_ue );
-      }
-      else if ( is_hcalin )
-      {
-        auto tower = towerinfosIH3->get_tower_at_channel( comp.second );
-        assert(tower);
-        unsigned int towerkey = towerinfosIH3->encode_key( comp.second );
-        this_comp_ieta = towerinfosIH3->getTowerEtaBin(towerkey);
-        this_comp_iphi = towerinfosIH3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALIN,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomIH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
-        this_comp_E = tower->get_energy();
-        this_comp_status = tower->get_isGood();
-
-        float this_ue = m_sub2_towerbkgd_hcalin[this_comp_ieta];
-        float this_unsub_pt = ( this_comp_E + this_ue ) / cosh(this_comp_eta);
-        unsub_px += this_unsub_pt * cos(this_comp_phi);
-        unsub_py += this_unsub_pt * sin(this_comp_phi);
-        unsub_E += ( this_comp_E + this_ue );
-      }
-      else if ( is_hcalout )
-      {
-        auto tower = towerinfosOH3->get_tower_at_channel( comp.second );
-        assert(tower);
-        unsigned int towerkey = towerinfosOH3->encode_key( comp.second );
-        this_comp_ieta = towerinfosOH3->getTowerEtaBin(towerkey);
-        this_comp_iphi = towerinfosOH3->getTowerPhiBin(towerkey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid( RawTowerDefs::CalorimeterId::HCALOUT,  this_comp_ieta,  this_comp_iphi);
-        auto geom = geomOH->get_tower_geometry(key);
-        if ( geom )
-        {
-          this_comp_eta = geom->get_eta();
-          this_comp_phi = geom->get_phi();
-        }
-        this_comp_E = tower->get_energy();
-        this_comp_status = tower->get_isGood();
-        float this_ue = m_sub2_towerbkgd_hcalout[this_comp_ieta];
-        float this_unsub_pt = ( this_comp_E + this_ue ) / cosh(this_comp_eta);
-        unsub_px += this_unsub_pt * cos(this_comp_phi);
-        unsub_py += this_unsub_pt * sin(this_comp_phi);
-        unsub_E += ( this_comp_E + this_ue );
-      }
+      TowerInfoContainer * towerinfos = nullptr;
+      int layer = UETable::CEMC;
+      if ( is_cemc ) { towerinfos = towerinfosEM3; layer = UETable::CEMC; }
+      else if ( is_hcalin ) { towerinfos = towerinfosIH3; layer = UETable::HCALIN; }
+      else if ( is_hcalout ) { towerinfos = towerinfosOH3; layer = UETable::HCALOUT; }
       else
       {
         std::cout << PHWHERE << " Warning: jets constituent caloid " << comp.first << " not recognized, skipping." << std::endl;
         continue;
       }
 
+      auto tower = towerinfos->get_tower_at_channel( comp.second );
+      assert(tower);
+      unsigned int towerkey = towerinfos->encode_key( comp.second );
+      int this_comp_ieta = towerinfos->getTowerEtaBin(towerkey);
+      int this_comp_iphi = towerinfos->getTowerPhiBin(towerkey);
+      float this_comp_eta = m_ue_table.get_eta( layer, this_comp_ieta, this_comp_iphi );
+      float this_comp_phi = m_ue_table.get_phi( layer, this_comp_ieta, this_comp_iphi );
+      float this_comp_E = tower->get_energy();
+      int this_comp_status = tower->get_isGood();
+
+      // modulated background of this tower back on top
+      m_ue_table.unsubtract( layer, this_comp_ieta, this_comp_iphi, this_comp_E, unsub_px, unsub_py, unsub_E );
+
       if ( this_comp_status != 1 ) 
       {
         continue; // skip bad towers
@@ -1739,19 +1654,19 @@ int TreeWriter::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
 
 
     float unsub_pt = sqrt( (unsub_px * unsub_px) + (unsub_py * unsub_py) );
-    m_sub1_jet_E.push_back(this_e);
-    m_sub1_jet_eta.push_back(this_eta);
-    m_sub1_jet_phi.push_back(this_phi);
-    m_sub1_jet_pT.push_back(this_pt);
-    m_sub1_jet_unsub_pT.push_back(unsub_pt);
-    m_sub1_jet_unsub_E.push_back(unsub_E);
-    m_sub1_jet_comp_ieta.push_back(tower_ieta);
-    m_sub1_jet_comp_iphi.push_back(tower_iphi);
-    m_sub1_jet_comp_caloid.push_back(tower_caloid);
-    m_sub1_jet_comp_status.push_back(tower_status);
-    m_sub1_jet_comp_E.push_back(tower_E);
-    m_sub1_jet_comp_eta.push_back(tower_eta);
-    m_sub1_jet_comp_phi.push_back(tower_phi); 
+    m_sub1_jet.E->push_back(this_e);
+    m_sub1_jet.eta->push_back(this_eta);
+    m_sub1_jet.phi->push_back(this_phi);
+    m_sub1_jet.pT->push_back(this_pt);
+    m_sub1_jet.unsub_pT->push_back(unsub_pt);
+    m_sub1_jet.unsub_E->push_back(unsub_E);
+    m_sub1_jet.comp_ieta->push_back(tower_ieta);
+    m_sub1_jet.comp_iphi->push_back(tower_iphi);
+    m_sub1_jet.comp_caloid->push_back(tower_caloid);
+    m_sub1_jet.comp_status->push_back(tower_status);
+    m_sub1_jet.comp_E->push_back(tower_E);
+    m_sub1_jet.comp_eta->push_back(tower_eta);
+    m_sub1_jet.comp_phi->push_back(tower_phi); 
 
 
   } // end loop over jets
@@ -1761,7 +1676,7 @@ int TreeWriter::GetSub1JetInfo( PHCompositeNode *topNode , const int idx)
     std::cout << PHWHERE << " - Found " << jets->size() << " sub1 jets in node " << node_name << std::endl;
   }
 
-  m_sub1_jet_trees[idx]->Fill();
+  m_branches.fill( m_sub1_jet_trees[idx] );
 
   
   return Fun4AllReturnCodes::EVENT_OK;
@@ -1773,10 +1688,10 @@ int TreeWriter::GetTruthJetInfo( PHCompositeNode *topNode , const int idx)
 
   const std::string & node_name = m_truthjet_nodes[idx];
  
-  ResetTruthJet();
+  m_branches.reset( kTruthJet );
 
   // get truth jets
-  auto jets = findNode::getClass<JetContainer>( topNode, node_name );
+  auto jets = m_nodes.get<JetContainer>( topNode, node_name );
   if ( !jets )
   {
     std::cout << PHWHERE << " Input node " << node_name << " Node missing, doing nothing." << std::endl;
@@ -1791,10 +1706,10 @@ int TreeWriter::GetTruthJetInfo( PHCompositeNode *topNode , const int idx)
     float this_phi = jet->get_phi();
     float this_e = jet->get_e();
 
-    m_truth_jet_E.push_back(this_e);
-    m_truth_jet_eta.push_back(this_eta);
-    m_truth_jet_phi.push_back(this_phi);
-    m_truth_jet_pT.push_back(this_pt);
+    m_truth_jet.E->push_back(this_e);
+    m_truth_jet.eta->push_back(this_eta);
+    m_truth_jet.phi->push_back(this_phi);
+    m_truth_jet.pT->push_back(this_pt);
 
   } // end loop over jets
 
@@ -1803,7 +1718,7 @@ int TreeWriter::GetTruthJetInfo( PHCompositeNode *topNode , const int idx)
     std::cout << PHWHERE << " - Found " << jets->size() << " truth jets in node " << node_name << std::endl;
   }
 
-  m_truth_jet_trees[idx]->Fill();
+  m_branches.fill( m_truth_jet_trees[idx] );
 
   
   return Fun4AllReturnCodes::EVENT_OK;
@@ -1812,10 +1727,10 @@ int TreeWriter::GetTruthJetInfo( PHCompositeNode *topNode , const int idx)
 
 int TreeWriter::GetG4TruthInfo( PHCompositeNode *topNode )
 {
-  ResetG4Truth();
+  m_branches.reset( kG4Truth );
 
   // get g4 truth info
-  PHG4TruthInfoContainer * truthinfo = findNode::getClass<PHG4TruthInfoContainer>( topNode, m_g4truth_node );
+  PHG4TruthInfoContainer * truthinfo = m_nodes.get<PHG4TruthInfoContainer>( topNode, m_g4truth_node );
   if ( !truthinfo ) 
   {
     std::cout << PHWHERE << " Input node "<< m_g4truth_node << " Node missing, doing nothing." << std::endl;
@@ -1898,7 +1813,7 @@ int TreeWriter::GetG4TruthInfo( PHCompositeNode *topNode )
 int TreeWriter::GetSepdInfo( PHCompositeNode *topNode )
 {
   // get sEPD info
-  auto sepd = findNode::getClass<TowerInfoContainer>(topNode, m_sepd_node );
+  auto sepd = m_nodes.get<TowerInfoContainer>(topNode, m_sepd_node );
 
   if ( !sepd ) {
     std::cout << PHWHERE << m_sepd_node << " node missing, doing nothing." << std::endl;
@@ -1913,7 +1828,7 @@ int TreeWriter::GetSepdInfo( PHCompositeNode *topNode )
   m_sepd_phi.clear();
 
   int num_sepd = sepd->size();
-  auto epdgeom = findNode::getClass<EpdGeom>(topNode, "TOWERGEOM_EPD");
+  auto epdgeom = m_nodes.get<EpdGeom>(topNode, "TOWERGEOM_EPD");
   for ( int i = 0; i < num_sepd; ++i ) {
     auto tower = sepd->get_tower_at_channel(i);
 
@@ -1952,7 +1867,7 @@ int TreeWriter::GetEventPlaneInfo( PHCompositeNode *topNode )
   m_psi_NS.clear();
   m_psi_S.clear();
   m_psi_N.clear();
-  auto m_evpmap  = findNode::getClass<EventplaneinfoMap>(topNode,  m_eventplane_node );
+  auto m_evpmap  = m_nodes.get<EventplaneinfoMap>(topNode,  m_eventplane_node );
   if ( !m_evpmap  || m_evpmap->empty() ) {
     std::cout << PHWHERE << "EventplaneinfoMap node missing, doing nothing." << std::endl;
   } else {
@@ -4,6 +4,13 @@
 #include <fun4all/SubsysReco.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <eventselection/NodeCache.h>
+#include <eventselection/TreeCheckpoint.h>
+
+#include "BranchRegistry.h"
+#include "SuperTowerGrid.h"
+#include "UETable.h"
+
 #include <string>
 #include <vector>
 #include <array>
@@ -14,6 +21,7 @@
 #include <cstring>
 
 class PHCompositeNode;
+class EventSummary;
 class TTree;
 class TRandom3;
 
@@ -39,6 +47,8 @@ class TreeWriter : public SubsysReco
 
 
   int Init( PHCompositeNode * /*topNode*/) override;
+
+  int InitRun( PHCompositeNode * /*topNode*/ ) override;
   
   int process_event( PHCompositeNode * topNode ) override;
   
@@ -46,23 +56,14 @@ class TreeWriter : public SubsysReco
   
   int ResetEvent( PHCompositeNode * /*topNode*/ ) override 
   {
-    ResetGL1();
-    ResetZvtx();
-    ResetCent();
-    ResetEventHeader();
-    ResetMbd();
-    ResetCaloArrays();
-    ResetCaloSub1Arrays();
-    ResetRhoArrays();
-    ResetTowerBkgd();
-    ResetRawSeed();
-    ResetRawJet();
-    ResetSub1Jet();
-    ResetTruthJet();
-    ResetG4Truth();
+    m_branches.reset();
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
+  // only write events accepted by stream of the EventSelector named
+  // selector, one writer ( and output file ) per stream
+  void set_stream ( const std::string & stream, const std::string & selector = "EventSelector" );
+
   void add_gl1_node ( const std::string & name = "GL1Packet"){  m_gl1_node = name; }
   void add_zvrtx_node ( const std::string & name = "GlobalVertexMap" ){ m_zvrtx_node = name; }
   void add_cent_node ( const std::string & name = "CentralityInfo" ) { m_cent_node = name;  }
@@ -82,6 +83,9 @@ class TreeWriter : public SubsysReco
    
   void add_rho_node ( const std::string & name ) { m_rho_nodes.push_back(name); }
   void do_towerbkgd_nodes( const bool b ) { m_do_towerbkgd = b; }
+  // per tower ( layer, ieta, iphi ) sub2 background with the v2 modulation,
+  // written as sub2_ue_table[3][24][64]
+  void write_ue_table( const bool b ) { m_write_ue_table = b; }
 
   void add_rawseed_node ( const std::string & name = "AntiKt_TowerInfo_HIRecoSeedsRaw_r02" ) { m_rawseed_node = name; }
   void add_rawjet_node ( const std::string & name ) { m_rawjet_nodes.push_back(name); }
@@ -94,50 +98,85 @@ class TreeWriter : public SubsysReco
   void do_flow ( const bool doflow , const bool do_fluc, const float scale  ) { m_do_flow = doflow;  m_do_fluc = do_fluc;  m_flow_scale = scale; }
   void add_truthjet_node ( const std::string & name ) { m_truthjet_nodes.push_back(name); }
 
+  // AutoSave the trees every nevents ( or nseconds ), see TreeCheckpoint
+  void set_checkpoint( const unsigned int nevents, const unsigned int nseconds = 0 ) { m_checkpoint.set_interval( nevents, nseconds ); }
+  // continue a killed job from its last checkpoint
+  void set_resume( const bool b ) { m_checkpoint.set_resume( b ); }
 
+  // write the event trees as RNTuples, pages compressed on nthreads
+  // implicit MT threads ( 0 single threaded ). TTrees by default
+  void use_rntuple( const bool b = true, const unsigned int nthreads = 0 ) { m_branches.set_backend( b ? BranchRegistry::kRNTuple : BranchRegistry::kTTree, nthreads ); }
 
 
 
+
+
+  // v2..v6 of a truth particle from the flow parametrisation
+  static void CalcFlow( float b , float eta, float pt, 
+    float &v2 , float &v3, float &v4, float &v5, float &v6 ,
+    TRandom3 * engine, bool do_fluc = false, float scale = 1.0);
+
  private:
+
+  // per run node handles
+  NodeCache m_nodes {};
+
+  // periodic AutoSave and resume
+  TreeCheckpoint m_checkpoint {};
     
   // output file name
   std::string m_output_filename { "" };
 
+  // stream filter, empty writes every event
+  std::string m_stream { "" };
+  std::string m_record_node { "" };
+
   TRandom3 * m_rand { nullptr };
 
   TTree * m_run_tree {nullptr};
   int m_nevents {0};
+  int m_run_number {0};
   float m_weight {1.0};
 
   // event tree
   TTree * m_tree {nullptr};
   int m_event_id {-1};
 
+  // per event output columns, booked in Init and reset per block
+  enum BLOCK
+  {
+    kGL1 = 0,
+    kZvtx,
+    kCent,
+    kSepd,
+    kEventPlane,
+    kEventHeader,
+    kMbd,
+    kCalo,
+    kCaloSub1,
+    kRho,
+    kTowerBkgd,
+    kUETable,
+    kSeed,
+    kRawJet,
+    kSub1Jet,
+    kTruthJet,
+    kG4Truth
+  };
+  BranchRegistry m_branches {};
+
   // gl1
   std::string m_gl1_node {""};
   uint64_t s_triggervec { 0 };
   uint64_t l_triggervec { 0 };
-  void ResetGL1()
-  {
-    s_triggervec = 0;
-    l_triggervec = 0;
-  }
 
   // z vertex info
   std::string m_zvrtx_node { "" };
   float m_zvtx { 0.0 };
-  void ResetZvtx()
-  {
-    m_zvtx = -999;
-  }
 
   // centrality info
   std::string m_cent_node { "" };
   int m_cent {-1};
-  void ResetCent()
-  {
-    m_cent = -1;
-  }
 
   // sepd
   std::string m_sepd_node { "" };
@@ -146,14 +185,6 @@ class TreeWriter : public SubsysReco
   std::vector< int  > m_sepd_arm {};
   std::vector< float > m_sepd_radius {};
   std::vector< float > m_sepd_phi {};
-  void ResetSepd()
-  {
-    m_sepd_energy.clear();
-    m_sepd_isgood.clear();
-    m_sepd_arm.clear();
-    m_sepd_radius.clear();
-    m_sepd_phi.clear();
-  }
 
   std::string m_eventplane_node { "" };
   std::vector< float > m_psi_shifted_NS {};
@@ -162,15 +193,6 @@ class TreeWriter : public SubsysReco
   std::vector< float > m_psi_S {};
   std::vector< float > m_psi_shifted_N {};
   std::vector< float > m_psi_N {};
-  void ResetEventPlane()
-  {
-    m_psi_shifted_NS.clear();
-    m_psi_NS.clear();
-    m_psi_shifted_S.clear();
-    m_psi_S.clear();
-    m_psi_shifted_N.clear();
-    m_psi_N.clear();
-  }
 
   // event header info
   std::string m_eventhead_node { "" };
@@ -185,20 +207,6 @@ class TreeWriter : public SubsysReco
   float m_psi6 { 0.0 };
   float m_ncoll { 0.0 };
   float m_npart { 0.0 };
-  void ResetEventHeader()
-  {
-    m_b = -999;
-    m_ep_angle = -999;
-    m_ecc = -999;
-    m_psi1 = -999;
-    m_psi2 = -999;
-    m_psi3 = -999;
-    m_psi4 = -999;
-    m_psi5 = -999;
-    m_psi6 = -999;
-    m_ncoll = -999;
-    m_npart = -999;
-  }
 
   // mbd
   std::string m_mbd_node { "" };
@@ -210,104 +218,51 @@ class TreeWriter : public SubsysReco
   float m_mbd_t_S { 0 };
   float m_mbd_n_N { 0 };
   float m_mbd_n_S { 0 };
-  void ResetMbd()
-  {
-    m_mbd_q_N = -999;
-    m_mbd_q_S = -999;
-    m_mbd_t_N = -999;
-    m_mbd_t_S = -999;
-    m_mbd_n_N = -999;
-    m_mbd_n_S = -999;
-  }
 
-  // calo info
+  // calo info, ieta x iphi columns owned by m_branches
   static const int k_ieta = 24;
   static const int k_iphi = 64;
+  struct CaloColumns
+  {
+    float * E { nullptr };
+    float * isgood { nullptr };
+    float * time { nullptr };
+    float * eta { nullptr };
+    float * phi { nullptr };
+
+    bool booked() const { return E != nullptr; }
+    void set( const int ieta, const int iphi, const float tower_E, const float tower_isgood, const float tower_time, const float tower_eta, const float tower_phi )
+    {
+      const int i = ieta * k_iphi + iphi;
+      E[i] = tower_E;
+      isgood[i] = tower_isgood;
+      time[i] = tower_time;
+      eta[i] = tower_eta;
+      phi[i] = tower_phi;
+    }
+  };
+  // <prefix>_E[24][64], _isgood, _time, _eta and _phi
+  CaloColumns BookCalo( const int block, const std::string & prefix );
+
   std::string m_cemc_node { "" };
   std::string m_hcalin_node { "" };
   std::string m_hcalout_node { "" };
-
-  float m_cemc_E[k_ieta][k_iphi] {};
-  float m_hcalin_E[k_ieta][k_iphi] {};
-  float m_hcalout_E[k_ieta][k_iphi] {};
-  float m_cemc_isgood[k_ieta][k_iphi] {};
-  float m_hcalin_isgood[k_ieta][k_iphi] {};
-  float m_hcalout_isgood[k_ieta][k_iphi] {};
-  float m_cemc_time[k_ieta][k_iphi] {};
-  float m_hcalin_time[k_ieta][k_iphi] {};
-  float m_hcalout_time[k_ieta][k_iphi] {};
-  float m_cemc_eta[k_ieta][k_iphi] {};
-  float m_hcalin_eta[k_ieta][k_iphi] {};
-  float m_hcalout_eta[k_ieta][k_iphi] {};
-  float m_cemc_phi[k_ieta][k_iphi] {};
-  float m_hcalin_phi[k_ieta][k_iphi] {};
-  float m_hcalout_phi[k_ieta][k_iphi] {};
-  void ResetCaloArrays()
-  {
-    memset(m_cemc_E, 0, sizeof(m_cemc_E));
-    memset(m_cemc_isgood, 0, sizeof(m_cemc_isgood));
-    memset(m_cemc_time, 0, sizeof(m_cemc_time));
-    memset(m_cemc_eta, 0, sizeof(m_cemc_eta));
-    memset(m_cemc_phi, 0, sizeof(m_cemc_phi));
-    memset(m_hcalin_E, 0, sizeof(m_hcalin_E));
-    memset(m_hcalin_isgood, 0, sizeof(m_hcalin_isgood));
-    memset(m_hcalin_time, 0, sizeof(m_hcalin_time));
-    memset(m_hcalin_eta, 0, sizeof(m_hcalin_eta));
-    memset(m_hcalin_phi, 0, sizeof(m_hcalin_phi));
-    memset(m_hcalout_E, 0, sizeof(m_hcalout_E));
-    memset(m_hcalout_isgood, 0, sizeof(m_hcalout_isgood));
-    memset(m_hcalout_time, 0, sizeof(m_hcalout_time));
-    memset(m_hcalout_eta, 0, sizeof(m_hcalout_eta));
-    memset(m_hcalout_phi, 0, sizeof(m_hcalout_phi));
-  }
+  CaloColumns m_cemc {};
+  CaloColumns m_hcalin {};
+  CaloColumns m_hcalout {};
 
   std::string m_cemc_sub1_node { "" };
   std::string m_hcalin_sub1_node { "" };
   std::string m_hcalout_sub1_node { "" };
-  float m_cemc_sub1_E[k_ieta][k_iphi] {};
-  float m_hcalin_sub1_E[k_ieta][k_iphi] {};
-  float m_hcalout_sub1_E[k_ieta][k_iphi] {};
-  float m_cemc_sub1_isgood[k_ieta][k_iphi] {};
-  float m_hcalin_sub1_isgood[k_ieta][k_iphi] {};
-  float m_hcalout_sub1_isgood[k_ieta][k_iphi] {};
-  float m_cemc_sub1_time[k_ieta][k_iphi] {};
-  float m_hcalin_sub1_time[k_ieta][k_iphi] {};
-  float m_hcalout_sub1_time[k_ieta][k_iphi] {};
-  float m_cemc_sub1_eta[k_ieta][k_iphi] {};
-  float m_hcalin_sub1_eta[k_ieta][k_iphi] {};
-  float m_hcalout_sub1_eta[k_ieta][k_iphi] {};
-  float m_cemc_sub1_phi[k_ieta][k_iphi] {};
-  float m_hcalin_sub1_phi[k_ieta][k_iphi] {};
-  float m_hcalout_sub1_phi[k_ieta][k_iphi] {};
-  void ResetCaloSub1Arrays()
-  {
-    memset(m_cemc_sub1_E, 0, sizeof(m_cemc_sub1_E));
-    memset(m_cemc_sub1_isgood, 0, sizeof(m_cemc_sub1_isgood));
-    memset(m_cemc_sub1_time, 0, sizeof(m_cemc_sub1_time));
-    memset(m_cemc_sub1_eta, 0, sizeof(m_cemc_sub1_eta));
-    memset(m_cemc_sub1_phi, 0, sizeof(m_cemc_sub1_phi));
-    memset(m_hcalin_sub1_E, 0, sizeof(m_hcalin_sub1_E));
-    memset(m_hcalin_sub1_isgood, 0, sizeof(m_hcalin_sub1_isgood));
-    memset(m_hcalin_sub1_time, 0, sizeof(m_hcalin_sub1_time));
-    memset(m_hcalin_sub1_eta, 0, sizeof(m_hcalin_sub1_eta));
-    memset(m_hcalin_sub1_phi, 0, sizeof(m_hcalin_sub1_phi));
-    memset(m_hcalout_sub1_E, 0, sizeof(m_hcalout_sub1_E));
-    memset(m_hcalout_sub1_isgood, 0, sizeof(m_hcalout_sub1_isgood));
-    memset(m_hcalout_sub1_time, 0, sizeof(m_hcalout_sub1_time));
-    memset(m_hcalout_sub1_eta, 0, sizeof(m_hcalout_sub1_eta));
-    memset(m_hcalout_sub1_phi, 0, sizeof(m_hcalout_sub1_phi));
-  }
+  CaloColumns m_cemc_sub1 {};
+  CaloColumns m_hcalin_sub1 {};
+  CaloColumns m_hcalout_sub1 {};
 
   // rho info
   static const int k_maxrho = 24;
   std::vector< std::string > m_rho_nodes {};
   float m_rho_val[k_maxrho] {};
   float m_std_rho_val[k_maxrho] {};
-  void ResetRhoArrays()
-  {
-    memset(m_rho_val, -1.0, sizeof(m_rho_val));
-    memset(m_std_rho_val, -1.0, sizeof(m_std_rho_val));
-  }
 
 
   // tower background nodes
@@ -322,133 +277,62 @@ class TreeWriter : public SubsysReco
   float m_sub2_towerbkgd_hcalout[k_ieta] {}; 
   float m_sub1_v2 { 0.0 };
   float m_sub2_v2 { 0.0 };
+  float m_sub1_psi2 { 0.0 };
+  float m_sub2_psi2 { 0.0 };
   int m_sub1_flowfaliure { 0 };
   int m_sub2_flowfaliure { 0 };
-  void ResetTowerBkgd()
-  {
-    memset(m_sub1_towerbkgd_cemc, 0, sizeof(m_sub1_towerbkgd_cemc));
-    memset(m_sub1_towerbkgd_hcalin, 0, sizeof(m_sub1_towerbkgd_hcalin));
-    memset(m_sub1_towerbkgd_hcalout, 0, sizeof(m_sub1_towerbkgd_hcalout));
-    memset(m_sub2_towerbkgd_cemc, 0, sizeof(m_sub2_towerbkgd_cemc));
-    memset(m_sub2_towerbkgd_hcalin, 0, sizeof(m_sub2_towerbkgd_hcalin));
-    memset(m_sub2_towerbkgd_hcalout, 0, sizeof(m_sub2_towerbkgd_hcalout));
-    m_sub1_v2 = 0.0;
-    m_sub2_v2 = 0.0;
-    m_sub1_flowfaliure = 0;
-    m_sub2_flowfaliure = 0;
-  }
+  // sub2 background per tower, used to unsubtract the sub1 jets
+  UETable m_ue_table {};
+  bool m_write_ue_table { false };
 
   
+  // jet columns owned by m_branches. One set per jet type, the trees
+  // of all its nodes book the same buffers; seeds also fill the super
+  // tower columns, truth jets only the kinematics
+  struct JetColumns
+  {
+    std::vector < float > * E { nullptr };
+    std::vector < float > * phi { nullptr };
+    std::vector < float > * eta { nullptr };
+    std::vector < float > * pT { nullptr };
+    std::vector < float > * unsub_pT { nullptr };
+    std::vector < float > * unsub_E { nullptr };
+    std::vector < float > * avg_super_E { nullptr };
+    std::vector < float > * max_super_E { nullptr };
+    std::vector < std::vector < int > > * comp_ieta { nullptr };
+    std::vector < std::vector < int > > * comp_iphi { nullptr };
+    std::vector < std::vector < int > > * comp_caloid { nullptr };
+    std::vector < std::vector < int > > * comp_status { nullptr };
+    std::vector < std::vector < float > > * comp_E { nullptr };
+    std::vector < std::vector < float > > * comp_eta { nullptr };
+    std::vector < std::vector < float > > * comp_phi { nullptr };
+    std::vector < std::vector < float > > * super_tower_E { nullptr };
+  };
+  // <prefix>_E, _phi, _eta and _pT
+  void BookJet( const int block, TTree * tree, const std::string & prefix, JetColumns & jet );
+  // <prefix>_comp_ieta, _iphi, _caloid, _status, _E, _eta and _phi
+  void BookJetComponents( const int block, TTree * tree, const std::string & prefix, JetColumns & jet );
+
   // seed info
   std::string m_rawseed_node { "" };
-  std::vector < float > m_raw_seed_E {};
-  std::vector < float > m_raw_seed_phi {};
-  std::vector < float > m_raw_seed_eta {};
-  std::vector < float > m_raw_seed_pT {};
-  std::vector< float > m_mean_super_tower_E {};
-  std::vector< float > m_max_super_tower_E {};
-  std::vector < std::vector < int > >   m_raw_seed_comp_ieta {};
-  std::vector < std::vector < int > >   m_raw_seed_comp_iphi {};
-  std::vector < std::vector < int > >   m_raw_seed_comp_caloid {};
-  std::vector < std::vector < int > >   m_raw_seed_comp_status {};
-  std::vector < std::vector < float > > m_raw_seed_comp_E {};
-  std::vector < std::vector < float > > m_raw_seed_comp_eta {};
-  std::vector < std::vector < float > > m_raw_seed_comp_phi {};
-  std::vector < std::vector < float > > m_raw_seed_super_tower_E {};
-  void ResetRawSeed()
-  {
-    m_raw_seed_E.clear();
-    m_raw_seed_phi.clear();
-    m_raw_seed_eta.clear();
-    m_raw_seed_pT.clear();
-    m_mean_super_tower_E.clear();
-    m_max_super_tower_E.clear();
-    m_raw_seed_comp_ieta.clear();
-    m_raw_seed_comp_iphi.clear();
-    m_raw_seed_comp_caloid.clear();
-    m_raw_seed_comp_status.clear();
-    m_raw_seed_comp_E.clear();
-    m_raw_seed_comp_eta.clear();
-    m_raw_seed_comp_phi.clear();
-    m_raw_seed_super_tower_E.clear();
-  }
+  JetColumns m_raw_seed {};
+  // per seed super tower sums, reused for every seed
+  SuperTowerGrid m_super_towers {};
 
   // raw jet info
   std::vector< std::string > m_rawjet_nodes {};
   TTree * m_raw_jet_trees[16] = { nullptr };
-  std::vector < float > m_raw_jet_E {};
-  std::vector < float > m_raw_jet_phi {};
-  std::vector < float > m_raw_jet_eta {};
-  std::vector < float > m_raw_jet_pT {};
-  std::vector < std::vector < int > > m_raw_jet_comp_ieta {};
-  std::vector < std::vector < int > > m_raw_jet_comp_iphi {};
-  std::vector < std::vector < int > > m_raw_jet_comp_caloid {};
-  std::vector < std::vector < int > > m_raw_jet_comp_status {};
-  std::vector < std::vector < float > > m_raw_jet_comp_E {};
-  std::vector < std::vector < float > > m_raw_jet_comp_eta {};
-  std::vector < std::vector < float > > m_raw_jet_comp_phi {};
-  void ResetRawJet()
-  {
-    m_raw_jet_E.clear();
-    m_raw_jet_phi.clear();
-    m_raw_jet_eta.clear();
-    m_raw_jet_pT.clear();
-    m_raw_jet_comp_ieta.clear();
-    m_raw_jet_comp_iphi.clear();
-    m_raw_jet_comp_caloid.clear();
-    m_raw_jet_comp_status.clear();
-    m_raw_jet_comp_E.clear();
-    m_raw_jet_comp_eta.clear();
-    m_raw_jet_comp_phi.clear();
-  }
+  JetColumns m_raw_jet {};
  
   // sub1 jet info
   std::vector< std::string > m_sub1jet_nodes {};
   TTree * m_sub1_jet_trees[16] = { nullptr };
-  std::vector < float > m_sub1_jet_E {};
-  std::vector < float > m_sub1_jet_phi {};
-  std::vector < float > m_sub1_jet_eta {};
-  std::vector < float > m_sub1_jet_pT {};
-  std::vector < float > m_sub1_jet_unsub_pT {};
-  std::vector < float > m_sub1_jet_unsub_E {};
-  std::vector < std::vector < int > > m_sub1_jet_comp_ieta {};
-  std::vector < std::vector < int > > m_sub1_jet_comp_iphi {};
-  std::vector < std::vector < int > > m_sub1_jet_comp_caloid {};
-  std::vector < std::vector < int > > m_sub1_jet_comp_status {};
-  std::vector < std::vector < float > > m_sub1_jet_comp_E {};
-  std::vector < std::vector < float > > m_sub1_jet_comp_eta {};
-  std::vector < std::vector < float > > m_sub1_jet_comp_phi {};
-  void ResetSub1Jet()
-  {
-    m_sub1_jet_E.clear();
-    m_sub1_jet_phi.clear();
-    m_sub1_jet_eta.clear();
-    m_sub1_jet_pT.clear();
-    m_sub1_jet_unsub_pT.clear();
-    m_sub1_jet_unsub_E.clear();
-    m_sub1_jet_comp_ieta.clear();
-    m_sub1_jet_comp_iphi.clear();
-    m_sub1_jet_comp_caloid.clear();
-    m_sub1_jet_comp_status.clear();
-    m_sub1_jet_comp_E.clear();
-    m_sub1_jet_comp_eta.clear();
-    m_sub1_jet_comp_phi.clear();
-  }
+  JetColumns m_sub1_jet {};
 
   // truth jet info
   std::vector< std::string > m_truthjet_nodes {};
   TTree * m_truth_jet_trees[16] = { nullptr };
-  std::vector < float > m_truth_jet_E {};
-  std::vector < float > m_truth_jet_phi {};
-  std::vector < float > m_truth_jet_eta {};
-  std::vector < float > m_truth_jet_pT {};
-  void ResetTruthJet()
-  {
-    m_truth_jet_E.clear();
-    m_truth_jet_phi.clear();
-    m_truth_jet_eta.clear();
-    m_truth_jet_pT.clear();
-  }
+  JetColumns m_truth_jet {};
 
   // truth info
   std::string m_g4truth_node { "" };
@@ -476,32 +360,11 @@ class TreeWriter : public SubsysReco
   std::vector < float > m_g4truth_v4 {};
   std::vector < float > m_g4truth_v5 {};
   std::vector < float > m_g4truth_v6 {};
-  void ResetG4Truth()
-  {
-    m_g4truth_id.clear();
-    m_g4truth_status.clear();
-    m_g4truth_px.clear();
-    m_g4truth_py.clear();
-    m_g4truth_pz.clear();
-    m_g4truth_E.clear();
-    m_g4truth_eta.clear();
-    m_g4truth_phi.clear();
-    m_g4truth_pT.clear();
-    m_g4truth_v2.clear();
-    m_g4truth_v3.clear();
-    m_g4truth_v4.clear();
-    m_g4truth_v5.clear();
-    m_g4truth_v6.clear();
-    m_g4truth_v2reco = -999;
-    m_g4truth_v3reco = -999;
-    m_g4truth_v4reco = -999;
-    m_g4truth_v5reco = -999;
-    m_g4truth_v6reco = -999;
-    m_g4truth_zvtx = -999;
-  }
 
 
   int GetGL1( PHCompositeNode *topNode );
+  // vertex, centrality, MBD and event header all come from the EventSummary node
+  EventSummary * GetEventSummary( PHCompositeNode *topNode );
   int GetZvtx( PHCompositeNode *topNode );
   int GetCentInfo( PHCompositeNode *topNode );
   int GetEventHeaderInfo( PHCompositeNode *topNode );
@@ -512,15 +375,12 @@ class TreeWriter : public SubsysReco
   int GetTowerBkgdInfo( PHCompositeNode *topNode );
   int GetSeedInfo( PHCompositeNode *topNode );
   int GetRawJetInfo( PHCompositeNode *topNode , const int idx );
+  int GetUETable( PHCompositeNode *topNode );
   int GetSub1JetInfo( PHCompositeNode *topNode , const int idx );
   int GetTruthJetInfo( PHCompositeNode *topNode , const int idx );
   int GetG4TruthInfo( PHCompositeNode *topNode );
   int GetSepdInfo( PHCompositeNode *topNode );
   int GetEventPlaneInfo( PHCompositeNode *topNode );
-  
-  static void CalcFlow( float b , float eta, float pt, 
-    float &v2 , float &v3, float &v4, float &v5, float &v6 ,
-    TRandom3 * engine, bool do_fluc = false, float scale = 1.0);
  
 };
 
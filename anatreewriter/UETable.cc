@@ -0,0 +1,101 @@
+#include "UETable.h"
+
+#include <calobase/RawTowerDefs.h>
+#include <calobase/RawTowerGeom.h>
+#include <calobase/RawTowerGeomContainer.h>
+
+#include <jetbackground/TowerBackground.h>
+
+#include <algorithm>
+#include <cmath>
+
+UETable::UETable()
+  : m_towers( k_size )
+  , m_ue( k_size, 0.0 )
+{
+}
+
+void UETable::clear_geometry()
+{
+  m_has_geometry = false;
+  std::fill( m_towers.begin(), m_towers.end(), Tower() );
+}
+
+void UETable::set_tower( Tower & t, const float eta, const float phi )
+{
+  t.eta = eta;
+  t.phi = phi;
+  t.cosh_eta = cosh( eta );
+  t.cos_phi = cos( phi );
+  t.sin_phi = sin( phi );
+  t.cos_2phi = cos( 2 * phi );
+  t.sin_2phi = sin( 2 * phi );
+}
+
+void UETable::set_geometry( RawTowerGeomContainer * geomIH, RawTowerGeomContainer * geomOH )
+{
+  for ( int layer = 0; layer < k_nlayers; ++layer )
+  {
+    RawTowerGeomContainer * geom = layer == HCALOUT ? geomOH : geomIH;
+    const auto caloid = layer == HCALOUT ? RawTowerDefs::CalorimeterId::HCALOUT : RawTowerDefs::CalorimeterId::HCALIN;
+    for ( int ieta = 0; ieta < k_neta; ++ieta )
+    {
+      for ( int iphi = 0; iphi < k_nphi; ++iphi )
+      {
+        Tower & t = m_towers[index( layer, ieta, iphi )];
+        t = Tower();
+        auto tower_geom = geom ? geom->get_tower_geometry( RawTowerDefs::encode_towerid( caloid, ieta, iphi ) ) : nullptr;
+        if ( tower_geom ) { set_tower( t, tower_geom->get_eta(), tower_geom->get_phi() ); }
+      }
+    }
+  }
+  m_has_geometry = true;
+}
+
+void UETable::set_tower_geometry( const int layer, const int ieta, const int iphi, const float eta, const float phi )
+{
+  if ( layer < 0 || layer >= k_nlayers || ieta < 0 || ieta >= k_neta || iphi < 0 || iphi >= k_nphi ) { return; }
+  set_tower( m_towers[index( layer, ieta, iphi )], eta, phi );
+  m_has_geometry = true;
+}
+
+void UETable::fill( TowerBackground * background )
+{
+  const std::vector < float > ue_cemc = background->get_UE( CEMC );
+  const std::vector < float > ue_hcalin = background->get_UE( HCALIN );
+  const std::vector < float > ue_hcalout = background->get_UE( HCALOUT );
+  if ( ue_cemc.size() < k_neta || ue_hcalin.size() < k_neta || ue_hcalout.size() < k_neta )
+  {
+    std::fill( m_ue.begin(), m_ue.end(), 0.0 );
+    return;
+  }
+  fill( ue_cemc.data(), ue_hcalin.data(), ue_hcalout.data(),
+        background->get_v2(), background->get_Psi2(), background->get_flow_failure_flag() );
+}
+
+void UETable::fill( const float * ue_cemc, const float * ue_hcalin, const float * ue_hcalout,
+                    const float v2, const float psi2, const bool flow_failure )
+{
+  m_v2 = v2;
+  m_psi2 = psi2;
+  const bool modulate = m_flow_modulation && !flow_failure && v2 != 0;
+
+  // cos( 2 ( phi - Psi2 ) ) from the cached cos 2phi, sin 2phi
+  const double cos_2psi = cos( 2 * psi2 );
+  const double sin_2psi = sin( 2 * psi2 );
+
+  const float * rings[k_nlayers] = { ue_cemc, ue_hcalin, ue_hcalout };
+  for ( int layer = 0; layer < k_nlayers; ++layer )
+  {
+    for ( int ieta = 0; ieta < k_neta; ++ieta )
+    {
+      const float ue = rings[layer][ieta];
+      const int first = index( layer, ieta, 0 );
+      for ( int iphi = 0; iphi < k_nphi; ++iphi )
+      {
+        const Tower & t = m_towers[first + iphi];
+        m_ue[first + iphi] = modulate ? ue * ( 1 + 2 * v2 * ( t.cos_2phi * cos_2psi + t.sin_2phi * sin_2psi ) ) : ue;
+      }
+    }
+  }
+}
@@ -0,0 +1,99 @@
+#ifndef UETABLE_H
+#define UETABLE_H
+
+#include <vector>
+
+class RawTowerGeomContainer;
+class TowerBackground;
+
+// per event underlying event of every ( layer, ieta, iphi ) tower of the
+// HCAL grid, layers CEMC retowered, HCALIN, HCALOUT. The ieta rings of
+// TowerBackground are expanded once per event with the v2 modulation
+// UE * ( 1 + 2 v2 cos( 2 ( phi - Psi2 ) ) ) already applied, so adding the
+// background back to a jet constituent is a single lookup.
+//
+// Tower eta, phi, cosh(eta), cos(phi), sin(phi) are cached once per run.
+// The table is a flat float[3][24][64], data() can be written as a branch
+// and fill() also takes the ring arrays, v2 and Psi2 read back from a
+// tree, so the unsubtraction can be redone offline.
+class UETable
+{
+ public:
+
+  static const int k_nlayers = 3;
+  static const int k_neta = 24;
+  static const int k_nphi = 64;
+  static const int k_size = k_nlayers * k_neta * k_nphi;
+
+  enum LAYER
+  {
+    CEMC = 0,
+    HCALIN = 1,
+    HCALOUT = 2
+  };
+
+  UETable();
+  ~UETable() {}
+
+  // geometry cache, call from InitRun
+  void clear_geometry();
+  bool has_geometry() const { return m_has_geometry; }
+  // retowered CEMC uses the HCALIN geometry, missing towers get eta = phi = 0
+  void set_geometry( RawTowerGeomContainer * geomIH, RawTowerGeomContainer * geomOH );
+  // offline, e.g. from the comp_eta / comp_phi branches
+  void set_tower_geometry( const int layer, const int ieta, const int iphi, const float eta, const float phi );
+
+  // no modulation when off or when the background flags a flow failure
+  void set_flow_modulation( const bool b ) { m_flow_modulation = b; }
+
+  // per event
+  void fill( TowerBackground * background );
+  void fill( const float * ue_cemc, const float * ue_hcalin, const float * ue_hcalout,
+             const float v2, const float psi2, const bool flow_failure );
+
+  float get( const int layer, const int ieta, const int iphi ) const { return m_ue[index( layer, ieta, iphi )]; }
+  float get_eta( const int layer, const int ieta, const int iphi ) const { return m_towers[index( layer, ieta, iphi )].eta; }
+  float get_phi( const int layer, const int ieta, const int iphi ) const { return m_towers[index( layer, ieta, iphi )].phi; }
+  float get_v2() const { return m_v2; }
+  float get_psi2() const { return m_psi2; }
+
+  // layer major, k_size floats, keeps its address
+  float * data() { return m_ue.data(); }
+
+  // add the background back to a subtracted constituent, sums the jet
+  void unsubtract( const int layer, const int ieta, const int iphi, const float E,
+                   float & px, float & py, float & unsub_E ) const
+  {
+    const int i = index( layer, ieta, iphi );
+    const Tower & t = m_towers[i];
+    const float this_unsub_pt = ( E + m_ue[i] ) / t.cosh_eta;
+    px += this_unsub_pt * t.cos_phi;
+    py += this_unsub_pt * t.sin_phi;
+    unsub_E += ( E + m_ue[i] );
+  }
+
+ private:
+
+  static int index( const int layer, const int ieta, const int iphi ) { return ( layer * k_neta + ieta ) * k_nphi + iphi; }
+
+  struct Tower
+  {
+    float eta { 0.0 };
+    float phi { 0.0 };
+    double cosh_eta { 1.0 };
+    double cos_phi { 1.0 };
+    double sin_phi { 0.0 };
+    double cos_2phi { 1.0 };
+    double sin_2phi { 0.0 };
+  };
+  void set_tower( Tower & t, const float eta, const float phi );
+
+  bool m_has_geometry { false };
+  bool m_flow_modulation { true };
+  std::vector < Tower > m_towers {};
+  std::vector < float > m_ue {};
+  float m_v2 { 0.0 };
+  float m_psi2 { 0.0 };
+};
+
+#endif
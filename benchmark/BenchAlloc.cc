@@ -0,0 +1,92 @@
+//===========================================================
+/// \file BenchAlloc.cc
+/// \brief Counting global operator new, compiled into each bench program
+/// \author Tanner Mengel
+//===========================================================
+
+// Replacing the global allocation functions has to happen in the
+// executable, not in libbenchmark, otherwise every library user
+// would pick up the counters. The array forms forward to the scalar
+// ones, the aligned forms ( over-aligned types, C++17 ) count on their
+// own and allocate with std::aligned_alloc, all of it is released with
+// std::free.
+
+#include "BenchUtils.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+void * operator new( std::size_t size )
+{
+  BenchUtils::add_alloc();
+  if ( size == 0 ) { size = 1; }
+  if ( void * p = std::malloc(size) ) { return p; }
+  throw std::bad_alloc();
+}
+
+void * operator new[]( std::size_t size )
+{
+  return ::operator new(size);
+}
+
+void * operator new( std::size_t size, const std::nothrow_t & ) noexcept
+{
+  BenchUtils::add_alloc();
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void * operator new[]( std::size_t size, const std::nothrow_t & tag ) noexcept
+{
+  return ::operator new(size, tag);
+}
+
+void operator delete( void * p ) noexcept { std::free(p); }
+void operator delete[]( void * p ) noexcept { std::free(p); }
+void operator delete( void * p, std::size_t ) noexcept { std::free(p); }
+void operator delete[]( void * p, std::size_t ) noexcept { std::free(p); }
+void operator delete( void * p, const std::nothrow_t & ) noexcept { std::free(p); }
+void operator delete[]( void * p, const std::nothrow_t & ) noexcept { std::free(p); }
+
+#ifdef __cpp_aligned_new
+namespace
+{
+  // aligned_alloc wants the size to be a multiple of the alignment
+  void * aligned_malloc( std::size_t size, std::align_val_t al ) noexcept
+  {
+    const std::size_t align = static_cast< std::size_t >(al);
+    if ( size == 0 ) { size = 1; }
+    return std::aligned_alloc(align, ( size + align - 1 ) / align * align);
+  }
+}
+
+void * operator new( std::size_t size, std::align_val_t al )
+{
+  BenchUtils::add_alloc();
+  if ( void * p = aligned_malloc(size, al) ) { return p; }
+  throw std::bad_alloc();
+}
+
+void * operator new[]( std::size_t size, std::align_val_t al )
+{
+  return ::operator new(size, al);
+}
+
+void * operator new( std::size_t size, std::align_val_t al, const std::nothrow_t & ) noexcept
+{
+  BenchUtils::add_alloc();
+  return aligned_malloc(size, al);
+}
+
+void * operator new[]( std::size_t size, std::align_val_t al, const std::nothrow_t & tag ) noexcept
+{
+  return ::operator new(size, al, tag);
+}
+
+void operator delete( void * p, std::align_val_t ) noexcept { std::free(p); }
+void operator delete[]( void * p, std::align_val_t ) noexcept { std::free(p); }
+void operator delete( void * p, std::size_t, std::align_val_t ) noexcept { std::free(p); }
+void operator delete[]( void * p, std::size_t, std::align_val_t ) noexcept { std::free(p); }
+void operator delete( void * p, std::align_val_t, const std::nothrow_t & ) noexcept { std::free(p); }
+void operator delete[]( void * p, std::align_val_t, const std::nothrow_t & ) noexcept { std::free(p); }
+#endif
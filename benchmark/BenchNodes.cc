@@ -0,0 +1,171 @@
+#include "BenchNodes.h"
+#include "SynthCaloEventGenerator.h"
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHObject.h>
+
+#include <calobase/RawTowerDefs.h>
+#include <calobase/RawTowerGeomContainer_Cylinderv1.h>
+#include <calobase/RawTowerGeomv1.h>
+#include <calobase/TowerInfo.h>
+#include <calobase/TowerInfoContainerv1.h>
+
+#include <globalvertex/GlobalVertex.h>
+#include <globalvertex/GlobalVertexMapv1.h>
+#include <globalvertex/GlobalVertexv1.h>
+
+#include <jetbase/Jet.h>
+#include <jetbase/JetContainerv1.h>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+BenchNodes::BenchNodes()
+{
+  m_topNode = new PHCompositeNode("TOP");
+  m_dstNode = new PHCompositeNode("DST");
+  m_runNode = new PHCompositeNode("RUN");
+  m_topNode->addNode(m_dstNode);
+  m_topNode->addNode(m_runNode);
+
+  m_cemc = AddTowers("TOWERINFO_CALIB_CEMC", true);
+  m_cemc_retower = AddTowers("TOWERINFO_CALIB_CEMC_RETOWER", false);
+  m_hcalin = AddTowers("TOWERINFO_CALIB_HCALIN", false);
+  m_hcalout = AddTowers("TOWERINFO_CALIB_HCALOUT", false);
+
+  AddGeometry("TOWERGEOM_CEMC", RawTowerDefs::CalorimeterId::CEMC,
+              SynthCaloEvent::k_neta_emcal, SynthCaloEvent::k_nphi_emcal,
+              SynthCaloEventGenerator::calo_radius(SynthCaloEventGenerator::CEMC));
+  AddGeometry("TOWERGEOM_HCALIN", RawTowerDefs::CalorimeterId::HCALIN,
+              SynthCaloEvent::k_neta, SynthCaloEvent::k_nphi,
+              SynthCaloEventGenerator::calo_radius(SynthCaloEventGenerator::HCALIN));
+  AddGeometry("TOWERGEOM_HCALOUT", RawTowerDefs::CalorimeterId::HCALOUT,
+              SynthCaloEvent::k_neta, SynthCaloEvent::k_nphi,
+              SynthCaloEventGenerator::calo_radius(SynthCaloEventGenerator::HCALOUT));
+
+  auto vertexmap = new GlobalVertexMapv1();
+  m_vertex = new GlobalVertexv1(GlobalVertex::MBD);
+  m_vertex->set_z(0.0);
+  vertexmap->insert(m_vertex);
+  m_dstNode->addNode(new PHIODataNode<PHObject>(vertexmap, "GlobalVertexMap", "PHObject"));
+}
+
+BenchNodes::~BenchNodes()
+{
+  // deletes every node below TOP
+  delete m_topNode;
+}
+
+void BenchNodes::add_jet_node( const std::string & name )
+{
+  auto jets = new JetContainerv1();
+  // properties the overlay modules write back onto the jets
+  jets->add_property({ Jet::PROPERTY::prop_JetCharge, Jet::PROPERTY::prop_BFrac,
+                       Jet::PROPERTY::prop_area, Jet::PROPERTY::prop_zg });
+  m_dstNode->addNode(new PHIODataNode<PHObject>(jets, name, "PHObject"));
+  m_jets.push_back(jets);
+}
+
+TowerInfoContainer * BenchNodes::AddTowers( const std::string & name, const bool is_emcal )
+{
+  auto towers = new TowerInfoContainerv1( is_emcal ? TowerInfoContainer::DETECTOR::EMCAL
+                                                   : TowerInfoContainer::DETECTOR::HCAL );
+  m_dstNode->addNode(new PHIODataNode<PHObject>(towers, name, "PHObject"));
+  return towers;
+}
+
+void BenchNodes::AddGeometry( const std::string & name, const int caloid, const int neta, const int nphi, const float radius )
+{
+  const auto id = static_cast<RawTowerDefs::CalorimeterId>(caloid);
+
+  auto geom = new RawTowerGeomContainer_Cylinderv1(id);
+  geom->set_radius(radius);
+  geom->set_thickness(1.0);
+  geom->set_etabins(neta);
+  geom->set_phibins(nphi);
+
+  for ( int ieta = 0; ieta < neta; ++ieta )
+  {
+    const float eta = SynthCaloEventGenerator::tower_eta(ieta, neta);
+    for ( int iphi = 0; iphi < nphi; ++iphi )
+    {
+      const float phi = SynthCaloEventGenerator::tower_phi(iphi, nphi);
+      auto tower_geom = new RawTowerGeomv1(RawTowerDefs::encode_towerid(id, ieta, iphi));
+      tower_geom->set_center_x(radius * std::cos(phi));
+      tower_geom->set_center_y(radius * std::sin(phi));
+      tower_geom->set_center_z(radius * std::sinh(eta));
+      geom->add_tower_geometry(tower_geom);
+    }
+  }
+
+  m_runNode->addNode(new PHIODataNode<PHObject>(geom, name, "PHObject"));
+}
+
+void BenchNodes::FillHcal( TowerInfoContainer * towers,
+                           const float E[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi],
+                           const int isgood[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi],
+                           const int ishot[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi] )
+{
+  const unsigned int nchannels = towers->size();
+  for ( unsigned int channel = 0; channel < nchannels; ++channel )
+  {
+    auto tower = towers->get_tower_at_channel(channel);
+    assert(tower);
+    const unsigned int key = towers->encode_key(channel);
+    const int ieta = towers->getTowerEtaBin(key);
+    const int iphi = towers->getTowerPhiBin(key);
+
+    const bool hot = ishot && ishot[ieta][iphi] > 0;
+    tower->set_status(0);
+    tower->set_energy(E[ieta][iphi]);
+    tower->set_isHot(hot);
+    tower->set_isNotInstr(isgood[ieta][iphi] <= 0 && !hot);
+  }
+}
+
+void BenchNodes::Load( const SynthCaloEvent & evt )
+{
+  FillHcal(m_cemc_retower, evt.cemc_E, evt.cemc_isgood, nullptr);
+  FillHcal(m_hcalin, evt.hcalin_E, evt.hcalin_isgood, evt.hcalin_ishot);
+  FillHcal(m_hcalout, evt.hcalout_E, evt.hcalout_isgood, evt.hcalout_ishot);
+
+  const unsigned int nchannels = m_cemc->size();
+  for ( unsigned int channel = 0; channel < nchannels; ++channel )
+  {
+    auto tower = m_cemc->get_tower_at_channel(channel);
+    assert(tower);
+    const unsigned int key = m_cemc->encode_key(channel);
+    const int ieta = m_cemc->getTowerEtaBin(key);
+    const int iphi = m_cemc->getTowerPhiBin(key);
+
+    const bool hot = evt.cemc_full_ishot[ieta][iphi] > 0;
+    tower->set_status(0);
+    tower->set_energy(evt.cemc_full_E[ieta][iphi]);
+    tower->set_isHot(hot);
+    tower->set_isNotInstr(evt.cemc_full_isgood[ieta][iphi] <= 0 && !hot);
+  }
+
+  m_vertex->set_z(evt.zvrtx);
+
+  for ( auto jets : m_jets )
+  {
+    jets->Reset();
+    for ( const auto & synth : evt.jets )
+    {
+      auto jet = jets->add_jet();
+      const float px = synth.pt * std::cos(synth.phi);
+      const float py = synth.pt * std::sin(synth.phi);
+      const float pz = synth.pt * std::sinh(synth.eta);
+      jet->set_px(px);
+      jet->set_py(py);
+      jet->set_pz(pz);
+      jet->set_e(synth.e);
+      for ( const auto & comp : synth.comps )
+      {
+        jet->insert_comp(comp.first, comp.second);
+      }
+    }
+  }
+}
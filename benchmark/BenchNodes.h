@@ -0,0 +1,69 @@
+#ifndef BENCHMARK_BENCHNODES_H
+#define BENCHMARK_BENCHNODES_H
+
+//===========================================================
+/// \file BenchNodes.h
+/// \brief Fun4All node tree filled from SynthCaloEvent for the bench programs
+/// \author Tanner Mengel
+//===========================================================
+
+#include "SynthCaloEvent.h"
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class TowerInfoContainer;
+class GlobalVertex;
+class JetContainer;
+
+// Builds TOP/{DST,RUN} with the nodes the analysis modules look up:
+//   DST: TOWERINFO_CALIB_CEMC, TOWERINFO_CALIB_CEMC_RETOWER,
+//        TOWERINFO_CALIB_HCALIN, TOWERINFO_CALIB_HCALOUT,
+//        GlobalVertexMap and one JetContainer per add_jet_node
+//   RUN: TOWERGEOM_CEMC, TOWERGEOM_HCALIN, TOWERGEOM_HCALOUT
+// Load() overwrites tower energies/status, the vertex and the jets
+// with the given event. The node tree owns every object.
+class BenchNodes
+{
+  public:
+
+    BenchNodes();
+    ~BenchNodes();
+
+    // jet containers filled from SynthCaloEvent::jets on Load
+    void add_jet_node( const std::string & name );
+
+    PHCompositeNode * topNode() const { return m_topNode; }
+
+    void Load( const SynthCaloEvent & evt );
+
+    // towers in the retowered + hcal containers, and in the full cemc
+    static unsigned long n_hcal_towers() { return SynthCaloEvent::k_neta * SynthCaloEvent::k_nphi; }
+    static unsigned long n_emcal_towers() { return SynthCaloEvent::k_neta_emcal * SynthCaloEvent::k_nphi_emcal; }
+
+  private:
+
+    PHCompositeNode * m_topNode { nullptr };
+    PHCompositeNode * m_dstNode { nullptr };
+    PHCompositeNode * m_runNode { nullptr };
+
+    TowerInfoContainer * m_cemc { nullptr };
+    TowerInfoContainer * m_cemc_retower { nullptr };
+    TowerInfoContainer * m_hcalin { nullptr };
+    TowerInfoContainer * m_hcalout { nullptr };
+
+    GlobalVertex * m_vertex { nullptr };
+
+    std::vector< JetContainer * > m_jets {};
+
+    TowerInfoContainer * AddTowers( const std::string & name, const bool is_emcal );
+    void AddGeometry( const std::string & name, const int caloid, const int neta, const int nphi, const float radius );
+
+    static void FillHcal( TowerInfoContainer * towers,
+                          const float E[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi],
+                          const int isgood[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi],
+                          const int ishot[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi] ); // may be null
+};
+
+#endif // BENCHMARK_BENCHNODES_H
@@ -0,0 +1,336 @@
+#include "BenchUtils.h"
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+  std::atomic< unsigned long > g_nallocs { 0 };
+
+  // minimal reader for the flat two level object written by WriteBaseline
+  class BaselineParser
+  {
+    public:
+
+      BaselineParser( const std::string & text ) : m_text( text ) {}
+
+      bool Parse( std::map< std::string, BenchUtils::BaselineEntry > & baseline )
+      {
+        if ( !Expect('{') ) { return false; }
+        if ( Peek() == '}' ) { ++m_pos; return true; }
+        while ( true )
+        {
+          std::string name {};
+          if ( !String(name) || !Expect(':') || !Expect('{') ) { return false; }
+
+          BenchUtils::BaselineEntry entry {};
+          if ( Peek() != '}' )
+          {
+            while ( true )
+            {
+              std::string key {};
+              double value = 0;
+              if ( !String(key) || !Expect(':') || !Number(value) ) { return false; }
+              if ( key == "events_per_s" ) { entry.events_per_s = value; }
+              else if ( key == "towers_per_s" ) { entry.towers_per_s = value; }
+              else if ( key == "allocs_per_event" ) { entry.allocs_per_event = value; }
+              if ( Peek() == ',' ) { ++m_pos; continue; }
+              break;
+            }
+          }
+          if ( !Expect('}') ) { return false; }
+          baseline[name] = entry;
+
+          if ( Peek() == ',' ) { ++m_pos; continue; }
+          break;
+        }
+        return Expect('}');
+      }
+
+    private:
+
+      const std::string & m_text;
+      size_t m_pos { 0 };
+
+      char Peek()
+      {
+        while ( m_pos < m_text.size() && std::isspace( static_cast<unsigned char>( m_text[m_pos] ) ) ) { ++m_pos; }
+        return m_pos < m_text.size() ? m_text[m_pos] : '\0';
+      }
+
+      bool Expect( const char c )
+      {
+        if ( Peek() != c ) { return false; }
+        ++m_pos;
+        return true;
+      }
+
+      bool String( std::string & s )
+      {
+        if ( !Expect('"') ) { return false; }
+        const size_t end = m_text.find('"', m_pos);
+        if ( end == std::string::npos ) { return false; }
+        s = m_text.substr(m_pos, end - m_pos);
+        m_pos = end + 1;
+        return true;
+      }
+
+      bool Number( double & value )
+      {
+        Peek();
+        const char * begin = m_text.c_str() + m_pos;
+        char * end = nullptr;
+        value = std::strtod(begin, &end);
+        if ( end == begin ) { return false; }
+        m_pos += static_cast<size_t>( end - begin );
+        return true;
+      }
+  };
+
+} // namespace
+
+unsigned long BenchUtils::get_alloc_count()
+{
+  return g_nallocs.load(std::memory_order_relaxed);
+}
+
+void BenchUtils::add_alloc()
+{
+  g_nallocs.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool BenchUtils::ParseArgs( int argc, char ** argv, BenchOptions & opts )
+{
+  for ( int i = 1; i < argc; ++i )
+  {
+    const std::string arg = argv[i];
+    const bool has_next = ( i + 1 < argc );
+
+    if ( arg == "--nevents" && has_next ) { opts.nevents = std::strtoul(argv[++i], nullptr, 10); }
+    else if ( arg == "--warmup" && has_next ) { opts.nwarmup = std::strtoul(argv[++i], nullptr, 10); }
+    else if ( arg == "--seed" && has_next ) { opts.seed = std::strtoul(argv[++i], nullptr, 10); }
+    else if ( arg == "--cent" && i + 2 < argc )
+    {
+      opts.cent_min = std::atoi(argv[++i]);
+      opts.cent_max = std::atoi(argv[++i]);
+    }
+    else if ( arg == "--threads" && has_next ) { opts.nthreads = std::strtoul(argv[++i], nullptr, 10); }
+    else if ( arg == "--baseline" && has_next ) { opts.baseline = argv[++i]; }
+    else if ( arg == "--tolerance" && has_next ) { opts.tolerance = std::strtof(argv[++i], nullptr); }
+    else if ( arg == "--update-baseline" ) { opts.update_baseline = true; }
+    else if ( arg == "-v" ) { opts.verbosity++; }
+    else
+    {
+      std::cout << "Unknown argument " << arg << std::endl;
+      std::cout << "usage: " << argv[0]
+                << " [--nevents N] [--warmup N] [--seed N] [--cent MIN MAX] [--threads N]"
+                << " [--baseline FILE] [--tolerance X] [--update-baseline] [-v]" << std::endl;
+      return false;
+    }
+  }
+
+  if ( opts.nevents == 0 )
+  {
+    std::cout << "BenchUtils::ParseArgs - nevents must be > 0" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+BenchUtils::BenchResult BenchUtils::Run( const std::string & name,
+                                         const BenchOptions & opts,
+                                         const unsigned long towers_per_event,
+                                         const std::function< void( unsigned int ) > & setup,
+                                         const std::function< void( unsigned int ) > & kernel )
+{
+  // warm caches and first-event lazy initialisation, not counted
+  for ( unsigned int i = 0; i < opts.nwarmup; ++i )
+  {
+    setup(i);
+    kernel(i);
+  }
+
+  BenchResult result {};
+  result.name = name;
+  result.nevents = opts.nevents;
+  result.ntowers = towers_per_event * opts.nevents;
+
+  std::chrono::steady_clock::duration elapsed {0};
+  for ( unsigned int i = 0; i < opts.nevents; ++i )
+  {
+    setup(i);
+
+    const unsigned long allocs_start = get_alloc_count();
+    const auto start = std::chrono::steady_clock::now();
+    kernel(i);
+    elapsed += std::chrono::steady_clock::now() - start;
+    result.nallocs += get_alloc_count() - allocs_start;
+  }
+
+  result.seconds = std::chrono::duration<double>(elapsed).count();
+
+  if ( opts.verbosity > 0 )
+  {
+    std::cout << "BenchUtils::Run - " << name << " done in " << result.seconds << " s" << std::endl;
+  }
+
+  return result;
+}
+
+bool BenchUtils::ReadBaseline( const std::string & filename, std::map< std::string, BaselineEntry > & baseline )
+{
+  std::ifstream in(filename);
+  if ( !in.is_open() )
+  {
+    std::cout << "BenchUtils::ReadBaseline - cannot open " << filename << std::endl;
+    return false;
+  }
+
+  std::stringstream ss;
+  ss << in.rdbuf();
+  const std::string text = ss.str();
+
+  BaselineParser parser(text);
+  if ( !parser.Parse(baseline) )
+  {
+    std::cout << "BenchUtils::ReadBaseline - malformed baseline " << filename << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool BenchUtils::WriteBaseline( const std::string & filename, const std::map< std::string, BaselineEntry > & baseline )
+{
+  std::ofstream out(filename);
+  if ( !out.is_open() )
+  {
+    std::cout << "BenchUtils::WriteBaseline - cannot open " << filename << std::endl;
+    return false;
+  }
+
+  out << std::setprecision(6) << "{\n";
+  unsigned int n = 0;
+  for ( const auto & entry : baseline )
+  {
+    out << "  \"" << entry.first << "\" : { "
+        << "\"events_per_s\" : " << entry.second.events_per_s << ", "
+        << "\"towers_per_s\" : " << entry.second.towers_per_s << ", "
+        << "\"allocs_per_event\" : " << entry.second.allocs_per_event << " }"
+        << ( ++n < baseline.size() ? ",\n" : "\n" );
+  }
+  out << "}\n";
+
+  return true;
+}
+
+void BenchUtils::BenchReport::Add( const BenchResult & result )
+{
+  m_results.push_back(result);
+}
+
+void BenchUtils::BenchReport::Print( std::ostream & os ) const
+{
+  os << "================================================================================" << std::endl;
+  os << " " << m_suite << std::endl;
+  os << "--------------------------------------------------------------------------------" << std::endl;
+  os << std::left << std::setw(32) << " kernel"
+     << std::right << std::setw(14) << "events/s"
+     << std::setw(16) << "towers/s"
+     << std::setw(16) << "allocs/event" << std::endl;
+  for ( const auto & r : m_results )
+  {
+    os << std::left << std::setw(32) << " " + r.name
+       << std::right << std::fixed << std::setprecision(1)
+       << std::setw(14) << r.events_per_s()
+       << std::setw(16) << std::setprecision(0) << r.towers_per_s()
+       << std::setw(16) << std::setprecision(2) << r.allocs_per_event() << std::endl;
+  }
+  os << std::defaultfloat;
+  os << "================================================================================" << std::endl;
+}
+
+int BenchUtils::BenchReport::Compare( const std::string & filename, const float tolerance, std::ostream & os ) const
+{
+  std::map< std::string, BaselineEntry > baseline {};
+  if ( !ReadBaseline(filename, baseline) ) { return -1; }
+
+  int nregress = 0;
+  for ( const auto & r : m_results )
+  {
+    auto it = baseline.find(r.name);
+    if ( it == baseline.end() || it->second.events_per_s <= 0 )
+    {
+      // nothing to compare to yet, reported but not a regression
+      os << " " << r.name << " : [WARNING: no baseline, run make bench-update on the reference machine]" << std::endl;
+      continue;
+    }
+
+    const BaselineEntry & base = it->second;
+    const double speed_ratio = r.events_per_s() / base.events_per_s;
+
+    // one allocation of slack so a 0 baseline does not flag a single alloc
+    const bool slow = speed_ratio < ( 1.0 - tolerance );
+    const bool allocs = r.allocs_per_event() > base.allocs_per_event * ( 1.0 + tolerance ) + 1.0;
+
+    os << " " << r.name << " : " << std::fixed << std::setprecision(3)
+       << speed_ratio << "x baseline throughput, "
+       << std::setprecision(2) << r.allocs_per_event() << " / " << base.allocs_per_event << " allocs/event";
+    if ( slow ) { os << " [REGRESSION: throughput]"; }
+    if ( allocs ) { os << " [REGRESSION: allocations]"; }
+    os << std::defaultfloat << std::endl;
+
+    if ( slow || allocs ) { nregress++; }
+  }
+
+  return nregress;
+}
+
+bool BenchUtils::BenchReport::Update( const std::string & filename ) const
+{
+  // keep the other suites' entries
+  std::map< std::string, BaselineEntry > baseline {};
+  ReadBaseline(filename, baseline);
+
+  for ( const auto & r : m_results )
+  {
+    BaselineEntry & entry = baseline[r.name];
+    entry.events_per_s = r.events_per_s();
+    entry.towers_per_s = r.towers_per_s();
+    entry.allocs_per_event = r.allocs_per_event();
+  }
+
+  return WriteBaseline(filename, baseline);
+}
+
+int BenchUtils::BenchReport::Finish( const BenchOptions & opts ) const
+{
+  Print();
+
+  if ( opts.baseline.empty() ) { return 0; }
+
+  if ( opts.update_baseline )
+  {
+    if ( !Update(opts.baseline) ) { return 1; }
+    std::cout << m_suite << ": baseline " << opts.baseline << " updated" << std::endl;
+    return 0;
+  }
+
+  const int nregress = Compare(opts.baseline, opts.tolerance);
+  if ( nregress < 0 ) { return 1; }
+  if ( nregress > 0 )
+  {
+    std::cout << m_suite << ": " << nregress << " regression(s) beyond tolerance "
+              << opts.tolerance << std::endl;
+    return 1;
+  }
+
+  std::cout << m_suite << ": all kernels within tolerance " << opts.tolerance << std::endl;
+  return 0;
+}
@@ -0,0 +1,121 @@
+#ifndef BENCHMARK_BENCHUTILS_H
+#define BENCHMARK_BENCHUTILS_H
+
+//===========================================================
+/// \file BenchUtils.h
+/// \brief Timing, allocation counting and baseline comparison for the bench programs
+/// \author Tanner Mengel
+//===========================================================
+
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace BenchUtils
+{
+  // ----------------------------------
+  // allocation counting
+  // ----------------------------------
+  // counts are bumped by the global operator new in BenchAlloc.cc,
+  // which every bench program links in. Without it they stay at 0.
+  unsigned long get_alloc_count();
+  void add_alloc();
+
+  // ----------------------------------
+  // options shared by all bench programs
+  // ----------------------------------
+  struct BenchOptions
+  {
+    unsigned int nevents {200};
+    unsigned int nwarmup {5};
+    unsigned int seed {42};
+    int cent_min {0};
+    int cent_max {10};
+    unsigned int nthreads {4}; // for kernels that time implicit MT
+    std::string baseline {""};
+    float tolerance {0.15};
+    bool update_baseline {false};
+    int verbosity {0};
+  };
+
+  // --nevents N --warmup N --seed N --cent MIN MAX --threads N
+  // --baseline FILE --tolerance X --update-baseline -v
+  // returns false on unknown arguments
+  bool ParseArgs( int argc, char ** argv, BenchOptions & opts );
+
+  // ----------------------------------
+  // one timed kernel
+  // ----------------------------------
+  struct BenchResult
+  {
+    std::string name {""};
+    unsigned long nevents {0};
+    unsigned long ntowers {0}; // total towers touched
+    double seconds {0.0};
+    unsigned long nallocs {0};
+
+    double events_per_s() const { return seconds > 0 ? nevents / seconds : 0.0; }
+    double towers_per_s() const { return seconds > 0 ? ntowers / seconds : 0.0; }
+    double allocs_per_event() const { return nevents > 0 ? static_cast<double>(nallocs) / nevents : 0.0; }
+  };
+
+  // setup is called untimed before every kernel call ( e.g. to load
+  // the next synthetic event onto the node tree ), kernel is timed and
+  // its allocations counted. towers_per_event only feeds towers/s.
+  BenchResult Run( const std::string & name,
+                   const BenchOptions & opts,
+                   const unsigned long towers_per_event,
+                   const std::function< void( unsigned int ) > & setup,
+                   const std::function< void( unsigned int ) > & kernel );
+
+  // ----------------------------------
+  // baseline
+  // ----------------------------------
+  // the baseline is a flat JSON object keyed by kernel name:
+  // { "name" : { "events_per_s" : x, "towers_per_s" : y, "allocs_per_event" : z }, ... }
+  // entries with events_per_s <= 0 are treated as not yet recorded,
+  // the comparison warns about them without failing
+  struct BaselineEntry
+  {
+    double events_per_s {0.0};
+    double towers_per_s {0.0};
+    double allocs_per_event {0.0};
+  };
+
+  bool ReadBaseline( const std::string & filename, std::map< std::string, BaselineEntry > & baseline );
+  bool WriteBaseline( const std::string & filename, const std::map< std::string, BaselineEntry > & baseline );
+
+  class BenchReport
+  {
+    public:
+
+      BenchReport( const std::string & suite ) : m_suite( suite ) {}
+      ~BenchReport() {}
+
+      void Add( const BenchResult & result );
+      void Print( std::ostream & os = std::cout ) const;
+
+      // throughput below (1-tolerance)*baseline or allocations above
+      // (1+tolerance)*baseline count as regressions, kernels without a
+      // recorded baseline are only reported
+      // returns the number of regressions, -1 if the file can't be read
+      int Compare( const std::string & filename, const float tolerance, std::ostream & os = std::cout ) const;
+
+      // merge this suite's results into the baseline file
+      bool Update( const std::string & filename ) const;
+
+      // parse options already applied: print, compare or update
+      // returns the process exit code
+      int Finish( const BenchOptions & opts ) const;
+
+    private:
+
+      std::string m_suite {""};
+      std::vector< BenchResult > m_results {};
+  };
+
+} // namespace BenchUtils
+
+#endif // BENCHMARK_BENCHUTILS_H
@@ -0,0 +1,72 @@
+#ifndef BENCHMARK_SYNTHCALOEVENT_H
+#define BENCHMARK_SYNTHCALOEVENT_H
+
+//===========================================================
+/// \file SynthCaloEvent.h
+/// \brief Plain per-event container filled by SynthCaloEventGenerator
+/// \author Tanner Mengel
+//===========================================================
+
+#include <jetbase/Jet.h>
+
+#include <utility>
+#include <vector>
+
+// embedded jet with its (Jet::SRC, channel) constituents,
+// same form as Jet::get_comp_vec()
+struct SynthJet
+{
+  float pt {0.0};
+  float eta {0.0};
+  float phi {0.0};
+  float e {0.0};
+  float em_frac {0.0};
+  std::vector< std::pair< Jet::SRC, unsigned int > > comps {};
+};
+
+// fixed size grids so an event can be handed straight to
+// TTree::Branch / SetBranchAddress ( layout matches TreeWriter )
+// the struct is ~250 kB, allocate it on the heap
+struct SynthCaloEvent
+{
+  static const int k_neta = 24;
+  static const int k_nphi = 64;
+  static const int k_neta_emcal = 96;
+  static const int k_nphi_emcal = 256;
+
+  int event_id {-1};
+  int cent {-1};
+  float b {0.0};
+  float zvrtx {0.0};
+  float psi2 {0.0};
+  float psi3 {0.0};
+  float v2 {0.0};
+  float v3 {0.0};
+
+  float sum_eT_all {0.0};
+  float sum_eT_cemc {0.0};
+  float sum_eT_hcalin {0.0};
+  float sum_eT_hcalout {0.0};
+
+  // retowered cemc + hcals (ieta, iphi)
+  float cemc_E[k_neta][k_nphi] {};
+  float hcalin_E[k_neta][k_nphi] {};
+  float hcalout_E[k_neta][k_nphi] {};
+  int cemc_isgood[k_neta][k_nphi] {};
+  int hcalin_isgood[k_neta][k_nphi] {};
+  int hcalout_isgood[k_neta][k_nphi] {};
+
+  // full granularity cemc
+  float cemc_full_E[k_neta_emcal][k_nphi_emcal] {};
+  int cemc_full_isgood[k_neta_emcal][k_nphi_emcal] {};
+
+  // hot towers are also flagged not good, this keeps
+  // hot vs dead separable for the status scans
+  int cemc_full_ishot[k_neta_emcal][k_nphi_emcal] {};
+  int hcalin_ishot[k_neta][k_nphi] {};
+  int hcalout_ishot[k_neta][k_nphi] {};
+
+  std::vector< SynthJet > jets {};
+};
+
+#endif // BENCHMARK_SYNTHCALOEVENT_H
@@ -0,0 +1,479 @@
+#include "SynthCaloEventGenerator.h"
+
+#include <calobase/TowerInfoDefs.h>
+
+#include <TFile.h>
+#include <TRandom3.h>
+#include <TString.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+SynthCaloEventGenerator::SynthCaloEventGenerator( const unsigned int seed )
+  : m_seed( seed )
+{
+  m_rng = new TRandom3( m_seed );
+  BuildChannelMap();
+}
+
+SynthCaloEventGenerator::~SynthCaloEventGenerator()
+{
+  delete m_rng;
+}
+
+float SynthCaloEventGenerator::tower_eta( const int ieta, const int neta )
+{
+  const float deta = 2.0 * k_max_abs_eta / neta;
+  return -k_max_abs_eta + ( ieta + 0.5 ) * deta;
+}
+
+float SynthCaloEventGenerator::tower_phi( const int iphi, const int nphi )
+{
+  const float dphi = 2.0 * M_PI / nphi;
+  return ( iphi + 0.5 ) * dphi;
+}
+
+float SynthCaloEventGenerator::correct_calo_eta( const float eta0, const float zvrtx, const float R )
+{
+  double z0 = sinh(eta0) * R;
+  double z = z0 - zvrtx;
+  return asinh(z / R);
+}
+
+void SynthCaloEventGenerator::BuildChannelMap()
+{
+  // keys are (ieta << 16) + iphi, the containers give back the channel
+  for ( int ieta = 0; ieta < SynthCaloEvent::k_neta; ieta++ )
+  {
+    for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi; iphi++ )
+    {
+      unsigned int key = ( static_cast<unsigned int>(ieta) << 16U ) + static_cast<unsigned int>(iphi);
+      m_hcal_channel[ieta][iphi] = TowerInfoDefs::decode_hcal( key );
+    }
+  }
+  for ( int ieta = 0; ieta < SynthCaloEvent::k_neta_emcal; ieta++ )
+  {
+    for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi_emcal; iphi++ )
+    {
+      unsigned int key = ( static_cast<unsigned int>(ieta) << 16U ) + static_cast<unsigned int>(iphi);
+      m_emcal_channel[ieta][iphi] = TowerInfoDefs::decode_emcal( key );
+    }
+  }
+}
+
+void SynthCaloEventGenerator::BuildTowerMap()
+{
+  // drawn from a separate stream so changing the map
+  // does not shift the event sequence
+  TRandom3 rng( m_seed + 1 );
+  auto draw = [&]() -> int {
+    float u = rng.Uniform();
+    if ( u < m_dead_frac ) { return 1; }
+    if ( u < m_dead_frac + m_hot_frac ) { return 2; }
+    return 0;
+  };
+
+  for ( int ieta = 0; ieta < SynthCaloEvent::k_neta_emcal; ieta++ )
+  {
+    for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi_emcal; iphi++ )
+    {
+      m_emcal_status[ieta][iphi] = draw();
+    }
+  }
+  for ( int ieta = 0; ieta < SynthCaloEvent::k_neta; ieta++ )
+  {
+    for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi; iphi++ )
+    {
+      m_hcalin_status[ieta][iphi] = draw();
+      m_hcalout_status[ieta][iphi] = draw();
+    }
+  }
+
+  m_map_valid = true;
+}
+
+float SynthCaloEventGenerator::ue_scale( const int cent ) const
+{
+  // roughly npart-like falloff, 1 at 0% and ~0.01 at 95%
+  float x = 1.0 - std::min( std::max( cent, 0 ), 100 ) / 100.0;
+  return std::pow( x, 2.5 ) + 0.005;
+}
+
+float SynthCaloEventGenerator::ue_occupancy( const LAYER layer, const int cent ) const
+{
+  const float occ_central[3] { 0.95, 0.80, 0.90 };
+  const float occ_periph[3] { 0.10, 0.05, 0.10 };
+  float s = std::min( ue_scale( cent ), 1.0f );
+  return occ_periph[layer] + ( occ_central[layer] - occ_periph[layer] ) * s;
+}
+
+float SynthCaloEventGenerator::v2_of_cent( const int cent ) const
+{
+  // peaks ~0.08 in mid central
+  float c = std::min( std::max( cent, 0 ), 80 );
+  return 0.02 + 0.06 * sin( M_PI * c / 80.0 );
+}
+
+void SynthCaloEventGenerator::Generate( SynthCaloEvent & evt )
+{
+  if ( !m_map_valid )
+  {
+    BuildTowerMap();
+  }
+
+  m_event_id++;
+  evt.event_id = m_event_id;
+  evt.cent = m_cent_min + static_cast<int>( m_rng->Integer( std::max( m_cent_max - m_cent_min, 1 ) ) );
+  evt.b = k_b_max * sqrt( ( evt.cent + m_rng->Uniform() ) / 100.0 );
+
+  float zvrtx = m_rng->Gaus( 0.0, m_zvrtx_sigma );
+  while ( std::abs( zvrtx ) > m_max_abs_zvrtx )
+  {
+    zvrtx = m_rng->Gaus( 0.0, m_zvrtx_sigma );
+  }
+  evt.zvrtx = zvrtx;
+
+  evt.psi2 = m_rng->Uniform( -M_PI / 2.0, M_PI / 2.0 );
+  evt.psi3 = m_rng->Uniform( -M_PI / 3.0, M_PI / 3.0 );
+  evt.v2 = m_do_flow ? v2_of_cent( evt.cent ) : 0.0;
+  evt.v3 = m_do_flow ? 0.02 : 0.0;
+
+  FillUE( evt );
+  EmbedJets( evt );
+  ApplyTowerMap( evt );
+  Retower( evt );
+  FillConstituents( evt );
+  SumET( evt );
+
+  if ( m_verbosity > 1 )
+  {
+    std::cout << "SynthCaloEventGenerator::Generate - event " << evt.event_id
+              << " cent = " << evt.cent << ", zvrtx = " << evt.zvrtx
+              << ", njets = " << evt.jets.size() << ", sum_eT_all = " << evt.sum_eT_all << std::endl;
+  }
+}
+
+void SynthCaloEventGenerator::FillUE( SynthCaloEvent & evt )
+{
+  const float scale = ue_scale( evt.cent );
+
+  auto fill_grid = [&]( const LAYER layer, float * grid, const int neta, const int nphi )
+  {
+    const float occ = ue_occupancy( layer, evt.cent );
+    const float mean_eT = m_central_sumeT[layer] * scale / ( neta * nphi );
+    const float R = k_calo_radius[layer];
+    for ( int ieta = 0; ieta < neta; ieta++ )
+    {
+      const float eta = correct_calo_eta( tower_eta( ieta, neta ), evt.zvrtx, R );
+      const float coshEta = cosh( eta );
+      for ( int iphi = 0; iphi < nphi; iphi++ )
+      {
+        float eT = 0;
+        if ( m_rng->Uniform() < occ )
+        {
+          eT = m_rng->Exp( mean_eT / occ );
+        }
+        if ( m_do_flow )
+        {
+          const float phi = tower_phi( iphi, nphi );
+          eT *= 1.0 + 2.0 * evt.v2 * cos( 2.0 * ( phi - evt.psi2 ) )
+                    + 2.0 * evt.v3 * cos( 3.0 * ( phi - evt.psi3 ) );
+        }
+        eT += m_rng->Gaus( 0.0, m_noise[layer] );
+        grid[ieta * nphi + iphi] = eT * coshEta;
+      }
+    }
+  };
+
+  fill_grid( CEMC, &evt.cemc_full_E[0][0], SynthCaloEvent::k_neta_emcal, SynthCaloEvent::k_nphi_emcal );
+  fill_grid( HCALIN, &evt.hcalin_E[0][0], SynthCaloEvent::k_neta, SynthCaloEvent::k_nphi );
+  fill_grid( HCALOUT, &evt.hcalout_E[0][0], SynthCaloEvent::k_neta, SynthCaloEvent::k_nphi );
+}
+
+void SynthCaloEventGenerator::EmbedJets( SynthCaloEvent & evt )
+{
+  evt.jets.clear();
+
+  const int njets = m_rng->Poisson( m_mean_njets );
+  const float max_abs_eta = k_max_abs_eta - m_jet_R;
+  const float sigma = 0.25 * m_jet_R;
+
+  // inverse cdf of pt^-n on [min, max]
+  const double a = 1.0 - m_jet_pt_power;
+  const double lo = std::pow( m_jet_pt_min, a );
+  const double hi = std::pow( m_jet_pt_max, a );
+
+  auto deposit = [&]( const LAYER layer, float * grid, const int neta, const int nphi, const SynthJet & jet, const float eT_layer )
+  {
+    const float R = k_calo_radius[layer];
+    std::vector< float > w ( neta * nphi, 0.0 );
+    std::vector< float > coshEta ( neta, 1.0 );
+    float sum_w = 0;
+    for ( int ieta = 0; ieta < neta; ieta++ )
+    {
+      const float eta = correct_calo_eta( tower_eta( ieta, neta ), evt.zvrtx, R );
+      coshEta[ieta] = cosh( eta );
+      const float deta = eta - jet.eta;
+      if ( std::abs( deta ) > m_jet_R ) { continue; }
+      for ( int iphi = 0; iphi < nphi; iphi++ )
+      {
+        float dphi = std::abs( tower_phi( iphi, nphi ) - jet.phi );
+        if ( dphi > M_PI ) { dphi = 2.0 * M_PI - dphi; }
+        const float dr2 = deta * deta + dphi * dphi;
+        if ( dr2 > m_jet_R * m_jet_R ) { continue; }
+        float this_w = exp( -0.5 * dr2 / ( sigma * sigma ) );
+        w[ieta * nphi + iphi] = this_w;
+        sum_w += this_w;
+      }
+    }
+    if ( sum_w <= 0 ) { return; }
+    for ( int ieta = 0; ieta < neta; ieta++ )
+    {
+      for ( int iphi = 0; iphi < nphi; iphi++ )
+      {
+        const int idx = ieta * nphi + iphi;
+        if ( w[idx] <= 0 ) { continue; }
+        grid[idx] += eT_layer * w[idx] / sum_w * coshEta[ieta];
+      }
+    }
+  };
+
+  for ( int ijet = 0; ijet < njets; ijet++ )
+  {
+    SynthJet jet;
+    jet.pt = std::pow( lo + ( hi - lo ) * m_rng->Uniform(), 1.0 / a );
+    jet.eta = m_rng->Uniform( -max_abs_eta, max_abs_eta );
+    jet.phi = m_rng->Uniform( 0.0, 2.0 * M_PI );
+    jet.e = jet.pt * cosh( jet.eta );
+    jet.em_frac = m_rng->Uniform( 0.3, 0.8 );
+
+    const float had = 1.0 - jet.em_frac;
+    deposit( CEMC, &evt.cemc_full_E[0][0], SynthCaloEvent::k_neta_emcal, SynthCaloEvent::k_nphi_emcal, jet, jet.pt * jet.em_frac );
+    deposit( HCALIN, &evt.hcalin_E[0][0], SynthCaloEvent::k_neta, SynthCaloEvent::k_nphi, jet, jet.pt * had * 0.15 );
+    deposit( HCALOUT, &evt.hcalout_E[0][0], SynthCaloEvent::k_neta, SynthCaloEvent::k_nphi, jet, jet.pt * had * 0.85 );
+
+    evt.jets.push_back( jet );
+  }
+}
+
+void SynthCaloEventGenerator::ApplyTowerMap( SynthCaloEvent & evt )
+{
+  auto apply = [&]( const int * status, float * E, int * isgood, int * ishot, const int ntowers )
+  {
+    for ( int i = 0; i < ntowers; i++ )
+    {
+      isgood[i] = ( status[i] == 0 );
+      ishot[i] = ( status[i] == 2 );
+      if ( status[i] == 1 )
+      {
+        E[i] = 0;
+      }
+      else if ( status[i] == 2 )
+      {
+        E[i] = m_hot_energy * ( 0.5 + m_rng->Uniform() );
+      }
+    }
+  };
+
+  apply( &m_emcal_status[0][0], &evt.cemc_full_E[0][0], &evt.cemc_full_isgood[0][0], &evt.cemc_full_ishot[0][0], SynthCaloEvent::k_neta_emcal * SynthCaloEvent::k_nphi_emcal );
+  apply( &m_hcalin_status[0][0], &evt.hcalin_E[0][0], &evt.hcalin_isgood[0][0], &evt.hcalin_ishot[0][0], SynthCaloEvent::k_neta * SynthCaloEvent::k_nphi );
+  apply( &m_hcalout_status[0][0], &evt.hcalout_E[0][0], &evt.hcalout_isgood[0][0], &evt.hcalout_ishot[0][0], SynthCaloEvent::k_neta * SynthCaloEvent::k_nphi );
+}
+
+void SynthCaloEventGenerator::Retower( SynthCaloEvent & evt )
+{
+  // 4x4 emcal towers per hcal tower, only good towers are summed
+  // and the retowered tower is bad only if all 16 are bad
+  const int feta = SynthCaloEvent::k_neta_emcal / SynthCaloEvent::k_neta;
+  const int fphi = SynthCaloEvent::k_nphi_emcal / SynthCaloEvent::k_nphi;
+  for ( int ieta = 0; ieta < SynthCaloEvent::k_neta; ieta++ )
+  {
+    for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi; iphi++ )
+    {
+      float sumE = 0;
+      int ngood = 0;
+      for ( int jeta = ieta * feta; jeta < ( ieta + 1 ) * feta; jeta++ )
+      {
+        for ( int jphi = iphi * fphi; jphi < ( iphi + 1 ) * fphi; jphi++ )
+        {
+          if ( !evt.cemc_full_isgood[jeta][jphi] ) { continue; }
+          sumE += evt.cemc_full_E[jeta][jphi];
+          ngood++;
+        }
+      }
+      evt.cemc_E[ieta][iphi] = sumE;
+      evt.cemc_isgood[ieta][iphi] = ( ngood > 0 );
+    }
+  }
+}
+
+void SynthCaloEventGenerator::FillConstituents( SynthCaloEvent & evt )
+{
+  const LAYER layers[3] { CEMC, HCALIN, HCALOUT };
+  const Jet::SRC srcs[3] { Jet::SRC::CEMC_TOWERINFO_RETOWER, Jet::SRC::HCALIN_TOWERINFO, Jet::SRC::HCALOUT_TOWERINFO };
+  const int * isgood[3] { &evt.cemc_isgood[0][0], &evt.hcalin_isgood[0][0], &evt.hcalout_isgood[0][0] };
+
+  for ( auto & jet : evt.jets )
+  {
+    jet.comps.clear();
+    for ( int il = 0; il < 3; il++ )
+    {
+      const float R = k_calo_radius[layers[il]];
+      for ( int ieta = 0; ieta < SynthCaloEvent::k_neta; ieta++ )
+      {
+        const float deta = correct_calo_eta( tower_eta( ieta ), evt.zvrtx, R ) - jet.eta;
+        if ( std::abs( deta ) > m_jet_R ) { continue; }
+        for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi; iphi++ )
+        {
+          if ( !isgood[il][ieta * SynthCaloEvent::k_nphi + iphi] ) { continue; }
+          float dphi = std::abs( tower_phi( iphi ) - jet.phi );
+          if ( dphi > M_PI ) { dphi = 2.0 * M_PI - dphi; }
+          if ( deta * deta + dphi * dphi > m_jet_R * m_jet_R ) { continue; }
+          jet.comps.push_back( std::make_pair( srcs[il], m_hcal_channel[ieta][iphi] ) );
+        }
+      }
+    }
+  }
+}
+
+void SynthCaloEventGenerator::SumET( SynthCaloEvent & evt )
+{
+  auto sum = [&]( const LAYER layer, const float * E, const int * isgood )
+  {
+    const float R = k_calo_radius[layer];
+    float sum_eT = 0;
+    for ( int ieta = 0; ieta < SynthCaloEvent::k_neta; ieta++ )
+    {
+      const float coshEta = cosh( correct_calo_eta( tower_eta( ieta ), evt.zvrtx, R ) );
+      for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi; iphi++ )
+      {
+        const int idx = ieta * SynthCaloEvent::k_nphi + iphi;
+        if ( !isgood[idx] ) { continue; }
+        sum_eT += E[idx] / coshEta;
+      }
+    }
+    return sum_eT;
+  };
+
+  // retowered cemc sits at the hcalin radius, same as TreeWriter
+  evt.sum_eT_cemc = sum( HCALIN, &evt.cemc_E[0][0], &evt.cemc_isgood[0][0] );
+  evt.sum_eT_hcalin = sum( HCALIN, &evt.hcalin_E[0][0], &evt.hcalin_isgood[0][0] );
+  evt.sum_eT_hcalout = sum( HCALOUT, &evt.hcalout_E[0][0], &evt.hcalout_isgood[0][0] );
+  evt.sum_eT_all = evt.sum_eT_cemc + evt.sum_eT_hcalin + evt.sum_eT_hcalout;
+}
+
+void SynthCaloEventGenerator::Fill( std::vector< SynthCaloEvent * > & events, const unsigned int nevents )
+{
+  events.reserve( events.size() + nevents );
+  for ( unsigned int i = 0; i < nevents; i++ )
+  {
+    auto evt = new SynthCaloEvent();
+    Generate( *evt );
+    events.push_back( evt );
+  }
+}
+
+int SynthCaloEventGenerator::Write( const std::string & filename, const unsigned int nevents )
+{
+  TFile * f = TFile::Open( filename.c_str(), "RECREATE" );
+  if ( !f || f->IsZombie() )
+  {
+    std::cerr << "SynthCaloEventGenerator::Write - cannot open " << filename << std::endl;
+    return -1;
+  }
+
+  auto evt = new SynthCaloEvent();
+  std::vector< float > jet_pt {}, jet_eta {}, jet_phi {}, jet_e {};
+  std::vector< std::vector< int > > jet_comp_src {};
+  std::vector< std::vector< unsigned int > > jet_comp_channel {};
+
+  const int k_neta = SynthCaloEvent::k_neta;
+  const int k_nphi = SynthCaloEvent::k_nphi;
+  const int k_neta_emcal = SynthCaloEvent::k_neta_emcal;
+  const int k_nphi_emcal = SynthCaloEvent::k_nphi_emcal;
+
+  TTree * t = new TTree( "T", "T" );
+  t -> Branch( "event_id", &evt->event_id, "event_id/I" );
+  t -> Branch( "cent", &evt->cent, "cent/I" );
+  t -> Branch( "b", &evt->b, "b/F" );
+  t -> Branch( "zvrtx", &evt->zvrtx, "zvrtx/F" );
+  t -> Branch( "psi2", &evt->psi2, "psi2/F" );
+  t -> Branch( "psi3", &evt->psi3, "psi3/F" );
+  t -> Branch( "v2", &evt->v2, "v2/F" );
+  t -> Branch( "v3", &evt->v3, "v3/F" );
+  t -> Branch( "sum_eT_all", &evt->sum_eT_all, "sum_eT_all/F" );
+  t -> Branch( "sum_eT_cemc", &evt->sum_eT_cemc, "sum_eT_cemc/F" );
+  t -> Branch( "sum_eT_hcalin", &evt->sum_eT_hcalin, "sum_eT_hcalin/F" );
+  t -> Branch( "sum_eT_hcalout", &evt->sum_eT_hcalout, "sum_eT_hcalout/F" );
+  t -> Branch( "cemc_E", evt->cemc_E, Form("cemc_E[%d][%d]/F", k_neta, k_nphi) );
+  t -> Branch( "cemc_isgood", evt->cemc_isgood, Form("cemc_isgood[%d][%d]/I", k_neta, k_nphi) );
+  t -> Branch( "hcalin_E", evt->hcalin_E, Form("hcalin_E[%d][%d]/F", k_neta, k_nphi) );
+  t -> Branch( "hcalin_isgood", evt->hcalin_isgood, Form("hcalin_isgood[%d][%d]/I", k_neta, k_nphi) );
+  t -> Branch( "hcalout_E", evt->hcalout_E, Form("hcalout_E[%d][%d]/F", k_neta, k_nphi) );
+  t -> Branch( "hcalout_isgood", evt->hcalout_isgood, Form("hcalout_isgood[%d][%d]/I", k_neta, k_nphi) );
+  t -> Branch( "cemc_full_E", evt->cemc_full_E, Form("cemc_full_E[%d][%d]/F", k_neta_emcal, k_nphi_emcal) );
+  t -> Branch( "cemc_full_isgood", evt->cemc_full_isgood, Form("cemc_full_isgood[%d][%d]/I", k_neta_emcal, k_nphi_emcal) );
+  t -> Branch( "jet_pt", &jet_pt );
+  t -> Branch( "jet_eta", &jet_eta );
+  t -> Branch( "jet_phi", &jet_phi );
+  t -> Branch( "jet_e", &jet_e );
+  t -> Branch( "jet_comp_src", &jet_comp_src );
+  t -> Branch( "jet_comp_channel", &jet_comp_channel );
+
+  for ( unsigned int i = 0; i < nevents; i++ )
+  {
+    Generate( *evt );
+
+    jet_pt.clear();
+    jet_eta.clear();
+    jet_phi.clear();
+    jet_e.clear();
+    jet_comp_src.clear();
+    jet_comp_channel.clear();
+    for ( const auto & jet : evt->jets )
+    {
+      jet_pt.push_back( jet.pt );
+      jet_eta.push_back( jet.eta );
+      jet_phi.push_back( jet.phi );
+      jet_e.push_back( jet.e );
+      std::vector< int > srcs {};
+      std::vector< unsigned int > channels {};
+      for ( const auto & comp : jet.comps )
+      {
+        srcs.push_back( static_cast<int>( comp.first ) );
+        channels.push_back( comp.second );
+      }
+      jet_comp_src.push_back( srcs );
+      jet_comp_channel.push_back( channels );
+    }
+
+    t->Fill();
+  }
+
+  f->cd();
+  t->Write();
+  f->Close();
+  delete f;
+  delete evt;
+
+  if ( m_verbosity > 0 )
+  {
+    std::cout << "SynthCaloEventGenerator::Write - wrote " << nevents << " events to " << filename << std::endl;
+  }
+
+  return static_cast<int>( nevents );
+}
+
+void SynthCaloEventGenerator::Print() const
+{
+  std::cout << "SynthCaloEventGenerator" << std::endl;
+  std::cout << "  seed: " << m_seed << std::endl;
+  std::cout << "  cent range: [" << m_cent_min << ", " << m_cent_max << ")" << std::endl;
+  std::cout << "  zvrtx sigma: " << m_zvrtx_sigma << " |zvrtx| < " << m_max_abs_zvrtx << std::endl;
+  std::cout << "  flow: " << ( m_do_flow ? "on" : "off" ) << std::endl;
+  std::cout << "  central sumeT (cemc, hcalin, hcalout): " << m_central_sumeT[0] << ", " << m_central_sumeT[1] << ", " << m_central_sumeT[2] << std::endl;
+  std::cout << "  jets: <n> = " << m_mean_njets << ", pT [" << m_jet_pt_min << ", " << m_jet_pt_max << "] ~ pT^-" << m_jet_pt_power << ", R = " << m_jet_R << std::endl;
+  std::cout << "  dead fraction: " << m_dead_frac << ", hot fraction: " << m_hot_frac << std::endl;
+}
@@ -0,0 +1,137 @@
+#ifndef BENCHMARK_SYNTHCALOEVENTGENERATOR_H
+#define BENCHMARK_SYNTHCALOEVENTGENERATOR_H
+
+//===========================================================
+/// \file SynthCaloEventGenerator.h
+/// \brief Synthetic heavy-ion calorimeter events for benchmarking
+/// \author Tanner Mengel
+//===========================================================
+
+#include "SynthCaloEvent.h"
+
+#include <string>
+#include <vector>
+
+class TRandom3;
+
+// Generates per-event tower grids for cemc (retowered 24x64 and
+// full 96x256), hcalin and hcalout. The UE is an exponential tower
+// spectrum whose occupancy and mean scale with centrality, modulated
+// by v2/v3 around a random event plane. Jets are deposited with a
+// gaussian profile and their constituents are every good tower inside
+// the cone, given as (Jet::SRC, channel) with the TowerInfoDefs channel
+// map. The dead/hot map is fixed per generator ( i.e. per "run" ).
+// Everything is drawn from one TRandom3 so a seed fixes the sequence.
+class SynthCaloEventGenerator
+{
+  public:
+
+    enum LAYER
+    {
+      CEMC = 0,
+      HCALIN = 1,
+      HCALOUT = 2
+    };
+
+    SynthCaloEventGenerator( const unsigned int seed = 42 );
+    ~SynthCaloEventGenerator();
+
+    // event shape
+    void set_cent_range( const int cent_min, const int cent_max ) { m_cent_min = cent_min; m_cent_max = cent_max; }
+    void set_zvrtx_sigma( const float sigma ) { m_zvrtx_sigma = sigma; }
+    void set_max_abs_zvrtx( const float max_abs ) { m_max_abs_zvrtx = max_abs; }
+    void set_do_flow( const bool do_flow ) { m_do_flow = do_flow; }
+    void set_central_sumeT( const LAYER layer, const float sumeT ) { m_central_sumeT[layer] = sumeT; }
+    void set_noise( const LAYER layer, const float sigma ) { m_noise[layer] = sigma; }
+
+    // embedded jets
+    void set_mean_njets( const float mean ) { m_mean_njets = mean; }
+    void set_jet_pt_range( const float pt_min, const float pt_max ) { m_jet_pt_min = pt_min; m_jet_pt_max = pt_max; }
+    void set_jet_pt_power( const float n ) { m_jet_pt_power = n; }
+    void set_jet_R( const float R ) { m_jet_R = R; }
+
+    // detector map, regenerated on change
+    void set_dead_fraction( const float frac ) { m_dead_frac = frac; m_map_valid = false; }
+    void set_hot_fraction( const float frac ) { m_hot_frac = frac; m_map_valid = false; }
+    void set_hot_energy( const float E ) { m_hot_energy = E; }
+
+    void set_verbosity( const int v ) { m_verbosity = v; }
+
+    // fill the next event, evt is fully overwritten
+    void Generate( SynthCaloEvent & evt );
+
+    // write nevents to a TTree "T" readable by OverlayFromTTree
+    // returns number of events written or -1 on failure
+    int Write( const std::string & filename, const unsigned int nevents );
+
+    // fill nevents in memory
+    void Fill( std::vector< SynthCaloEvent * > & events, const unsigned int nevents );
+
+    // geometry used by the generator
+    static float tower_eta( const int ieta, const int neta = SynthCaloEvent::k_neta );
+    static float tower_phi( const int iphi, const int nphi = SynthCaloEvent::k_nphi );
+    static float correct_calo_eta( const float eta0, const float zvrtx, const float R );
+    static float calo_radius( const LAYER layer ) { return k_calo_radius[layer]; }
+
+    // TowerInfoContainer channel for (ieta, iphi)
+    unsigned int hcal_channel( const int ieta, const int iphi ) const { return m_hcal_channel[ieta][iphi]; }
+    unsigned int emcal_channel( const int ieta, const int iphi ) const { return m_emcal_channel[ieta][iphi]; }
+
+    void Print() const;
+
+  private:
+
+    TRandom3 * m_rng { nullptr };
+    unsigned int m_seed { 42 };
+    int m_event_id { -1 };
+    int m_verbosity { 0 };
+
+    int m_cent_min { 0 };
+    int m_cent_max { 100 };
+    float m_zvrtx_sigma { 20.0 };
+    float m_max_abs_zvrtx { 30.0 };
+    bool m_do_flow { true };
+
+    // 0-1% event sum eT per layer (GeV)
+    float m_central_sumeT[3] { 650.0, 45.0, 180.0 };
+    float m_noise[3] { 0.015, 0.005, 0.025 };
+
+    float m_mean_njets { 1.0 };
+    float m_jet_pt_min { 10.0 };
+    float m_jet_pt_max { 80.0 };
+    float m_jet_pt_power { 5.0 };
+    float m_jet_R { 0.4 };
+
+    float m_dead_frac { 0.03 };
+    float m_hot_frac { 0.002 };
+    float m_hot_energy { 50.0 };
+    bool m_map_valid { false };
+
+    static constexpr float k_calo_radius[3] { 93.5, 127.503, 225.87 };
+    static constexpr float k_max_abs_eta { 1.1 };
+    static constexpr float k_b_max { 15.6 }; // fm, Au+Au
+
+    // 0 good, 1 dead, 2 hot
+    int m_emcal_status[SynthCaloEvent::k_neta_emcal][SynthCaloEvent::k_nphi_emcal] {};
+    int m_hcalin_status[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi] {};
+    int m_hcalout_status[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi] {};
+
+    unsigned int m_hcal_channel[SynthCaloEvent::k_neta][SynthCaloEvent::k_nphi] {};
+    unsigned int m_emcal_channel[SynthCaloEvent::k_neta_emcal][SynthCaloEvent::k_nphi_emcal] {};
+
+    void BuildChannelMap();
+    void BuildTowerMap();
+
+    float ue_scale( const int cent ) const;
+    float ue_occupancy( const LAYER layer, const int cent ) const;
+    float v2_of_cent( const int cent ) const;
+
+    void FillUE( SynthCaloEvent & evt );
+    void EmbedJets( SynthCaloEvent & evt );
+    void ApplyTowerMap( SynthCaloEvent & evt );
+    void Retower( SynthCaloEvent & evt );
+    void FillConstituents( SynthCaloEvent & evt );
+    void SumET( SynthCaloEvent & evt );
+};
+
+#endif // BENCHMARK_SYNTHCALOEVENTGENERATOR_H
@@ -0,0 +1,194 @@
+//===========================================================
+/// \file bench_anatreewriter.cc
+/// \brief Times TreeWriter jet constituent flattening, the TTree and
+///        RNTuple backends and CalcFlow
+/// \author Tanner Mengel
+//===========================================================
+
+// kernels:
+//   treewriter_rawjets : TreeWriter::process_event with a raw jet node,
+//                        per constituent geometry lookup + flattening into
+//                        the nested vector branches and the tree fill
+//   treewriter_rawjets_rntuple : the same written through the RNTuple
+//                        backend, nested vectors as RNTuple collections
+//   treewriter_rawjets_rntuple_mt : the RNTuple backend with page
+//                        compression on --threads worker threads
+//   treewriter_read_ttree / treewriter_read_rntuple : reading the raw
+//                        jet tree / RNTuple of the files written above
+//                        back, one entry per call, all columns
+//   treewriter_calcflow: TreeWriter::CalcFlow with fluctuations for a
+//                        fixed set of particles per event
+
+#include "BenchNodes.h"
+#include "BenchUtils.h"
+#include "SynthCaloEvent.h"
+#include "SynthCaloEventGenerator.h"
+
+#include <anatreewriter/BranchRegistry.h>
+#include <anatreewriter/TreeWriter.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <TFile.h>
+#include <TRandom3.h>
+#include <TTree.h>
+
+#ifdef BRANCHREGISTRY_RNTUPLE
+#include <ROOT/RNTupleReader.hxx>
+#endif
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main( int argc, char ** argv )
+{
+  BenchUtils::BenchOptions opts {};
+  if ( !BenchUtils::ParseArgs(argc, argv, opts) ) { return 1; }
+
+  SynthCaloEventGenerator gen(opts.seed);
+  gen.set_cent_range(opts.cent_min, opts.cent_max);
+  gen.set_mean_njets(4.0);
+
+  std::vector< SynthCaloEvent * > events {};
+  gen.Fill(events, std::min(opts.nevents, 50U));
+
+  BenchNodes nodes {};
+  nodes.add_jet_node("AntiKt_Tower_r04");
+  PHCompositeNode * topNode = nodes.topNode();
+  auto load = [&]( unsigned int i ) { nodes.Load(*events[i % events.size()]); };
+
+  unsigned long ncomps = 0;
+  for ( auto evt : events )
+  {
+    for ( const auto & jet : evt->jets ) { ncomps += jet.comps.size(); }
+  }
+  ncomps /= events.size();
+
+  BenchUtils::BenchReport report("bench_anatreewriter");
+
+  // A/B of the output backends on the same events. The files are kept
+  // until the read kernels ran, their sizes are printed with the report
+  const std::string jet_node = "AntiKt_Tower_r04";
+  auto write_sample = [&]( const std::string & name, const std::string & output,
+                           const bool rntuple, const unsigned int nthreads ) -> bool
+  {
+    TreeWriter writer(output);
+    writer.add_zvrtx_node();
+    writer.add_rawjet_node(jet_node);
+    if ( rntuple ) { writer.use_rntuple(true, nthreads); }
+    if ( writer.Init(topNode) != Fun4AllReturnCodes::EVENT_OK || writer.InitRun(topNode) != Fun4AllReturnCodes::EVENT_OK )
+    {
+      std::cout << "bench_anatreewriter: TreeWriter::Init failed" << std::endl;
+      return false;
+    }
+
+    // towers/s counts constituents here
+    report.Add(BenchUtils::Run(name, opts, ncomps,
+      load, [&]( unsigned int )
+      {
+        writer.process_event(topNode);
+        writer.ResetEvent(topNode);
+      }));
+
+    writer.End(topNode);
+    return true;
+  };
+
+  auto file_size = []( const std::string & filename ) -> long long
+  {
+    struct stat st {};
+    return stat(filename.c_str(), &st) == 0 ? static_cast< long long >( st.st_size ) : -1;
+  };
+
+  const std::string output_ttree = "bench_anatreewriter_output.root";
+  if ( !write_sample("treewriter_rawjets", output_ttree, false, 0) ) { return 1; }
+
+  // all branches, the nested vectors are read back into ROOT owned objects
+  {
+    TFile * file = TFile::Open(output_ttree.c_str(), "READ");
+    TTree * tree = file ? file->Get< TTree >(jet_node.c_str()) : nullptr;
+    const long long nentries = tree ? tree->GetEntries() : 0;
+    if ( nentries > 0 )
+    {
+      report.Add(BenchUtils::Run("treewriter_read_ttree", opts, ncomps,
+        []( unsigned int ) {}, [&]( unsigned int i ) { tree->GetEntry(i % nentries); }));
+    }
+    if ( file ) { file->Close(); delete file; }
+  }
+
+  std::vector< std::pair< std::string, long long > > sizes { { "ttree", file_size(output_ttree) } };
+
+#ifdef BRANCHREGISTRY_RNTUPLE
+  const std::string output_rntuple = "bench_anatreewriter_rntuple.root";
+  if ( !write_sample("treewriter_rawjets_rntuple", output_rntuple, true, 0) ) { return 1; }
+
+  {
+    auto reader = BranchRegistryNTuple::RNTupleReader::Open(jet_node, output_rntuple);
+    const long long nentries = reader->GetNEntries();
+    if ( nentries > 0 )
+    {
+      report.Add(BenchUtils::Run("treewriter_read_rntuple", opts, ncomps,
+        []( unsigned int ) {}, [&]( unsigned int i ) { reader->LoadEntry(i % nentries); }));
+    }
+  }
+
+  sizes.push_back( { "rntuple", file_size(output_rntuple) } );
+  std::remove(output_rntuple.c_str());
+
+  // same events, pages compressed by the implicit MT pool. Timed after
+  // the single threaded kernels, the registry leaves implicit MT enabled
+  if ( opts.nthreads > 0 )
+  {
+    const std::string output_rntuple_mt = "bench_anatreewriter_rntuple_mt.root";
+    if ( !write_sample("treewriter_rawjets_rntuple_mt", output_rntuple_mt, true, opts.nthreads) ) { return 1; }
+    sizes.push_back( { "rntuple, " + std::to_string(opts.nthreads) + " threads", file_size(output_rntuple_mt) } );
+    std::remove(output_rntuple_mt.c_str());
+  }
+#else
+  std::cout << "bench_anatreewriter: ROOT without RNTuple writing, only the TTree backend is timed" << std::endl;
+#endif
+
+  std::remove(output_ttree.c_str());
+  for ( const auto & [ backend, bytes ] : sizes )
+  {
+    std::cout << "bench_anatreewriter: " << backend << " output " << bytes << " bytes" << std::endl;
+  }
+
+  // particles per event, roughly a central event inside |eta| < 1.1
+  const unsigned int nparticles = 2000;
+  std::vector< float > particle_eta(nparticles);
+  std::vector< float > particle_pt(nparticles);
+  TRandom3 kinematics(opts.seed);
+  for ( unsigned int i = 0; i < nparticles; ++i )
+  {
+    particle_eta[i] = kinematics.Uniform(-1.1, 1.1);
+    particle_pt[i] = 0.2 + kinematics.Exp(0.5);
+  }
+
+  TRandom3 engine(opts.seed);
+  float b = 0;
+  float sink = 0;
+  report.Add(BenchUtils::Run("treewriter_calcflow", opts, 0,
+    [&]( unsigned int i ) { b = events[i % events.size()]->b; },
+    [&]( unsigned int )
+    {
+      float v2 = 0, v3 = 0, v4 = 0, v5 = 0, v6 = 0;
+      for ( unsigned int i = 0; i < nparticles; ++i )
+      {
+        TreeWriter::CalcFlow(b, particle_eta[i], particle_pt[i], v2, v3, v4, v5, v6, &engine, true);
+        sink += v2;
+      }
+    }));
+
+  if ( opts.verbosity > 1 ) { std::cout << "checksum " << sink << std::endl; }
+
+  for ( auto evt : events ) { delete evt; }
+
+  return report.Finish(opts);
+}
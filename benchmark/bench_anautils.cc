@@ -0,0 +1,196 @@
+//===========================================================
+/// \file bench_anautils.cc
+/// \brief Times the batch AnaUtils geometry helpers against the
+///        scalar loops they replace
+/// \author Tanner Mengel
+//===========================================================
+
+// every kernel runs over the retowered 24 x 64 grid of one event,
+// <name> is the batch overload and <name>_scalar the per element loop
+//   anautils_dphi_wrap       : dphi_wrap( jet phi, tower phi[] ) per jet
+//   anautils_calc_dr         : jet x tower dR matrix
+//   anautils_get_dpsi2       : get_dpsi2( psi2, tower phi[] )
+//   anautils_classify_plane  : classify_plane( psi2, tower phi[] )
+//   anautils_correct_calo_eta: tower eta shifted to the event vertex
+//   anautils_accept_jet_eta  : acceptance of a jet seeded on every tower
+
+#include "BenchUtils.h"
+#include "SynthCaloEvent.h"
+#include "SynthCaloEventGenerator.h"
+
+#include <myana/AnaUtils.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main( int argc, char ** argv )
+{
+  BenchUtils::BenchOptions opts {};
+  if ( !BenchUtils::ParseArgs(argc, argv, opts) ) { return 1; }
+
+  SynthCaloEventGenerator gen(opts.seed);
+  gen.set_cent_range(opts.cent_min, opts.cent_max);
+  gen.set_mean_njets(4.0);
+
+  std::vector< SynthCaloEvent * > events {};
+  gen.Fill(events, std::min(opts.nevents, 50U));
+
+  // tower centres, ieta major like the TreeWriter columns
+  const std::size_t ntowers = SynthCaloEvent::k_neta * SynthCaloEvent::k_nphi;
+  std::vector< float > tower_eta(ntowers);
+  std::vector< float > tower_phi(ntowers);
+  for ( int ieta = 0; ieta < SynthCaloEvent::k_neta; ++ieta )
+  {
+    for ( int iphi = 0; iphi < SynthCaloEvent::k_nphi; ++iphi )
+    {
+      tower_eta[ieta * SynthCaloEvent::k_nphi + iphi] = SynthCaloEventGenerator::tower_eta(ieta);
+      tower_phi[ieta * SynthCaloEvent::k_nphi + iphi] = SynthCaloEventGenerator::tower_phi(iphi);
+    }
+  }
+
+  unsigned long njets = 0;
+  for ( auto evt : events ) { njets += evt->jets.size(); }
+  njets = std::max( 1UL, njets / events.size() );
+
+  // per event inputs, loaded untimed
+  const SynthCaloEvent * evt = nullptr;
+  std::vector< float > jet_eta {};
+  std::vector< float > jet_phi {};
+  auto load = [&]( unsigned int i )
+  {
+    evt = events[i % events.size()];
+    jet_eta.clear();
+    jet_phi.clear();
+    for ( const auto & jet : evt->jets )
+    {
+      jet_eta.push_back(jet.eta);
+      jet_phi.push_back(jet.phi);
+    }
+  };
+
+  // outputs sized for the largest event so the kernels don't allocate
+  std::size_t max_jets = 1;
+  for ( auto e : events ) { max_jets = std::max( max_jets, e->jets.size() ); }
+  std::vector< float > out_f( max_jets * ntowers );
+  std::vector< int > out_i( ntowers );
+  std::unique_ptr< bool[] > out_b( new bool[ntowers] );
+
+  const float R_cemc = SynthCaloEventGenerator::calo_radius(SynthCaloEventGenerator::CEMC);
+  const float jet_R = 0.4;
+  float sink = 0;
+
+  BenchUtils::BenchReport report("bench_anautils");
+
+  // dphi_wrap
+  report.Add(BenchUtils::Run("anautils_dphi_wrap", opts, njets * ntowers, load,
+    [&]( unsigned int )
+    {
+      for ( std::size_t j = 0; j < jet_phi.size(); ++j )
+      {
+        AnaUtils::dphi_wrap(jet_phi[j], tower_phi.data(), ntowers, out_f.data() + j * ntowers);
+      }
+      sink += out_f[0];
+    }));
+  report.Add(BenchUtils::Run("anautils_dphi_wrap_scalar", opts, njets * ntowers, load,
+    [&]( unsigned int )
+    {
+      for ( std::size_t j = 0; j < jet_phi.size(); ++j )
+      {
+        for ( std::size_t i = 0; i < ntowers; ++i ) { out_f[j * ntowers + i] = AnaUtils::dphi_wrap(jet_phi[j], tower_phi[i]); }
+      }
+      sink += out_f[0];
+    }));
+
+  // calc_dr
+  report.Add(BenchUtils::Run("anautils_calc_dr", opts, njets * ntowers, load,
+    [&]( unsigned int )
+    {
+      AnaUtils::calc_dr(jet_eta.data(), jet_phi.data(), jet_eta.size(),
+                        tower_eta.data(), tower_phi.data(), ntowers, out_f.data());
+      sink += out_f[0];
+    }));
+  report.Add(BenchUtils::Run("anautils_calc_dr_scalar", opts, njets * ntowers, load,
+    [&]( unsigned int )
+    {
+      for ( std::size_t j = 0; j < jet_eta.size(); ++j )
+      {
+        for ( std::size_t i = 0; i < ntowers; ++i )
+        {
+          out_f[j * ntowers + i] = AnaUtils::calc_dr(jet_eta[j], jet_phi[j], tower_eta[i], tower_phi[i]);
+        }
+      }
+      sink += out_f[0];
+    }));
+
+  // get_dpsi2
+  report.Add(BenchUtils::Run("anautils_get_dpsi2", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      AnaUtils::get_dpsi2(evt->psi2, tower_phi.data(), ntowers, out_f.data());
+      sink += out_f[0];
+    }));
+  report.Add(BenchUtils::Run("anautils_get_dpsi2_scalar", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      for ( std::size_t i = 0; i < ntowers; ++i ) { out_f[i] = AnaUtils::get_dpsi2(evt->psi2, tower_phi[i]); }
+      sink += out_f[0];
+    }));
+
+  // classify_plane
+  report.Add(BenchUtils::Run("anautils_classify_plane", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      AnaUtils::classify_plane(evt->psi2, tower_phi.data(), ntowers, out_i.data());
+      sink += out_i[0];
+    }));
+  report.Add(BenchUtils::Run("anautils_classify_plane_scalar", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      for ( std::size_t i = 0; i < ntowers; ++i )
+      {
+        out_i[i] = AnaUtils::in_plane(evt->psi2, tower_phi[i]) ? AnaUtils::kInPlane
+                 : AnaUtils::mid_plane(evt->psi2, tower_phi[i]) ? AnaUtils::kMidPlane
+                 : AnaUtils::out_of_plane(evt->psi2, tower_phi[i]) ? AnaUtils::kOutOfPlane
+                 : AnaUtils::kNoPlane;
+      }
+      sink += out_i[0];
+    }));
+
+  // correct_calo_eta
+  report.Add(BenchUtils::Run("anautils_correct_calo_eta", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      AnaUtils::correct_calo_eta(tower_eta.data(), ntowers, evt->zvrtx, R_cemc, out_f.data());
+      sink += out_f[0];
+    }));
+  report.Add(BenchUtils::Run("anautils_correct_calo_eta_scalar", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      for ( std::size_t i = 0; i < ntowers; ++i ) { out_f[i] = AnaUtils::correct_calo_eta(tower_eta[i], evt->zvrtx, R_cemc); }
+      sink += out_f[0];
+    }));
+
+  // accept_jet_eta
+  report.Add(BenchUtils::Run("anautils_accept_jet_eta", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      AnaUtils::accept_jet_eta(tower_eta.data(), ntowers, evt->zvrtx, jet_R, out_b.get());
+      sink += out_b[0];
+    }));
+  report.Add(BenchUtils::Run("anautils_accept_jet_eta_scalar", opts, ntowers, load,
+    [&]( unsigned int )
+    {
+      for ( std::size_t i = 0; i < ntowers; ++i ) { out_b[i] = AnaUtils::accept_jet_eta(tower_eta[i], evt->zvrtx, jet_R); }
+      sink += out_b[0];
+    }));
+
+  if ( opts.verbosity > 1 ) { std::cout << "checksum " << sink << std::endl; }
+
+  for ( auto e : events ) { delete e; }
+
+  return report.Finish(opts);
+}
@@ -0,0 +1,74 @@
+//===========================================================
+/// \file bench_calomanip.cc
+/// \brief Times CaloTowerManip tower shuffling on synthetic events
+/// \author Tanner Mengel
+//===========================================================
+
+// kernels:
+//   calotowermanip_hcalin : RandomizeTowers on TOWERINFO_CALIB_HCALIN
+//   calotowermanip_cemc   : RandomizeTowers on the full TOWERINFO_CALIB_CEMC
+
+#include "BenchNodes.h"
+#include "BenchUtils.h"
+#include "SynthCaloEvent.h"
+#include "SynthCaloEventGenerator.h"
+
+#include <calomanip/CaloTowerManip.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main( int argc, char ** argv )
+{
+  BenchUtils::BenchOptions opts {};
+  if ( !BenchUtils::ParseArgs(argc, argv, opts) ) { return 1; }
+
+  SynthCaloEventGenerator gen(opts.seed);
+  gen.set_cent_range(opts.cent_min, opts.cent_max);
+
+  std::vector< SynthCaloEvent * > events {};
+  gen.Fill(events, std::min(opts.nevents, 50U));
+
+  BenchNodes nodes {};
+  PHCompositeNode * topNode = nodes.topNode();
+  // towers are shuffled in place, reload every event
+  auto load = [&]( unsigned int i ) { nodes.Load(*events[i % events.size()]); };
+
+  BenchUtils::BenchReport report("bench_calomanip");
+
+  struct ManipInput
+  {
+    std::string kernel;
+    std::string node;
+    unsigned long ntowers;
+  };
+
+  const std::vector< ManipInput > inputs = {
+    { "calotowermanip_hcalin", "TOWERINFO_CALIB_HCALIN", BenchNodes::n_hcal_towers() },
+    { "calotowermanip_cemc", "TOWERINFO_CALIB_CEMC", BenchNodes::n_emcal_towers() }
+  };
+
+  for ( const auto & input : inputs )
+  {
+    CaloTowerManip manip("Bench" + input.kernel);
+    manip.SetInputNode(input.node);
+    manip.RandomizeTowers(true);
+    manip.SetRandomSeed(opts.seed);
+    if ( manip.InitRun(topNode) != Fun4AllReturnCodes::EVENT_OK )
+    {
+      std::cout << "bench_calomanip: CaloTowerManip::InitRun failed for " << input.node << std::endl;
+      return 1;
+    }
+
+    report.Add(BenchUtils::Run(input.kernel, opts, input.ntowers,
+      load, [&]( unsigned int ) { manip.process_event(topNode); }));
+  }
+
+  for ( auto evt : events ) { delete evt; }
+
+  return report.Finish(opts);
+}
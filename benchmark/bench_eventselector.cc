@@ -0,0 +1,58 @@
+//===========================================================
+/// \file bench_eventselector.cc
+/// \brief Times the tower status scans of the event selection cuts
+/// \author Tanner Mengel
+//===========================================================
+
+// kernels:
+//   missingsebfilter : MissingSebFilter over cemc, hcalin, hcalout
+//   towerchi2cut     : TowerChi2Cut over cemc, hcalin, hcalout
+
+#include "BenchNodes.h"
+#include "BenchUtils.h"
+#include "SynthCaloEvent.h"
+#include "SynthCaloEventGenerator.h"
+
+#include <eventselection/MissingSebFilter.h>
+#include <eventselection/TowerChi2Cut.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+int main( int argc, char ** argv )
+{
+  BenchUtils::BenchOptions opts {};
+  if ( !BenchUtils::ParseArgs(argc, argv, opts) ) { return 1; }
+
+  SynthCaloEventGenerator gen(opts.seed);
+  gen.set_cent_range(opts.cent_min, opts.cent_max);
+
+  std::vector< SynthCaloEvent * > events {};
+  gen.Fill(events, std::min(opts.nevents, 50U));
+
+  BenchNodes nodes {};
+  PHCompositeNode * topNode = nodes.topNode();
+  auto load = [&]( unsigned int i ) { nodes.Load(*events[i % events.size()]); };
+
+  // default node names of both cuts
+  const unsigned long ntowers = BenchNodes::n_emcal_towers() + 2 * BenchNodes::n_hcal_towers();
+
+  BenchUtils::BenchReport report("bench_eventselector");
+
+  unsigned int npassed = 0;
+
+  MissingSebFilter seb_filter {};
+  report.Add(BenchUtils::Run("missingsebfilter", opts, ntowers,
+    load, [&]( unsigned int ) { npassed += seb_filter(topNode); }));
+
+  TowerChi2Cut chi2_cut {};
+  report.Add(BenchUtils::Run("towerchi2cut", opts, ntowers,
+    load, [&]( unsigned int ) { npassed += chi2_cut(topNode); }));
+
+  if ( opts.verbosity > 1 ) { std::cout << "passed " << npassed << std::endl; }
+
+  for ( auto evt : events ) { delete evt; }
+
+  return report.Finish(opts);
+}
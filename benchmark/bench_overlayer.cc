@@ -0,0 +1,78 @@
+//===========================================================
+/// \file bench_overlayer.cc
+/// \brief Times OverlayFromTTree background addition on synthetic events
+/// \author Tanner Mengel
+//===========================================================
+
+// kernels:
+//   overlayfromttree : OverlayFromTTree::process_event, reads the next
+//                      background event from a SynthCaloEventGenerator
+//                      file, sums truth jet reco eT and adds the
+//                      background to retowered cemc + hcals
+
+#include "BenchNodes.h"
+#include "BenchUtils.h"
+#include "SynthCaloEvent.h"
+#include "SynthCaloEventGenerator.h"
+
+#include <overlay/OverlayFromTTree.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main( int argc, char ** argv )
+{
+  BenchUtils::BenchOptions opts {};
+  if ( !BenchUtils::ParseArgs(argc, argv, opts) ) { return 1; }
+
+  // background file, one entry per overlaid event
+  const std::string bkgd_file = "bench_overlayer_bkgd.root";
+  SynthCaloEventGenerator bkgd_gen(opts.seed + 1000);
+  bkgd_gen.set_cent_range(opts.cent_min, opts.cent_max);
+  bkgd_gen.set_mean_njets(0.0);
+  if ( bkgd_gen.Write(bkgd_file, opts.nevents + opts.nwarmup) < 0 )
+  {
+    std::cout << "bench_overlayer: cannot write " << bkgd_file << std::endl;
+    return 1;
+  }
+
+  // signal events: few towers, one hard jet
+  SynthCaloEventGenerator gen(opts.seed);
+  gen.set_cent_range(90, 100);
+  gen.set_mean_njets(1.0);
+  gen.set_jet_pt_range(20.0, 60.0);
+
+  std::vector< SynthCaloEvent * > events {};
+  gen.Fill(events, std::min(opts.nevents, 50U));
+
+  BenchNodes nodes {};
+  nodes.add_jet_node("AntiKt_Truth_r03");
+  nodes.add_jet_node("AntiKt_Tower_r03_DVP");
+  PHCompositeNode * topNode = nodes.topNode();
+  auto load = [&]( unsigned int i ) { nodes.Load(*events[i % events.size()]); };
+
+  BenchUtils::BenchReport report("bench_overlayer");
+
+  OverlayFromTTree overlay {};
+  overlay.set_emb_input(bkgd_file, false);
+  if ( overlay.Init(topNode) != Fun4AllReturnCodes::EVENT_OK || overlay.InitRun(topNode) != Fun4AllReturnCodes::EVENT_OK )
+  {
+    std::cout << "bench_overlayer: OverlayFromTTree::Init failed" << std::endl;
+    return 1;
+  }
+
+  report.Add(BenchUtils::Run("overlayfromttree", opts, 3 * BenchNodes::n_hcal_towers(),
+    load, [&]( unsigned int ) { overlay.process_event(topNode); }));
+
+  overlay.End(topNode);
+  std::remove(bkgd_file.c_str());
+
+  for ( auto evt : events ) { delete evt; }
+
+  return report.Finish(opts);
+}
@@ -0,0 +1,129 @@
+//===========================================================
+/// \file bench_underlyingevent.cc
+/// \brief Times the underlyingevent tower loops on synthetic events
+/// \author Tanner Mengel
+//===========================================================
+
+// kernels:
+//   calowindow_towerreco : CaloWindowTowerReco::process_event, per channel
+//                          geometry lookup + vertex correction over the
+//                          retowered cemc, hcals and the full cemc
+//   randomcone_towerreco : RandomConeTowerReco::process_event, random cone
+//                          accumulation over retowered cemc + hcals
+//   calo_window_sums     : CaloWindowMapv1::get_calo_windows for a set of
+//                          window sizes on each map filled above
+
+#include "BenchNodes.h"
+#include "BenchUtils.h"
+#include "SynthCaloEvent.h"
+#include "SynthCaloEventGenerator.h"
+
+#include <underlyingevent/CaloWindowMap.h>
+#include <underlyingevent/CaloWindowTowerReco.h>
+#include <underlyingevent/RandomConeTowerReco.h>
+#include <underlyingevent/UEDefs.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/getClass.h>
+
+#include <jetbase/Jet.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main( int argc, char ** argv )
+{
+  BenchUtils::BenchOptions opts {};
+  if ( !BenchUtils::ParseArgs(argc, argv, opts) ) { return 1; }
+
+  SynthCaloEventGenerator gen(opts.seed);
+  gen.set_cent_range(opts.cent_min, opts.cent_max);
+
+  // fixed pool of events, cycled through
+  std::vector< SynthCaloEvent * > events {};
+  gen.Fill(events, std::min(opts.nevents, 50U));
+
+  BenchNodes nodes {};
+  PHCompositeNode * topNode = nodes.topNode();
+  auto load = [&]( unsigned int i ) { nodes.Load(*events[i % events.size()]); };
+
+  BenchUtils::BenchReport report("bench_underlyingevent");
+
+  const std::vector< Jet::SRC > srcs = {
+    Jet::SRC::CEMC_TOWERINFO_RETOWER,
+    Jet::SRC::HCALIN_TOWERINFO,
+    Jet::SRC::HCALOUT_TOWERINFO,
+    Jet::SRC::CEMC_TOWERINFO
+  };
+
+  CaloWindowTowerReco windows("BenchCaloWindowTowerReco");
+  for ( auto src : srcs ) { windows.add_input(src); }
+  if ( windows.Init(topNode) != Fun4AllReturnCodes::EVENT_OK || windows.InitRun(topNode) != Fun4AllReturnCodes::EVENT_OK )
+  {
+    std::cout << "bench_underlyingevent: CaloWindowTowerReco::Init failed" << std::endl;
+    return 1;
+  }
+
+  report.Add(BenchUtils::Run("calowindow_towerreco", opts,
+    3 * BenchNodes::n_hcal_towers() + BenchNodes::n_emcal_towers(),
+    load, [&]( unsigned int ) { windows.process_event(topNode); }));
+
+  RandomConeTowerReco cones("BenchRandomConeTowerReco");
+  for ( unsigned int in = 0; in < 3; ++in ) { cones.add_input(srcs[in]); }
+  cones.set_output_node("RandomCone_r04");
+  cones.set_R(0.4);
+  cones.set_abs_eta(0.7);
+  cones.set_user_seed(opts.seed);
+  if ( cones.Init(topNode) != Fun4AllReturnCodes::EVENT_OK || cones.InitRun(topNode) != Fun4AllReturnCodes::EVENT_OK )
+  {
+    std::cout << "bench_underlyingevent: RandomConeTowerReco::Init failed" << std::endl;
+    return 1;
+  }
+
+  report.Add(BenchUtils::Run("randomcone_towerreco", opts,
+    3 * BenchNodes::n_hcal_towers(),
+    load, [&]( unsigned int ) { cones.process_event(topNode); }));
+
+  // window sums read the maps filled by CaloWindowTowerReco
+  std::vector< CaloWindowMap * > maps {};
+  for ( auto src : srcs )
+  {
+    const std::string name = "CaloWindowMap" + UEDefs::GetCaloTowerNode(src, "");
+    auto map = findNode::getClass<CaloWindowMap>(topNode, name);
+    if ( !map )
+    {
+      std::cout << "bench_underlyingevent: missing " << name << std::endl;
+      return 1;
+    }
+    maps.push_back(map);
+  }
+
+  const std::vector< std::pair< unsigned int, unsigned int > > sizes = { {1, 1}, {2, 2}, {4, 4}, {8, 8}, {16, 12} };
+
+  float sink = 0;
+  report.Add(BenchUtils::Run("calo_window_sums", opts,
+    sizes.size() * ( 3 * BenchNodes::n_hcal_towers() + BenchNodes::n_emcal_towers() ),
+    [&]( unsigned int i ) { load(i); windows.process_event(topNode); },
+    [&]( unsigned int )
+    {
+      for ( auto map : maps )
+      {
+        for ( const auto & size : sizes )
+        {
+          const auto sums = map->get_calo_windows(size.first, size.second);
+          if ( !sums.empty() ) { sink += sums.front(); }
+        }
+      }
+    }));
+
+  if ( opts.verbosity > 1 ) { std::cout << "checksum " << sink << std::endl; }
+
+  for ( auto evt : events ) { delete evt; }
+
+  return report.Finish(opts);
+}
@@ -23,6 +23,7 @@
 
 int CaloManip::InitRun( PHCompositeNode * topNode )
 {
+  m_nodes.clear();
 
   if ( m_do_randomize_towers ) 
   {
@@ -289,7 +290,7 @@ inline TowerInfoContainer * CaloManip::getTowerInfo( PHCompositeNode * topNode,
   const std::string & node_name , bool abort_on_missing 
 )
 {
-  auto towerinfo = findNode::getClass<TowerInfoContainer>( topNode, node_name );
+  auto towerinfo = m_nodes.get<TowerInfoContainer>( topNode, node_name );
   if ( ! towerinfo )
   {
     if ( abort_on_missing )
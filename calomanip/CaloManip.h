@@ -3,6 +3,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+
 #include <string>
 #include <vector>
 #include <limits>
@@ -45,6 +47,8 @@ class CaloManip : public SubsysReco {
 
  private:
 
+  NodeCache m_nodes {};
+
   std::string m_input_node { "" };
   
   float m_scale_factor { 1.0 };
@@ -73,6 +73,12 @@ int CaloSpy::Init(PHCompositeNode * /*topNode*/)
     return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int CaloSpy::InitRun(PHCompositeNode * /*topNode*/)
+{
+    m_nodes.clear();
+    return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int CaloSpy::process_event(PHCompositeNode *topNode)
 {
   
@@ -82,7 +88,7 @@ int CaloSpy::process_event(PHCompositeNode *topNode)
   
   for (unsigned int i = 0; i < m_caloNodes.size(); i++) {
   
-    auto towerinfo = findNode::getClass<TowerInfoContainer>( topNode, m_caloNodes[i] );
+    auto towerinfo = m_nodes.get<TowerInfoContainer>( topNode, m_caloNodes[i] );
     if ( ! towerinfo ) {
       std::cout << PHWHERE << " Input node " << m_caloNodes[i] << " Node missing, doing nothing." << std::endl;
       return Fun4AllReturnCodes::ABORTRUN;
@@ -3,6 +3,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+
 #include <string>
 #include <vector>
 #include <array>
@@ -25,11 +27,14 @@ class CaloSpy : public SubsysReco
 
    // standard Fun4All functions
    int Init(PHCompositeNode */*topNode*/) override;
+   int InitRun(PHCompositeNode */*topNode*/) override;
    int process_event(PHCompositeNode *topNode) override;
    int End(PHCompositeNode *topNode) override;
 
  private:
     
+   NodeCache m_nodes {};
+
    std::string m_output_filename { "output.root" };
    std::vector< std::string > m_caloNodes {};
 
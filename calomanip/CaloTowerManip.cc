@@ -33,6 +33,8 @@ CaloTowerManip::CaloTowerManip( const std::string &name )
 
 int CaloTowerManip::InitRun( PHCompositeNode * topNode )
 {
+  m_nodes.clear();
+
   if ( m_input_node.empty() ) { // make sure input node is set
     std::cout << PHWHERE << "Input node not set, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
@@ -98,14 +100,14 @@ int CaloTowerManip::InitRun( PHCompositeNode * topNode )
 int CaloTowerManip::process_event( PHCompositeNode * topNode )
 {
   // get original tower info container
-  auto manip_towerinfo = findNode::getClass<TowerInfoContainer>( topNode, m_input_node );
+  auto manip_towerinfo = m_nodes.get<TowerInfoContainer>( topNode, m_input_node );
   if ( ! manip_towerinfo ) {
     std::cout << PHWHERE << " Input node " << m_input_node << " Node missing, doing nothing." << std::endl;
   }
 
   TowerInfoContainer * unmanip_towerinfo {nullptr};
   if ( m_save_original_towers ) {
-    unmanip_towerinfo = findNode::getClass<TowerInfoContainer>( topNode, m_output_node );
+    unmanip_towerinfo = m_nodes.get<TowerInfoContainer>( topNode, m_output_node );
     if ( ! unmanip_towerinfo ) {
       std::cout << PHWHERE << m_output_node << " Node missing, doing nothing." << std::endl;
       return Fun4AllReturnCodes::ABORTRUN;
@@ -3,6 +3,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+
 #include <iostream>
 #include <string>
 #include <cmath>
@@ -39,6 +41,8 @@ class CaloTowerManip : public SubsysReco
 
  private:
 
+  NodeCache m_nodes {};
+
   std::string m_input_node;
 
   bool m_save_original_towers{ false };
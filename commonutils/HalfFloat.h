@@ -0,0 +1,81 @@
+#ifndef _HALFFLOAT_H_
+#define _HALFFLOAT_H_
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// IEEE 754 binary16 conversions, round to nearest even, no denormal
+// flush. Used for the fp16 tower storage of the background library and
+// CaloWindowMapv2, header only so io libraries need not link anything.
+namespace HalfFloat
+{
+  inline uint16_t float_to_half( const float f )
+  {
+    uint32_t x = 0;
+    std::memcpy(&x, &f, sizeof(x));
+
+    const uint16_t sign = static_cast<uint16_t>( ( x >> 16 ) & 0x8000 );
+    const uint32_t abs = x & 0x7fffffff;
+
+    if ( abs >= 0x7f800000 ) // inf or nan
+    {
+      return sign | 0x7c00 | ( abs > 0x7f800000 ? 0x200 : 0 );
+    }
+    if ( abs >= 0x477ff000 ) // rounds to >= 65520, overflow to inf
+    {
+      return sign | 0x7c00;
+    }
+    if ( abs < 0x38800000 ) // below the smallest normal half, denormal or zero
+    {
+      if ( abs < 0x33000000 ) { return sign; } // rounds to zero
+      const uint32_t mant = ( abs & 0x007fffff ) | 0x00800000;
+      const int shift = 126 - static_cast<int>( abs >> 23 );
+      const uint32_t half = mant >> shift;
+      const uint32_t rest = mant & ( ( 1u << shift ) - 1 );
+      const uint32_t halfway = 1u << ( shift - 1 );
+      const uint32_t rounded = half + ( ( rest > halfway || ( rest == halfway && ( half & 1 ) ) ) ? 1 : 0 );
+      return sign | static_cast<uint16_t>(rounded);
+    }
+
+    // normal, rebias exponent and round mantissa to nearest even
+    uint32_t h = ( ( abs >> 13 ) - ( 112 << 10 ) );
+    const uint32_t rest = abs & 0x1fff;
+    if ( rest > 0x1000 || ( rest == 0x1000 && ( h & 1 ) ) ) { ++h; }
+    return sign | static_cast<uint16_t>(h);
+  }
+
+  inline float half_to_float( const uint16_t h )
+  {
+    const uint32_t sign = static_cast<uint32_t>( h & 0x8000 ) << 16;
+    const uint32_t exp = ( h >> 10 ) & 0x1f;
+    const uint32_t mant = h & 0x3ff;
+
+    uint32_t x = 0;
+    if ( exp == 0 )
+    {
+      if ( mant == 0 ) { x = sign; }
+      else
+      {
+        const float f = std::ldexp(static_cast<float>(mant), -24);
+        std::memcpy(&x, &f, sizeof(x));
+        x |= sign;
+      }
+    }
+    else if ( exp == 0x1f )
+    {
+      x = sign | 0x7f800000 | ( mant << 13 );
+    }
+    else
+    {
+      x = sign | ( ( exp + 112 ) << 23 ) | ( mant << 13 );
+    }
+
+    float f = 0;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+  }
+
+} // namespace HalfFloat
+
+#endif // _HALFFLOAT_H_
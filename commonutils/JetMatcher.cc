@@ -0,0 +1,115 @@
+#include "JetMatcher.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  const float kTwoPi = 2.0 * M_PI;
+
+  // phi in [0, 2pi)
+  float wrap_phi( const float phi )
+  {
+    float p = std::fmod(phi, kTwoPi);
+    if ( p < 0 ) { p += kTwoPi; }
+    return p < kTwoPi ? p : 0;
+  }
+
+  float delta_R( const float eta1, const float phi1, const float eta2, const float phi2 )
+  {
+    float dphi = std::fabs(phi1 - phi2);
+    if ( dphi > M_PI ) { dphi = kTwoPi - dphi; }
+    const float deta = eta1 - eta2;
+    return std::sqrt(deta * deta + dphi * dphi);
+  }
+
+} // namespace
+
+unsigned int JetMatcher::Match( const std::vector<float> & eta_a, const std::vector<float> & phi_a,
+                                const std::vector<float> & eta_b, const std::vector<float> & phi_b,
+                                std::vector<int> & a_to_b, std::vector<float> & a_dR, std::vector<int> & b_to_a )
+{
+  const int na = static_cast<int>( eta_a.size() );
+  const int nb = static_cast<int>( eta_b.size() );
+
+  a_to_b.assign(na, -1);
+  a_dR.assign(na, -1);
+  b_to_a.assign(nb, -1);
+
+  if ( na == 0 || nb == 0 || !( m_dR_max > 0 ) ) { return 0; }
+
+  // grid over the eta range of b, cells at least dR_max wide
+  const auto [eta_lo, eta_hi] = std::minmax_element(eta_b.begin(), eta_b.end());
+  const float eta_min = *eta_lo;
+  const int neta = static_cast<int>( ( *eta_hi - eta_min ) / m_dR_max ) + 1;
+  const int nphi = std::max(1, static_cast<int>( kTwoPi / m_dR_max ));
+  const float phi_width = kTwoPi / nphi;
+
+  auto phi_bin = [&]( const float phi ) { return std::min(nphi - 1, static_cast<int>( wrap_phi(phi) / phi_width )); };
+
+  m_cell_start.assign(neta * nphi + 1, 0);
+  m_jet_cell.resize(nb);
+  for ( int ib = 0; ib < nb; ++ib )
+  {
+    const int ieta = std::min(neta - 1, static_cast<int>( ( eta_b[ib] - eta_min ) / m_dR_max ));
+    m_jet_cell[ib] = ieta * nphi + phi_bin(phi_b[ib]);
+    ++m_cell_start[m_jet_cell[ib] + 1];
+  }
+  for ( int icell = 0; icell < neta * nphi; ++icell )
+  {
+    m_cell_start[icell + 1] += m_cell_start[icell];
+  }
+  m_cell_fill.assign(m_cell_start.begin(), m_cell_start.end() - 1);
+  m_cell_jets.resize(nb);
+  for ( int ib = 0; ib < nb; ++ib )
+  {
+    m_cell_jets[m_cell_fill[m_jet_cell[ib]]++] = ib;
+  }
+
+  // candidate pairs from the 3x3 neighbourhood of each a
+  m_candidates.clear();
+  for ( int ia = 0; ia < na; ++ia )
+  {
+    const float x = ( eta_a[ia] - eta_min ) / m_dR_max;
+    if ( x < -1 || x >= neta + 1 ) { continue; }
+    const int ieta_a = static_cast<int>( std::floor(x) );
+    const int iphi_a = phi_bin(phi_a[ia]);
+
+    for ( int ieta = std::max(0, ieta_a - 1); ieta <= std::min(neta - 1, ieta_a + 1); ++ieta )
+    {
+      // with fewer than 3 phi cells every cell is a neighbour, visit each once
+      const int nphi_scan = std::min(nphi, 3);
+      for ( int k = 0; k < nphi_scan; ++k )
+      {
+        const int iphi = nphi < 3 ? k : ( iphi_a + k - 1 + nphi ) % nphi;
+        const int icell = ieta * nphi + iphi;
+        for ( int i = m_cell_start[icell]; i < m_cell_start[icell + 1]; ++i )
+        {
+          const int ib = m_cell_jets[i];
+          const float dR = delta_R(eta_a[ia], phi_a[ia], eta_b[ib], phi_b[ib]);
+          if ( dR < m_dR_max ) { m_candidates.push_back({ dR, ia, ib }); }
+        }
+      }
+    }
+  }
+
+  // closest pairs first, ties broken by index so the result is stable
+  std::sort(m_candidates.begin(), m_candidates.end(), []( const Candidate & l, const Candidate & r )
+  {
+    if ( l.dR != r.dR ) { return l.dR < r.dR; }
+    if ( l.ia != r.ia ) { return l.ia < r.ia; }
+    return l.ib < r.ib;
+  });
+
+  unsigned int nmatched = 0;
+  for ( const auto & c : m_candidates )
+  {
+    if ( a_to_b[c.ia] >= 0 || b_to_a[c.ib] >= 0 ) { continue; }
+    a_to_b[c.ia] = c.ib;
+    a_dR[c.ia] = c.dR;
+    b_to_a[c.ib] = c.ia;
+    ++nmatched;
+  }
+
+  return nmatched;
+}
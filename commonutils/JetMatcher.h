@@ -0,0 +1,54 @@
+#ifndef _JETMATCHER_H_
+#define _JETMATCHER_H_
+
+#include <vector>
+
+// Unique geometric matching of two jet collections in eta-phi.
+//
+// Collection b is hashed into an eta-phi grid of cells no smaller than
+// dR_max, so each jet of a only looks at the 3x3 cells around it (phi
+// wraps) instead of every jet of b. Candidate pairs with dR < dR_max
+// are then assigned closest first, each jet used at most once, which
+// is the same answer as the usual nested loop + sort.
+//
+// Scratch buffers are kept between calls, so one matcher per module
+// does no allocations once the jet multiplicity has been seen.
+class JetMatcher
+{
+  public:
+
+    JetMatcher( const float dR_max = 0.3 ) { set_dR_max(dR_max); }
+    ~JetMatcher() {}
+
+    void set_dR_max( const float dR_max ) { m_dR_max = dR_max; }
+    float get_dR_max() const { return m_dR_max; }
+
+    // a_to_b[i] : index in b matched to a[i], -1 if unmatched
+    // a_dR[i]   : dR of that match, -1 if unmatched
+    // b_to_a[j] : index in a matched to b[j], -1 if unmatched
+    // returns the number of matched pairs
+    unsigned int Match( const std::vector<float> & eta_a, const std::vector<float> & phi_a,
+                        const std::vector<float> & eta_b, const std::vector<float> & phi_b,
+                        std::vector<int> & a_to_b, std::vector<float> & a_dR, std::vector<int> & b_to_a );
+
+  private:
+
+    float m_dR_max { 0.3 };
+
+    struct Candidate
+    {
+      float dR;
+      int ia;
+      int ib;
+    };
+
+    // grid cells in CSR form, m_cell_start[icell] .. m_cell_start[icell+1]
+    // index into m_cell_jets
+    std::vector<int> m_cell_start {};
+    std::vector<int> m_cell_jets {};
+    std::vector<int> m_cell_fill {};
+    std::vector<int> m_jet_cell {};
+    std::vector<Candidate> m_candidates {};
+};
+
+#endif // _JETMATCHER_H_
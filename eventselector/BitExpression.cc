@@ -0,0 +1,207 @@
+#include "BitExpression.h"
+
+#include <algorithm>
+#include <cctype>
+
+bool BitExpression::Compile(const std::string &expression, const std::vector<std::string> &names)
+{
+    return Compile(expression, [&names](const std::string &name) {
+        for ( unsigned int i = 0; i < names.size() && i < 64; ++i ) {
+            if ( names[i] == name ) { return static_cast<int>(i); }
+        }
+        return -1;
+    });
+}
+
+bool BitExpression::Compile(const std::string &expression, const std::function<int(const std::string &)> &lookup)
+{
+    m_expression = expression;
+    m_error.clear();
+    m_terms.clear();
+    m_text = expression;
+    m_pos = 0;
+    m_lookup = lookup;
+
+    Sop terms {};
+    bool ok = ParseOr(terms);
+    if ( ok ) {
+        SkipSpace();
+        if ( m_pos != m_text.size() ) { ok = Fail("unexpected '" + m_text.substr(m_pos, 1) + "'"); }
+    }
+    if ( ok && terms.size() > kMAX_TERMS ) {
+        ok = Fail("more than " + std::to_string(kMAX_TERMS) + " terms");
+    }
+
+    m_lookup = nullptr;
+    if ( !ok ) { return false; }
+
+    m_terms = terms;
+    return true;
+}
+
+uint64_t BitExpression::GetUsedBits() const
+{
+    uint64_t bits = 0;
+    for ( const auto &term : m_terms ) { bits |= term.mask; }
+    return bits;
+}
+
+void BitExpression::identify(std::ostream &os) const
+{
+    os << "BitExpression: " << m_expression << " -> " << m_terms.size() << " terms" << std::endl;
+    for ( const auto &term : m_terms ) {
+        os << "  ( bits & 0x" << std::hex << term.mask << " ) == 0x" << term.value << std::dec << std::endl;
+    }
+    return ;
+}
+
+void BitExpression::SkipSpace()
+{
+    while ( m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])) ) { ++m_pos; }
+}
+
+bool BitExpression::Fail(const std::string &what)
+{
+    if ( m_error.empty() ) {
+        m_error = what + " at position " + std::to_string(m_pos) + " in \"" + m_text + "\"";
+    }
+    return false;
+}
+
+// or := and ( ( '|' | '||' ) and )*
+bool BitExpression::ParseOr(Sop &out)
+{
+    if ( !ParseAnd(out) ) { return false; }
+    while ( true ) {
+        SkipSpace();
+        if ( m_pos >= m_text.size() || m_text[m_pos] != '|' ) { return true; }
+        m_pos += ( m_pos + 1 < m_text.size() && m_text[m_pos + 1] == '|' ) ? 2 : 1;
+
+        Sop rhs {};
+        if ( !ParseAnd(rhs) ) { return false; }
+        out = Or(out, rhs);
+        if ( out.size() > kMAX_TERMS ) { return Fail("more than " + std::to_string(kMAX_TERMS) + " terms"); }
+    }
+}
+
+// and := unary ( ( '&' | '&&' ) unary )*
+bool BitExpression::ParseAnd(Sop &out)
+{
+    if ( !ParseUnary(out) ) { return false; }
+    while ( true ) {
+        SkipSpace();
+        if ( m_pos >= m_text.size() || m_text[m_pos] != '&' ) { return true; }
+        m_pos += ( m_pos + 1 < m_text.size() && m_text[m_pos + 1] == '&' ) ? 2 : 1;
+
+        Sop rhs {};
+        if ( !ParseUnary(rhs) ) { return false; }
+        out = And(out, rhs);
+        if ( out.size() > kMAX_TERMS ) { return Fail("more than " + std::to_string(kMAX_TERMS) + " terms"); }
+    }
+}
+
+// unary := '!' unary | '(' or ')' | name
+bool BitExpression::ParseUnary(Sop &out)
+{
+    SkipSpace();
+    if ( m_pos >= m_text.size() ) { return Fail("unexpected end"); }
+
+    const char c = m_text[m_pos];
+    if ( c == '!' ) {
+        ++m_pos;
+        Sop inner {};
+        if ( !ParseUnary(inner) ) { return false; }
+        out = Not(inner);
+        if ( out.size() > kMAX_TERMS ) { return Fail("more than " + std::to_string(kMAX_TERMS) + " terms"); }
+        return true;
+    }
+    if ( c == '(' ) {
+        ++m_pos;
+        if ( !ParseOr(out) ) { return false; }
+        SkipSpace();
+        if ( m_pos >= m_text.size() || m_text[m_pos] != ')' ) { return Fail("missing ')'"); }
+        ++m_pos;
+        return true;
+    }
+
+    const std::size_t start = m_pos;
+    while ( m_pos < m_text.size() && ( std::isalnum(static_cast<unsigned char>(m_text[m_pos])) || m_text[m_pos] == '_' || m_text[m_pos] == '.' ) ) { ++m_pos; }
+    if ( m_pos == start ) { return Fail("expected a name"); }
+
+    const std::string name = m_text.substr(start, m_pos - start);
+    if ( name == "1" ) { out = { Term{ 0, 0 } }; return true; }
+    if ( name == "0" ) { out.clear(); return true; }
+
+    const int bit = m_lookup ? m_lookup(name) : -1;
+    if ( bit < 0 || bit > 63 ) {
+        m_pos = start;
+        return Fail("unknown name '" + name + "'");
+    }
+    const uint64_t mask = uint64_t{1} << bit;
+    out = { Term{ mask, mask } };
+    return true;
+}
+
+BitExpression::Sop BitExpression::And(const Sop &a, const Sop &b)
+{
+    Sop out {};
+    for ( const auto &ta : a ) {
+        for ( const auto &tb : b ) {
+            // contradictory on a shared bit, the product is false
+            const uint64_t shared = ta.mask & tb.mask;
+            if ( ( ta.value & shared ) != ( tb.value & shared ) ) { continue; }
+            out.push_back(Term{ ta.mask | tb.mask, ta.value | tb.value });
+        }
+    }
+    Simplify(out);
+    return out;
+}
+
+BitExpression::Sop BitExpression::Or(const Sop &a, const Sop &b)
+{
+    Sop out = a;
+    out.insert(out.end(), b.begin(), b.end());
+    Simplify(out);
+    return out;
+}
+
+BitExpression::Sop BitExpression::Not(const Sop &a)
+{
+    // !( t1 | t2 | ... ) = !t1 & !t2 & ..., and !t is the OR of its flipped literals
+    Sop out = { Term{ 0, 0 } };
+    for ( const auto &term : a ) {
+        Sop flipped {};
+        for ( int bit = 0; bit < 64; ++bit ) {
+            const uint64_t b = uint64_t{1} << bit;
+            if ( term.mask & b ) { flipped.push_back(Term{ b, ~term.value & b }); }
+        }
+        out = And(out, flipped);
+        if ( out.empty() || out.size() > kMAX_TERMS ) { break; }
+    }
+    return out;
+}
+
+void BitExpression::Simplify(Sop &terms)
+{
+    // drop duplicates and terms implied by a looser one ( fewer bits, same values )
+    std::sort(terms.begin(), terms.end(), [](const Term &l, const Term &r) {
+        const int nl = __builtin_popcountll(l.mask);
+        const int nr = __builtin_popcountll(r.mask);
+        if ( nl != nr ) { return nl < nr; }
+        if ( l.mask != r.mask ) { return l.mask < r.mask; }
+        return l.value < r.value;
+    });
+
+    Sop kept {};
+    for ( const auto &term : terms ) {
+        bool implied = false;
+        for ( const auto &k : kept ) {
+            if ( ( k.mask & term.mask ) == k.mask && ( term.value & k.mask ) == k.value ) {
+                implied = true;
+                break;
+            }
+        }
+        if ( !implied ) { kept.push_back(term); }
+    }
+    terms.swap(kept);
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file BitExpression.h
+ * \brief BitExpression: boolean expression over named bits compiled to 64 bit mask/compare terms
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_BITEXPRESSION_H
+#define EVENTSELECTION_BITEXPRESSION_H
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Expressions like "(jet4 | jet6) & !mbd_ns1" ( '&&', '||' and 'not'
+// style '!' also accepted ) are compiled once into a sum of products:
+// the expression is true when ( bits & term.mask ) == term.value for
+// any term. Evaluating it is then a few integer ops per term, no
+// parsing or name lookups per event.
+//
+// Names are resolved by the lookup given to Compile(), returning the
+// bit ( 0 - 63 ) or -1 for an unknown name. "1" / "0" are the
+// constants true / false.
+class BitExpression
+{
+  public:
+
+    struct Term
+    {
+      uint64_t mask;
+      uint64_t value;
+    };
+
+    // negating large sums of products grows them, refuse beyond this
+    static const unsigned int kMAX_TERMS = 256;
+
+    BitExpression() {}
+    ~BitExpression() {}
+
+    // false on a syntax error or unknown name, see GetError()
+    bool Compile( const std::string &expression, const std::function<int(const std::string &)> &lookup );
+    bool Compile( const std::string &expression, const std::vector<std::string> &names );
+
+    bool Evaluate( const uint64_t bits ) const
+    {
+      for ( const auto &term : m_terms ) {
+        if ( ( bits & term.mask ) == term.value ) { return true; }
+      }
+      return false;
+    }
+
+    const std::string & GetExpression() const { return m_expression; }
+    const std::string & GetError() const { return m_error; }
+    const std::vector<Term> & GetTerms() const { return m_terms; }
+    uint64_t GetUsedBits() const;
+
+    void identify( std::ostream &os = std::cout ) const;
+
+  private:
+
+    typedef std::vector<Term> Sop;
+
+    std::string m_expression {""};
+    std::string m_error {""};
+    std::vector<Term> m_terms {};
+
+    // recursive descent state
+    std::string m_text {""};
+    std::size_t m_pos {0};
+    std::function<int(const std::string &)> m_lookup {};
+
+    bool ParseOr( Sop &out );
+    bool ParseAnd( Sop &out );
+    bool ParseUnary( Sop &out );
+    void SkipSpace();
+    bool Fail( const std::string &what );
+
+    static Sop And( const Sop &a, const Sop &b );
+    static Sop Or( const Sop &a, const Sop &b );
+    static Sop Not( const Sop &a );
+    static void Simplify( Sop &terms );
+};
+
+#endif // EVENTSELECTION_BITEXPRESSION_H
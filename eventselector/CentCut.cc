@@ -4,10 +4,8 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/getClass.h>
 
-// jet reco
-#include <centrality/CentralityInfo.h>
-#include <centrality/CentralityInfov1.h>
-#include <centrality/CentralityInfov2.h>
+#include "EventSummary.h"
+#include "EventSummaryReco.h"
 
 #include <cstdlib>
 
@@ -23,20 +21,14 @@ bool CentCut::operator()(PHCompositeNode *topNode)
 {
 
 
-    // get centrality
-    auto cent_node = findNode::getClass< CentralityInfo >(topNode, GetNodeName());
-    if ( !cent_node ) {
-        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " + GetNodeName() << std::endl;
+    // centrality decoded once per event by EventSummaryReco
+    auto * summary = EventSummaryReco::GetSummary(topNode, Nodes(), GetNodeName());
+    if ( !summary || !summary->has(EventSummary::kCENTRALITY) ) {
+        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find centrality for " + GetNodeName() << std::endl;
         exit(-1); // this is a fatal error
     }
 
-    int cent = -1;
-    if ( cent_node -> has_centrality_bin(CentralityInfo::PROP::mbd_NS) ) {
-        cent = (int)(cent_node->get_centrality_bin(CentralityInfo::PROP::mbd_NS));
-    } else if ( cent_node -> has_centile(CentralityInfo::PROP::mbd_NS) ){
-        cent = (int)(cent_node->get_centile(CentralityInfo::PROP::mbd_NS));
-    } 
-
+    const int cent = summary->get_centrality();
     if ( cent < 0 ) {
         if(Verbosity()){
             std::cout << Name() + "::operator(PHCompositeNode *topNode) Could not find valid centrality in " + GetNodeName() << std::endl;
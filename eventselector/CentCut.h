@@ -17,7 +17,7 @@ class CentCut  : public EventCut
 {
   public:
 
-    CentCut() : EventCut("CentCut") {}
+    CentCut() : EventCut("CentCut") { SetNodeName("EventSummary"); } // see EventSummaryReco
     ~CentCut() override {}
 
     void identify(std::ostream &os = std::cout) const override;
@@ -15,6 +15,8 @@
  #include <utility>
  #include <cmath>  
  
+ #include "NodeCache.h"
+ 
  class PHCompositeNode;
  
  class EventCut
@@ -37,12 +39,18 @@
      void Verbosity(int verbosity) { m_verbosity = verbosity; }
  
      virtual bool operator()(PHCompositeNode* topNode) = 0;
+
+     // once per run before the first event, false aborts the run
+     virtual bool InitRun(PHCompositeNode* /*topNode*/) { return true; }
  
      void SetNodeNames(const std::vector<std::string> & names) { m_node_names = names; }
      const std::vector<std::string>& GetNodeNames() const { return m_node_names; }
      void SetNodeName(const std::string &name) { SetNodeNames({ name }); }
      const std::string& GetNodeName() const { return GetNodeNames().front(); }
  
+     // node handles are per run, EventSelector::InitRun() clears them
+     void ClearNodes() { m_nodes.clear(); }
+ 
      void AddEventValue(float value) { m_value = value; }
      float GetEventValue() const { return m_value; }
  
@@ -96,6 +104,9 @@
      
      EventCut( const std::string &name = "EventCut" ) :  m_name(name) {}
  
+     // drop in for findNode::getClass in operator()
+     NodeCache& Nodes() { return m_nodes; }
+ 
    private:
  
      int m_verbosity{0};
@@ -104,6 +115,7 @@
      bool m_result{false};
  
      std::vector<std::string> m_node_names {};
+     NodeCache m_nodes {};
  
      // only used for cuts that need a range
      std::pair<float, float> m_var_range{NAN, NAN};
@@ -0,0 +1,96 @@
+/*!
+ * \file EventCutRecord.h
+ * \brief EventCutRecord: per event result and value of every EventSelector cut
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_EVENTCUTRECORD_H
+#define EVENTSELECTION_EVENTCUTRECORD_H
+
+#include <phool/PHObject.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class EventCutRecord : public PHObject
+{
+  public:
+
+    // one bit per cut in the mask
+    static const unsigned int kMAX_CUTS = 64;
+
+    // node of the record written by the EventSelector called selector
+    static std::string NodeName(const std::string &selector) { return "EventCutRecord_" + selector; }
+
+    ~EventCutRecord() override {}
+
+    void identify(std::ostream &os = std::cout) const override { os << "EventCutRecord base class" << std::endl; }
+    int isValid() const override { return 0; }
+
+    virtual void set_run(const int /*run*/) { return; }
+    virtual void set_event(const int /*event*/) { return; }
+    virtual int get_run() const { return 0; }
+    virtual int get_event() const { return -1; }
+
+    // cut names in EventSelector order, bit i of the mask is cut i.
+    // The names are configuration, they survive Reset() and are not
+    // written out, a record read back from a DST only has the bits
+    virtual void set_cut_names(const std::vector<std::string> & /*names*/) { return; }
+    virtual unsigned int n_cuts() const { return 0; }
+    virtual std::string get_cut_name(const unsigned int /*icut*/) const { return ""; }
+    virtual int find_cut(const std::string & /*name*/) const { return -1; }
+
+    virtual void set_result(const unsigned int /*icut*/, const bool /*passed*/, const float /*value*/) { return; }
+    virtual uint64_t get_mask() const { return 0; }
+    virtual bool passed(const unsigned int /*icut*/) const { return false; }
+    virtual float get_value(const unsigned int /*icut*/) const { return NAN; } // EventCut::GetEventValue()
+
+    // streams ( named selection expressions ), bit i of the stream mask is
+    // stream i. The names are configuration like the cut names
+    virtual void set_stream_names(const std::vector<std::string> & /*names*/) { return; }
+    virtual unsigned int n_streams() const { return 0; }
+    virtual std::string get_stream_name(const unsigned int /*istream*/) const { return ""; }
+    virtual int find_stream(const std::string & /*name*/) const { return -1; }
+    virtual void set_stream_mask(const uint64_t /*mask*/) { return; }
+    virtual uint64_t get_stream_mask() const { return 0; }
+
+    bool accepted(const std::string &stream) const
+    {
+      const int istream = find_stream(stream);
+      return istream >= 0 && ( ( get_stream_mask() >> istream ) & 1U );
+    }
+
+    bool passed_all() const { return n_cuts() == 0 || ( get_mask() & mask_of_all() ) == mask_of_all(); }
+
+    // mask of the named cuts, unknown names are reported and ignored
+    uint64_t get_cut_mask(const std::vector<std::string> &names) const
+    {
+      uint64_t mask = 0;
+      for ( const auto &name : names ) {
+        const int icut = find_cut(name);
+        if ( icut < 0 ) {
+          std::cerr << "EventCutRecord::get_cut_mask - unknown cut " << name << std::endl;
+          continue;
+        }
+        mask |= ( uint64_t{1} << icut );
+      }
+      return mask;
+    }
+
+  protected:
+
+    EventCutRecord() {}
+
+    uint64_t mask_of_all() const { return n_cuts() >= kMAX_CUTS ? ~uint64_t{0} : ( uint64_t{1} << n_cuts() ) - 1; }
+
+  private:
+
+    ClassDefOverride(EventCutRecord, 1);
+};
+
+#endif // EVENTSELECTION_EVENTCUTRECORD_H
@@ -0,0 +1,75 @@
+#include "EventCutRecordv1.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void EventCutRecordv1::identify(std::ostream &os) const
+{
+    os << "EventCutRecordv1: run " << m_run << " event " << m_event << ", " << n_cuts() << " cuts" << std::endl;
+    for ( unsigned int icut = 0; icut < n_cuts(); ++icut ) {
+        os << "  " << get_cut_name(icut) << ": " << ( passed(icut) ? "passed" : "failed" ) << ", value = " << m_values.at(icut) << std::endl;
+    }
+    for ( unsigned int istream = 0; istream < m_streams.size(); ++istream ) {
+        os << "  stream " << m_streams.at(istream) << ": " << ( accepted(m_streams.at(istream)) ? "accepted" : "rejected" ) << std::endl;
+    }
+    return ;
+}
+
+void EventCutRecordv1::Reset()
+{
+    // cut names are configuration, only the event content is cleared
+    m_run = 0;
+    m_event = -1;
+    m_mask = 0;
+    m_stream_mask = 0;
+    std::fill(m_values.begin(), m_values.end(), NAN);
+    return ;
+}
+
+void EventCutRecordv1::set_cut_names(const std::vector<std::string> &names)
+{
+    if ( names.size() > kMAX_CUTS ) {
+        std::cerr << "EventCutRecordv1::set_cut_names - " << names.size() << " cuts, only the first " << kMAX_CUTS << " are recorded" << std::endl;
+    }
+    m_cuts.assign(names.begin(), names.begin() + std::min<std::size_t>(names.size(), kMAX_CUTS));
+    m_values.assign(m_cuts.size(), NAN);
+    m_mask = 0;
+    return ;
+}
+
+int EventCutRecordv1::find_cut(const std::string &name) const
+{
+    for ( unsigned int icut = 0; icut < m_cuts.size(); ++icut ) {
+        if ( m_cuts[icut] == name ) { return icut; }
+    }
+    return -1;
+}
+
+void EventCutRecordv1::set_stream_names(const std::vector<std::string> &names)
+{
+    if ( names.size() > kMAX_CUTS ) {
+        std::cerr << "EventCutRecordv1::set_stream_names - " << names.size() << " streams, only the first " << kMAX_CUTS << " are recorded" << std::endl;
+    }
+    m_streams.assign(names.begin(), names.begin() + std::min<std::size_t>(names.size(), kMAX_CUTS));
+    m_stream_mask = 0;
+    return ;
+}
+
+int EventCutRecordv1::find_stream(const std::string &name) const
+{
+    for ( unsigned int istream = 0; istream < m_streams.size(); ++istream ) {
+        if ( m_streams[istream] == name ) { return istream; }
+    }
+    return -1;
+}
+
+void EventCutRecordv1::set_result(const unsigned int icut, const bool passed, const float value)
+{
+    if ( icut >= m_values.size() ) { return; }
+
+    const uint64_t bit = uint64_t{1} << icut;
+    m_mask = passed ? ( m_mask | bit ) : ( m_mask & ~bit );
+    m_values[icut] = value;
+    return ;
+}
@@ -0,0 +1,63 @@
+/*!
+ * \file EventCutRecordv1.h
+ * \brief EventCutRecordv1: run, event, 64 bit cut mask and one value per cut
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_EVENTCUTRECORDV1_H
+#define EVENTSELECTION_EVENTCUTRECORDV1_H
+
+#include "EventCutRecord.h"
+
+#include <string>
+#include <vector>
+
+class EventCutRecordv1 : public EventCutRecord
+{
+  public:
+
+    EventCutRecordv1() {}
+    ~EventCutRecordv1() override {}
+
+    void identify(std::ostream &os = std::cout) const override;
+    void Reset() override;
+    int isValid() const override { return !m_values.empty(); }
+
+    void set_run(const int run) override { m_run = run; }
+    void set_event(const int event) override { m_event = event; }
+    int get_run() const override { return m_run; }
+    int get_event() const override { return m_event; }
+
+    void set_cut_names(const std::vector<std::string> &names) override;
+    unsigned int n_cuts() const override { return m_values.size(); }
+    std::string get_cut_name(const unsigned int icut) const override { return icut < m_cuts.size() ? m_cuts[icut] : ""; }
+    int find_cut(const std::string &name) const override;
+
+    void set_result(const unsigned int icut, const bool passed, const float value) override;
+    uint64_t get_mask() const override { return m_mask; }
+    bool passed(const unsigned int icut) const override { return icut < m_values.size() && ( ( m_mask >> icut ) & 1U ); }
+    float get_value(const unsigned int icut) const override { return icut < m_values.size() ? m_values[icut] : NAN; }
+
+    void set_stream_names(const std::vector<std::string> &names) override;
+    unsigned int n_streams() const override { return m_streams.size(); }
+    std::string get_stream_name(const unsigned int istream) const override { return istream < m_streams.size() ? m_streams[istream] : ""; }
+    int find_stream(const std::string &name) const override;
+    void set_stream_mask(const uint64_t mask) override { m_stream_mask = mask; }
+    uint64_t get_stream_mask() const override { return m_stream_mask; }
+
+  private:
+
+    int m_run {0};
+    int m_event {-1};
+    uint64_t m_mask {0};
+    std::vector<std::string> m_cuts {}; //! per run configuration, set by EventSelector
+    std::vector<float> m_values {};
+    uint64_t m_stream_mask {0};
+    std::vector<std::string> m_streams {}; //! per run configuration, set by EventSelector
+
+    ClassDefOverride(EventCutRecordv1, 2);
+};
+
+#endif // EVENTSELECTION_EVENTCUTRECORDV1_H
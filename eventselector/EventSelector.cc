@@ -1,10 +1,23 @@
 #include "EventSelector.h"
 #include "EventCut.h"
 #include "EventCutReport.h"
+#include "EventCutRecord.h"
+#include "EventCutRecordv1.h"
 
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <ffaobjects/EventHeader.h>
+
 #include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
+#include <phool/getClass.h>
+#include <phool/recoConsts.h>
+
+#include <TEntryList.h>
+#include <TFile.h>
+#include <TTree.h>
 
 
 EventSelector::~EventSelector()
@@ -17,6 +30,12 @@ EventSelector::~EventSelector()
   if(m_report){
     delete m_report;
   }
+
+  // the entry lists and tree belong to the record file
+  if(m_record_file){
+    m_record_file->Close();
+    delete m_record_file;
+  }
 }
 
 void EventSelector::AddCut(EventCut * cut)
@@ -32,6 +51,30 @@ void EventSelector::AddCut(EventCut * cut)
   return ;
 }
 
+void EventSelector::AddSelection(const std::string &name, const std::vector<std::string> &cuts)
+{
+  for(const auto &selection : m_selections){
+    if(selection.first == name){
+      std::cerr << Name() + "::AddSelection(const std::string &name, const std::vector<std::string> &cuts) Selection " + name + " already exists" << std::endl;
+      return ;
+    }
+  }
+  m_selections.push_back(std::make_pair(name, cuts));
+  return ;
+}
+
+void EventSelector::AddStream(const std::string &name, const std::string &expression)
+{
+  for(const auto &stream : m_streams){
+    if(stream.first == name){
+      std::cerr << Name() + "::AddStream(const std::string &name, const std::string &expression) Stream " + name + " already exists" << std::endl;
+      return ;
+    }
+  }
+  m_streams.push_back(std::make_pair(name, expression));
+  return ;
+}
+
 void EventSelector::AddCuts(const std::vector<EventCut *> &cuts)
 {
   for(auto cut: cuts){
@@ -85,32 +128,195 @@ bool EventSelector::CutInVector(const std::string &name)
   return FindCutIdx(name) < m_cuts.size();
 }
 
-int EventSelector::InitRun(PHCompositeNode * /*topNode*/)
+int EventSelector::InitRun(PHCompositeNode *topNode)
 {
   m_report = new EventCutReport();
   for(auto cut: m_cuts){
     cut->Verbosity(Verbosity());
+    cut->ClearNodes();
+    if(!cut->InitRun(topNode)){
+      std::cerr << Name() + "::InitRun(PHCompositeNode *topNode) Cut " + cut->Name() + " failed to initialize" << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  m_nodes.clear();
+
+  if(m_cuts.size() > EventCutRecord::kMAX_CUTS){
+    std::cerr << Name() + "::InitRun(PHCompositeNode *topNode) " << m_cuts.size() << " cuts, only the first "
+              << EventCutRecord::kMAX_CUTS << " are recorded" << std::endl;
+  }
+
+  return CreateRecord(topNode);
+}
+
+std::string EventSelector::GetRecordNode() const
+{
+  return EventCutRecord::NodeName(Name());
+}
+
+int EventSelector::CreateRecord(PHCompositeNode *topNode)
+{
+  std::vector<std::string> cut_names {};
+  for(auto cut: m_cuts){
+    cut_names.push_back(cut->Name());
+  }
+
+  m_record = findNode::getClass<EventCutRecord>(topNode, GetRecordNode());
+  if(!m_record){
+    PHNodeIterator iter(topNode);
+    auto * dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if(!dstNode){
+      std::cerr << Name() + "::CreateRecord(PHCompositeNode *topNode) DST node missing, doing nothing." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    m_record = new EventCutRecordv1();
+    dstNode->addNode(new PHIODataNode<PHObject>(m_record, GetRecordNode(), "PHObject"));
+  }
+  m_record->set_cut_names(cut_names);
+
+  // streams, an expression that does not compile is a configuration error
+  std::vector<std::string> stream_names {};
+  m_stream_exprs.assign(m_streams.size(), BitExpression());
+  m_stream_counts.resize(m_streams.size(), 0);
+  for(unsigned int istream = 0; istream < m_streams.size(); istream++){
+    if(!m_stream_exprs[istream].Compile(m_streams[istream].second, cut_names)){
+      std::cerr << Name() + "::CreateRecord(PHCompositeNode *topNode) Stream " + m_streams[istream].first + ": " + m_stream_exprs[istream].GetError() << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    if(Verbosity()){
+      m_stream_exprs[istream].identify();
+    }
+    stream_names.push_back(m_streams[istream].first);
+  }
+  m_record->set_stream_names(stream_names);
+
+  // selection masks, an unknown cut name is a configuration error
+  m_selection_masks.clear();
+  for(const auto &selection : m_selections){
+    for(const auto &cut : selection.second){
+      if(m_record->find_cut(cut) < 0){
+        std::cerr << Name() + "::CreateRecord(PHCompositeNode *topNode) Selection " + selection.first + " uses unknown cut " + cut << std::endl;
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+    }
+    m_selection_masks.push_back(m_record->get_cut_mask(selection.second));
+  }
+
+  if(!m_selections.empty() && m_record_filename.empty()){
+    std::cerr << Name() + "::CreateRecord(PHCompositeNode *topNode) Selections need SetRecordOutput(), no entry lists written" << std::endl;
+  }
+
+  // the record file spans all runs, only opened once
+  if(m_record_filename.empty() || m_record_file){
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  m_record_file = TFile::Open(m_record_filename.c_str(), "RECREATE");
+  if(!m_record_file || m_record_file->IsZombie()){
+    std::cerr << Name() + "::CreateRecord(PHCompositeNode *topNode) Could not open " + m_record_filename << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  m_record_file->cd();
+
+  m_record_tree = new TTree("EventCutRecord", "EventCutRecord");
+  m_record_tree->Branch("run", &m_record_run, "run/I");
+  m_record_tree->Branch("event", &m_record_event, "event/I");
+  m_record_tree->Branch("mask", &m_record_mask, "mask/l");
+  m_record_tree->Branch("passed", &m_record_passed, "passed/O");
+  m_record_tree->Branch("cut_values", &m_record_values);
+  if(!m_streams.empty()){
+    m_record_tree->Branch("streams", &m_record_streams, "streams/l");
   }
+  m_record_values.assign(m_record->n_cuts(), NAN);
+
+  // tree->Draw("cut_values[0]", "ZVertexCut && !MinBiasCut") style access
+  for(unsigned int icut = 0; icut < m_record->n_cuts(); icut++){
+    const std::string cut = m_record->get_cut_name(icut);
+    m_record_tree->SetAlias(cut.c_str(), ("((mask>>" + std::to_string(icut) + ")&1)").c_str());
+    m_record_tree->SetAlias((cut + "_value").c_str(), ("cut_values[" + std::to_string(icut) + "]").c_str());
+  }
+
+  for(unsigned int istream = 0; istream < m_streams.size(); istream++){
+    m_record_tree->SetAlias(("stream_" + m_streams[istream].first).c_str(), ("((streams>>" + std::to_string(istream) + ")&1)").c_str());
+  }
+
+  const std::string treename = m_entrylist_tree.empty() ? "EventCutRecord" : m_entrylist_tree;
+  const std::string filename = m_entrylist_tree.empty() ? m_record_filename : m_entrylist_file;
+  for(const auto &selection : m_selections){
+    m_entry_lists.push_back(new TEntryList(selection.first.c_str(), selection.first.c_str(), treename.c_str(), filename.c_str()));
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void EventSelector::FillRecord(PHCompositeNode *topNode, bool passed)
+{
+  recoConsts *rc = recoConsts::instance();
+  m_record->set_run(rc->get_IntFlag("RUNNUMBER"));
+
+  // event sequence if there is a header, otherwise the count of processed events
+  auto * eventheader = m_nodes.get<EventHeader>(topNode, m_eventheader_node);
+  m_record->set_event(eventheader ? eventheader->get_EvtSequence() : static_cast<int>(m_nevents_processed) - 1);
+
+  if(!m_record_tree){
+    return ;
+  }
+
+  m_record_run = m_record->get_run();
+  m_record_event = m_record->get_event();
+  m_record_mask = m_record->get_mask();
+  m_record_passed = passed;
+  m_record_streams = m_record->get_stream_mask();
+  for(unsigned int icut = 0; icut < m_record_values.size(); icut++){
+    m_record_values[icut] = m_record->get_value(icut);
+  }
+
+  // entry of this event in the record tree ( and in writer trees fed every event )
+  const long long entry = m_record_tree->GetEntries();
+  m_record_tree->Fill();
+  for(unsigned int isel = 0; isel < m_entry_lists.size(); isel++){
+    if((m_record_mask & m_selection_masks[isel]) == m_selection_masks[isel]){
+      m_entry_lists[isel]->Enter(entry);
+    }
+  }
+  return ;
+}
+
 int EventSelector::process_event(PHCompositeNode *topNode)
 {
 
   bool passed = true;
   m_nevents_processed++;
-  for(auto cut: m_cuts){
-    if(!(*cut)(topNode)){
+  for(unsigned int icut = 0; icut < m_cuts.size(); icut++){
+    auto cut = m_cuts[icut];
+    const bool cut_passed = (*cut)(topNode);
+    if(!cut_passed){
       passed = false;
     }
+    m_record->set_result(icut, cut_passed, cut->GetEventValue());
     m_report->addResult(cut);
   }
+
+  // with streams the event is kept if any of them accepts it
+  if(!m_stream_exprs.empty()){
+    uint64_t streams = 0;
+    for(unsigned int istream = 0; istream < m_stream_exprs.size(); istream++){
+      if(m_stream_exprs[istream].Evaluate(m_record->get_mask())){
+        streams |= (uint64_t{1} << istream);
+        m_stream_counts[istream]++;
+      }
+    }
+    m_record->set_stream_mask(streams);
+    passed = streams != 0;
+  }
+  FillRecord(topNode, passed);
+
   if(passed){
     m_nevents_passed++;
     return Fun4AllReturnCodes::EVENT_OK;
   }
   // if we get here, the event failed
-  return Fun4AllReturnCodes::ABORTEVENT;
+  return m_abort_on_fail ? Fun4AllReturnCodes::ABORTEVENT : Fun4AllReturnCodes::EVENT_OK;
 
 }
 
@@ -129,6 +335,24 @@ int EventSelector::End(PHCompositeNode * /*topNode*/)
     std::cout << "Events Summary: " << m_nevents_passed << "/" << m_nevents_processed << " (" << 100.0 * m_nevents_passed / m_nevents_processed << "%)" << std::endl;
     m_report->printReport();
   // }
+  for(unsigned int istream = 0; istream < m_stream_counts.size(); istream++){
+    std::cout << "Stream " << m_streams[istream].first << " (" << m_streams[istream].second << "): "
+              << m_stream_counts[istream] << "/" << m_nevents_processed << std::endl;
+  }
+
+  if(m_record_file){
+    m_record_file->cd();
+    m_record_tree->Write();
+    for(unsigned int isel = 0; isel < m_entry_lists.size(); isel++){
+      std::cout << "Selection " << m_selections[isel].first << ": " << m_entry_lists[isel]->GetN() << " entries" << std::endl;
+      m_entry_lists[isel]->Write();
+    }
+    m_record_file->Close();
+    delete m_record_file;
+    m_record_file = nullptr;
+    m_record_tree = nullptr;
+    m_entry_lists.clear();
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -9,15 +9,24 @@
 #ifndef EVENTSELECTION_EVENTSELECTOR_H
 #define EVENTSELECTION_EVENTSELECTOR_H
 
+#include "BitExpression.h"
+#include "NodeCache.h"
+
 #include <fun4all/SubsysReco.h>
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 class PHCompositeNode;
 class EventCut;
 class EventCutReport;
+class EventCutRecord;
+class TEntryList;
+class TFile;
+class TTree;
 
 class EventSelector : public SubsysReco
 {
@@ -36,6 +45,37 @@ class EventSelector : public SubsysReco
     // Print the cuts
     void PrintCuts( std::ostream &os = std::cout ) const;
 
+    // Every event the result and GetEventValue() of each cut is written to
+    // the EventCutRecord_<Name()> node ( DST ), so selectors with different
+    // names keep separate records. With SetAbortOnFail(false) failing
+    // events are kept and only the record carries the decision
+    std::string GetRecordNode() const;
+    void SetEventHeaderNode( const std::string &name ) { m_eventheader_node = name; }
+    void SetAbortOnFail( bool abort ) { m_abort_on_fail = abort; }
+
+    // Streams are named expressions over the cut names, e.g.
+    // AddStream("central", "MinBiasCut & CentCut & !LeadJetCut"). Each cut
+    // runs once per event, every stream is evaluated on the results and
+    // the accepting streams are published in the record, writers pick
+    // theirs with set_stream( stream, Name() ). With streams the event is kept when any
+    // stream accepts it
+    void AddStream( const std::string &name, const std::string &expression );
+
+    // Flat copy of the record ( run, event, mask, cut_values ) in its own
+    // file, with one alias per cut, plus a TEntryList per selection
+    void SetRecordOutput( const std::string &filename ) { m_record_filename = filename; }
+
+    // a selection passes when all of its cuts pass
+    void AddSelection( const std::string &name, const std::vector<std::string> &cuts );
+
+    // Tree the entry lists refer to, by default the record tree itself. A
+    // writer tree ( e.g. EventTree ) only lines up entry for entry when the
+    // writer sees every event, so use it with SetAbortOnFail(false)
+    void SetEntryListTree( const std::string &treename, const std::string &filename ) {
+      m_entrylist_tree = treename;
+      m_entrylist_file = filename;
+    }
+
     // Standard Fun4All functions
     int InitRun(PHCompositeNode *topNode) override;
     int process_event(PHCompositeNode *topNode) override;
@@ -53,6 +93,37 @@ class EventSelector : public SubsysReco
     bool CutInVector(const std::string &name);
 
     EventCutReport * m_report{nullptr};
+
+    // per event record
+    std::string m_eventheader_node {"EventHeader"};
+    bool m_abort_on_fail {true};
+    EventCutRecord * m_record {nullptr};
+    NodeCache m_nodes {};
+
+    std::string m_record_filename {""};
+    TFile * m_record_file {nullptr};
+    TTree * m_record_tree {nullptr};
+    int m_record_run {0};
+    int m_record_event {-1};
+    uint64_t m_record_mask {0};
+    bool m_record_passed {false};
+    std::vector<float> m_record_values {};
+
+    // streams, compiled against the cut names in InitRun
+    std::vector< std::pair< std::string, std::string > > m_streams {};
+    std::vector<BitExpression> m_stream_exprs {};
+    std::vector<unsigned int> m_stream_counts {};
+    uint64_t m_record_streams {0};
+
+    // selections, cut names are resolved to a mask in InitRun
+    std::vector< std::pair< std::string, std::vector<std::string> > > m_selections {};
+    std::vector<uint64_t> m_selection_masks {};
+    std::vector<TEntryList *> m_entry_lists {};
+    std::string m_entrylist_tree {""};
+    std::string m_entrylist_file {""};
+
+    int CreateRecord(PHCompositeNode *topNode);
+    void FillRecord(PHCompositeNode *topNode, bool passed);
 };
 
 #endif // EVENTSELECTION_EVENTSELECTOR_H
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*!
+ * \file EventSummary.h
+ * \brief EventSummary: vertex, centrality, MBD and event header decoded once per event
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_EVENTSUMMARY_H
+#define EVENTSELECTION_EVENTSUMMARY_H
+
+#include <phool/PHObject.h>
+
+#include <cmath>
+#include <iostream>
+
+class EventSummary : public PHObject
+{
+  public:
+
+    // which inputs were found this event, see has()
+    enum SOURCE
+    {
+      kVERTEXMAP = 1U << 0U,
+      kCENTRALITY = 1U << 1U,
+      kMBD = 1U << 2U,
+      kEVENTHEADER = 1U << 3U,
+      kMINBIAS = 1U << 4U
+    };
+
+    enum VERTEX
+    {
+      kVERTEX_OK = 0,
+      kVERTEX_MISSING = 1, // no vertex map, empty map or no vertex
+      kVERTEX_BAD = 2      // NaN or |z| > kMAX_ZVTX
+    };
+
+    enum ARM
+    {
+      kSOUTH = 0,
+      kNORTH = 1
+    };
+
+    static const int kNPSI = 6; // psi_1 .. psi_6
+
+    // the one vertex sanity check, anything else is a reco failure
+    static constexpr float kMAX_ZVTX = 1e3;
+    static bool is_good_zvtx(const float zvtx) { return !std::isnan(zvtx) && std::fabs(zvtx) <= kMAX_ZVTX; }
+
+    ~EventSummary() override {}
+
+    void identify(std::ostream &os = std::cout) const override { os << "EventSummary base class" << std::endl; }
+    int isValid() const override { return 0; }
+
+    // Reset() at the end of every event clears the filled flag
+    virtual void set_filled(const bool /*filled*/) { return; }
+    virtual bool is_filled() const { return false; }
+
+    virtual void set_sources(const unsigned int /*sources*/) { return; }
+    virtual unsigned int get_sources() const { return 0; }
+    bool has(const SOURCE source) const { return get_sources() & source; }
+
+    virtual void set_zvtx(const float /*zvtx*/, const int /*status*/) { return; }
+    virtual float get_zvtx() const { return NAN; }
+    virtual int get_vertex_status() const { return kVERTEX_MISSING; }
+    bool has_good_vertex() const { return get_vertex_status() == kVERTEX_OK; }
+
+    // mbd_NS centrality bin ( centile if there is no bin ), -1 if unknown
+    virtual void set_centrality(const int /*cent*/) { return; }
+    virtual int get_centrality() const { return -1; }
+
+    virtual void set_minbias(const bool /*minbias*/) { return; }
+    virtual bool is_minbias() const { return false; }
+
+    virtual void set_mbd(const int /*arm*/, const float /*q*/, const float /*t*/, const float /*npmt*/) { return; }
+    virtual float get_mbd_q(const int /*arm*/) const { return NAN; }
+    virtual float get_mbd_t(const int /*arm*/) const { return NAN; }
+    virtual float get_mbd_npmt(const int /*arm*/) const { return NAN; }
+
+    // event header ( simulation )
+    virtual void set_b(const float /*b*/) { return; }
+    virtual float get_b() const { return NAN; }
+    virtual void set_psi(const int /*n*/, const float /*psi*/) { return; }
+    virtual float get_psi(const int /*n*/) const { return NAN; }
+    virtual void set_ep_angle(const float /*ep_angle*/) { return; }
+    virtual float get_ep_angle() const { return NAN; }
+    virtual void set_ecc(const float /*ecc*/) { return; }
+    virtual float get_ecc() const { return NAN; }
+    virtual void set_ncoll(const float /*ncoll*/) { return; }
+    virtual float get_ncoll() const { return NAN; }
+    virtual void set_npart(const float /*npart*/) { return; }
+    virtual float get_npart() const { return NAN; }
+
+  protected:
+
+    EventSummary() {}
+
+  private:
+
+    ClassDefOverride(EventSummary, 1);
+};
+
+#endif // EVENTSELECTION_EVENTSUMMARY_H
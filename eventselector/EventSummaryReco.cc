@@ -0,0 +1,185 @@
+#include "EventSummaryReco.h"
+#include "EventSummary.h"
+#include "EventSummaryv1.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+// phool includes
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <globalvertex/GlobalVertex.h>
+#include <globalvertex/GlobalVertexMap.h>
+
+#include <centrality/CentralityInfo.h>
+
+#include <calotrigger/MinimumBiasInfo.h>
+
+#include <mbd/MbdOut.h>
+
+#include <ffaobjects/EventHeader.h>
+
+#include <iostream>
+
+namespace
+{
+  // replaces the static once flags each consumer had, first one is printed
+  unsigned int s_nmissing_vertex = 0;
+  unsigned int s_nbad_vertex = 0;
+  unsigned int s_nmissing_mbd = 0;
+}
+
+int EventSummaryReco::InitRun(PHCompositeNode *topNode)
+{
+    m_nodes.clear();
+    if ( !CreateNode(topNode, m_output_node) ) {
+        return Fun4AllReturnCodes::ABORTRUN;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int EventSummaryReco::process_event(PHCompositeNode *topNode)
+{
+    auto * summary = m_nodes.get<EventSummary>(topNode, m_output_node);
+    if ( !summary ) {
+        std::cerr << Name() + "::process_event(PHCompositeNode *topNode) Could not find " + m_output_node << std::endl;
+        return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    Fill(topNode, m_nodes, m_inputs, summary);
+
+    if ( Verbosity() > 1 ) {
+        summary->identify();
+    }
+
+    return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int EventSummaryReco::End(PHCompositeNode * /*topNode*/)
+{
+    if ( s_nmissing_vertex || s_nbad_vertex || s_nmissing_mbd ) {
+        std::cout << Name() + "::End(PHCompositeNode *topNode) events without vertex: " << s_nmissing_vertex
+                  << ", with bad vertex: " << s_nbad_vertex << ", without MBD: " << s_nmissing_mbd << std::endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+}
+
+EventSummary * EventSummaryReco::GetSummary(PHCompositeNode *topNode, NodeCache &nodes, const std::string &summary_node, const InputNodes &inputs)
+{
+    auto * summary = nodes.get<EventSummary>(topNode, summary_node);
+    if ( !summary ) {
+        summary = CreateNode(topNode, summary_node);
+        if ( !summary ) { return nullptr; }
+    }
+
+    // Reset() at the end of every event clears the filled flag
+    if ( !summary->is_filled() ) {
+        Fill(topNode, nodes, inputs, summary);
+    }
+
+    return summary;
+}
+
+void EventSummaryReco::Fill(PHCompositeNode *topNode, NodeCache &nodes, const InputNodes &inputs, EventSummary *summary)
+{
+    if ( !summary ) { return; }
+
+    summary->Reset();
+    unsigned int sources = 0;
+
+    // vertex, first vertex of the map
+    if ( !inputs.vertex.empty() ) {
+        auto * vertexmap = nodes.get<GlobalVertexMap>(topNode, inputs.vertex);
+        GlobalVertex * vtx = ( vertexmap && !vertexmap->empty() ) ? vertexmap->begin()->second : nullptr;
+        if ( vertexmap ) { sources |= EventSummary::kVERTEXMAP; }
+
+        if ( !vtx ) {
+            if ( s_nmissing_vertex++ == 0 ) {
+                std::cout << PHWHERE << inputs.vertex << " missing or empty (further warnings suppressed, see EventSummaryReco::End)" << std::endl;
+            }
+            summary->set_zvtx(NAN, EventSummary::kVERTEX_MISSING);
+        } else if ( !EventSummary::is_good_zvtx(vtx->get_z()) ) {
+            if ( s_nbad_vertex++ == 0 ) {
+                std::cout << PHWHERE << "vertex is " << vtx->get_z() << " (further warnings suppressed, see EventSummaryReco::End)" << std::endl;
+            }
+            summary->set_zvtx(vtx->get_z(), EventSummary::kVERTEX_BAD);
+        } else {
+            summary->set_zvtx(vtx->get_z(), EventSummary::kVERTEX_OK);
+        }
+    }
+
+    // centrality bin, centile if there is no bin
+    if ( !inputs.centrality.empty() ) {
+        auto * cent = nodes.get<CentralityInfo>(topNode, inputs.centrality);
+        if ( cent ) {
+            sources |= EventSummary::kCENTRALITY;
+            if ( cent->has_centrality_bin(CentralityInfo::PROP::mbd_NS) ) {
+                summary->set_centrality(static_cast<int>(cent->get_centrality_bin(CentralityInfo::PROP::mbd_NS)));
+            } else if ( cent->has_centile(CentralityInfo::PROP::mbd_NS) ) {
+                summary->set_centrality(static_cast<int>(cent->get_centile(CentralityInfo::PROP::mbd_NS)));
+            }
+        }
+    }
+
+    if ( !inputs.minbias.empty() ) {
+        auto * minbias = nodes.get<MinimumBiasInfo>(topNode, inputs.minbias);
+        if ( minbias ) {
+            sources |= EventSummary::kMINBIAS;
+            summary->set_minbias(minbias->isAuAuMinimumBias());
+        }
+    }
+
+    if ( !inputs.mbd.empty() ) {
+        auto * mbd = nodes.get<MbdOut>(topNode, inputs.mbd);
+        if ( mbd ) {
+            sources |= EventSummary::kMBD;
+            for ( const int arm : { EventSummary::kSOUTH, EventSummary::kNORTH } ) {
+                summary->set_mbd(arm, mbd->get_q(arm), mbd->get_time(arm), mbd->get_npmt(arm));
+            }
+        } else if ( s_nmissing_mbd++ == 0 ) {
+            std::cout << PHWHERE << inputs.mbd << " node missing (further warnings suppressed, see EventSummaryReco::End)" << std::endl;
+        }
+    }
+
+    if ( !inputs.eventheader.empty() ) {
+        auto * eventheader = nodes.get<EventHeader>(topNode, inputs.eventheader);
+        if ( eventheader ) {
+            sources |= EventSummary::kEVENTHEADER;
+            summary->set_b(eventheader->get_ImpactParameter());
+            for ( int n = 1; n <= EventSummary::kNPSI; ++n ) {
+                summary->set_psi(n, eventheader->get_FlowPsiN(n));
+            }
+            summary->set_ep_angle(eventheader->get_EventPlaneAngle());
+            summary->set_ecc(eventheader->get_eccentricity());
+            summary->set_ncoll(eventheader->get_ncoll());
+            summary->set_npart(eventheader->get_npart());
+        }
+    }
+
+    summary->set_sources(sources);
+    summary->set_filled(true);
+    return ;
+}
+
+EventSummary * EventSummaryReco::CreateNode(PHCompositeNode *topNode, const std::string &summary_node)
+{
+    auto * summary = findNode::getClass<EventSummary>(topNode, summary_node);
+    if ( summary ) { return summary; }
+
+    PHNodeIterator iter(topNode);
+    auto * dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if ( !dstNode ) {
+        std::cerr << "EventSummaryReco::CreateNode(PHCompositeNode *topNode) DST node missing, doing nothing." << std::endl;
+        return nullptr;
+    }
+
+    summary = new EventSummaryv1();
+    auto * node = new PHIODataNode<PHObject>(summary, summary_node, "PHObject");
+    dstNode->addNode(node);
+
+    return summary;
+}
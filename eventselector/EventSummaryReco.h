@@ -0,0 +1,76 @@
+/*!
+ * \file EventSummaryReco.h
+ * \brief SubsysReco module decoding the EventSummary node once per event
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_EVENTSUMMARYRECO_H
+#define EVENTSELECTION_EVENTSUMMARYRECO_H
+
+#include "NodeCache.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class PHCompositeNode;
+class EventSummary;
+
+// Decodes the vertex map, centrality, MBD, minimum bias and event header
+// nodes into the flat EventSummary node, with the vertex sanity check
+// and its warnings in one place. Register it early, consumers go through
+// GetSummary(), which also decodes with the default node names when the
+// module is not registered. An empty node name skips that input.
+class EventSummaryReco : public SubsysReco
+{
+ public:
+
+    struct InputNodes
+    {
+      std::string vertex {"GlobalVertexMap"};
+      std::string centrality {"CentralityInfo"};
+      std::string mbd {"MbdOut"};
+      std::string eventheader {"EventHeader"};
+      std::string minbias {"MinimumBiasInfo"};
+    };
+
+    EventSummaryReco(const std::string &name = "EventSummaryReco") : SubsysReco(name) {}
+    ~EventSummaryReco() override {}
+
+    void set_vertex_node(const std::string &node) { m_inputs.vertex = node; }
+    void set_cent_node(const std::string &node) { m_inputs.centrality = node; }
+    void set_mbd_node(const std::string &node) { m_inputs.mbd = node; }
+    void set_eventheader_node(const std::string &node) { m_inputs.eventheader = node; }
+    void set_minbias_node(const std::string &node) { m_inputs.minbias = node; }
+    void set_output_node(const std::string &node) { m_output_node = node; }
+
+    int InitRun(PHCompositeNode *topNode) override;
+    int process_event(PHCompositeNode *topNode) override;
+    int End(PHCompositeNode *topNode) override;
+
+    // summary for this event, created and decoded from inputs on first use.
+    // nodes is the caller's per run cache. Whoever fills first in an event
+    // decides the inputs, EventSummaryReco when it is registered
+    static EventSummary * GetSummary(PHCompositeNode *topNode, NodeCache &nodes,
+                                     const std::string &summary_node, const InputNodes &inputs);
+    static EventSummary * GetSummary(PHCompositeNode *topNode, NodeCache &nodes,
+                                     const std::string &summary_node = "EventSummary")
+    {
+      return GetSummary(topNode, nodes, summary_node, InputNodes());
+    }
+
+    // decode every input of this event into summary
+    static void Fill(PHCompositeNode *topNode, NodeCache &nodes, const InputNodes &inputs, EventSummary *summary);
+
+ private:
+
+    InputNodes m_inputs {};
+    std::string m_output_node {"EventSummary"};
+    NodeCache m_nodes {};
+
+    static EventSummary * CreateNode(PHCompositeNode *topNode, const std::string &summary_node);
+};
+
+#endif // EVENTSELECTION_EVENTSUMMARYRECO_H
@@ -0,0 +1,46 @@
+#include "EventSummaryv1.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void EventSummaryv1::identify(std::ostream &os) const
+{
+    os << "EventSummaryv1: " << ( m_filled ? "filled" : "not filled" ) << ", sources 0x" << std::hex << m_sources << std::dec << std::endl;
+    os << "  zvtx = " << m_zvtx << " (status " << m_vertex_status << "), cent = " << m_cent << ", minbias = " << m_minbias << std::endl;
+    os << "  MBD S (q, t, n) = (" << m_mbd_q[kSOUTH] << ", " << m_mbd_t[kSOUTH] << ", " << m_mbd_npmt[kSOUTH] << ")"
+       << ", N (q, t, n) = (" << m_mbd_q[kNORTH] << ", " << m_mbd_t[kNORTH] << ", " << m_mbd_npmt[kNORTH] << ")" << std::endl;
+    if ( has(kEVENTHEADER) ) {
+        os << "  b = " << m_b << ", psi2 = " << get_psi(2) << ", ncoll = " << m_ncoll << ", npart = " << m_npart << std::endl;
+    }
+    return ;
+}
+
+void EventSummaryv1::Reset()
+{
+    m_filled = false;
+    m_sources = 0;
+    m_zvtx = NAN;
+    m_vertex_status = kVERTEX_MISSING;
+    m_cent = -1;
+    m_minbias = false;
+    std::fill(m_mbd_q, m_mbd_q + 2, NAN);
+    std::fill(m_mbd_t, m_mbd_t + 2, NAN);
+    std::fill(m_mbd_npmt, m_mbd_npmt + 2, NAN);
+    m_b = NAN;
+    std::fill(m_psi, m_psi + kNPSI, NAN);
+    m_ep_angle = NAN;
+    m_ecc = NAN;
+    m_ncoll = NAN;
+    m_npart = NAN;
+    return ;
+}
+
+void EventSummaryv1::set_mbd(const int arm, const float q, const float t, const float npmt)
+{
+    if ( !is_arm(arm) ) { return; }
+    m_mbd_q[arm] = q;
+    m_mbd_t[arm] = t;
+    m_mbd_npmt[arm] = npmt;
+    return ;
+}
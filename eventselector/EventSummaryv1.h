@@ -0,0 +1,85 @@
+/*!
+ * \file EventSummaryv1.h
+ * \brief EventSummaryv1: flat event level quantities
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_EVENTSUMMARYV1_H
+#define EVENTSELECTION_EVENTSUMMARYV1_H
+
+#include "EventSummary.h"
+
+class EventSummaryv1 : public EventSummary
+{
+  public:
+
+    EventSummaryv1() { Reset(); }
+    ~EventSummaryv1() override {}
+
+    void identify(std::ostream &os = std::cout) const override;
+    void Reset() override;
+    int isValid() const override { return m_filled; }
+
+    void set_filled(const bool filled) override { m_filled = filled; }
+    bool is_filled() const override { return m_filled; }
+
+    void set_sources(const unsigned int sources) override { m_sources = sources; }
+    unsigned int get_sources() const override { return m_sources; }
+
+    void set_zvtx(const float zvtx, const int status) override { m_zvtx = zvtx; m_vertex_status = status; }
+    float get_zvtx() const override { return m_zvtx; }
+    int get_vertex_status() const override { return m_vertex_status; }
+
+    void set_centrality(const int cent) override { m_cent = cent; }
+    int get_centrality() const override { return m_cent; }
+
+    void set_minbias(const bool minbias) override { m_minbias = minbias; }
+    bool is_minbias() const override { return m_minbias; }
+
+    void set_mbd(const int arm, const float q, const float t, const float npmt) override;
+    float get_mbd_q(const int arm) const override { return is_arm(arm) ? m_mbd_q[arm] : NAN; }
+    float get_mbd_t(const int arm) const override { return is_arm(arm) ? m_mbd_t[arm] : NAN; }
+    float get_mbd_npmt(const int arm) const override { return is_arm(arm) ? m_mbd_npmt[arm] : NAN; }
+
+    void set_b(const float b) override { m_b = b; }
+    float get_b() const override { return m_b; }
+    void set_psi(const int n, const float psi) override { if ( n >= 1 && n <= kNPSI ) { m_psi[n - 1] = psi; } }
+    float get_psi(const int n) const override { return ( n >= 1 && n <= kNPSI ) ? m_psi[n - 1] : NAN; }
+    void set_ep_angle(const float ep_angle) override { m_ep_angle = ep_angle; }
+    float get_ep_angle() const override { return m_ep_angle; }
+    void set_ecc(const float ecc) override { m_ecc = ecc; }
+    float get_ecc() const override { return m_ecc; }
+    void set_ncoll(const float ncoll) override { m_ncoll = ncoll; }
+    float get_ncoll() const override { return m_ncoll; }
+    void set_npart(const float npart) override { m_npart = npart; }
+    float get_npart() const override { return m_npart; }
+
+  private:
+
+    bool m_filled {false}; //! per event, set by the reco module
+    unsigned int m_sources {0};
+
+    float m_zvtx {NAN};
+    int m_vertex_status {kVERTEX_MISSING};
+    int m_cent {-1};
+    bool m_minbias {false};
+
+    float m_mbd_q[2] {};
+    float m_mbd_t[2] {};
+    float m_mbd_npmt[2] {};
+
+    float m_b {NAN};
+    float m_psi[kNPSI] {};
+    float m_ep_angle {NAN};
+    float m_ecc {NAN};
+    float m_ncoll {NAN};
+    float m_npart {NAN};
+
+    static bool is_arm(const int arm) { return arm == kSOUTH || arm == kNORTH; }
+
+    ClassDefOverride(EventSummaryv1, 1);
+};
+
+#endif // EVENTSELECTION_EVENTSUMMARYV1_H
@@ -0,0 +1,70 @@
+/*!
+ * \file JetSummary.h
+ * \brief JetSummary: per event top-K jets by pT for a set of jet nodes
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_JETSUMMARY_H
+#define EVENTSELECTION_JETSUMMARY_H
+
+#include <phool/PHObject.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+class JetSummary : public PHObject
+{
+  public:
+
+    ~JetSummary() override {}
+
+    void identify(std::ostream &os = std::cout) const override { os << "JetSummary base class" << std::endl; }
+    int isValid() const override { return 0; }
+
+    // jet nodes, the returned index is the first argument of everything below.
+    // Nodes and K are configuration and survive Reset()
+    virtual int add_node(const std::string & /*node*/) { return -1; }
+    virtual int find_node(const std::string & /*node*/) const { return -1; }
+    virtual unsigned int n_nodes() const { return 0; }
+    virtual std::string get_node(const int /*inode*/) const { return ""; }
+
+    virtual void set_topk(const unsigned int /*k*/) { return; }
+    virtual unsigned int get_topk() const { return 0; }
+
+    // start summarizing a node for this event, then add_jet() every jet
+    virtual void reset_node(const int /*inode*/) { return; }
+    virtual bool is_filled(const int /*inode*/) const { return false; }
+    virtual void add_jet(const int /*inode*/, const float /*pt*/, const float /*eta*/, const float /*phi*/,
+                         const float /*e*/, const int /*index*/) { return; }
+
+    // all jets in the node, of which min( njets, K ) are stored
+    virtual unsigned int get_njets(const int /*inode*/) const { return 0; }
+    virtual unsigned int get_nstored(const int /*inode*/) const { return 0; }
+
+    // k-th jet by pT, k = 0 is the leading jet. index is the position in
+    // the JetContainer ( or the JetMap key ), NAN / -1 past get_nstored()
+    virtual float get_pt(const int /*inode*/, const unsigned int /*k*/ = 0) const { return NAN; }
+    virtual float get_eta(const int /*inode*/, const unsigned int /*k*/ = 0) const { return NAN; }
+    virtual float get_phi(const int /*inode*/, const unsigned int /*k*/ = 0) const { return NAN; }
+    virtual float get_e(const int /*inode*/, const unsigned int /*k*/ = 0) const { return NAN; }
+    virtual int get_index(const int /*inode*/, const unsigned int /*k*/ = 0) const { return -1; }
+
+    // leading + subleading pair, NAN with fewer than two jets
+    virtual float get_dijet_mass(const int /*inode*/) const { return NAN; }
+    virtual float get_dijet_dphi(const int /*inode*/) const { return NAN; }
+    virtual float get_dijet_xj(const int /*inode*/) const { return NAN; }   // pT2 / pT1
+    virtual float get_dijet_aj(const int /*inode*/) const { return NAN; }   // ( pT1 - pT2 ) / ( pT1 + pT2 )
+
+  protected:
+
+    JetSummary() {}
+
+  private:
+
+    ClassDefOverride(JetSummary, 1);
+};
+
+#endif // EVENTSELECTION_JETSUMMARY_H
@@ -0,0 +1,140 @@
+#include "JetSummaryReco.h"
+#include "JetSummary.h"
+#include "JetSummaryv1.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+// phool includes
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
+#include <phool/getClass.h>
+
+// jet reco
+#include <jetbase/Jet.h>
+#include <jetbase/JetContainer.h>
+#include <jetbase/JetMap.h>
+
+#include <iostream>
+
+int JetSummaryReco::InitRun(PHCompositeNode *topNode)
+{
+    auto * summary = CreateNode(topNode, m_output_node, m_topk);
+    if ( !summary ) {
+        return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    if ( summary->get_topk() != m_topk ) {
+        std::cerr << Name() + "::InitRun(PHCompositeNode *topNode) " + m_output_node + " already exists with K = "
+                  << summary->get_topk() << ", not " << m_topk << std::endl;
+    }
+    for ( const auto &node : m_jet_nodes ) {
+        summary->add_node(node);
+    }
+
+    if ( Verbosity() ) {
+        summary->identify();
+    }
+
+    return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int JetSummaryReco::process_event(PHCompositeNode *topNode)
+{
+    auto * summary = findNode::getClass<JetSummary>(topNode, m_output_node);
+    if ( !summary ) {
+        std::cerr << Name() + "::process_event(PHCompositeNode *topNode) Could not find " + m_output_node << std::endl;
+        return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    for ( const auto &node : m_jet_nodes ) {
+        if ( !Fill(topNode, node, summary, summary->find_node(node)) ) {
+            std::cerr << Name() + "::process_event(PHCompositeNode *topNode) Could not find jet node " + node << std::endl;
+            return Fun4AllReturnCodes::ABORTRUN;
+        }
+    }
+
+    if ( Verbosity() > 1 ) {
+        summary->identify();
+    }
+
+    return Fun4AllReturnCodes::EVENT_OK;
+}
+
+JetSummary * JetSummaryReco::GetSummary(PHCompositeNode *topNode, const std::string &jet_node, int &inode, const std::string &summary_node)
+{
+    inode = -1;
+
+    auto * summary = findNode::getClass<JetSummary>(topNode, summary_node);
+    if ( !summary ) {
+        summary = CreateNode(topNode, summary_node, 4);
+        if ( !summary ) { return nullptr; }
+    }
+
+    inode = summary->find_node(jet_node);
+    if ( inode < 0 ) {
+        inode = summary->add_node(jet_node);
+    }
+
+    // Reset() at the end of every event clears the filled flags
+    if ( !summary->is_filled(inode) && !Fill(topNode, jet_node, summary, inode) ) {
+        inode = -1;
+        return nullptr;
+    }
+
+    return summary;
+}
+
+bool JetSummaryReco::Fill(PHCompositeNode *topNode, const std::string &jet_node, JetSummary *summary, const int inode)
+{
+    if ( !summary || inode < 0 ) { return false; }
+
+    auto * jets = findNode::getClass<JetContainer>(topNode, jet_node);
+    if ( jets ) {
+        summary->reset_node(inode);
+        int index = 0;
+        for ( auto * jet : *jets ) {
+            if ( jet ) {
+                summary->add_jet(inode, jet->get_pt(), jet->get_eta(), jet->get_phi(), jet->get_e(), index);
+            }
+            ++index;
+        }
+        return true;
+    }
+
+    // could be a jetmap
+    auto * jetmap = findNode::getClass<JetMap>(topNode, jet_node);
+    if ( jetmap ) {
+        summary->reset_node(inode);
+        for ( JetMap::Iter iter = jetmap->begin(); iter != jetmap->end(); ++iter ) {
+            auto * jet = iter->second;
+            if ( jet ) {
+                summary->add_jet(inode, jet->get_pt(), jet->get_eta(), jet->get_phi(), jet->get_e(), iter->first);
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+JetSummary * JetSummaryReco::CreateNode(PHCompositeNode *topNode, const std::string &summary_node, const unsigned int topk)
+{
+    auto * summary = findNode::getClass<JetSummary>(topNode, summary_node);
+    if ( summary ) { return summary; }
+
+    PHNodeIterator iter(topNode);
+    auto * dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if ( !dstNode ) {
+        std::cerr << "JetSummaryReco::CreateNode(PHCompositeNode *topNode) DST node missing, doing nothing." << std::endl;
+        return nullptr;
+    }
+
+    summary = new JetSummaryv1();
+    summary->set_topk(topk);
+    auto * node = new PHIODataNode<PHObject>(summary, summary_node, "PHObject");
+    dstNode->addNode(node);
+
+    return summary;
+}
@@ -0,0 +1,56 @@
+/*!
+ * \file JetSummaryReco.h
+ * \brief SubsysReco module publishing the JetSummary node once per event
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_JETSUMMARYRECO_H
+#define EVENTSELECTION_JETSUMMARYRECO_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class JetSummary;
+
+// Summarizes the requested JetContainer / JetMap nodes into the
+// JetSummary node ( top-K jets by pT ) so leading jet consumers do not
+// each rescan the containers. Consumers go through GetSummary(), which
+// also fills nodes nobody registered here on first use in the event.
+class JetSummaryReco : public SubsysReco
+{
+ public:
+
+    JetSummaryReco(const std::string &name = "JetSummaryReco") : SubsysReco(name) {}
+    ~JetSummaryReco() override {}
+
+    void add_jet_node(const std::string &node) { m_jet_nodes.push_back(node); }
+    void set_topk(const unsigned int k) { m_topk = k; }
+    void set_output_node(const std::string &node) { m_output_node = node; }
+
+    int InitRun(PHCompositeNode *topNode) override;
+    int process_event(PHCompositeNode *topNode) override;
+
+    // summary holding jet_node for this event, inode is its index. Creates
+    // the summary node and summarizes jet_node if not done yet this event,
+    // nullptr if jet_node is neither a JetContainer nor a JetMap
+    static JetSummary * GetSummary(PHCompositeNode *topNode, const std::string &jet_node, int &inode,
+                                   const std::string &summary_node = "JetSummary");
+
+    // (re)fill entry inode of summary from jet_node
+    static bool Fill(PHCompositeNode *topNode, const std::string &jet_node, JetSummary *summary, const int inode);
+
+ private:
+
+    std::vector<std::string> m_jet_nodes {};
+    unsigned int m_topk {4};
+    std::string m_output_node {"JetSummary"};
+
+    static JetSummary * CreateNode(PHCompositeNode *topNode, const std::string &summary_node, const unsigned int topk);
+};
+
+#endif // EVENTSELECTION_JETSUMMARYRECO_H
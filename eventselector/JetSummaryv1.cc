@@ -0,0 +1,178 @@
+#include "JetSummaryv1.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void JetSummaryv1::identify(std::ostream &os) const
+{
+    os << "JetSummaryv1: top " << m_topk << " jets in " << m_nodes.size() << " nodes" << std::endl;
+    for ( unsigned int inode = 0; inode < m_nodes.size(); ++inode ) {
+        os << "  " << m_nodes.at(inode) << ": njets = " << get_njets(inode);
+        if ( get_nstored(inode) > 0 ) {
+            os << ", lead (pt, eta, phi) = (" << get_pt(inode) << ", " << get_eta(inode) << ", " << get_phi(inode) << ")";
+        }
+        os << std::endl;
+    }
+    return ;
+}
+
+void JetSummaryv1::Reset()
+{
+    // node list and K are configuration, only the event content is cleared
+    std::fill(m_njets.begin(), m_njets.end(), 0);
+    std::fill(m_filled.begin(), m_filled.end(), false);
+    std::fill(m_pt.begin(), m_pt.end(), NAN);
+    std::fill(m_eta.begin(), m_eta.end(), NAN);
+    std::fill(m_phi.begin(), m_phi.end(), NAN);
+    std::fill(m_e.begin(), m_e.end(), NAN);
+    std::fill(m_index.begin(), m_index.end(), -1);
+    return ;
+}
+
+int JetSummaryv1::add_node(const std::string &node)
+{
+    const int inode = find_node(node);
+    if ( inode >= 0 ) { return inode; }
+
+    m_nodes.push_back(node);
+    m_njets.push_back(0);
+    m_filled.resize(m_nodes.size(), false);
+    m_pt.resize(m_nodes.size() * m_topk, NAN);
+    m_eta.resize(m_nodes.size() * m_topk, NAN);
+    m_phi.resize(m_nodes.size() * m_topk, NAN);
+    m_e.resize(m_nodes.size() * m_topk, NAN);
+    m_index.resize(m_nodes.size() * m_topk, -1);
+    return m_nodes.size() - 1;
+}
+
+int JetSummaryv1::find_node(const std::string &node) const
+{
+    for ( unsigned int inode = 0; inode < m_nodes.size(); ++inode ) {
+        if ( m_nodes[inode] == node ) { return inode; }
+    }
+    return -1;
+}
+
+std::string JetSummaryv1::get_node(const int inode) const
+{
+    if ( inode < 0 || inode >= static_cast<int>(m_nodes.size()) ) { return ""; }
+    return m_nodes[inode];
+}
+
+void JetSummaryv1::set_topk(const unsigned int k)
+{
+    if ( k == 0 || k == m_topk ) { return; }
+    if ( !m_nodes.empty() ) {
+        std::cerr << "JetSummaryv1::set_topk - nodes already added, K stays " << m_topk << std::endl;
+        return;
+    }
+    m_topk = k;
+    return ;
+}
+
+void JetSummaryv1::reset_node(const int inode)
+{
+    if ( inode < 0 || inode >= static_cast<int>(m_nodes.size()) ) { return; }
+
+    m_njets[inode] = 0;
+    m_filled.resize(m_nodes.size(), false); // transient, empty after a read
+    m_filled[inode] = true;
+    const unsigned int first = inode * m_topk;
+    std::fill(m_pt.begin() + first, m_pt.begin() + first + m_topk, NAN);
+    std::fill(m_eta.begin() + first, m_eta.begin() + first + m_topk, NAN);
+    std::fill(m_phi.begin() + first, m_phi.begin() + first + m_topk, NAN);
+    std::fill(m_e.begin() + first, m_e.begin() + first + m_topk, NAN);
+    std::fill(m_index.begin() + first, m_index.begin() + first + m_topk, -1);
+    return ;
+}
+
+bool JetSummaryv1::is_filled(const int inode) const
+{
+    if ( inode < 0 || inode >= static_cast<int>(m_filled.size()) ) { return false; }
+    return m_filled[inode];
+}
+
+void JetSummaryv1::add_jet(const int inode, const float pt, const float eta, const float phi, const float e, const int index)
+{
+    if ( inode < 0 || inode >= static_cast<int>(m_nodes.size()) ) { return; }
+
+    // insertion into the sorted top-K, equal pT keeps the earlier jet first
+    const unsigned int first = inode * m_topk;
+    const unsigned int nstored = get_nstored(inode);
+    m_njets[inode]++;
+
+    unsigned int k = nstored;
+    if ( k == m_topk ) {
+        if ( !( pt > m_pt[first + m_topk - 1] ) ) { return; }
+        k = m_topk - 1;
+    }
+    while ( k > 0 && pt > m_pt[first + k - 1] ) {
+        m_pt[first + k] = m_pt[first + k - 1];
+        m_eta[first + k] = m_eta[first + k - 1];
+        m_phi[first + k] = m_phi[first + k - 1];
+        m_e[first + k] = m_e[first + k - 1];
+        m_index[first + k] = m_index[first + k - 1];
+        --k;
+    }
+    m_pt[first + k] = pt;
+    m_eta[first + k] = eta;
+    m_phi[first + k] = phi;
+    m_e[first + k] = e;
+    m_index[first + k] = index;
+    return ;
+}
+
+unsigned int JetSummaryv1::get_njets(const int inode) const
+{
+    if ( inode < 0 || inode >= static_cast<int>(m_nodes.size()) ) { return 0; }
+    return m_njets[inode];
+}
+
+unsigned int JetSummaryv1::get_nstored(const int inode) const
+{
+    return std::min(get_njets(inode), m_topk);
+}
+
+int JetSummaryv1::get_index(const int inode, const unsigned int k) const
+{
+    return has(inode, k) ? m_index[inode * m_topk + k] : -1;
+}
+
+float JetSummaryv1::get_dijet_mass(const int inode) const
+{
+    if ( !has(inode, 1) ) { return NAN; }
+
+    // invariant mass of the leading pair four-vector sum
+    float px = 0, py = 0, pz = 0, e = 0;
+    for ( unsigned int k = 0; k < 2; ++k ) {
+        px += get_pt(inode, k) * std::cos(get_phi(inode, k));
+        py += get_pt(inode, k) * std::sin(get_phi(inode, k));
+        pz += get_pt(inode, k) * std::sinh(get_eta(inode, k));
+        e += get_e(inode, k);
+    }
+    const float m2 = e * e - px * px - py * py - pz * pz;
+    return m2 > 0 ? std::sqrt(m2) : 0;
+}
+
+float JetSummaryv1::get_dijet_dphi(const int inode) const
+{
+    if ( !has(inode, 1) ) { return NAN; }
+
+    float dphi = std::fabs(get_phi(inode, 0) - get_phi(inode, 1));
+    if ( dphi > M_PI ) { dphi = 2 * M_PI - dphi; }
+    return dphi;
+}
+
+float JetSummaryv1::get_dijet_xj(const int inode) const
+{
+    if ( !has(inode, 1) || !( get_pt(inode, 0) > 0 ) ) { return NAN; }
+    return get_pt(inode, 1) / get_pt(inode, 0);
+}
+
+float JetSummaryv1::get_dijet_aj(const int inode) const
+{
+    if ( !has(inode, 1) ) { return NAN; }
+    const float sum = get_pt(inode, 0) + get_pt(inode, 1);
+    return sum > 0 ? ( get_pt(inode, 0) - get_pt(inode, 1) ) / sum : NAN;
+}
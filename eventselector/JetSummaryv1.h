@@ -0,0 +1,75 @@
+/*!
+ * \file JetSummaryv1.h
+ * \brief JetSummaryv1: top-K jets stored flat, [ inode * K + k ]
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_JETSUMMARYV1_H
+#define EVENTSELECTION_JETSUMMARYV1_H
+
+#include "JetSummary.h"
+
+#include <string>
+#include <vector>
+
+class JetSummaryv1 : public JetSummary
+{
+  public:
+
+    JetSummaryv1() {}
+    ~JetSummaryv1() override {}
+
+    void identify(std::ostream &os = std::cout) const override;
+    void Reset() override;
+    int isValid() const override { return !m_nodes.empty(); }
+
+    int add_node(const std::string &node) override;
+    int find_node(const std::string &node) const override;
+    unsigned int n_nodes() const override { return m_nodes.size(); }
+    std::string get_node(const int inode) const override;
+
+    void set_topk(const unsigned int k) override;
+    unsigned int get_topk() const override { return m_topk; }
+
+    void reset_node(const int inode) override;
+    bool is_filled(const int inode) const override;
+    void add_jet(const int inode, const float pt, const float eta, const float phi,
+                 const float e, const int index) override;
+
+    unsigned int get_njets(const int inode) const override;
+    unsigned int get_nstored(const int inode) const override;
+
+    float get_pt(const int inode, const unsigned int k = 0) const override { return at(m_pt, inode, k); }
+    float get_eta(const int inode, const unsigned int k = 0) const override { return at(m_eta, inode, k); }
+    float get_phi(const int inode, const unsigned int k = 0) const override { return at(m_phi, inode, k); }
+    float get_e(const int inode, const unsigned int k = 0) const override { return at(m_e, inode, k); }
+    int get_index(const int inode, const unsigned int k = 0) const override;
+
+    float get_dijet_mass(const int inode) const override;
+    float get_dijet_dphi(const int inode) const override;
+    float get_dijet_xj(const int inode) const override;
+    float get_dijet_aj(const int inode) const override;
+
+  private:
+
+    unsigned int m_topk {4};
+    std::vector<std::string> m_nodes {};
+
+    std::vector<unsigned int> m_njets {};
+    std::vector<bool> m_filled {}; //! per event, set by the reco module
+
+    std::vector<float> m_pt {};
+    std::vector<float> m_eta {};
+    std::vector<float> m_phi {};
+    std::vector<float> m_e {};
+    std::vector<int> m_index {};
+
+    bool has(const int inode, const unsigned int k) const { return inode >= 0 && inode < static_cast<int>(m_nodes.size()) && k < get_nstored(inode); }
+    float at(const std::vector<float> &v, const int inode, const unsigned int k) const { return has(inode, k) ? v[inode * m_topk + k] : NAN; }
+
+    ClassDefOverride(JetSummaryv1, 1);
+};
+
+#endif // EVENTSELECTION_JETSUMMARYV1_H
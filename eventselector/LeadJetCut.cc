@@ -1,13 +1,11 @@
 #include "LeadJetCut.h"
+#include "JetSummary.h"
+#include "JetSummaryReco.h"
 
 // phool includes
 #include <phool/PHCompositeNode.h>
 #include <phool/getClass.h>
 
-// jet reco
-#include <jetbase/Jetv1.h>
-#include <jetbase/JetContainerv1.h>
-
 #include <cstdlib>
 
 void LeadJetCut::identify(std::ostream &os) const
@@ -21,20 +19,16 @@ void LeadJetCut::identify(std::ostream &os) const
 bool LeadJetCut::operator()(PHCompositeNode *topNode)
 {
 
-    // get truth jet nodes
-    auto * jets = findNode::getClass<JetContainer>(topNode, GetNodeName());
-    if( !jets ) {
+    // get leading jet from the per event jet summary
+    int inode = -1;
+    auto * summary = JetSummaryReco::GetSummary(topNode, GetNodeName(), inode);
+    if( !summary ) {
         std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " + GetNodeName() << std::endl;
         exit(-1); // this is a fatal error
     }
 
     // get leading truth jet pT
-    float max_pt = -1;
-    for(auto jet: * jets){
-        if(jet->get_pt() > max_pt){
-            max_pt = jet->get_pt(); 
-        }
-    }
+    const float max_pt = summary->get_nstored(inode) > 0 ? summary->get_pt(inode, 0) : -1;
 
     bool status = EvaluateRangeCut(max_pt);
     Passed(status);
@@ -1,4 +1,6 @@
 #include "LeadJetHook.h"
+#include "JetSummary.h"
+#include "JetSummaryReco.h"
 
 // phool includes
 #include <phool/PHCompositeNode.h>
@@ -14,33 +16,48 @@ void LeadJetHook::identify(std::ostream &os) const
 {
     os << Name() + "::identify: " << std::endl;
     os << "  Node name: " << GetNodeName() << std::endl;
-    os << "  Min pT: " << GetMin() << std::endl;
+    os << ( m_use_lead_pt ? "  Min lead pT: " : "  Min E_T: " ) << GetMin() << std::endl;
     return;
 }
 
 bool LeadJetHook::operator()(PHCompositeNode *topNode)
 {
 
-    // get truth jet nodes
-    auto * jets = findNode::getClass<JetContainer>(topNode, GetNodeName());
-    if( !jets ) {
-        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " + GetNodeName() << std::endl;
-        exit(-1); // this is a fatal error
-    }
-
-    // get leading truth jet pT
     bool found = false;
-    for ( auto jet : *jets ) {
-        if ( jet->get_et() > GetMin() ) {
-            found = true;
-            break;
+    if ( m_use_lead_pt ) {
+
+        // get leading jet from the per event jet summary
+        int inode = -1;
+        auto * summary = JetSummaryReco::GetSummary(topNode, GetNodeName(), inode);
+        if( !summary ) {
+            std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " + GetNodeName() << std::endl;
+            exit(-1); // this is a fatal error
+        }
+
+        found = summary->get_nstored(inode) > 0 && summary->get_pt(inode, 0) > GetMin();
+
+    } else {
+
+        // get truth jet nodes
+        auto * jets = Nodes().get<JetContainer>(topNode, GetNodeName());
+        if( !jets ) {
+            std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " + GetNodeName() << std::endl;
+            exit(-1); // this is a fatal error
+        }
+
+        // any jet above threshold
+        for ( auto jet : *jets ) {
+            if ( jet->get_et() > GetMin() ) {
+                found = true;
+                break;
+            }
         }
     }
 
     Passed(found);
 
     if(!Passed() && Verbosity()){
-       std::cout << Name() + "::operator(PHCompositeNode *topNode) Event failed" + Name() + ". Lead jet pT in " + GetNodeName() + " > " + std::to_string(GetMin()) << std::endl;
+       std::cout << Name() + "::operator(PHCompositeNode *topNode) Event failed" + Name() + ( m_use_lead_pt ? ". Lead jet pT in " : ". Jet E_T in " ) + GetNodeName() + " > " + std::to_string(GetMin()) << std::endl;
     }
 
     return Passed();
@@ -22,7 +22,16 @@ class LeadJetHook  : public EventCut
 
     void identify(std::ostream &os = std::cout) const override;
     bool operator()(PHCompositeNode* topNode) override;
-    
+
+    // default: any jet in the container with E_T > min. With
+    // UseLeadPt(true) the leading jet pT from the JetSummary is cut on
+    void UseLeadPt(const bool use) { m_use_lead_pt = use; }
+    bool UseLeadPt() const { return m_use_lead_pt; }
+
+  private:
+
+    bool m_use_lead_pt {false};
+
 };
 
 #endif // EVENTSELECTION_LEADTRUTHJETCUT_H
\ No newline at end of file
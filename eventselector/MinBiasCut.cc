@@ -3,16 +3,15 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/getClass.h>
 
-// minbias
-#include <calotrigger/MinimumBiasInfo.h>
-#include <calotrigger/MinimumBiasInfov1.h>
+#include "EventSummary.h"
+#include "EventSummaryReco.h"
 
 #include <cstdlib>
 
 MinBiasCut::MinBiasCut() : EventCut("MinBiasCut")
 {
     // Set the default node name
-    SetNodeName("MinimumBiasInfo");
+    SetNodeName("EventSummary"); // see EventSummaryReco
 }
 
 void MinBiasCut::identify(std::ostream &os) const
@@ -24,14 +23,14 @@ void MinBiasCut::identify(std::ostream &os) const
 
 bool MinBiasCut::operator()(PHCompositeNode *topNode)
 {
-    // get minbias info
-    auto * node = findNode::getClass<MinimumBiasInfov1>(topNode, GetNodeName());
-    if( !node ){
-        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " + GetNodeName() << std::endl;
+    // minimum bias flag decoded once per event by EventSummaryReco
+    auto * summary = EventSummaryReco::GetSummary(topNode, Nodes(), GetNodeName());
+    if( !summary || !summary->has(EventSummary::kMINBIAS) ){
+        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find minimum bias info for " + GetNodeName() << std::endl;
         exit(-1); // this is a fatal error
     }
 
-    Passed( node->isAuAuMinimumBias() );
+    Passed( summary->is_minbias() );
     if(!Passed() && Verbosity()){
        std::cout << Name() + "::operator(PHCompositeNode *topNode) Event failed" + Name() + " event selection" << std::endl;
     }
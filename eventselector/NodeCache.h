@@ -0,0 +1,105 @@
+/*!
+ * \file NodeCache.h
+ * \brief NodeCache: typed node handles resolved once per run
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_NODECACHE_H
+#define EVENTSELECTION_NODECACHE_H
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
+#include <phool/getClass.h>
+
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+// Drop in for findNode::getClass<T>( topNode, name ) in per event code.
+//
+// The first get<T>() of a name walks the node tree like getClass and
+// keeps the data node, later calls are a hash lookup plus a check that
+// the node still holds the same object ( input managers may swap it ),
+// so the tree is walked once per run instead of once per call. Missing
+// nodes are not cached, they are searched again on the next call.
+//
+// The cached nodes belong to the current node tree: call clear() from
+// InitRun() so nothing survives a rebuilt tree.
+class NodeCache
+{
+  public:
+
+    NodeCache() {}
+    ~NodeCache() {}
+
+    void clear() { m_entries.clear(); }
+
+    template <class T>
+    T * get(PHCompositeNode *topNode, const std::string &name)
+    {
+      Entry &entry = find<T>(name);
+      if ( entry.resolved && entry.top == topNode ) {
+        if ( !entry.node ) { return static_cast<T *>(entry.ptr); }
+
+        PHObject * data = entry.node->getData();
+        if ( data != entry.data ) {
+          entry.data = data;
+          entry.ptr = dynamic_cast<T *>(data);
+        }
+        return static_cast<T *>(entry.ptr);
+      }
+
+      PHNodeIterator iter(topNode);
+      entry.top = topNode;
+      entry.node = dynamic_cast<PHDataNode<PHObject> *>(iter.findFirst("PHIODataNode", name));
+      if ( entry.node ) {
+        entry.data = entry.node->getData();
+        entry.ptr = dynamic_cast<T *>(entry.data);
+      } else {
+        // not a PHObject node, keep the pointer without revalidation
+        entry.data = nullptr;
+        entry.ptr = findNode::getClass<T>(topNode, name);
+      }
+
+      entry.resolved = entry.ptr != nullptr;
+      return static_cast<T *>(entry.ptr);
+    }
+
+  private:
+
+    struct Entry
+    {
+      std::type_index type;
+      bool resolved {false};
+      PHCompositeNode * top {nullptr};
+      PHDataNode<PHObject> * node {nullptr};
+      PHObject * data {nullptr};
+      void * ptr {nullptr};
+    };
+
+    // one name may be asked for as several types, usually just one
+    std::unordered_map< std::string, std::vector<Entry> > m_entries {};
+
+    template <class T>
+    Entry & find(const std::string &name)
+    {
+      auto it = m_entries.find(name);
+      if ( it == m_entries.end() ) {
+        it = m_entries.emplace(name, std::vector<Entry>{}).first;
+      }
+
+      const std::type_index type(typeid(T));
+      for ( auto &entry : it->second ) {
+        if ( entry.type == type ) { return entry; }
+      }
+      it->second.push_back(Entry{ type });
+      return it->second.back();
+    }
+};
+
+#endif // EVENTSELECTION_NODECACHE_H
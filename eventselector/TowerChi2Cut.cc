@@ -30,7 +30,7 @@ bool TowerChi2Cut::operator()(PHCompositeNode *topNode)
 
     for (const auto &node_name : GetNodeNames())
     {
-        auto * towers = findNode::getClass<TowerInfoContainer>(topNode, node_name);
+        auto * towers = Nodes().get<TowerInfoContainer>(topNode, node_name);
         if (!towers) {
             std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " << node_name << " node" << std::endl;
             exit(-1); // this is a fatal error
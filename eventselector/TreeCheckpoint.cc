@@ -0,0 +1,253 @@
+#include "TreeCheckpoint.h"
+
+#include <TTree.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+TreeCheckpoint::InputPosition TreeCheckpoint::s_input {};
+bool TreeCheckpoint::s_input_counted { false };
+
+void TreeCheckpoint::count_input( const std::string & file )
+{
+    if ( file != s_input.file ) {
+        s_input.file = file;
+        s_input.offset = 0;
+    }
+    ++s_input.offset;
+    ++s_input.events;
+    s_input_counted = true;
+}
+
+bool TreeCheckpoint::get_committed_input( const std::string & output_file, InputPosition & position )
+{
+    Record record;
+    if ( !ReadRecord( output_file + ".ckpt", record ) || record.complete || record.input_events == 0 ) { return false; }
+    position.file = record.input_file;
+    position.offset = record.input_offset;
+    position.events = record.input_events;
+    return true;
+}
+
+bool TreeCheckpoint::get_committed_entries( const std::string & part_file, std::map< std::string, long long > & entries )
+{
+    // <stem>_resume<N>.root shares the sidecar of <stem>.root
+    std::string output = part_file;
+    unsigned int part = 0;
+    const std::string::size_type pos = part_file.rfind( "_resume" );
+    const std::string::size_type dot = part_file.rfind( ".root" );
+    if ( pos != std::string::npos && dot != std::string::npos && dot > pos + 7 ) {
+        const std::string digits = part_file.substr( pos + 7, dot - pos - 7 );
+        if ( digits.find_first_not_of( "0123456789" ) == std::string::npos ) {
+            output = part_file.substr( 0, pos ) + part_file.substr( dot );
+            part = std::stoul( digits );
+        }
+    }
+
+    Record record;
+    if ( !ReadRecord( output + ".ckpt", record ) ) { return false; }
+    if ( record.complete && part == record.part ) { return false; }
+    auto it = record.committed.find( part );
+    if ( it == record.committed.end() ) { return false; }
+    entries = it->second;
+    return true;
+}
+
+std::string TreeCheckpoint::begin( const std::string & output_file )
+{
+    m_sidecar = output_file + ".ckpt";
+    m_record = Record();
+    m_record.output = output_file;
+    m_trees.clear();
+    m_counters.clear();
+    m_seen = 0;
+    m_skip = 0;
+    m_skip_input = false;
+    m_resume_event_id = -1;
+    m_since_save = 0;
+    m_entries_before = 0;
+    m_last_save = std::chrono::steady_clock::now();
+
+    if ( !enabled() ) { return output_file; }
+
+    Record previous;
+    if ( m_resume && ReadRecord( m_sidecar, previous ) ) {
+        if ( previous.complete ) {
+            std::cout << "TreeCheckpoint::begin - " << output_file << " is complete, nothing to resume, starting over" << std::endl;
+        } else {
+            // input events when the previous part counted them, the input
+            // managers then already skipped ( up to ) these
+            m_skip_input = input_counted() && previous.input_events > 0;
+            m_skip = m_skip_input ? previous.input_events : previous.events_seen;
+            m_resume_event_id = previous.last_event_id;
+            m_entries_before = previous.entries;
+            m_record = previous;
+            m_record.part = previous.part + 1;
+
+            const std::string::size_type dot = output_file.rfind( ".root" );
+            const std::string stem = dot == std::string::npos ? output_file : output_file.substr( 0, dot );
+            const std::string part = stem + "_resume" + std::to_string( m_record.part ) + ".root";
+            std::cout << "TreeCheckpoint::begin - resuming " << output_file << " after " << m_skip
+                      << ( m_skip_input ? " input events ( " + previous.input_file + " + " + std::to_string( previous.input_offset ) + ", " : " events ( " )
+                      << "last event id " << previous.last_event_id << " ), writing " << part << std::endl;
+            return part;
+        }
+    }
+
+    WriteRecord();
+    return output_file;
+}
+
+void TreeCheckpoint::add_tree( TTree * tree )
+{
+    if ( !tree ) { return; }
+    m_trees.push_back( tree );
+    if ( !enabled() ) { return; }
+
+    // nothing committed yet, a kill before the first checkpoint leaves
+    // a part whose entries are all repeated
+    m_record.committed[m_record.part][tree->GetName()] = 0;
+    WriteRecord();
+}
+
+bool TreeCheckpoint::add_counter( const std::string & name, uint64_t * values, const std::size_t n )
+{
+    if ( !values || n == 0 ) { return false; }
+    m_counters.push_back( { name, values, n } );
+
+    // only a resumed record has counters
+    auto it = m_record.counters.find( name );
+    if ( it == m_record.counters.end() || it->second.size() != n ) { return false; }
+    std::copy( it->second.begin(), it->second.end(), values );
+    return true;
+}
+
+bool TreeCheckpoint::skip_event()
+{
+    ++m_seen;
+    if ( m_skip_input ) { return s_input.events <= m_skip; }
+    return m_seen <= m_skip;
+}
+
+void TreeCheckpoint::filled( const int event_id )
+{
+    m_record.last_event_id = event_id;
+    if ( m_interval_events == 0 && m_interval_seconds == 0 ) { return; }
+
+    ++m_since_save;
+    bool due = m_interval_events > 0 && m_since_save >= m_interval_events;
+    if ( !due && m_interval_seconds > 0 ) {
+        const auto elapsed = std::chrono::steady_clock::now() - m_last_save;
+        due = std::chrono::duration_cast< std::chrono::seconds >( elapsed ).count() >= m_interval_seconds;
+    }
+    if ( due ) { save(); }
+}
+
+void TreeCheckpoint::save()
+{
+    // AutoSave flushes the baskets and writes the tree header, SaveSelf
+    // the directory, so the file recovers up to here
+    for ( auto tree : m_trees ) { tree->AutoSave( "SaveSelf" ); }
+
+    m_record.events_seen = m_seen;
+    if ( input_counted() ) {
+        m_record.input_file = s_input.file;
+        m_record.input_offset = s_input.offset;
+        m_record.input_events = s_input.events;
+    }
+    m_record.entries = m_entries_before + ( m_trees.empty() ? 0 : m_trees.front()->GetEntries() );
+    for ( auto tree : m_trees ) { m_record.committed[m_record.part][tree->GetName()] = tree->GetEntries(); }
+    for ( const auto & counter : m_counters ) {
+        m_record.counters[counter.name].assign( counter.values, counter.values + counter.n );
+    }
+    WriteRecord();
+
+    m_since_save = 0;
+    m_last_save = std::chrono::steady_clock::now();
+    if ( m_verbosity > 0 ) {
+        std::cout << "TreeCheckpoint::save - " << m_record.output << ": " << m_record.events_seen
+                  << " events seen, " << m_record.entries << " entries, last event id " << m_record.last_event_id << std::endl;
+    }
+}
+
+void TreeCheckpoint::finish()
+{
+    if ( !enabled() ) { return; }
+    m_record.events_seen = m_seen;
+    m_record.complete = true;
+    WriteRecord();
+    m_trees.clear(); // owned by the closed file
+}
+
+bool TreeCheckpoint::ReadRecord( const std::string & sidecar, Record & record )
+{
+    std::ifstream in( sidecar );
+    if ( !in ) { return false; }
+
+    std::string line;
+    while ( std::getline( in, line ) ) {
+        std::istringstream fields( line );
+        std::string key;
+        fields >> key;
+        if ( key == "output" ) { fields >> record.output; }
+        else if ( key == "part" ) { fields >> record.part; }
+        else if ( key == "events_seen" ) { fields >> record.events_seen; }
+        else if ( key == "input_file" ) { fields >> std::ws; std::getline( fields, record.input_file ); }
+        else if ( key == "input_offset" ) { fields >> record.input_offset; }
+        else if ( key == "input_events" ) { fields >> record.input_events; }
+        else if ( key == "last_event_id" ) { fields >> record.last_event_id; }
+        else if ( key == "entries" ) { fields >> record.entries; }
+        else if ( key == "complete" ) { fields >> record.complete; }
+        else if ( key == "committed" ) {
+            unsigned int part = 0;
+            std::string tree;
+            long long entries = 0;
+            if ( fields >> part >> tree >> entries ) { record.committed[part][tree] = entries; }
+        }
+        else if ( key == "counter" ) {
+            std::string name;
+            fields >> name;
+            std::vector< uint64_t > & values = record.counters[name];
+            values.clear();
+            uint64_t value = 0;
+            while ( fields >> value ) { values.push_back( value ); }
+        }
+    }
+    return true;
+}
+
+void TreeCheckpoint::WriteRecord() const
+{
+    // written aside and renamed, a kill never leaves half a record
+    const std::string tmp = m_sidecar + ".tmp";
+    {
+        std::ofstream out( tmp, std::ios::trunc );
+        if ( !out ) {
+            std::cout << "TreeCheckpoint::WriteRecord - cannot write " << tmp << std::endl;
+            return;
+        }
+        out << "output " << m_record.output << "\n"
+            << "part " << m_record.part << "\n"
+            << "events_seen " << m_record.events_seen << "\n"
+            << "input_file " << m_record.input_file << "\n"
+            << "input_offset " << m_record.input_offset << "\n"
+            << "input_events " << m_record.input_events << "\n"
+            << "last_event_id " << m_record.last_event_id << "\n"
+            << "entries " << m_record.entries << "\n"
+            << "complete " << m_record.complete << "\n";
+        for ( const auto & [ part, trees ] : m_record.committed ) {
+            for ( const auto & [ tree, entries ] : trees ) {
+                out << "committed " << part << " " << tree << " " << entries << "\n";
+            }
+        }
+        for ( const auto & [ name, values ] : m_record.counters ) {
+            out << "counter " << name;
+            for ( const uint64_t value : values ) { out << " " << value; }
+            out << "\n";
+        }
+    }
+    std::rename( tmp.c_str(), m_sidecar.c_str() );
+}
@@ -0,0 +1,171 @@
+/*!
+ * \file TreeCheckpoint.h
+ * \brief TreeCheckpoint: periodic AutoSave of output trees and resumable jobs
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_TREECHECKPOINT_H
+#define EVENTSELECTION_TREECHECKPOINT_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class TTree;
+
+// Checkpoints for tree writers that otherwise only write in End().
+//
+// Every set_interval() events ( or seconds ) the registered trees are
+// AutoSave'd, which flushes the baskets and the tree headers, and a
+// sidecar text file <output>.ckpt records the input position ( file name,
+// event offset in that file and input events read ), the last filled
+// event id and the entries committed. A killed job then leaves a file
+// ROOT can recover up to the last checkpoint.
+//
+// The input position is counted by a TreeCheckpointInput module, which
+// has to be the first module registered. On resume it skips the committed
+// input events in the input managers ( Fun4AllServer::skip ) before any
+// module runs, see TreeCheckpointInput.h. Without it the writer counts
+// the events reaching it and drops the committed ones itself, after the
+// full reconstruction chain ran on them.
+//
+// With set_resume( true ) a restarted job reads the sidecar, writes to a
+// new part <stem>_resume<N>.root next to the first one, event ids
+// continue where they were. Parts are combined with OutputMerger.
+//
+// The sidecar keeps the entries committed per part and tree. A kill
+// between AutoSave ( or a ROOT auto flush ) and the sidecar update leaves
+// up to one interval past the committed entries in the killed part, the
+// resumed part repeats those events. OutputMerger keeps only the
+// committed entries of such a part, see get_committed_entries(), so the
+// sidecar has to stay next to the parts until they are merged.
+//
+// Run level values ( first event scalars, trigger masks ) registered with
+// add_counter() are saved with every checkpoint and restored in the
+// resumed part. Only the part that completes writes run summaries, with
+// event ids continuing it counts the events of all parts.
+//
+// In the writer:
+//   Init:          m_output_filename = m_checkpoint.begin( m_output_filename );
+//                  ... open the file, book the trees, add_tree() them
+//                  m_event_id = m_checkpoint.get_resume_event_id();
+//                  m_checkpoint.add_counter( "name", values, n );
+//   process_event: if ( m_checkpoint.skip_event() ) { return ABORTEVENT; }
+//                  ... m_tree->Fill(); m_checkpoint.filled( m_event_id );
+//   End:           ... write, close, m_checkpoint.finish();
+class TreeCheckpoint
+{
+  public:
+
+    TreeCheckpoint() {}
+    ~TreeCheckpoint() {}
+
+    // 0 disables, a checkpoint is taken when either is reached
+    void set_interval( const unsigned int nevents, const unsigned int nseconds = 0 ) { m_interval_events = nevents; m_interval_seconds = nseconds; }
+    void set_resume( const bool b ) { m_resume = b; }
+    void set_verbosity( const int v ) { m_verbosity = v; }
+
+    bool enabled() const { return m_interval_events > 0 || m_interval_seconds > 0 || m_resume; }
+
+    // reads the sidecar when resuming, returns the file to write
+    std::string begin( const std::string & output_file );
+    // after begin(), the first tree gives the entries of the record
+    void add_tree( TTree * tree );
+
+    // after begin(), values saved with every checkpoint. True when they
+    // were restored from the part we resume from
+    bool add_counter( const std::string & name, uint64_t * values, const std::size_t n = 1 );
+
+    // last event id committed by earlier parts, -1 for a fresh job
+    int get_resume_event_id() const { return m_resume_event_id; }
+
+    // counts the event, true while it was committed by an earlier part
+    bool skip_event();
+    // after the fill of the main tree
+    void filled( const int event_id );
+    // forced checkpoint
+    void save();
+    // after the output is closed, marks the record complete
+    void finish();
+
+    unsigned long get_events_seen() const { return m_seen; }
+
+    // position in the input, process wide ( one Fun4AllServer per process )
+    struct InputPosition
+    {
+        std::string file {};
+        unsigned long offset { 0 }; // events read from file
+        unsigned long events { 0 }; // events read in total
+    };
+
+    // called by TreeCheckpointInput for every event read
+    static void count_input( const std::string & file );
+    // after the input managers skipped position.events events
+    static void set_input( const InputPosition & position ) { s_input = position; s_input_counted = true; }
+    static const InputPosition & get_input() { return s_input; }
+    static bool input_counted() { return s_input_counted; }
+
+    // input position committed to the sidecar of output_file, false when
+    // there is no record or the job completed
+    static bool get_committed_input( const std::string & output_file, InputPosition & position );
+
+    // entries per tree committed for part_file ( an output or one of its
+    // _resume<N> parts ), false when there is no record or the part was
+    // closed normally and all its entries count
+    static bool get_committed_entries( const std::string & part_file, std::map< std::string, long long > & entries );
+
+  private:
+
+    struct Record
+    {
+        std::string output {};
+        unsigned int part { 0 };
+        unsigned long events_seen { 0 };
+        std::string input_file {};
+        unsigned long input_offset { 0 };
+        unsigned long input_events { 0 };
+        int last_event_id { -1 };
+        long long entries { 0 };
+        bool complete { false };
+        std::map< unsigned int, std::map< std::string, long long > > committed {}; // part -> tree -> entries
+        std::map< std::string, std::vector< uint64_t > > counters {};
+    };
+
+    struct Counter
+    {
+        std::string name {};
+        uint64_t * values { nullptr };
+        std::size_t n { 1 };
+    };
+
+    static bool ReadRecord( const std::string & sidecar, Record & record );
+    void WriteRecord() const;
+
+    static InputPosition s_input;
+    static bool s_input_counted;
+
+    unsigned int m_interval_events { 0 };
+    unsigned int m_interval_seconds { 0 };
+    bool m_resume { false };
+    int m_verbosity { 0 };
+
+    std::string m_sidecar {};
+    Record m_record {};
+    std::vector < TTree * > m_trees {};
+    std::vector < Counter > m_counters {};
+
+    unsigned long m_seen { 0 };
+    unsigned long m_skip { 0 };
+    bool m_skip_input { false }; // m_skip counts input events, not writer events
+    int m_resume_event_id { -1 };
+    unsigned long m_since_save { 0 };
+    long long m_entries_before { 0 }; // entries of earlier parts
+    std::chrono::steady_clock::time_point m_last_save {};
+};
+
+#endif // EVENTSELECTION_TREECHECKPOINT_H
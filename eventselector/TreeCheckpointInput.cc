@@ -0,0 +1,72 @@
+#include "TreeCheckpointInput.h"
+#include "TreeCheckpoint.h"
+
+#include <fun4all/Fun4AllInputManager.h>
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
+
+#include <phool/PHCompositeNode.h>
+
+#include <iostream>
+
+int TreeCheckpointInput::Init(PHCompositeNode * /*topNode*/)
+{
+  // before the writers' Init, so their checkpoints count input events
+  TreeCheckpoint::set_input(TreeCheckpoint::InputPosition());
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int TreeCheckpointInput::process_event(PHCompositeNode * /*topNode*/)
+{
+  TreeCheckpoint::count_input(CurrentFile());
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+std::string TreeCheckpointInput::CurrentFile() const
+{
+  if(m_input_manager.empty()){ return ""; }
+  auto * input = Fun4AllServer::instance()->getInputManager(m_input_manager);
+  return input ? input->FileName() : "";
+}
+
+unsigned long TreeCheckpointInput::Resume(const std::vector<std::string> &outputs)
+{
+  // the writer furthest behind decides, nothing it still needs is skipped
+  bool found = false;
+  TreeCheckpoint::InputPosition position;
+  for(const auto &output : outputs){
+    TreeCheckpoint::InputPosition committed;
+    if(!TreeCheckpoint::get_committed_input(output, committed)){
+      if(Verbosity()){
+        std::cout << Name() << "::Resume - nothing to resume for " << output << std::endl;
+      }
+      position = TreeCheckpoint::InputPosition();
+      found = true;
+      break;
+    }
+    if(!found || committed.events < position.events){
+      position = committed;
+      found = true;
+    }
+  }
+  if(position.events == 0){
+    return 0;
+  }
+
+  std::cout << Name() << "::Resume - skipping " << position.events << " input events, up to event "
+            << position.offset << " of " << position.file << std::endl;
+  const int iret = Fun4AllServer::instance()->skip(static_cast<int>(position.events));
+  if(iret != 0){
+    std::cerr << Name() << "::Resume - Fun4AllServer::skip returned " << iret << ", input shorter than the committed events?" << std::endl;
+  }
+
+  // the input list of the restarted job should be the one of the killed job
+  const std::string file = CurrentFile();
+  if(!m_input_manager.empty() && file != position.file){
+    std::cerr << Name() << "::Resume - " << m_input_manager << " is in " << file << " after the skip, the checkpoint was in "
+              << position.file << ". Different input list?" << std::endl;
+  }
+
+  TreeCheckpoint::set_input(position);
+  return position.events;
+}
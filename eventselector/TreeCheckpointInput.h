@@ -0,0 +1,56 @@
+/*!
+ * \file TreeCheckpointInput.h
+ * \brief TreeCheckpointInput: input position for TreeCheckpoint and input level resume
+ * \author Tanner Mengel <tmengel@bnl.gov>
+ * \version $Verison: 1.0.1 $
+ * \date $Date: 09/10/2024 $
+ */
+
+#ifndef EVENTSELECTION_TREECHECKPOINTINPUT_H
+#define EVENTSELECTION_TREECHECKPOINTINPUT_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+
+// Counts every event read ( file name and offset of input_manager ) for
+// the checkpoints of the tree writers, so it has to be the first module
+// registered. Resume() skips the input events the writers committed in
+// the input managers, nothing downstream runs on them:
+//
+//   auto * input = new TreeCheckpointInput( "DSTin" );
+//   se->registerSubsystem( input );
+//   ... reconstruction, writers with set_resume( true )
+//   se->registerInputManager( in );
+//   input->Resume( { "out.root", "other.root" } );
+//   se->run( nevents );
+//
+// With several writers the smallest committed count is skipped, writers
+// further ahead drop the rest themselves.
+class TreeCheckpointInput : public SubsysReco
+{
+ public:
+
+    TreeCheckpointInput(const std::string &input_manager = "", const std::string &name = "TreeCheckpointInput")
+      : SubsysReco(name), m_input_manager(input_manager) {}
+    ~TreeCheckpointInput() override {}
+
+    // after the input managers are registered, before Fun4AllServer::run().
+    // Returns the number of input events skipped
+    unsigned long Resume(const std::vector<std::string> &outputs);
+    unsigned long Resume(const std::string &output) { return Resume(std::vector<std::string>{output}); }
+
+    int Init(PHCompositeNode *topNode) override;
+    int process_event(PHCompositeNode *topNode) override;
+
+ private:
+
+    std::string m_input_manager {""};
+
+    std::string CurrentFile() const;
+};
+
+#endif // EVENTSELECTION_TREECHECKPOINTINPUT_H
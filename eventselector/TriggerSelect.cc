@@ -8,39 +8,101 @@
 
 #include <cstdlib>
 #include <cstdint>
+#include <cctype>
 
 TriggerSelect::TriggerSelect() : EventCut("TriggerSelect")
 {
     // Set the default node name
-    SetNodeName("14001");
+    SetNodeName("GL1Packet");
 }
 
 void TriggerSelect::identify(std::ostream &os) const
 {
     os << Name() + "::identify: " << std::endl;
-    os << "  Node name: " << GetPacket() << std::endl;
+    os << "  Node name: " << GetNodeName() << " (packet " << GetPacket() << ")" << std::endl;
+    os << "  Vector: " << ( m_vector == kLIVE ? "live" : "scaled" ) << std::endl;
+    os << "  Expression: " << m_compiled.GetExpression() << std::endl;
+    if ( m_do_weight ) {
+        os << "  Prescale weight: on" << std::endl;
+    }
     return;
 }
 
+int TriggerSelect::BitOf(const std::string &name) const
+{
+    for ( const auto &trigger : m_trigger_names ) {
+        if ( trigger.first == name ) { return trigger.second < 64 ? static_cast<int>(trigger.second) : -1; }
+    }
+
+    // bitN
+    if ( name.size() > 3 && name.compare(0, 3, "bit") == 0 ) {
+        for ( std::size_t i = 3; i < name.size(); ++i ) {
+            if ( !std::isdigit(static_cast<unsigned char>(name[i])) ) { return -1; }
+        }
+        const int bit = std::stoi(name.substr(3));
+        return bit < 64 ? bit : -1;
+    }
+    return -1;
+}
+
+bool TriggerSelect::InitRun(PHCompositeNode * /*topNode*/)
+{
+    // expression AND every SelectTrigger() bit
+    std::string expression = m_expression.empty() ? "" : "(" + m_expression + ")";
+    for ( const auto id : m_trigger_ids ) {
+        expression += ( expression.empty() ? "" : " & " ) + std::string("bit") + std::to_string(id);
+    }
+    if ( expression.empty() ) {
+        std::cerr << Name() + "::InitRun(PHCompositeNode *topNode) No triggers selected, no event will pass" << std::endl;
+        expression = "0";
+    }
+
+    if ( !m_compiled.Compile(expression, [this](const std::string &name) { return BitOf(name); }) ) {
+        std::cerr << Name() + "::InitRun(PHCompositeNode *topNode) " + m_compiled.GetError() << std::endl;
+        return false;
+    }
+    if ( Verbosity() ) {
+        m_compiled.identify();
+    }
+    return true;
+}
+
 bool TriggerSelect::operator()(PHCompositeNode *topNode)
 {
     // get minbias info
-    auto * node = findNode::getClass<Gl1Packet>(topNode, GetPacket());
+    auto * node = Nodes().get<Gl1Packet>(topNode, GetNodeName());
     if( !node ){
-        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " << GetPacket() << std::endl;
+        node = Nodes().get<Gl1Packet>(topNode, std::to_string(m_packet_id)); // raw data names the node by packet id
+    }
+    if( !node ){
+        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " << GetNodeName() << " or " << GetPacket() << std::endl;
         exit(-1); // this is a fatal error
     }
 
-    uint64_t gl1_scaled = node->getScaledVector(); 
-    for (size_t i = 0; i < m_trigger_ids.size(); ++i) {
-        Passed(((gl1_scaled >> m_trigger_ids[i]) & 0x1U) == 0x1U);
-        if (!Passed()) {
-            if (Verbosity()) {
-                std::cout << Name() + "::operator(PHCompositeNode *topNode) Trigger " << m_trigger_ids[i] << " did not fire." << std::endl;
-            }
-            break; // exit loop if any trigger did not fire
-        }
+    const uint64_t bits = m_vector == kLIVE ? node->getLiveVector() : node->getScaledVector();
+    Passed(m_compiled.Evaluate(bits));
+    if ( !Passed() && Verbosity() ) {
+        std::cout << Name() + "::operator(PHCompositeNode *topNode) " << m_compiled.GetExpression() << " false for 0x" << std::hex << bits << std::dec << std::endl;
+    }
+
+    if ( m_do_weight ) {
+        m_weight = Passed() ? PrescaleWeight(node, bits & m_compiled.GetUsedBits()) : 0;
+        AddEventValue(m_weight);
     }
 
     return Passed();
 }
+
+float TriggerSelect::PrescaleWeight(Gl1Packet *gl1, uint64_t fired) const
+{
+    // least prescaled bit that accepted the event, prescale from the run integrated scalers
+    float weight = 0;
+    for ( int bit = 0; bit < 64; ++bit ) {
+        if ( !( ( fired >> bit ) & 0x1U ) ) { continue; }
+        const uint64_t scaled = gl1->lValue(bit, 1);
+        const uint64_t live = gl1->lValue(bit, 2);
+        const float prescale = ( scaled > 0 && live >= scaled ) ? static_cast<float>(live) / static_cast<float>(scaled) : 1.0f;
+        if ( weight == 0 || prescale < weight ) { weight = prescale; }
+    }
+    return weight > 0 ? weight : 1.0f;
+}
@@ -8,25 +8,65 @@
 #define EVENTSELECTION_TRIGGERSELECT_H
 
 #include "EventCut.h"
+#include "BitExpression.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
 
 class PHCompositeNode;
+class Gl1Packet;
 
+// Trigger logic as an expression over GL1 bits, e.g.
+//   SetExpression("(jet4 | jet6) & !mbd_ns1") with AddTriggerName("jet4", 21), ...
+// Bits can also be written bitN. SelectTrigger() bits are ANDed on top.
+// The expression is compiled in InitRun, per event it is a few mask /
+// compare ops on the scaled ( or live ) trigger vector.
 class TriggerSelect  : public EventCut
 {
   public:
 
+    enum VECTOR
+    {
+      kSCALED = 0,
+      kLIVE = 1
+    };
+
     TriggerSelect();
     ~TriggerSelect() override {} 
 
     void identify(std::ostream &os = std::cout) const override;
+    bool InitRun(PHCompositeNode* topNode) override;
     bool operator()(PHCompositeNode* topNode) override;
 
     void SelectTrigger(size_t trigger_id) { m_trigger_ids.push_back(trigger_id); }
-    void SetPacket(const int packet_id) { SetNodeName(std::to_string(packet_id)); }
-    int GetPacket() const { return std::stoi(GetNodeName()); }
+    void SetExpression(const std::string &expression) { m_expression = expression; }
+    void AddTriggerName(const std::string &name, const unsigned int bit) { m_trigger_names.push_back(std::make_pair(name, bit)); }
+    void SetTriggerVector(VECTOR vector) { m_vector = vector; }
+
+    // Event value ( and GetWeight() ) becomes the prescale of the least
+    // prescaled expression bit that fired, live / scaled from the GL1 scalers
+    void DoPrescaleWeight(bool b = true) { m_do_weight = b; }
+    float GetWeight() const { return m_weight; }
+
+    // GL1 node is GetNodeName(), the packet id names the raw data node used as fall back
+    void SetPacket(const int packet_id) { m_packet_id = packet_id; }
+    int GetPacket() const { return m_packet_id; }
   
   private:
     std::vector<size_t> m_trigger_ids; // list of trigger IDs to select
+    std::string m_expression {""};
+    std::vector< std::pair<std::string, unsigned int> > m_trigger_names {};
+    int m_vector {kSCALED};
+    bool m_do_weight {false};
+    float m_weight {1.0};
+    int m_packet_id {14001};
+
+    BitExpression m_compiled {};
+
+    int BitOf(const std::string &name) const;
+    float PrescaleWeight(Gl1Packet *gl1, uint64_t fired) const;
   };
 
-#endif // EVENTSELECTION_TriggerSelect_H
\ No newline at end of file
+#endif // EVENTSELECTION_TriggerSelect_H
@@ -4,16 +4,15 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/getClass.h>
 
-// global vertex
-#include <globalvertex/GlobalVertex.h>
-#include <globalvertex/GlobalVertexMapv1.h>
+#include "EventSummary.h"
+#include "EventSummaryReco.h"
 
 #include <cstdlib>
 
 
 ZVertexCut::ZVertexCut(float high, float low) : EventCut("ZVertexCut") 
 {
-        SetNodeName("GlobalVertexMap"); // default node name
+        SetNodeName("EventSummary"); // default node name, see EventSummaryReco
         if(low == -999.0){
             SetRange(high, -high);
         } else {
@@ -32,28 +31,27 @@ void ZVertexCut::identify(std::ostream &os) const
 bool ZVertexCut::operator()(PHCompositeNode *topNode)
 {
 
-    // get global vertex map node
-    auto *vrtxMap = findNode::getClass<GlobalVertexMapv1>(topNode, GetNodeName());
-    if ( !vrtxMap ) {
-        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find " + GetNodeName() << std::endl;
+    // vertex decoded once per event by EventSummaryReco
+    auto * summary = EventSummaryReco::GetSummary(topNode, Nodes(), GetNodeName());
+    if ( !summary || !summary->has(EventSummary::kVERTEXMAP) ) {
+        std::cerr << Name() + "::operator(PHCompositeNode *topNode) Could not find vertex map for " + GetNodeName() << std::endl;
         // exit(-1); // this is a fatal error
         return false;
     } 
 
-    // get primary vertex
-    auto * vrtx = vrtxMap->get(0);
-    if ( !vrtx ) {
+    if ( !summary->has_good_vertex() ) {
         
         if(Verbosity()){
-            std::cout << Name() + "::operator(PHCompositeNode *topNode) Could not find primary vertex in " + GetNodeName() << std::endl;
+            std::cout << Name() + "::operator(PHCompositeNode *topNode) Could not find valid primary vertex in " + GetNodeName() << std::endl;
         }
         return false;
 
     } 
 
-    Passed((vrtx->get_z() <= GetRange().second) && (vrtx->get_z() >= GetRange().first)); // check z-vertex
+    const float zvtx = summary->get_zvtx();
+    Passed((zvtx <= GetRange().second) && (zvtx >= GetRange().first)); // check z-vertex
     if(!Passed() && Verbosity()){
-        std::cout << Name() + "::operator(PHCompositeNode *topNode) Event failed" + Name() + " event selection. Vertex z: " + std::to_string(vrtx->get_z()) << std::endl;
+        std::cout << Name() + "::operator(PHCompositeNode *topNode) Event failed" + Name() + " event selection. Vertex z: " + std::to_string(zvtx) << std::endl;
     }
 
     return Passed();
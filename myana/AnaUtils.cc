@@ -1,10 +1,23 @@
 #include "AnaUtils.h"
+#include "OutputMerger.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <thread>
 
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <TFile.h>
 #include <TMath.h>
+#include <TTree.h>
 
 std::vector< std::string > AnaUtils::getFilelist( const std::string & inlist , const std::string & ext )
 {
@@ -169,4 +182,368 @@ bool AnaUtils::out_of_plane( const float psi2, const float phi_jet )
 {
     float dpsi2 = get_dpsi2( psi2, phi_jet );
     return ( dpsi2 >= TMath::Pi()/3.0f ); // out-of-plane if greater than 60 degrees from event plane
-}  
\ No newline at end of file
+}  
+
+namespace
+{
+    // dphi_wrap on phi2 - phi1: the comparisons and the shift are done in
+    // double like the scalar version, the result rounded once to float
+    inline float wrap_abs( const float dphi )
+    {
+        const double pi = TMath::Pi();
+        double d = dphi;
+        d = ( d > pi ) ? d - 2 * pi : d;
+        d = ( d < -pi ) ? d + 2 * pi : d;
+        return std::fabs( static_cast< float >( d ) );
+    }
+
+    // edges of get_dpsi2 classes, same double constants as the scalar versions
+    const double kPLANE_LOW = TMath::Pi()/6.0f;
+    const double kPLANE_HIGH = TMath::Pi()/3.0f;
+} // namespace
+
+void AnaUtils::dphi_wrap( const float * phi1, const float * phi2, const std::size_t n, float * out )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        out[i] = wrap_abs( phi2[i] - phi1[i] );
+    }
+}
+
+void AnaUtils::dphi_wrap( const float phi1, const float * phi2, const std::size_t n, float * out )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        out[i] = wrap_abs( phi2[i] - phi1 );
+    }
+}
+
+void AnaUtils::calc_dr( const float * eta1, const float * phi1, const std::size_t n1,
+                        const float * eta2, const float * phi2, const std::size_t n2, float * dr )
+{
+    for ( std::size_t i = 0; i < n1; ++i )
+    {
+        const float eta = eta1[i];
+        const float phi = phi1[i];
+        float * row = dr + i * n2;
+        for ( std::size_t j = 0; j < n2; ++j )
+        {
+            const float dphi = wrap_abs( phi2[j] - phi );
+            const float deta = std::fabs( eta2[j] - eta );
+            // sqrt in double rounded to float is sqrtf
+            row[j] = std::sqrt( dphi*dphi + deta*deta );
+        }
+    }
+}
+
+std::vector< float > AnaUtils::calc_dr( const std::vector< float > & eta1, const std::vector< float > & phi1,
+                                        const std::vector< float > & eta2, const std::vector< float > & phi2 )
+{
+    std::vector< float > dr( eta1.size() * eta2.size() );
+    calc_dr( eta1.data(), phi1.data(), eta1.size(), eta2.data(), phi2.data(), eta2.size(), dr.data() );
+    return dr;
+}
+
+void AnaUtils::get_dpsi2( const float psi2, const float * phi, const std::size_t n, float * out )
+{
+    float psi2_mod = psi2 - TMath::Pi();
+    if ( psi2 < 0 )
+    {
+        psi2_mod = psi2 + TMath::Pi();
+    }
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const float dA = wrap_abs( psi2 - phi[i] );
+        const float dB = wrap_abs( psi2_mod - phi[i] );
+        out[i] = std::fabs( std::min( dA, dB ) );
+    }
+}
+
+void AnaUtils::classify_plane( const float psi2, const float * phi, const std::size_t n, int * plane )
+{
+    float psi2_mod = psi2 - TMath::Pi();
+    if ( psi2 < 0 )
+    {
+        psi2_mod = psi2 + TMath::Pi();
+    }
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const float dA = wrap_abs( psi2 - phi[i] );
+        const float dB = wrap_abs( psi2_mod - phi[i] );
+        const float dpsi2 = std::fabs( std::min( dA, dB ) );
+        // NaN fails every comparison, like the three scalar classifiers
+        plane[i] = ( dpsi2 < kPLANE_LOW ) ? kInPlane
+                 : ( dpsi2 < kPLANE_HIGH ) ? kMidPlane
+                 : ( dpsi2 >= kPLANE_HIGH ) ? kOutOfPlane : kNoPlane;
+    }
+}
+
+std::vector< int > AnaUtils::classify_plane( const float psi2, const std::vector< float > & phi )
+{
+    std::vector< int > plane( phi.size() );
+    classify_plane( psi2, phi.data(), phi.size(), plane.data() );
+    return plane;
+}
+
+void AnaUtils::correct_calo_eta( const float * eta0, const std::size_t n, const float zvrtx, const float R, float * out )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        double z0 = sinh(eta0[i]) * R;
+        double z1 = z0 - zvrtx;
+        double eta1 = asinh( z1 / R );
+        out[i] = eta1;
+    }
+}
+
+void AnaUtils::accept_jet_eta( const float * eta, const std::size_t n, const float zvrtx, const float jet_R, bool * accept )
+{
+    const float CALO_ABS_Z[3] = {130.23, 170.299, 301.683};
+    const float CALO_RADIUS[3] = {93.5, 127.503, 225.87};
+    float min_eta = -999, MAX_eta = 999;
+    for (int i=0; i<3; i++) 
+    {
+       float min_z = -1.0*CALO_ABS_Z[i];
+       float max_z = CALO_ABS_Z[i];
+       float z_l = min_z - zvrtx;
+       float z_h = max_z - zvrtx;
+       float r = CALO_RADIUS[i];
+       float eta_min = asinh( z_l / r );
+       float eta_max = asinh( z_h / r );
+       if ( eta_min > min_eta ) { min_eta = eta_min; }
+       if ( eta_max < MAX_eta ) { MAX_eta = eta_max; }
+    }
+    min_eta += jet_R;
+    MAX_eta -= jet_R;
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        accept[i] = (eta[i] >= min_eta && eta[i] <= MAX_eta);
+    }
+}
+
+std::vector< double > AnaUtils::getFileLoads( const std::vector< std::string > & files , const std::string & tree_name )
+{
+    std::vector< double > loads( files.size(), 0 );
+    bool use_entries = !tree_name.empty();
+    for ( std::size_t i = 0; i < files.size() && use_entries; ++i )
+    {
+        std::unique_ptr< TFile > f( TFile::Open( files[i].c_str(), "READ" ) );
+        auto tree = ( f && !f->IsZombie() ) ? dynamic_cast< TTree * >( f->Get( tree_name.c_str() ) ) : nullptr;
+        if ( !tree )
+        {
+            std::cerr << "AnaUtils::getFileLoads - no " << tree_name << " in " << files[i] << ", using file sizes" << std::endl;
+            use_entries = false;
+            break;
+        }
+        loads[i] = tree->GetEntries();
+    }
+
+    if ( !use_entries )
+    {
+        for ( std::size_t i = 0; i < files.size(); ++i )
+        {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size( files[i], ec );
+            loads[i] = ec ? 0 : static_cast< double >( size );
+        }
+    }
+    return loads;
+}
+
+std::vector< AnaUtils::Shard > AnaUtils::makeShards( const std::vector< std::string > & files , const unsigned int nshards , const std::string & tree_name )
+{
+    std::vector< Shard > shards( std::max( 1U, std::min< unsigned int >( nshards, files.size() ) ) );
+    if ( files.empty() )
+    {
+        return shards;
+    }
+
+    const auto loads = getFileLoads( files, tree_name );
+    std::vector< std::size_t > order( files.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(), [&]( const std::size_t a, const std::size_t b ) { return loads[a] > loads[b]; } );
+
+    // longest processing time first, ties to the lower shard
+    std::vector< std::vector< std::size_t > > assigned( shards.size() );
+    for ( const auto ifile : order )
+    {
+        std::size_t best = 0;
+        for ( std::size_t ishard = 1; ishard < shards.size(); ++ishard )
+        {
+            if ( shards[ishard].load < shards[best].load )
+            {
+                best = ishard;
+            }
+        }
+        shards[best].load += loads[ifile];
+        assigned[best].push_back( ifile );
+    }
+
+    for ( std::size_t ishard = 0; ishard < shards.size(); ++ishard )
+    {
+        std::sort( assigned[ishard].begin(), assigned[ishard].end() );
+        for ( const auto ifile : assigned[ishard] )
+        {
+            shards[ishard].files.push_back( files[ifile] );
+        }
+    }
+    return shards;
+}
+
+std::vector< std::string > AnaUtils::writeShardLists( const std::vector< Shard > & shards , const std::string & prefix )
+{
+    std::vector< std::string > lists;
+    for ( std::size_t ishard = 0; ishard < shards.size(); ++ishard )
+    {
+        const std::string name = prefix + "_" + std::to_string( ishard ) + ".list";
+        std::ofstream out( name );
+        if ( !out.is_open() )
+        {
+            std::cerr << "Error: could not write shard list " << name << std::endl;
+            return {};
+        }
+        for ( const auto & file : shards[ishard].files )
+        {
+            out << file << "\n";
+        }
+        lists.push_back( name );
+    }
+    return lists;
+}
+
+std::vector< int > AnaUtils::runParallel( const std::vector< std::string > & commands , unsigned int max_jobs , const std::string & log_prefix )
+{
+    if ( max_jobs == 0 )
+    {
+        max_jobs = std::max( 1U, std::thread::hardware_concurrency() );
+    }
+
+    std::vector< int > codes( commands.size(), -1 );
+    std::map< pid_t, std::size_t > running;
+    std::size_t next = 0;
+
+    auto reap = [&]()
+    {
+        int status = 0;
+        const pid_t pid = waitpid( -1, &status, 0 );
+        auto it = running.find( pid );
+        if ( pid <= 0 || it == running.end() )
+        {
+            return;
+        }
+        codes[it->second] = WIFEXITED( status ) ? WEXITSTATUS( status ) : 128 + WTERMSIG( status );
+        if ( codes[it->second] != 0 )
+        {
+            std::cerr << "AnaUtils::runParallel - job " << it->second << " exited with " << codes[it->second] << ": " << commands[it->second] << std::endl;
+        }
+        running.erase( it );
+    };
+
+    while ( next < commands.size() || !running.empty() )
+    {
+        if ( next < commands.size() && running.size() < max_jobs )
+        {
+            std::cout.flush();
+            std::cerr.flush();
+            const pid_t pid = fork();
+            if ( pid == 0 )
+            {
+                if ( !log_prefix.empty() )
+                {
+                    const std::string log = log_prefix + "_" + std::to_string( next ) + ".log";
+                    const int fd = open( log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+                    if ( fd >= 0 )
+                    {
+                        dup2( fd, STDOUT_FILENO );
+                        dup2( fd, STDERR_FILENO );
+                        close( fd );
+                    }
+                }
+                execl( "/bin/sh", "sh", "-c", commands[next].c_str(), static_cast< char * >( nullptr ) );
+                _exit( 127 );
+            }
+            if ( pid < 0 )
+            {
+                std::cerr << "AnaUtils::runParallel - fork failed for job " << next << std::endl;
+                codes[next++] = -1;
+                continue;
+            }
+            running[pid] = next++;
+            continue;
+        }
+        reap();
+    }
+    return codes;
+}
+
+bool AnaUtils::mergeOutputs( const std::vector< std::string > & inputs , const std::string & output ,
+                             const std::string & run_tree , const std::vector< std::string > & sum_branches )
+{
+    OutputMerger merger( output );
+    merger.AddInputs( inputs );
+    merger.SetRunTree( run_tree );
+    merger.SetRunKey( "" ); // one entry in total
+    merger.ClearReduce();
+    for ( const auto & name : sum_branches )
+    {
+        merger.SetReduce( name, OutputMerger::kSum );
+    }
+    return merger.Merge();
+}
+
+bool AnaUtils::runSharded( const std::string & inlist , const unsigned int nshards , const std::string & cmd_template ,
+                           const std::string & output , const unsigned int max_jobs , const std::string & tree_name )
+{
+    const auto files = getFilelist( inlist );
+    if ( files.empty() )
+    {
+        std::cerr << "Error: no files in " << inlist << std::endl;
+        return false;
+    }
+
+    std::string stem = output;
+    if ( stem.size() > 5 && stem.compare( stem.size() - 5, 5, ".root" ) == 0 )
+    {
+        stem.resize( stem.size() - 5 );
+    }
+
+    const auto shards = makeShards( files, nshards, tree_name );
+    const auto lists = writeShardLists( shards, stem + "_shard" );
+    if ( lists.size() != shards.size() )
+    {
+        return false;
+    }
+
+    auto replace_all = []( std::string s, const std::string & key, const std::string & value )
+    {
+        for ( auto pos = s.find( key ); pos != std::string::npos; pos = s.find( key, pos + value.size() ) )
+        {
+            s.replace( pos, key.size(), value );
+        }
+        return s;
+    };
+
+    std::vector< std::string > commands;
+    std::vector< std::string > outputs;
+    for ( std::size_t ishard = 0; ishard < shards.size(); ++ishard )
+    {
+        outputs.push_back( stem + "_shard_" + std::to_string( ishard ) + ".root" );
+        std::string cmd = replace_all( cmd_template, "{list}", lists[ishard] );
+        cmd = replace_all( cmd, "{output}", outputs.back() );
+        cmd = replace_all( cmd, "{shard}", std::to_string( ishard ) );
+        commands.push_back( cmd );
+        std::cout << "AnaUtils::runSharded - shard " << ishard << ": " << shards[ishard].files.size() << " files, load " << shards[ishard].load << std::endl;
+    }
+
+    const auto codes = runParallel( commands, max_jobs, stem + "_shard" );
+    for ( std::size_t ishard = 0; ishard < codes.size(); ++ishard )
+    {
+        if ( codes[ishard] != 0 )
+        {
+            std::cerr << "Error: shard " << ishard << " failed, see " << stem << "_shard_" << ishard << ".log" << std::endl;
+            return false;
+        }
+    }
+
+    return mergeOutputs( outputs, output );
+}
@@ -1,6 +1,7 @@
 #ifndef _ANAUTILS_H_
 #define _ANAUTILS_H_
 
+#include <cstddef>
 #include <vector>
 #include <string>
 
@@ -31,7 +32,79 @@ namespace AnaUtils
     bool mid_plane( const float psi2, const float phi_jet ) ;
     bool out_of_plane( const float psi2, const float phi_jet ) ;   
 
+    // ----------------------------------
+    // batch versions over contiguous arrays, bit for bit the scalar
+    // results. The loops are branch free so the compiler can vectorize them
+    // ----------------------------------
+    enum PLANE
+    {
+        kNoPlane = -1, // dpsi2 is NaN
+        kInPlane = 0,
+        kMidPlane = 1,
+        kOutOfPlane = 2
+    };
+
+    // out[i] = dphi_wrap( phi1[i], phi2[i] )
+    void dphi_wrap( const float * phi1, const float * phi2, const std::size_t n, float * out );
+    // out[i] = dphi_wrap( phi1, phi2[i] )
+    void dphi_wrap( const float phi1, const float * phi2, const std::size_t n, float * out );
+
+    // all pairs, dr[i*n2 + j] = calc_dr( eta1[i], phi1[i], eta2[j], phi2[j] )
+    void calc_dr( const float * eta1, const float * phi1, const std::size_t n1,
+                  const float * eta2, const float * phi2, const std::size_t n2, float * dr );
+    std::vector< float > calc_dr( const std::vector< float > & eta1, const std::vector< float > & phi1,
+                                  const std::vector< float > & eta2, const std::vector< float > & phi2 );
+
+    // out[i] = get_dpsi2( psi2, phi[i] )
+    void get_dpsi2( const float psi2, const float * phi, const std::size_t n, float * out );
+
+    // plane[i] = kInPlane, kMidPlane or kOutOfPlane as in_plane(), mid_plane() and out_of_plane()
+    void classify_plane( const float psi2, const float * phi, const std::size_t n, int * plane );
+    std::vector< int > classify_plane( const float psi2, const std::vector< float > & phi );
+
+    // out[i] = correct_calo_eta( eta0[i], zvrtx, R )
+    void correct_calo_eta( const float * eta0, const std::size_t n, const float zvrtx, const float R, float * out );
+
+    // accept[i] = accept_jet_eta( eta[i], zvrtx, jet_R ), the acceptance is computed once
+    void accept_jet_eta( const float * eta, const std::size_t n, const float zvrtx, const float jet_R, bool * accept );
+
    std::vector< std::string > getFilelist( const std::string & inlist , const std::string & ext = ".root" );
+
+   // ----------------------------------
+   // job sharding
+   // ----------------------------------
+   struct Shard
+   {
+       std::vector< std::string > files {};
+       double load { 0 };
+   };
+
+   // entries of tree_name in each file, on-disk sizes (bytes) for every
+   // file when tree_name is empty or any file lacks the tree
+   std::vector< double > getFileLoads( const std::vector< std::string > & files , const std::string & tree_name = "EventTree" );
+
+   // largest first onto the lightest shard, keeps the list order inside a shard
+   std::vector< Shard > makeShards( const std::vector< std::string > & files , const unsigned int nshards , const std::string & tree_name = "EventTree" );
+
+   // one list per shard, <prefix>_<ishard>.list
+   std::vector< std::string > writeShardLists( const std::vector< Shard > & shards , const std::string & prefix );
+
+   // runs every command through /bin/sh, at most max_jobs at a time (0 =
+   // number of cores). Output goes to <log_prefix>_<ijob>.log when
+   // log_prefix is set. Returns the exit codes in command order
+   std::vector< int > runParallel( const std::vector< std::string > & commands , unsigned int max_jobs = 0 , const std::string & log_prefix = "" );
+
+   // hadd of the inputs, except the run tree which becomes one entry with
+   // sum_branches summed over all inputs and the rest from the first input
+   bool mergeOutputs( const std::vector< std::string > & inputs , const std::string & output ,
+                      const std::string & run_tree = "RunTree" ,
+                      const std::vector< std::string > & sum_branches = { "num_events", "weight" } );
+
+   // inlist -> nshards balanced lists -> cmd_template per shard -> output.
+   // {list}, {output} and {shard} in cmd_template are replaced by the
+   // shard list, the shard output file and the shard index
+   bool runSharded( const std::string & inlist , const unsigned int nshards , const std::string & cmd_template ,
+                    const std::string & output , const unsigned int max_jobs = 0 , const std::string & tree_name = "EventTree" );
    
 } // namespace MyAna
 
@@ -0,0 +1,577 @@
+#include "OutputMerger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <TBranch.h>
+#include <TChain.h>
+#include <TClass.h>
+#include <TFile.h>
+#include <TFileMerger.h>
+#include <TKey.h>
+#include <TLeaf.h>
+#include <TList.h>
+#include <TObjArray.h>
+#include <TTree.h>
+#include <TVirtualIndex.h>
+
+#include <eventselection/TreeCheckpoint.h>
+
+namespace
+{
+    const std::string kLINK_SUFFIX = "_entry";
+
+    // one fixed size leaf of the run tree, read into data
+    struct Column
+    {
+        std::string name {};
+        std::string type {};
+        int len { 0 };
+        int size { 0 }; // bytes per element
+        OutputMerger::REDUCE reduce { OutputMerger::kFirst };
+        std::vector< char > data {};
+        bool warned { false };
+    };
+
+    // reduced values of one run
+    struct RunGroup
+    {
+        std::vector< std::vector< char > > first {};
+        std::vector< std::vector< uint64_t > > isum {};
+        std::vector< std::vector< double > > fval {};
+    };
+
+    bool is_float( const std::string & type ) { return type == "Float_t" || type == "Double_t"; }
+
+    int type_size( const std::string & type )
+    {
+        if ( type == "Double_t" || type == "Long64_t" || type == "ULong64_t" ) { return 8; }
+        if ( type == "Float_t" || type == "Int_t" || type == "UInt_t" ) { return 4; }
+        if ( type == "Short_t" || type == "UShort_t" ) { return 2; }
+        if ( type == "Char_t" || type == "UChar_t" || type == "Bool_t" ) { return 1; }
+        return 0;
+    }
+
+    template < class T >
+    T read_as( const char * p ) { T v; std::memcpy( &v, p, sizeof( T ) ); return v; }
+
+    template < class T >
+    void write_as( char * p, const T v ) { std::memcpy( p, &v, sizeof( T ) ); }
+
+    double get_float( const Column & c, const int k )
+    {
+        const char * p = c.data.data() + k * c.size;
+        return c.type == "Double_t" ? read_as< double >( p ) : read_as< float >( p );
+    }
+
+    // integers as two's complement 64 bit, sums wrap like the original types
+    uint64_t get_int( const Column & c, const int k )
+    {
+        const char * p = c.data.data() + k * c.size;
+        if ( c.type == "Int_t" ) { return static_cast< uint64_t >( static_cast< int64_t >( read_as< int32_t >( p ) ) ); }
+        if ( c.type == "UInt_t" ) { return read_as< uint32_t >( p ); }
+        if ( c.type == "Long64_t" || c.type == "ULong64_t" ) { return read_as< uint64_t >( p ); }
+        if ( c.type == "Short_t" ) { return static_cast< uint64_t >( static_cast< int64_t >( read_as< int16_t >( p ) ) ); }
+        if ( c.type == "UShort_t" ) { return read_as< uint16_t >( p ); }
+        if ( c.type == "Char_t" ) { return static_cast< uint64_t >( static_cast< int64_t >( read_as< int8_t >( p ) ) ); }
+        return read_as< uint8_t >( p ); // UChar_t, Bool_t
+    }
+
+    void set_value( Column & c, const int k, const uint64_t ival, const double fval )
+    {
+        char * p = c.data.data() + k * c.size;
+        if ( c.type == "Double_t" ) { write_as< double >( p, fval ); }
+        else if ( c.type == "Float_t" ) { write_as< float >( p, static_cast< float >( fval ) ); }
+        else if ( c.type == "Bool_t" ) { write_as< uint8_t >( p, ival != 0 ); }
+        else if ( c.size == 8 ) { write_as< uint64_t >( p, ival ); }
+        else if ( c.size == 4 ) { write_as< uint32_t >( p, static_cast< uint32_t >( ival ) ); }
+        else if ( c.size == 2 ) { write_as< uint16_t >( p, static_cast< uint16_t >( ival ) ); }
+        else { write_as< uint8_t >( p, static_cast< uint8_t >( ival ) ); }
+    }
+
+    // signed view for min/max of integer leaves
+    double int_value( const Column & c, const uint64_t v )
+    {
+        const bool is_unsigned = c.type[0] == 'U' || c.type == "Bool_t";
+        return is_unsigned ? static_cast< double >( v ) : static_cast< double >( static_cast< int64_t >( v ) );
+    }
+
+    std::vector< std::string > tree_names( TFile * f )
+    {
+        std::vector< std::string > names;
+        TIter next( f->GetListOfKeys() );
+        while ( TKey * key = static_cast< TKey * >( next() ) )
+        {
+            TClass * cl = TClass::GetClass( key->GetClassName() );
+            if ( !cl || !cl->InheritsFrom( TTree::Class() ) ) { continue; }
+            if ( std::find( names.begin(), names.end(), key->GetName() ) == names.end() )
+            {
+                names.push_back( key->GetName() );
+            }
+        }
+        return names;
+    }
+} // namespace
+
+OutputMerger::OutputMerger( const std::string & output )
+  : m_output( output )
+{
+    m_reduce["num_events"] = kSum;
+    m_reduce["weight"] = kSum;
+    m_reduce["run_scalars_*"] = kSum;
+    m_reduce["active_triggers"] = kOr;
+}
+
+OutputMerger::REDUCE OutputMerger::GetReduce( const std::string & branch ) const
+{
+    auto it = m_reduce.find( branch );
+    if ( it != m_reduce.end() ) { return it->second; }
+    for ( const auto & [ pattern, reduce ] : m_reduce )
+    {
+        if ( !pattern.empty() && pattern.back() == '*' && branch.compare( 0, pattern.size() - 1, pattern, 0, pattern.size() - 1 ) == 0 )
+        {
+            return reduce;
+        }
+    }
+    return kFirst;
+}
+
+bool OutputMerger::Merge()
+{
+    if ( m_inputs.empty() )
+    {
+        std::cerr << "OutputMerger::Merge - no inputs for " << m_output << std::endl;
+        return false;
+    }
+
+    unsigned int nworkers = m_nworkers ? m_nworkers : std::max( 1U, std::thread::hardware_concurrency() );
+    const unsigned int ngroups = std::min< std::size_t >( nworkers, m_inputs.size() / 2 );
+    if ( ngroups <= 1 )
+    {
+        return MergeGroup( m_inputs, m_output );
+    }
+
+    // contiguous groups keep the input order, which the link offsets need
+    std::vector< std::string > partials;
+    std::vector< pid_t > pids;
+    std::size_t begin = 0;
+    for ( unsigned int igroup = 0; igroup < ngroups; ++igroup )
+    {
+        const std::size_t end = begin + ( m_inputs.size() - begin ) / ( ngroups - igroup );
+        const std::vector< std::string > group( m_inputs.begin() + begin, m_inputs.begin() + end );
+        begin = end;
+
+        partials.push_back( m_output + ".part" + std::to_string( igroup ) + ".root" );
+        std::cout.flush();
+        std::cerr.flush();
+        const pid_t pid = fork();
+        if ( pid == 0 )
+        {
+            _exit( MergeGroup( group, partials.back() ) ? 0 : 1 );
+        }
+        if ( pid < 0 )
+        {
+            std::cerr << "OutputMerger::Merge - fork failed" << std::endl;
+        }
+        pids.push_back( pid );
+    }
+
+    bool ok = true;
+    for ( const pid_t pid : pids )
+    {
+        int status = 0;
+        if ( pid < 0 || waitpid( pid, &status, 0 ) != pid || !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+        {
+            ok = false;
+        }
+    }
+
+    if ( ok )
+    {
+        if ( m_verbosity > 0 )
+        {
+            std::cout << "OutputMerger::Merge - merging " << partials.size() << " partial files into " << m_output << std::endl;
+        }
+        ok = MergeGroup( partials, m_output );
+    }
+    else
+    {
+        std::cerr << "OutputMerger::Merge - a worker failed, " << m_output << " not written" << std::endl;
+    }
+
+    for ( const auto & partial : partials )
+    {
+        std::remove( partial.c_str() );
+    }
+    return ok;
+}
+
+bool OutputMerger::MergeGroup( const std::vector< std::string > & inputs, const std::string & output ) const
+{
+    // scan: trees, entries per input, compression, indexes of the first input
+    std::vector< std::string > trees;
+    std::map< std::string, std::vector< long long > > offsets; // tree -> entries before input i
+    std::map< std::string, std::vector< long long > > limits; // tree -> entries kept of input i, -1 all
+    std::vector< std::pair< std::string, std::pair< std::string, std::string > > > indexes;
+    int compression = -1;
+    bool same_compression = true;
+
+    for ( std::size_t i = 0; i < inputs.size(); ++i )
+    {
+        std::unique_ptr< TFile > f( TFile::Open( inputs[i].c_str(), "READ" ) );
+        if ( !f || f->IsZombie() )
+        {
+            std::cerr << "OutputMerger::MergeGroup - could not open " << inputs[i] << std::endl;
+            return false;
+        }
+
+        if ( i == 0 )
+        {
+            trees = tree_names( f.get() );
+            compression = f->GetCompressionSettings();
+            for ( const auto & name : trees )
+            {
+                auto tree = dynamic_cast< TTree * >( f->Get( name.c_str() ) );
+                TVirtualIndex * index = tree ? tree->GetTreeIndex() : nullptr;
+                if ( index )
+                {
+                    indexes.push_back( { name, { index->GetMajorName(), index->GetMinorName() } } );
+                }
+            }
+        }
+        else if ( f->GetCompressionSettings() != compression )
+        {
+            same_compression = false;
+        }
+
+        // a part killed after AutoSave but before its checkpoint record
+        // holds entries the resumed part wrote again, keep the committed ones
+        std::map< std::string, long long > committed;
+        TreeCheckpoint::get_committed_entries( inputs[i], committed );
+
+        for ( const auto & name : trees )
+        {
+            auto & offset = offsets[name];
+            const long long before = offset.empty() ? 0 : offset.back();
+            auto tree = dynamic_cast< TTree * >( f->Get( name.c_str() ) );
+            long long entries = tree ? tree->GetEntries() : 0;
+            limits[name].push_back( -1 );
+            auto it = committed.find( name );
+            if ( it != committed.end() && it->second < entries )
+            {
+                if ( m_verbosity > 0 )
+                {
+                    std::cout << "OutputMerger::MergeGroup - " << inputs[i] << ": " << name << " keeps " << it->second
+                              << " of " << entries << " entries, the rest was not committed" << std::endl;
+                }
+                entries = it->second;
+                limits[name].back() = entries;
+            }
+            if ( offset.empty() ) { offset.push_back( 0 ); }
+            offset.push_back( before + entries );
+        }
+    }
+
+    const bool fast = m_fast && same_compression;
+    if ( m_fast && !same_compression )
+    {
+        std::cout << "OutputMerger::MergeGroup - compression differs between inputs, baskets are recompressed" << std::endl;
+    }
+
+    {   // histograms and other non-tree objects
+        TFileMerger merger( false, false );
+        merger.SetPrintLevel( 0 );
+        if ( !merger.OutputFile( output.c_str(), "RECREATE", compression ) )
+        {
+            std::cerr << "OutputMerger::MergeGroup - could not create " << output << std::endl;
+            return false;
+        }
+        for ( const auto & input : inputs )
+        {
+            merger.AddFile( input.c_str(), false );
+        }
+        for ( const auto & name : trees )
+        {
+            merger.AddObjectNames( name.c_str() );
+        }
+        if ( !merger.PartialMerge( TFileMerger::kAll | TFileMerger::kRegular | TFileMerger::kSkipListed ) )
+        {
+            std::cerr << "OutputMerger::MergeGroup - merge of non-tree objects failed for " << output << std::endl;
+            return false;
+        }
+    }
+
+    std::unique_ptr< TFile > out( TFile::Open( output.c_str(), "UPDATE" ) );
+    if ( !out || out->IsZombie() )
+    {
+        std::cerr << "OutputMerger::MergeGroup - could not reopen " << output << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    for ( const auto & name : trees )
+    {
+        if ( name == m_run_tree ) { continue; }
+
+        // <tree>_entry links into other trees of the file
+        bool linked = false;
+        {
+            std::unique_ptr< TFile > f( TFile::Open( inputs.front().c_str(), "READ" ) );
+            auto tree = dynamic_cast< TTree * >( f->Get( name.c_str() ) );
+            TObjArray * branches = tree ? tree->GetListOfBranches() : nullptr;
+            for ( int ib = 0; branches && ib < branches->GetEntries() && !linked; ++ib )
+            {
+                const std::string bname = branches->At( ib )->GetName();
+                if ( bname.size() > kLINK_SUFFIX.size() && bname.compare( bname.size() - kLINK_SUFFIX.size(), kLINK_SUFFIX.size(), kLINK_SUFFIX ) == 0 )
+                {
+                    linked = offsets.count( bname.substr( 0, bname.size() - kLINK_SUFFIX.size() ) ) > 0;
+                }
+            }
+        }
+
+        const auto & limit = limits[name];
+        const bool trimmed = std::any_of( limit.begin(), limit.end(), []( const long long n ) { return n >= 0; } );
+
+        out->cd();
+        if ( linked || trimmed )
+        {
+            ok = MergeByEntry( inputs, name, offsets, limit ) && ok;
+            continue;
+        }
+
+        TChain chain( name.c_str() );
+        for ( const auto & input : inputs ) { chain.Add( input.c_str() ); }
+        if ( m_verbosity > 0 )
+        {
+            std::cout << "OutputMerger::MergeGroup - " << name << ": " << chain.GetEntries() << " entries" << ( fast ? " (fast)" : "" ) << std::endl;
+        }
+        if ( chain.Merge( out.get(), 0, fast ? "fast keep" : "keep" ) < 0 )
+        {
+            std::cerr << "OutputMerger::MergeGroup - merge of " << name << " failed" << std::endl;
+            ok = false;
+        }
+    }
+
+    out->cd();
+    ok = MergeRunTree( inputs ) && ok;
+
+    for ( const auto & [ name, keys ] : indexes )
+    {
+        // a job local counter repeats across inputs, the index would join wrong entries
+        if ( inputs.size() > 1 && keys.first == "event_id" )
+        {
+            std::cerr << "OutputMerger::MergeGroup - " << name << " is indexed on event_id only, not unique across jobs, index dropped" << std::endl;
+            continue;
+        }
+        auto tree = dynamic_cast< TTree * >( out->Get( name.c_str() ) );
+        if ( !tree ) { continue; }
+        tree->BuildIndex( keys.first.c_str(), keys.second.c_str() );
+        out->cd();
+        tree->Write( "", TObject::kOverwrite );
+    }
+
+    out->Close();
+    return ok;
+}
+
+bool OutputMerger::MergeByEntry( const std::vector< std::string > & inputs, const std::string & tree_name,
+                                 const std::map< std::string, std::vector< long long > > & offsets,
+                                 const std::vector< long long > & limit ) const
+{
+    TChain chain( tree_name.c_str() );
+    for ( const auto & input : inputs ) { chain.Add( input.c_str() ); }
+    if ( chain.LoadTree( 0 ) < 0 )
+    {
+        return true; // no entries anywhere
+    }
+
+    // links are read into our buffers, the clone writes from them
+    struct Link
+    {
+        std::string branch;
+        const std::vector< long long > * offset;
+        Int_t value;
+    };
+    std::vector< Link > links;
+    TObjArray * branches = chain.GetTree()->GetListOfBranches();
+    for ( int ib = 0; ib < branches->GetEntries(); ++ib )
+    {
+        const std::string bname = branches->At( ib )->GetName();
+        if ( bname.size() <= kLINK_SUFFIX.size() || bname.compare( bname.size() - kLINK_SUFFIX.size(), kLINK_SUFFIX.size(), kLINK_SUFFIX ) != 0 ) { continue; }
+        auto it = offsets.find( bname.substr( 0, bname.size() - kLINK_SUFFIX.size() ) );
+        TLeaf * leaf = chain.GetTree()->GetLeaf( bname.c_str() );
+        if ( it == offsets.end() || !leaf || std::string( leaf->GetTypeName() ) != "Int_t" ) { continue; }
+        links.push_back( { bname, &it->second, -1 } );
+    }
+    for ( auto & link : links )
+    {
+        chain.SetBranchAddress( link.branch.c_str(), &link.value );
+    }
+
+    TTree * merged = chain.CloneTree( 0 );
+    const Long64_t nentries = chain.GetEntries();
+    Long64_t nkept = 0;
+    for ( Long64_t i = 0; i < nentries; ++i )
+    {
+        if ( chain.GetEntry( i ) <= 0 ) { continue; }
+        const int itree = chain.GetTreeNumber();
+        if ( itree < static_cast< int >( limit.size() ) && limit[itree] >= 0 && chain.GetTree()->GetReadEntry() >= limit[itree] ) { continue; }
+        ++nkept;
+        for ( auto & link : links )
+        {
+            // -1 means no entry yet in that tree
+            if ( link.value >= 0 ) { link.value += static_cast< Int_t >( ( *link.offset )[itree] ); }
+        }
+        merged->Fill();
+    }
+
+    if ( m_verbosity > 0 )
+    {
+        std::cout << "OutputMerger::MergeByEntry - " << tree_name << ": " << nkept << " of " << nentries << " entries, " << links.size() << " links shifted" << std::endl;
+    }
+    merged->Write( "", TObject::kOverwrite );
+    chain.ResetBranchAddresses();
+    return true;
+}
+
+bool OutputMerger::MergeRunTree( const std::vector< std::string > & inputs ) const
+{
+    TChain chain( m_run_tree.c_str() );
+    for ( const auto & input : inputs ) { chain.Add( input.c_str() ); }
+    if ( chain.LoadTree( 0 ) < 0 )
+    {
+        return true; // nothing to reduce
+    }
+
+    std::vector< Column > columns;
+    TObjArray * branches = chain.GetTree()->GetListOfBranches();
+    for ( int ib = 0; ib < branches->GetEntries(); ++ib )
+    {
+        auto branch = static_cast< TBranch * >( branches->At( ib ) );
+        TObjArray * leaves = branch->GetListOfLeaves();
+        auto leaf = leaves->GetEntries() == 1 ? static_cast< TLeaf * >( leaves->At( 0 ) ) : nullptr;
+        Column c;
+        c.name = branch->GetName();
+        c.type = leaf ? leaf->GetTypeName() : "";
+        c.size = type_size( c.type );
+        c.len = leaf ? leaf->GetLenStatic() : 0;
+        if ( !leaf || leaf->GetLeafCount() || c.size == 0 )
+        {
+            std::cerr << "OutputMerger::MergeRunTree - " << m_run_tree << "." << c.name << " is not a fixed size leaf, can not reduce" << std::endl;
+            return false;
+        }
+        c.reduce = GetReduce( c.name );
+        c.data.assign( static_cast< std::size_t >( c.len ) * c.size, 0 );
+        columns.push_back( c );
+    }
+    for ( auto & c : columns )
+    {
+        chain.SetBranchAddress( c.name.c_str(), c.data.data() );
+    }
+
+    int ikey = -1;
+    for ( std::size_t ic = 0; ic < columns.size(); ++ic )
+    {
+        if ( columns[ic].name == m_run_key ) { ikey = ic; }
+    }
+
+    // runs in order of first appearance
+    std::vector< uint64_t > runs;
+    std::map< uint64_t, RunGroup > groups;
+    const Long64_t nentries = chain.GetEntries();
+    for ( Long64_t i = 0; i < nentries; ++i )
+    {
+        if ( chain.GetEntry( i ) <= 0 ) { continue; }
+        const uint64_t run = ikey >= 0 ? get_int( columns[ikey], 0 ) : 0;
+        auto it = groups.find( run );
+        const bool first = it == groups.end();
+        if ( first )
+        {
+            runs.push_back( run );
+            it = groups.emplace( run, RunGroup() ).first;
+            it->second.first.resize( columns.size() );
+            it->second.isum.resize( columns.size() );
+            it->second.fval.resize( columns.size() );
+        }
+        RunGroup & g = it->second;
+
+        for ( std::size_t ic = 0; ic < columns.size(); ++ic )
+        {
+            Column & c = columns[ic];
+            if ( first )
+            {
+                g.first[ic] = c.data;
+                g.isum[ic].resize( c.len );
+                g.fval[ic].resize( c.len );
+                for ( int k = 0; k < c.len; ++k )
+                {
+                    g.isum[ic][k] = is_float( c.type ) ? 0 : get_int( c, k );
+                    g.fval[ic][k] = is_float( c.type ) ? get_float( c, k ) : int_value( c, get_int( c, k ) );
+                }
+                continue;
+            }
+
+            if ( c.reduce == kFirst )
+            {
+                if ( g.first[ic] != c.data && !c.warned && static_cast< int >( ic ) != ikey )
+                {
+                    std::cout << "OutputMerger::MergeRunTree - " << c.name << " differs between inputs, keeping the first value" << std::endl;
+                    c.warned = true;
+                }
+                continue;
+            }
+
+            for ( int k = 0; k < c.len; ++k )
+            {
+                const uint64_t iv = is_float( c.type ) ? 0 : get_int( c, k );
+                const double fv = is_float( c.type ) ? get_float( c, k ) : int_value( c, iv );
+                switch ( c.reduce )
+                {
+                case kSum: g.isum[ic][k] += iv; g.fval[ic][k] += fv; break;
+                case kOr: g.isum[ic][k] |= iv; g.fval[ic][k] = ( g.fval[ic][k] != 0 || fv != 0 ) ? 1 : 0; break;
+                case kMin: if ( fv < g.fval[ic][k] ) { g.isum[ic][k] = iv; g.fval[ic][k] = fv; } break;
+                case kMax: if ( fv > g.fval[ic][k] ) { g.isum[ic][k] = iv; g.fval[ic][k] = fv; } break;
+                default: break;
+                }
+            }
+        }
+    }
+
+    TTree * merged = chain.CloneTree( 0 );
+    for ( const auto run : runs )
+    {
+        const RunGroup & g = groups[run];
+        for ( std::size_t ic = 0; ic < columns.size(); ++ic )
+        {
+            Column & c = columns[ic];
+            c.data = g.first[ic];
+            if ( c.reduce == kFirst ) { continue; }
+            for ( int k = 0; k < c.len; ++k )
+            {
+                set_value( c, k, g.isum[ic][k], g.fval[ic][k] );
+            }
+        }
+        // data may have been reallocated by the copy above
+        for ( auto & c : columns )
+        {
+            merged->SetBranchAddress( c.name.c_str(), c.data.data() );
+        }
+        merged->Fill();
+    }
+
+    if ( m_verbosity > 0 )
+    {
+        std::cout << "OutputMerger::MergeRunTree - " << nentries << " " << m_run_tree << " entries reduced to " << runs.size() << std::endl;
+    }
+    merged->Write( "", TObject::kOverwrite );
+    chain.ResetBranchAddresses();
+    return true;
+}
@@ -0,0 +1,88 @@
+#ifndef _OUTPUTMERGER_H_
+#define _OUTPUTMERGER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Merges TreeWriter / AnaTreeWriter job outputs.
+//
+// - RunTree: one entry per run_number (one entry in total without that
+//   branch). Counters are reduced per branch, see SetReduce(). Defaults
+//   are: num_events, weight and the run_scalars_* arrays summed (as in
+//   AnaUtils::mergeOutputs), active_triggers OR'ed, anything else taken
+//   from the first input of the run.
+// - Trees with <tree>_entry branches (the AnaTreeWriter event tree) are
+//   copied entry by entry with the links shifted by the entries of <tree>
+//   in the preceding inputs, so they still point at the right entry.
+// - All other trees are concatenated with TChain::Merge, cloning baskets
+//   without unzipping when every input has the same compression settings.
+// - Parts of a checkpointed job ( <stem>_resume<N>.root ) keep only the
+//   entries committed in the <stem>.root.ckpt sidecar next to them, see
+//   TreeCheckpoint. A part killed between AutoSave and its record holds
+//   events the resumed part wrote again, those trees are copied entry by
+//   entry. Without the sidecar the parts are merged as they are.
+// - TTreeIndex objects found in the first input are rebuilt on the merged
+//   trees. AnaTreeWriter indexes on ( run_number, evt_sequence ), which is
+//   unique across jobs, indexes on event_id alone are dropped.
+//
+// With more than one worker the inputs are split into contiguous groups
+// merged by forked processes, the partial files are merged afterwards.
+// All steps are associative so the result does not depend on the number
+// of workers.
+class OutputMerger
+{
+  public:
+
+    enum REDUCE
+    {
+        kFirst = 0,
+        kSum = 1,
+        kOr = 2,
+        kMin = 3,
+        kMax = 4
+    };
+
+    OutputMerger( const std::string & output );
+    ~OutputMerger() {}
+
+    void AddInput( const std::string & input ) { m_inputs.push_back( input ); }
+    void AddInputs( const std::vector< std::string > & inputs ) { m_inputs.insert( m_inputs.end(), inputs.begin(), inputs.end() ); }
+
+    void SetRunTree( const std::string & name ) { m_run_tree = name; }
+    void SetRunKey( const std::string & branch ) { m_run_key = branch; }
+    // reduction of a RunTree branch, prefix* matches every branch starting with prefix
+    void SetReduce( const std::string & branch, const REDUCE reduce ) { m_reduce[branch] = reduce; }
+    void ClearReduce() { m_reduce.clear(); }
+
+    void SetNWorkers( const unsigned int n ) { m_nworkers = n; } // 0 = number of cores
+    void SetFastClone( const bool fast ) { m_fast = fast; }
+    void SetVerbosity( const int v ) { m_verbosity = v; }
+
+    bool Merge();
+
+  private:
+
+    std::string m_output {};
+    std::vector< std::string > m_inputs {};
+
+    std::string m_run_tree { "RunTree" };
+    std::string m_run_key { "run_number" };
+    std::map< std::string, REDUCE > m_reduce {};
+
+    unsigned int m_nworkers { 1 };
+    bool m_fast { true };
+    int m_verbosity { 0 };
+
+    REDUCE GetReduce( const std::string & branch ) const;
+
+    bool MergeGroup( const std::vector< std::string > & inputs, const std::string & output ) const;
+    // entry by entry copy, shifting links and dropping the entries of
+    // input i past limit[i] ( -1 keeps all )
+    bool MergeByEntry( const std::vector< std::string > & inputs, const std::string & tree_name,
+                       const std::map< std::string, std::vector< long long > > & offsets,
+                       const std::vector< long long > & limit ) const;
+    bool MergeRunTree( const std::vector< std::string > & inputs ) const;
+};
+
+#endif // _OUTPUTMERGER_H_
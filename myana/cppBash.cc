@@ -1,13 +1,246 @@
 #include "cppBash.h"
+#include <algorithm>
 #include <array>
+#include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <glob.h>
+#include <locale.h>
+#include <regex.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Everything except exec() and runCommand() is done natively with
+// std::filesystem and POSIX calls, no shell is forked. Outputs are the
+// ones the coreutils commands printed and every case where the command
+// returned non-zero still throws. Paths are taken literally apart from
+// glob patterns, which are expanded like the shell did (sorted, left as
+// is when nothing matches). ls and find options that are not handled
+// natively fall back to the shell versions below.
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::string errno_str(const int err)
+    {
+        return std::string(std::strerror(err));
+    }
+
+    bool has_glob(const std::string& s)
+    {
+        return s.find_first_of("*?[") != std::string::npos;
+    }
+
+    // shell style pathname expansion of one word
+    std::vector<std::string> expand(const std::string& pattern)
+    {
+        if (!has_glob(pattern))
+        {
+            return {pattern};
+        }
+
+        glob_t g{};
+        std::vector<std::string> out;
+        if (glob(pattern.c_str(), 0, nullptr, &g) == 0)
+        {
+            for (std::size_t i = 0; i < g.gl_pathc; ++i)
+            {
+                out.emplace_back(g.gl_pathv[i]);
+            }
+        }
+        globfree(&g);
+
+        if (out.empty())
+        {
+            out.push_back(pattern);
+        }
+        return out;
+    }
+
+    std::vector<std::string> split_words(const std::string& s)
+    {
+        std::vector<std::string> out;
+        std::istringstream iss(s);
+        for (std::string w; iss >> w;)
+        {
+            out.push_back(w);
+        }
+        return out;
+    }
+
+    // name ordering of ls, which collates with the user locale
+    bool collate_less(const std::string& a, const std::string& b)
+    {
+        static locale_t loc = newlocale(LC_COLLATE_MASK, "", static_cast<locale_t>(0));
+        if (loc == static_cast<locale_t>(0))
+        {
+            return a < b;
+        }
+        const int c = strcoll_l(a.c_str(), b.c_str(), loc);
+        return c != 0 ? c < 0 : a < b;
+    }
 
+    std::vector<std::string> read_lines(const std::string& filename, const std::string& cmd)
+    {
+        std::error_code ec;
+        if (fs::is_directory(filename, ec))
+        {
+            throw std::runtime_error(cmd + ": " + filename + ": Is a directory");
+        }
+
+        std::ifstream ifs(filename);
+        if (!ifs)
+        {
+            throw std::runtime_error(cmd + ": " + filename + ": " + errno_str(errno));
+        }
+
+        std::vector<std::string> out;
+        for (std::string line; std::getline(ifs, line);)
+        {
+            out.push_back(line);
+        }
+        return out;
+    }
+
+    // ----------------------------------
+    // shell fall backs
+    // ----------------------------------
+    std::vector<std::string> shell_lines(const std::string& cmd, const std::string& name)
+    {
+        std::string result;
+        int rc = cppBash::exec(cmd, result);
+        if (rc != 0)
+        {
+            throw std::runtime_error(name + " command failed with return code " + std::to_string(rc));
+        }
+        return cppBash::parseLines(result);
+    }
+
+    // ----------------------------------
+    // ls
+    // ----------------------------------
+    struct LsOptions
+    {
+        bool all{false};       // -a
+        bool almost_all{false}; // -A
+        bool directory{false}; // -d
+        bool reverse{false};   // -r
+        bool by_time{false};   // -t
+        bool by_size{false};   // -S
+    };
+
+    // false if kwargs holds anything not handled natively
+    bool parse_ls_options(const std::string& kwargs, LsOptions& opt)
+    {
+        for (const auto& w : split_words(kwargs))
+        {
+            if (w.size() < 2 || w[0] != '-' || w[1] == '-')
+            {
+                return false;
+            }
+            for (std::size_t i = 1; i < w.size(); ++i)
+            {
+                switch (w[i])
+                {
+                case '1': break;
+                case 'a': opt.all = true; break;
+                case 'A': opt.almost_all = true; break;
+                case 'd': opt.directory = true; break;
+                case 'r': opt.reverse = true; break;
+                case 't': opt.by_time = true; break;
+                case 'S': opt.by_size = true; break;
+                default: return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    struct LsEntry
+    {
+        std::string name;
+        struct stat st;
+    };
+
+    void sort_ls(std::vector<LsEntry>& entries, const LsOptions& opt)
+    {
+        std::sort(entries.begin(), entries.end(), [&](const LsEntry& l, const LsEntry& r)
+        {
+            if (opt.by_size && !opt.by_time && l.st.st_size != r.st.st_size)
+            {
+                return l.st.st_size > r.st.st_size;
+            }
+            if (opt.by_time)
+            {
+                if (l.st.st_mtim.tv_sec != r.st.st_mtim.tv_sec)
+                {
+                    return l.st.st_mtim.tv_sec > r.st.st_mtim.tv_sec;
+                }
+                if (l.st.st_mtim.tv_nsec != r.st.st_mtim.tv_nsec)
+                {
+                    return l.st.st_mtim.tv_nsec > r.st.st_mtim.tv_nsec;
+                }
+            }
+            return collate_less(l.name, r.name);
+        });
+        if (opt.reverse)
+        {
+            std::reverse(entries.begin(), entries.end());
+        }
+    }
+
+    std::vector<std::string> list_dir(const std::string& dir, const LsOptions& opt)
+    {
+        std::vector<LsEntry> entries;
+        if (opt.all)
+        {
+            for (const char* dot : {".", ".."})
+            {
+                LsEntry e{dot, {}};
+                stat((dir + "/" + dot).c_str(), &e.st);
+                entries.push_back(e);
+            }
+        }
+
+        std::error_code ec;
+        for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+        {
+            std::string name = it->path().filename().string();
+            if (name[0] == '.' && !opt.all && !opt.almost_all)
+            {
+                continue;
+            }
+            LsEntry e{name, {}};
+            lstat(it->path().c_str(), &e.st);
+            entries.push_back(e);
+        }
+        if (ec)
+        {
+            throw std::runtime_error("ls: cannot open directory '" + dir + "': " + ec.message());
+        }
+
+        sort_ls(entries, opt);
+        std::vector<std::string> out;
+        for (const auto& e : entries)
+        {
+            out.push_back(e.name);
+        }
+        return out;
+    }
+} // namespace
 
 int cppBash::exec(const std::string& cmd, std::string& result)
 {
@@ -44,13 +277,37 @@ std::vector<std::string> cppBash::parseLines(const std::string& s)
 
 std::string cppBash::realpath_str(const std::string& path)
 {
-    std::string cmd = "realpath " + path;
+    if (path.empty())
+    {
+        throw std::runtime_error("realpath: missing operand");
+    }
 
+    // like realpath(1) every component but the last has to exist
     std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    char* resolved = ::realpath(path.c_str(), nullptr);
+    if (resolved)
     {
-        throw std::runtime_error("realpath command failed with return code " + std::to_string(rc));
+        result = resolved;
+        free(resolved);
+    }
+    else
+    {
+        const int err = errno;
+        const fs::path p(path);
+        std::error_code ec;
+        const fs::path leaf = p.filename();
+        if (err != ENOENT || leaf.empty() || leaf == "." || leaf == ".." || fs::is_symlink(p, ec))
+        {
+            throw std::runtime_error("realpath: " + path + ": " + errno_str(err));
+        }
+        const fs::path parent = p.has_parent_path() ? p.parent_path() : fs::path(".");
+        char* resolved_parent = ::realpath(parent.c_str(), nullptr);
+        if (!resolved_parent)
+        {
+            throw std::runtime_error("realpath: " + path + ": " + errno_str(errno));
+        }
+        result = (fs::path(resolved_parent) / leaf).string();
+        free(resolved_parent);
     }
 
     auto pos = result.find("/sphenix");
@@ -59,12 +316,6 @@ std::string cppBash::realpath_str(const std::string& path)
         result = result.substr(pos);
     }
 
-    // remove trailing newline
-    if (!result.empty() && result.back() == '\n')
-    {
-        result.pop_back();
-    }
-
     return result;
 }
 
@@ -74,27 +325,64 @@ std::string cppBash::realpath_str(const std::string& path)
 std::vector<std::string> cppBash::ls(const std::string& dir,
                                    const std::string& kwargs )
 {
-    std::string cmd = "ls ";
-    if (!kwargs.empty())
+    LsOptions opt;
+    if (!parse_ls_options(kwargs, opt))
     {
-        cmd += kwargs + " ";
+        std::string cmd = "ls " + kwargs + " " + dir;
+        auto lines = shell_lines(cmd, "ls");
+        lines.erase(std::remove(lines.begin(), lines.end(), std::string()), lines.end());
+        return lines;
     }
-    cmd += dir;
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    // operands: files (and -d directories) first, then each directory
+    std::vector<LsEntry> files;
+    std::vector<LsEntry> dirs;
+    std::string missing;
+    const auto operands = expand(dir.empty() ? std::string(".") : dir);
+    for (const auto& operand : operands)
     {
-        throw std::runtime_error("ls command failed with return code " + std::to_string(rc));
+        LsEntry e{operand, {}};
+        if (lstat(operand.c_str(), &e.st) != 0)
+        {
+            missing = operand;
+            continue;
+        }
+        // symlinks to directories are followed when given as operands
+        struct stat target{};
+        const bool is_dir = S_ISDIR(e.st.st_mode) || (S_ISLNK(e.st.st_mode) && stat(operand.c_str(), &target) == 0 && S_ISDIR(target.st_mode));
+        if (is_dir && !opt.directory)
+        {
+            dirs.push_back(e);
+        }
+        else
+        {
+            files.push_back(e);
+        }
     }
 
-    auto lines = parseLines(result);
+    sort_ls(files, opt);
+    sort_ls(dirs, opt);
+
     std::vector<std::string> out;
+    for (const auto& f : files)
+    {
+        out.push_back(f.name);
+    }
+    for (const auto& d : dirs)
+    {
+        if (operands.size() > 1)
+        {
+            out.push_back(d.name + ":");
+        }
+        for (auto& name : list_dir(d.name, opt))
+        {
+            out.push_back(std::move(name));
+        }
+    }
 
-    for (const auto& line : lines)
+    if (!missing.empty())
     {
-        if (line.empty()) continue;
-        out.push_back(line);
+        throw std::runtime_error("ls: cannot access '" + missing + "': No such file or directory");
     }
 
     return out;
@@ -105,18 +393,23 @@ std::vector<std::string> cppBash::ls(const std::string& dir,
 // ----------------------------------
 void cppBash::mkdir_p(const std::string& dir, bool p )
 {
-    std::string cmd = "mkdir ";
+    std::error_code ec;
     if (p)
     {
-        cmd += "-p ";
+        fs::create_directories(dir, ec);
+        if (!ec && !fs::is_directory(dir))
+        {
+            ec = std::make_error_code(std::errc::file_exists);
+        }
+    }
+    else if (!fs::create_directory(dir, ec) && !ec)
+    {
+        ec = std::make_error_code(std::errc::file_exists);
     }
-    cmd += dir;
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    if (ec)
     {
-        throw std::runtime_error("mkdir command failed with return code " + std::to_string(rc));
+        throw std::runtime_error("mkdir: cannot create directory '" + dir + "': " + ec.message());
     }
 }
 
@@ -125,51 +418,135 @@ void cppBash::mkdir_p(const std::string& dir, bool p )
 // ----------------------------------
 void cppBash::cp(const std::string& src, const std::string& dst, bool recursive )
 {
-    std::string cmd = "cp ";
-    if (recursive)
+    const auto sources = expand(src);
+    std::error_code ec;
+    const bool dst_is_dir = fs::is_directory(dst, ec);
+    if (sources.size() > 1 && !dst_is_dir)
     {
-        cmd += "-r ";
+        throw std::runtime_error("cp: target '" + dst + "' is not a directory");
     }
-    cmd += src + " " + dst;
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    std::string failed;
+    for (const auto& s : sources)
     {
-        throw std::runtime_error("cp command failed with return code " + std::to_string(rc));
+        const fs::path from(s);
+        fs::path to(dst);
+        if (dst_is_dir)
+        {
+            to /= from.filename();
+        }
+
+        ec.clear();
+        if (fs::is_directory(from, ec))
+        {
+            if (!recursive)
+            {
+                failed = "cp: -r not specified; omitting directory '" + s + "'";
+                continue;
+            }
+            fs::copy(from, to, fs::copy_options::recursive | fs::copy_options::overwrite_existing, ec);
+        }
+        else
+        {
+            fs::copy_file(from, to, fs::copy_options::overwrite_existing, ec);
+        }
+
+        if (ec)
+        {
+            failed = "cp: cannot copy '" + s + "' to '" + to.string() + "': " + ec.message();
+        }
+    }
+
+    if (!failed.empty())
+    {
+        throw std::runtime_error(failed);
     }
 }
 
 void cppBash::mv(const std::string& src, const std::string& dst)
 {
-    std::string cmd = "mv " + src + " " + dst;
+    const auto sources = expand(src);
+    std::error_code ec;
+    const bool dst_is_dir = fs::is_directory(dst, ec);
+    if (sources.size() > 1 && !dst_is_dir)
+    {
+        throw std::runtime_error("mv: target '" + dst + "' is not a directory");
+    }
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    std::string failed;
+    for (const auto& s : sources)
+    {
+        const fs::path from(s);
+        fs::path to(dst);
+        if (dst_is_dir)
+        {
+            to /= from.filename();
+        }
+
+        ec.clear();
+        fs::rename(from, to, ec);
+        if (ec == std::errc::cross_device_link)
+        {
+            // different file systems, copy then remove like mv does
+            ec.clear();
+            fs::copy(from, to, fs::copy_options::recursive | fs::copy_options::overwrite_existing | fs::copy_options::copy_symlinks, ec);
+            if (!ec)
+            {
+                fs::remove_all(from, ec);
+            }
+        }
+
+        if (ec)
+        {
+            failed = "mv: cannot move '" + s + "' to '" + to.string() + "': " + ec.message();
+        }
+    }
+
+    if (!failed.empty())
     {
-        throw std::runtime_error("mv command failed with return code " + std::to_string(rc));
+        throw std::runtime_error(failed);
     }
 }
 
 void cppBash::rm(const std::string& target, bool recursive , bool force )
 {
-    std::string cmd = "rm ";
-    if (recursive)
+    std::string failed;
+    for (const auto& t : expand(target))
     {
-        cmd += "-r ";
-    }
-    if (force)
-    {
-        cmd += "-f ";
+        std::error_code ec;
+        const auto st = fs::symlink_status(t, ec);
+        if (!fs::exists(st))
+        {
+            if (!force)
+            {
+                failed = "rm: cannot remove '" + t + "': No such file or directory";
+            }
+            continue;
+        }
+
+        if (fs::is_directory(st))
+        {
+            if (!recursive)
+            {
+                failed = "rm: cannot remove '" + t + "': Is a directory";
+                continue;
+            }
+            fs::remove_all(t, ec);
+        }
+        else
+        {
+            fs::remove(t, ec);
+        }
+
+        if (ec)
+        {
+            failed = "rm: cannot remove '" + t + "': " + ec.message();
+        }
     }
-    cmd += target;
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    if (!failed.empty())
     {
-        throw std::runtime_error("rm command failed with return code " + std::to_string(rc));
+        throw std::runtime_error(failed);
     }
 }
 
@@ -180,21 +557,116 @@ std::vector<std::string> cppBash::find(const std::string& root,
                                      const std::string& args,
                                      const std::string& name_pattern)
 {
-    std::string cmd = "find " + root;
-    if (!args.empty())
+    // natively: -maxdepth N, -mindepth N, -type f|d|l
+    int maxdepth = -1;
+    int mindepth = 0;
+    char type = 0;
+    bool native = true;
+    const auto words = split_words(args);
+    for (std::size_t i = 0; i < words.size() && native; ++i)
+    {
+        const bool has_value = i + 1 < words.size();
+        if (words[i] == "-maxdepth" && has_value)
+        {
+            maxdepth = std::atoi(words[++i].c_str());
+        }
+        else if (words[i] == "-mindepth" && has_value)
+        {
+            mindepth = std::atoi(words[++i].c_str());
+        }
+        else if (words[i] == "-type" && has_value && words[i + 1].size() == 1 && std::strchr("fdl", words[i + 1][0]))
+        {
+            type = words[++i][0];
+        }
+        else
+        {
+            native = false;
+        }
+    }
+
+    if (!native)
     {
-        cmd += " " + args;
+        std::string cmd = "find " + root + " " + args + " -name \"" + name_pattern + "\"";
+        return shell_lines(cmd, "find");
     }
-    cmd += " -name \"" + name_pattern + "\"";
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    auto matches = [&](const fs::path& p, const fs::file_status& st, const int depth)
     {
-        throw std::runtime_error("find command failed with return code " + std::to_string(rc));
+        if (depth < mindepth)
+        {
+            return false;
+        }
+        if ((type == 'f' && !fs::is_regular_file(st)) ||
+            (type == 'd' && !fs::is_directory(st)) ||
+            (type == 'l' && !fs::is_symlink(st)))
+        {
+            return false;
+        }
+        // -name looks at the last component, trailing slashes ignored
+        std::string name = p.string();
+        while (name.size() > 1 && name.back() == '/')
+        {
+            name.pop_back();
+        }
+        const auto slash = name.find_last_of('/');
+        if (slash != std::string::npos && name.size() > 1)
+        {
+            name = name.substr(slash + 1);
+        }
+        return fnmatch(name_pattern.c_str(), name.c_str(), 0) == 0;
+    };
+
+    // pre-order walk in directory order, which is the order find prints
+    std::vector<std::string> out;
+    std::string failed;
+    for (const auto& start : expand(root))
+    {
+        std::error_code ec;
+        const auto st = fs::symlink_status(start, ec);
+        if (!fs::exists(st))
+        {
+            failed = "find: '" + start + "': No such file or directory";
+            continue;
+        }
+        if (matches(start, st, 0))
+        {
+            out.push_back(start);
+        }
+        if (!fs::is_directory(st) || maxdepth == 0)
+        {
+            continue;
+        }
+
+        fs::recursive_directory_iterator it(start, ec), end;
+        for (; !ec && it != end; it.increment(ec))
+        {
+            const int depth = it.depth() + 1;
+            const auto entry_st = it->symlink_status(ec);
+            if (ec)
+            {
+                break;
+            }
+            if (matches(it->path(), entry_st, depth))
+            {
+                out.push_back(it->path().string());
+            }
+            if (maxdepth >= 0 && depth >= maxdepth)
+            {
+                it.disable_recursion_pending();
+            }
+        }
+        if (ec)
+        {
+            failed = "find: '" + start + "': " + ec.message();
+        }
     }
 
-    return parseLines(result);
+    if (!failed.empty())
+    {
+        throw std::runtime_error(failed);
+    }
+
+    return out;
 }
 
 // ----------------------------------
@@ -202,21 +674,14 @@ std::vector<std::string> cppBash::find(const std::string& root,
 // ----------------------------------
 std::string cppBash::pwd()
 {
-    std::string cmd = "pwd";
-
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
-    {
-        throw std::runtime_error("pwd command failed with return code " + std::to_string(rc));
-    }
-
-    if (!result.empty() && result.back() == '\n')
+    std::error_code ec;
+    const auto cwd = fs::current_path(ec);
+    if (ec)
     {
-        result.pop_back();
+        throw std::runtime_error("pwd: " + ec.message());
     }
 
-    return realpath_str(result);
+    return realpath_str(cwd.string());
 }
 
 // ----------------------------------
@@ -224,66 +689,99 @@ std::string cppBash::pwd()
 // ----------------------------------
 std::vector<std::string> cppBash::cat(const std::string& filename)
 {
-    std::string cmd = "cat " + filename;
-
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    std::vector<std::string> out;
+    for (const auto& f : expand(filename))
     {
-        throw std::runtime_error("cat command failed with return code " + std::to_string(rc));
+        auto lines = read_lines(f, "cat");
+        out.insert(out.end(), lines.begin(), lines.end());
     }
-
-    return parseLines(result);
+    return out;
 }
 
 std::vector<std::string> cppBash::head(const std::string& filename, std::size_t nlines)
 {
-    std::string cmd = "head -n " + std::to_string(nlines) + " " + filename;
-
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    const auto files = expand(filename);
+    std::vector<std::string> out;
+    for (std::size_t i = 0; i < files.size(); ++i)
     {
-        throw std::runtime_error("head command failed with return code " + std::to_string(rc));
+        if (files.size() > 1)
+        {
+            if (i > 0)
+            {
+                out.emplace_back();
+            }
+            out.push_back("==> " + files[i] + " <==");
+        }
+        if (nlines == 0)
+        {
+            // opened but never read, so directories pass
+            if (!std::ifstream(files[i]))
+            {
+                throw std::runtime_error("head: cannot open '" + files[i] + "' for reading: " + errno_str(errno));
+            }
+            continue;
+        }
+        auto lines = read_lines(files[i], "head");
+        lines.resize(std::min(nlines, lines.size()));
+        out.insert(out.end(), lines.begin(), lines.end());
     }
-    return parseLines(result);
+    return out;
 }
 
 std::vector<std::string> cppBash::tail(const std::string& filename, std::size_t nlines)
 {
-    std::string cmd = "tail -n " + std::to_string(nlines) + " " + filename;
+    // tail -n 0 does not even open its files
+    if (nlines == 0)
+    {
+        return {};
+    }
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    const auto files = expand(filename);
+    std::vector<std::string> out;
+    for (std::size_t i = 0; i < files.size(); ++i)
     {
-        throw std::runtime_error("tail command failed with return code " + std::to_string(rc));
+        if (files.size() > 1)
+        {
+            if (i > 0)
+            {
+                out.emplace_back();
+            }
+            out.push_back("==> " + files[i] + " <==");
+        }
+        auto lines = read_lines(files[i], "tail");
+        const std::size_t skip = lines.size() > nlines ? lines.size() - nlines : 0;
+        out.insert(out.end(), lines.begin() + skip, lines.end());
     }
-    return parseLines(result);
+    return out;
 }
 
 void cppBash::touch(const std::string& filename)
 {
-    std::string cmd = "touch " + filename;
-
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    for (const auto& f : expand(filename))
     {
-        throw std::runtime_error("touch command failed with return code " + std::to_string(rc));
+        int fd = open(f.c_str(), O_WRONLY | O_CREAT | O_NOCTTY, 0666);
+        if (fd < 0 && errno != EISDIR)
+        {
+            throw std::runtime_error("touch: cannot touch '" + f + "': " + errno_str(errno));
+        }
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        if (utimensat(AT_FDCWD, f.c_str(), nullptr, 0) != 0)
+        {
+            throw std::runtime_error("touch: setting times of '" + f + "': " + errno_str(errno));
+        }
     }
 }
 
 void cppBash::sleep(const int seconds)
 {
-    std::string cmd = "sleep " + std::to_string(seconds);
-
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    if (seconds < 0)
     {
-        throw std::runtime_error("sleep command failed with return code " + std::to_string(rc));
+        throw std::runtime_error("sleep: invalid time interval '" + std::to_string(seconds) + "'");
     }
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
 }
 
 void cppBash::append(const std::string& filename, const std::string& content)
@@ -314,7 +812,7 @@ void cppBash::prepend(const std::string& filename, const std::string& content)
     }
     ofs << content << existing_content;
     ofs.close();
-}   
+}
 void cppBash::write(const std::string& filename, const std::string& content)
 {
     std::ofstream ofs(filename);
@@ -332,20 +830,40 @@ void cppBash::write(const std::string& filename, const std::string& content)
 // ----------------------------------
 std::string cppBash::date(const std::string& format )
 {
-    std::string cmd = "date '" + format + "'";
+    // only "+FORMAT" prints, anything else would try to set the clock.
+    // %N is not known to strftime, leave it to date(1)
+    if (format.empty() || format[0] != '+' || format.find("%N") != std::string::npos)
+    {
+        auto lines = shell_lines("date '" + format + "'", "date");
+        return lines.empty() ? std::string() : lines.front();
+    }
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    static locale_t loc = newlocale(LC_TIME_MASK, "", static_cast<locale_t>(0));
+    const std::time_t now = std::time(nullptr);
+    std::tm tm{};
+    localtime_r(&now, &tm);
+
+    const std::string fmt = format.substr(1);
+    std::vector<char> buffer(256 + 4 * fmt.size());
+    // strftime returns 0 both for an empty result and a short buffer
+    std::size_t n = 0;
+    for (int attempt = 0; attempt < 4; ++attempt)
     {
-        throw std::runtime_error("date command failed with return code " + std::to_string(rc));
+        n = loc != static_cast<locale_t>(0) ? strftime_l(buffer.data(), buffer.size(), fmt.c_str(), &tm, loc)
+                                            : std::strftime(buffer.data(), buffer.size(), fmt.c_str(), &tm);
+        if (n > 0 || fmt.empty())
+        {
+            break;
+        }
+        buffer.resize(buffer.size() * 4);
     }
 
+    std::string result(buffer.data(), n);
+    // date prints one line, the trailing newline was dropped
     if (!result.empty() && result.back() == '\n')
     {
         result.pop_back();
     }
-
     return result;
 }
 
@@ -355,16 +873,49 @@ std::string cppBash::date(const std::string& format )
 std::vector<std::string> cppBash::grep(const std::string& filename,
                                      const std::string& needle)
 {
-    std::string cmd = "grep '" + needle + "' " + filename;
+    // grep's default syntax is POSIX basic regular expressions
+    regex_t re;
+    if (regcomp(&re, needle.c_str(), REG_NOSUB) != 0)
+    {
+        throw std::runtime_error("grep: invalid regular expression '" + needle + "'");
+    }
 
-    std::string result;
-    int rc = exec(cmd, result);
-    if (rc != 0)
+    const auto files = expand(filename);
+    std::vector<std::string> out;
+    std::string failed;
+    for (const auto& f : files)
     {
-        throw std::runtime_error("grep command failed with return code " + std::to_string(rc));
+        std::vector<std::string> lines;
+        try
+        {
+            lines = read_lines(f, "grep");
+        }
+        catch (const std::runtime_error& e)
+        {
+            failed = e.what();
+            continue;
+        }
+        for (const auto& line : lines)
+        {
+            if (regexec(&re, line.c_str(), 0, nullptr, 0) == 0)
+            {
+                out.push_back(files.size() > 1 ? f + ":" + line : line);
+            }
+        }
+    }
+    regfree(&re);
+
+    // grep returns 1 without a match and 2 on errors
+    if (!failed.empty())
+    {
+        throw std::runtime_error(failed);
+    }
+    if (out.empty())
+    {
+        throw std::runtime_error("grep command failed with return code 1");
     }
 
-    return parseLines(result);
+    return out;
 }
 
 // ----------------------------------
@@ -451,4 +1002,3 @@ std::string cppBash::dirname(const std::string& path)
     std::string dir = p.parent_path().string();
     return realpath_str(dir);
 }
-
@@ -7,6 +7,8 @@
 namespace cppBash {
 // ----------------------------------
 // core exec
+// only exec() and runCommand() go through the shell, the other helpers
+// are native and throw wherever the command would have failed
 // ----------------------------------
 int exec(const std::string& cmd, std::string& result);
 
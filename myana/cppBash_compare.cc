@@ -0,0 +1,368 @@
+// Compares the native cppBash helpers against the shell commands they
+// replaced, on a scratch tree whose paths hold spaces and quotes.
+// Read only helpers are compared line by line ( and on whether they
+// throw ), then timed per call. The mutating helpers run on two copies
+// of a tree, one per version, and the resulting trees are compared.
+//
+//   cppBash_compare [-n NCALLS] [-v]
+//
+// returns the number of mismatches, 0 when every case agrees
+
+#include "cppBash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct Outcome
+    {
+        bool threw{false};
+        std::vector<std::string> lines;
+    };
+
+    // single quote a word for sh, ' becomes '\''
+    std::string quote(const std::string& s)
+    {
+        std::string out = "'";
+        for (const char c : s)
+        {
+            out += (c == '\'') ? std::string("'\\''") : std::string(1, c);
+        }
+        return out + "'";
+    }
+
+    Outcome run_native(const std::function<std::vector<std::string>()>& f)
+    {
+        Outcome o;
+        try
+        {
+            o.lines = f();
+        }
+        catch (const std::exception&)
+        {
+            o.threw = true;
+        }
+        return o;
+    }
+
+    // the command the old helper built, with the operands quoted
+    Outcome run_shell(const std::string& cmd, const bool drop_empty = false)
+    {
+        Outcome o;
+        std::string result;
+        o.threw = cppBash::exec(cmd + " 2>/dev/null", result) != 0;
+        if (!o.threw)
+        {
+            o.lines = cppBash::parseLines(result);
+        }
+        if (drop_empty)
+        {
+            std::vector<std::string> kept;
+            for (auto& line : o.lines)
+            {
+                if (!line.empty())
+                {
+                    kept.push_back(std::move(line));
+                }
+            }
+            o.lines = std::move(kept);
+        }
+        return o;
+    }
+
+    void print_lines(const std::string& label, const Outcome& o)
+    {
+        std::cout << "    " << label << (o.threw ? " threw" : "") << std::endl;
+        for (const auto& line : o.lines)
+        {
+            std::cout << "      " << line << std::endl;
+        }
+    }
+
+    struct Case
+    {
+        std::string name;
+        std::function<std::vector<std::string>()> native;
+        std::string shell;
+        bool drop_empty{false};
+    };
+
+    // relative path, type and contents of every entry, sorted
+    std::vector<std::string> snapshot(const fs::path& root)
+    {
+        std::vector<std::string> out;
+        for (const auto& entry : fs::recursive_directory_iterator(root))
+        {
+            std::string line = fs::relative(entry.path(), root).string();
+            if (entry.is_directory())
+            {
+                line += "/";
+            }
+            else
+            {
+                std::ifstream ifs(entry.path());
+                std::stringstream ss;
+                ss << ifs.rdbuf();
+                line += " : " + ss.str();
+            }
+            out.push_back(line);
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    void write_file(const fs::path& p, const std::string& content)
+    {
+        std::ofstream ofs(p);
+        ofs << content;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int ncalls = 20;
+    int verbosity = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc)
+        {
+            ncalls = std::atoi(argv[++i]);
+        }
+        else if (arg == "-v")
+        {
+            verbosity++;
+        }
+        else
+        {
+            std::cout << "usage: " << argv[0] << " [-n NCALLS] [-v]" << std::endl;
+            return 1;
+        }
+    }
+
+    // scratch tree, every name needs quoting in a shell
+    std::string tmpl = (fs::temp_directory_path() / "cppBash_compare.XXXXXX").string();
+    if (!mkdtemp(tmpl.data()))
+    {
+        std::cout << "cppBash_compare: cannot create a scratch directory" << std::endl;
+        return 1;
+    }
+    const fs::path scratch(tmpl);
+    const fs::path top = scratch / "it's a \"odd\" dir";
+    fs::create_directories(top / "sub dir" / "deeper");
+    fs::create_directories(top / "empty dir");
+    write_file(top / "a.root", "a\n");
+    write_file(top / "b file.root", "");
+    write_file(top / "c'q.root", "quoted\n");
+    write_file(top / "d\"q.txt", "double quoted\n");
+    write_file(top / ".hidden", "hidden\n");
+    write_file(top / "sub dir" / "e.root", "e\n");
+    write_file(top / "sub dir" / "deeper" / "f.root", "f\n");
+    std::string notes;
+    for (int i = 0; i < 25; ++i)
+    {
+        notes += (i % 3 == 0 ? "alpha " : "beta ") + std::to_string(i) + (i % 5 == 0 ? " gamma a" : "") + "\n";
+    }
+    write_file(top / "notes.txt", notes);
+
+    const std::string T = top.string();
+    const std::string qT = quote(T);
+    const std::string notes_file = (top / "notes.txt").string();
+    const std::string quoted_file = (top / "c'q.root").string();
+    const std::string missing = (top / "missing file").string();
+
+    const std::vector<Case> cases = {
+        {"ls", [&] { return cppBash::ls(T); }, "ls " + qT, true},
+        {"ls -1", [&] { return cppBash::ls(T, "-1"); }, "ls -1 " + qT, true},
+        {"ls -a", [&] { return cppBash::ls(T, "-a"); }, "ls -a " + qT, true},
+        {"ls -A", [&] { return cppBash::ls(T, "-A"); }, "ls -A " + qT, true},
+        {"ls -r", [&] { return cppBash::ls(T, "-r"); }, "ls -r " + qT, true},
+        {"ls -d", [&] { return cppBash::ls(T, "-d"); }, "ls -d " + qT, true},
+        {"ls glob", [&] { return cppBash::ls(T + "/*.root"); }, "ls " + qT + "/*.root", true},
+        {"ls glob dirs", [&] { return cppBash::ls(T + "/*dir"); }, "ls " + qT + "/*dir", true},
+        {"ls glob no match", [&] { return cppBash::ls(T + "/*.none"); }, "ls " + qT + "/*.none", true},
+        {"ls file", [&] { return cppBash::ls(quoted_file); }, "ls " + quote(quoted_file), true},
+        {"ls missing", [&] { return cppBash::ls(missing); }, "ls " + quote(missing), true},
+        {"find", [&] { return cppBash::find(T); }, "find " + qT + " -name '*'"},
+        {"find *.root", [&] { return cppBash::find(T, "", "*.root"); }, "find " + qT + " -name '*.root'"},
+        {"find -maxdepth 1", [&] { return cppBash::find(T, "-maxdepth 1"); }, "find " + qT + " -maxdepth 1 -name '*'"},
+        {"find -mindepth 2", [&] { return cppBash::find(T, "-mindepth 2"); }, "find " + qT + " -mindepth 2 -name '*'"},
+        {"find -type f", [&] { return cppBash::find(T, "-type f", "*.root"); }, "find " + qT + " -type f -name '*.root'"},
+        {"find -type d", [&] { return cppBash::find(T, "-type d"); }, "find " + qT + " -type d -name '*'"},
+        {"find quoted name", [&] { return cppBash::find(T, "", "c'q*"); }, "find " + qT + " -name " + quote("c'q*")},
+        {"find missing", [&] { return cppBash::find(missing); }, "find " + quote(missing) + " -name '*'"},
+        {"cat", [&] { return cppBash::cat(notes_file); }, "cat " + quote(notes_file)},
+        {"cat quoted", [&] { return cppBash::cat(quoted_file); }, "cat " + quote(quoted_file)},
+        {"cat empty", [&] { return cppBash::cat(T + "/b file.root"); }, "cat " + quote(T + "/b file.root")},
+        {"cat missing", [&] { return cppBash::cat(missing); }, "cat " + quote(missing)},
+        {"cat directory", [&] { return cppBash::cat(T); }, "cat " + qT},
+        {"head", [&] { return cppBash::head(notes_file); }, "head -n 10 " + quote(notes_file)},
+        {"head 3", [&] { return cppBash::head(notes_file, 3); }, "head -n 3 " + quote(notes_file)},
+        {"head 100", [&] { return cppBash::head(notes_file, 100); }, "head -n 100 " + quote(notes_file)},
+        {"tail", [&] { return cppBash::tail(notes_file); }, "tail -n 10 " + quote(notes_file)},
+        {"tail 3", [&] { return cppBash::tail(notes_file, 3); }, "tail -n 3 " + quote(notes_file)},
+        {"grep", [&] { return cppBash::grep(notes_file, "alpha"); }, "grep alpha " + quote(notes_file)},
+        {"grep bre", [&] { return cppBash::grep(notes_file, "^b.* a$"); }, "grep " + quote("^b.* a$") + " " + quote(notes_file)},
+        {"grep quoted", [&] { return cppBash::grep(quoted_file, "quo"); }, "grep quo " + quote(quoted_file)},
+        {"grep no match", [&] { return cppBash::grep(notes_file, "delta"); }, "grep delta " + quote(notes_file)},
+        {"realpath", [&] { return std::vector<std::string>{cppBash::realpath_str(T)}; }, "realpath " + qT},
+        {"realpath ..", [&] { return std::vector<std::string>{cppBash::realpath_str(T + "/sub dir/../a.root")}; }, "realpath " + quote(T + "/sub dir/../a.root")},
+        {"realpath new leaf", [&] { return std::vector<std::string>{cppBash::realpath_str(missing)}; }, "realpath " + quote(missing)},
+        {"pwd", [&] { return std::vector<std::string>{cppBash::pwd()}; }, "realpath \"$(pwd)\""},
+        {"date", [&] { return std::vector<std::string>{cppBash::date("+%Y-%m-%d")}; }, "date +%Y-%m-%d"},
+    };
+
+    int nmismatch = 0;
+
+    std::cout << "================================================================================" << std::endl;
+    std::cout << " cppBash native vs shell, " << ncalls << " calls per case" << std::endl;
+    std::cout << " scratch " << T << std::endl;
+    std::cout << "--------------------------------------------------------------------------------" << std::endl;
+    std::cout << std::left << std::setw(24) << " case" << std::setw(10) << "result"
+              << std::right << std::setw(14) << "native us" << std::setw(14) << "shell us"
+              << std::setw(12) << "speedup" << std::endl;
+
+    double native_total = 0;
+    double shell_total = 0;
+    for (const auto& c : cases)
+    {
+        const Outcome native = run_native(c.native);
+        const Outcome shell = run_shell(c.shell, c.drop_empty);
+        const bool same = native.threw == shell.threw && (native.threw || native.lines == shell.lines);
+
+        auto time_us = [&](const std::function<void()>& f)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < ncalls; ++i)
+            {
+                f();
+            }
+            const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            return ncalls > 0 ? elapsed.count() / ncalls : 0.0;
+        };
+        const double native_us = time_us([&] { run_native(c.native); });
+        const double shell_us = time_us([&] { run_shell(c.shell, c.drop_empty); });
+        native_total += native_us;
+        shell_total += shell_us;
+
+        std::cout << std::left << std::setw(24) << " " + c.name << std::setw(10) << (same ? "ok" : "MISMATCH")
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << native_us << std::setw(14) << shell_us
+                  << std::setw(11) << (native_us > 0 ? shell_us / native_us : 0.0) << "x"
+                  << std::defaultfloat << std::endl;
+
+        if (!same || verbosity > 0)
+        {
+            std::cout << "    shell: " << c.shell << std::endl;
+            print_lines("native", native);
+            print_lines("shell", shell);
+        }
+        if (!same)
+        {
+            nmismatch++;
+        }
+    }
+
+    // mutating helpers, one tree per version
+    struct Op
+    {
+        std::string name;
+        std::function<void(const std::string&)> native;
+        std::function<std::string(const std::string&)> shell;
+    };
+
+    const std::vector<Op> ops = {
+        {"mkdir -p", [](const std::string& d) { cppBash::mkdir_p(d + "/new dir/a 'b'"); },
+         [](const std::string& d) { return "mkdir -p " + quote(d + "/new dir/a 'b'"); }},
+        {"mkdir existing", [](const std::string& d) { cppBash::mkdir_p(d + "/new dir", false); },
+         [](const std::string& d) { return "mkdir " + quote(d + "/new dir"); }},
+        {"touch", [](const std::string& d) { cppBash::touch(d + "/new dir/t'1.txt"); },
+         [](const std::string& d) { return "touch " + quote(d + "/new dir/t'1.txt"); }},
+        {"cp", [](const std::string& d) { cppBash::cp(d + "/src file.txt", d + "/new dir/copy \"1\".txt"); },
+         [](const std::string& d) { return "cp " + quote(d + "/src file.txt") + " " + quote(d + "/new dir/copy \"1\".txt"); }},
+        {"cp into dir", [](const std::string& d) { cppBash::cp(d + "/src file.txt", d + "/new dir/a 'b'"); },
+         [](const std::string& d) { return "cp " + quote(d + "/src file.txt") + " " + quote(d + "/new dir/a 'b'"); }},
+        {"cp dir", [](const std::string& d) { cppBash::cp(d + "/new dir", d + "/no r"); },
+         [](const std::string& d) { return "cp " + quote(d + "/new dir") + " " + quote(d + "/no r"); }},
+        {"cp -r", [](const std::string& d) { cppBash::cp(d + "/new dir", d + "/copied dir", true); },
+         [](const std::string& d) { return "cp -r " + quote(d + "/new dir") + " " + quote(d + "/copied dir"); }},
+        {"mv", [](const std::string& d) { cppBash::mv(d + "/src file.txt", d + "/moved 'src'.txt"); },
+         [](const std::string& d) { return "mv " + quote(d + "/src file.txt") + " " + quote(d + "/moved 'src'.txt"); }},
+        {"mv missing", [](const std::string& d) { cppBash::mv(d + "/src file.txt", d + "/again.txt"); },
+         [](const std::string& d) { return "mv " + quote(d + "/src file.txt") + " " + quote(d + "/again.txt"); }},
+        {"rm dir", [](const std::string& d) { cppBash::rm(d + "/copied dir"); },
+         [](const std::string& d) { return "rm " + quote(d + "/copied dir"); }},
+        {"rm -r", [](const std::string& d) { cppBash::rm(d + "/copied dir", true); },
+         [](const std::string& d) { return "rm -r " + quote(d + "/copied dir"); }},
+        {"rm -f missing", [](const std::string& d) { cppBash::rm(d + "/missing", false, true); },
+         [](const std::string& d) { return "rm -f " + quote(d + "/missing"); }},
+        {"rm missing", [](const std::string& d) { cppBash::rm(d + "/missing"); },
+         [](const std::string& d) { return "rm " + quote(d + "/missing"); }},
+    };
+
+    const fs::path native_root = scratch / "native 'tree'";
+    const fs::path shell_root = scratch / "shell 'tree'";
+    for (const auto& root : {native_root, shell_root})
+    {
+        fs::create_directories(root);
+        write_file(root / "src file.txt", "source\n");
+    }
+
+    std::cout << "--------------------------------------------------------------------------------" << std::endl;
+    for (const auto& op : ops)
+    {
+        bool native_threw = false;
+        try
+        {
+            op.native(native_root.string());
+        }
+        catch (const std::exception&)
+        {
+            native_threw = true;
+        }
+        std::string result;
+        const bool shell_threw = cppBash::exec(op.shell(shell_root.string()) + " 2>/dev/null", result) != 0;
+
+        const auto native_tree = snapshot(native_root);
+        const auto shell_tree = snapshot(shell_root);
+        const bool same = native_threw == shell_threw && native_tree == shell_tree;
+
+        std::cout << std::left << std::setw(24) << " " + op.name << (same ? "ok" : "MISMATCH")
+                  << (native_threw ? "  ( throws )" : "") << std::endl;
+        if (!same || verbosity > 0)
+        {
+            print_lines("native", {native_threw, native_tree});
+            print_lines("shell", {shell_threw, shell_tree});
+        }
+        if (!same)
+        {
+            nmismatch++;
+        }
+    }
+
+    std::cout << "--------------------------------------------------------------------------------" << std::endl;
+    std::cout << " read helpers: " << std::fixed << std::setprecision(1) << native_total << " us native, "
+              << shell_total << " us shell per pass" << std::defaultfloat << std::endl;
+    std::cout << " " << nmismatch << " mismatch(es)" << std::endl;
+    std::cout << "================================================================================" << std::endl;
+
+    std::error_code ec;
+    fs::remove_all(scratch, ec);
+
+    return nmismatch;
+}
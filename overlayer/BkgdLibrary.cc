@@ -0,0 +1,191 @@
+#include "BkgdLibrary.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+  const size_t kMaskBytes = BkgdLibrary::kNLayers * BkgdLibrary::kNEta * sizeof(uint64_t);
+  const size_t kNTowersPerLayer = BkgdLibrary::kNEta * BkgdLibrary::kNPhi;
+
+  size_t energy_bytes( const uint32_t flags )
+  {
+    return ( flags & BkgdLibrary::kFlagFP16 ) ? sizeof(uint16_t) : sizeof(float);
+  }
+
+  uint64_t * mask_words( unsigned char * record, const BkgdLibrary::LAYER layer )
+  {
+    return reinterpret_cast< uint64_t * >( record + sizeof(BkgdLibrary::RecordInfo) ) + layer * BkgdLibrary::kNEta;
+  }
+
+  const uint64_t * mask_words( const unsigned char * record, const BkgdLibrary::LAYER layer )
+  {
+    return reinterpret_cast< const uint64_t * >( record + sizeof(BkgdLibrary::RecordInfo) ) + layer * BkgdLibrary::kNEta;
+  }
+
+  size_t energy_offset( const uint32_t flags, const BkgdLibrary::LAYER layer )
+  {
+    return sizeof(BkgdLibrary::RecordInfo) + kMaskBytes + layer * kNTowersPerLayer * energy_bytes(flags);
+  }
+
+} // namespace
+
+size_t BkgdLibrary::record_size( const uint32_t flags )
+{
+  const size_t size = sizeof(RecordInfo) + kMaskBytes + kNLayers * kNTowersPerLayer * energy_bytes(flags);
+  return ( size + 7 ) & ~static_cast<size_t>(7);
+}
+
+uint32_t BkgdLibrary::cent_bin( const Header & header, const int cent )
+{
+  if ( cent <= 0 ) { return 0; }
+  const uint32_t icent = static_cast<uint32_t>(cent);
+  return icent < header.ncent ? icent : header.ncent - 1;
+}
+
+uint32_t BkgdLibrary::zvrtx_bin( const Header & header, const float zvrtx )
+{
+  const float width = ( header.zvrtx_max - header.zvrtx_min ) / header.nzvrtx;
+  const float x = ( zvrtx - header.zvrtx_min ) / width;
+  if ( !( x > 0 ) ) { return 0; } // also catches NaN
+  const uint32_t iz = static_cast<uint32_t>(x);
+  return iz < header.nzvrtx ? iz : header.nzvrtx - 1;
+}
+
+void BkgdLibrary::EncodeLayer( unsigned char * record, const uint32_t flags, const LAYER layer,
+                               const float E[kNEta][kNPhi], const int isgood[kNEta][kNPhi] )
+{
+  uint64_t * mask = mask_words(record, layer);
+  for ( int ieta = 0; ieta < kNEta; ++ieta )
+  {
+    uint64_t word = 0;
+    for ( int iphi = 0; iphi < kNPhi; ++iphi )
+    {
+      if ( isgood[ieta][iphi] > 0 ) { word |= ( uint64_t{1} << iphi ); }
+    }
+    mask[ieta] = word;
+  }
+
+  unsigned char * energies = record + energy_offset(flags, layer);
+  if ( flags & kFlagFP16 )
+  {
+    uint16_t * out = reinterpret_cast< uint16_t * >( energies );
+    for ( int ieta = 0; ieta < kNEta; ++ieta )
+    {
+      for ( int iphi = 0; iphi < kNPhi; ++iphi )
+      {
+        out[ieta * kNPhi + iphi] = float_to_half(E[ieta][iphi]);
+      }
+    }
+  }
+  else
+  {
+    std::memcpy(energies, E, kNTowersPerLayer * sizeof(float));
+  }
+}
+
+bool BkgdLibraryReader::Open( const std::string & filename )
+{
+  Close();
+
+  m_fd = ::open(filename.c_str(), O_RDONLY);
+  if ( m_fd < 0 )
+  {
+    std::cout << "BkgdLibraryReader::Open - cannot open " << filename << std::endl;
+    return false;
+  }
+
+  struct stat st {};
+  if ( ::fstat(m_fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BkgdLibrary::Header) )
+  {
+    std::cout << "BkgdLibraryReader::Open - " << filename << " is too short to be a library" << std::endl;
+    Close();
+    return false;
+  }
+  m_length = static_cast<size_t>(st.st_size);
+
+  void * data = ::mmap(nullptr, m_length, PROT_READ, MAP_SHARED, m_fd, 0);
+  if ( data == MAP_FAILED )
+  {
+    std::cout << "BkgdLibraryReader::Open - mmap failed for " << filename << std::endl;
+    Close();
+    return false;
+  }
+  m_data = data;
+
+  const unsigned char * base = static_cast< const unsigned char * >( m_data );
+  m_header = reinterpret_cast< const BkgdLibrary::Header * >( base );
+
+  const auto & h = *m_header;
+  const bool bad_magic = std::memcmp(h.magic, BkgdLibrary::kMagic, sizeof(h.magic)) != 0;
+  const bool bad_shape = h.nlayers != BkgdLibrary::kNLayers || h.neta != BkgdLibrary::kNEta || h.nphi != BkgdLibrary::kNPhi
+                         || h.record_size != BkgdLibrary::record_size(h.flags) || h.ncent == 0 || h.nzvrtx == 0;
+  const uint64_t nindex = static_cast<uint64_t>(h.ncent) * h.nzvrtx + 1;
+  const bool bad_size = h.index_offset + nindex * sizeof(uint64_t) > m_length
+                        || h.data_offset + h.nrecords * h.record_size > m_length;
+  if ( bad_magic || h.version != BkgdLibrary::kVersion || bad_shape || bad_size )
+  {
+    std::cout << "BkgdLibraryReader::Open - " << filename << " is not a valid version "
+              << BkgdLibrary::kVersion << " background library" << std::endl;
+    Close();
+    return false;
+  }
+
+  m_index = reinterpret_cast< const uint64_t * >( base + h.index_offset );
+  m_records = base + h.data_offset;
+
+  return true;
+}
+
+void BkgdLibraryReader::Close()
+{
+  if ( m_data ) { ::munmap(m_data, m_length); }
+  if ( m_fd >= 0 ) { ::close(m_fd); }
+
+  m_fd = -1;
+  m_data = nullptr;
+  m_length = 0;
+  m_header = nullptr;
+  m_index = nullptr;
+  m_records = nullptr;
+}
+
+void BkgdLibraryReader::DecodeLayer( const uint64_t irec, const BkgdLibrary::LAYER layer,
+                                     float E[BkgdLibrary::kNEta][BkgdLibrary::kNPhi],
+                                     int isgood[BkgdLibrary::kNEta][BkgdLibrary::kNPhi] ) const
+{
+  const unsigned char * rec = record(irec);
+
+  const uint64_t * mask = mask_words(rec, layer);
+  for ( int ieta = 0; ieta < BkgdLibrary::kNEta; ++ieta )
+  {
+    const uint64_t word = mask[ieta];
+    for ( int iphi = 0; iphi < BkgdLibrary::kNPhi; ++iphi )
+    {
+      isgood[ieta][iphi] = static_cast<int>( ( word >> iphi ) & 1 );
+    }
+  }
+
+  const unsigned char * energies = rec + energy_offset(m_header->flags, layer);
+  if ( is_fp16() )
+  {
+    const uint16_t * in = reinterpret_cast< const uint16_t * >( energies );
+    for ( int ieta = 0; ieta < BkgdLibrary::kNEta; ++ieta )
+    {
+      for ( int iphi = 0; iphi < BkgdLibrary::kNPhi; ++iphi )
+      {
+        E[ieta][iphi] = BkgdLibrary::half_to_float(in[ieta * BkgdLibrary::kNPhi + iphi]);
+      }
+    }
+  }
+  else
+  {
+    std::memcpy(E, energies, kNTowersPerLayer * sizeof(float));
+  }
+}
@@ -0,0 +1,136 @@
+#ifndef _BKGDLIBRARY_H_
+#define _BKGDLIBRARY_H_
+
+#include <commonutils/HalfFloat.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fixed-record binary library of background events for embedding.
+//
+// file layout ( native byte order, written and read on the same arch ):
+//   Header
+//   index  : uint64_t[ncent * nzvrtx + 1], first record of each
+//            ( cent bin, zvrtx bin ), records sorted by bin then zvrtx
+//   padding up to data_offset ( page aligned )
+//   records: nrecords * record_size bytes
+//
+// record layout:
+//   RecordInfo
+//   uint64_t goodmask[nlayers][neta]   bit iphi set if tower is good
+//   energies [nlayers][neta][nphi]     float, or fp16 if kFlagFP16
+//   padding to 8 bytes
+//
+// layers are ( cemc retower, hcalin, hcalout ), same grids as the
+// TreeWriter cemc_E / hcalin_E / hcalout_E branches
+namespace BkgdLibrary
+{
+  enum LAYER
+  {
+    CEMC = 0,
+    HCALIN = 1,
+    HCALOUT = 2
+  };
+
+  static const int kNLayers = 3;
+  static const int kNEta = 24;
+  static const int kNPhi = 64; // one uint64_t mask word per eta row
+
+  static const uint32_t kVersion = 1;
+  static const uint32_t kFlagFP16 = 0x1;
+  static const char kMagic[8] = { 'P', 'P', 'G', '4', 'B', 'K', 'G', 'L' };
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t nlayers;
+    uint32_t neta;
+    uint32_t nphi;
+    uint32_t record_size;
+    uint64_t nrecords;
+    uint32_t ncent;       // unit width bins starting at 0
+    uint32_t nzvrtx;      // uniform bins in [zvrtx_min, zvrtx_max)
+    float zvrtx_min;
+    float zvrtx_max;
+    uint64_t index_offset;
+    uint64_t data_offset;
+  };
+
+  struct RecordInfo
+  {
+    int32_t event_id;
+    int32_t cent;
+    float zvrtx;
+    float psi2;
+    float b;
+    float sum_eT[kNLayers];
+  };
+
+  size_t record_size( const uint32_t flags );
+
+  // pack one layer of a record buffer of record_size( flags ) bytes
+  void EncodeLayer( unsigned char * record, const uint32_t flags, const LAYER layer,
+                    const float E[kNEta][kNPhi], const int isgood[kNEta][kNPhi] );
+
+  // out of range values are clamped into the first / last bin
+  uint32_t cent_bin( const Header & header, const int cent );
+  uint32_t zvrtx_bin( const Header & header, const float zvrtx );
+
+  // IEEE 754 binary16, see commonutils/HalfFloat.h
+  using HalfFloat::float_to_half;
+  using HalfFloat::half_to_float;
+
+} // namespace BkgdLibrary
+
+// Read only view of a library. The file is mmap'd shared, so jobs on
+// one node reading the same library share the page cache. A record is
+// a pointer offset into the mapping, DecodeLayer() unpacks it into the
+// arrays OverlayFromTTree works with.
+class BkgdLibraryReader
+{
+  public:
+
+    BkgdLibraryReader() {}
+    ~BkgdLibraryReader() { Close(); }
+
+    BkgdLibraryReader( const BkgdLibraryReader & ) = delete;
+    BkgdLibraryReader & operator=( const BkgdLibraryReader & ) = delete;
+
+    bool Open( const std::string & filename );
+    void Close();
+    bool is_open() const { return m_data != nullptr; }
+
+    const BkgdLibrary::Header & header() const { return *m_header; }
+    uint64_t size() const { return m_header ? m_header->nrecords : 0; }
+    bool is_fp16() const { return m_header && ( m_header->flags & BkgdLibrary::kFlagFP16 ); }
+
+    // records [first, last) of a ( cent bin, zvrtx bin )
+    uint64_t first( const uint32_t icent, const uint32_t iz ) const { return m_index[icent * m_header->nzvrtx + iz]; }
+    uint64_t last( const uint32_t icent, const uint32_t iz ) const { return m_index[icent * m_header->nzvrtx + iz + 1]; }
+
+    const unsigned char * record( const uint64_t irec ) const { return m_records + irec * m_header->record_size; }
+    const BkgdLibrary::RecordInfo & info( const uint64_t irec ) const
+    {
+      return *reinterpret_cast< const BkgdLibrary::RecordInfo * >( record( irec ) );
+    }
+
+    // unpack one layer into a [24][64] energy / isgood array pair
+    void DecodeLayer( const uint64_t irec, const BkgdLibrary::LAYER layer,
+                      float E[BkgdLibrary::kNEta][BkgdLibrary::kNPhi],
+                      int isgood[BkgdLibrary::kNEta][BkgdLibrary::kNPhi] ) const;
+
+  private:
+
+    int m_fd { -1 };
+    void * m_data { nullptr };
+    size_t m_length { 0 };
+
+    const BkgdLibrary::Header * m_header { nullptr };
+    const uint64_t * m_index { nullptr };
+    const unsigned char * m_records { nullptr };
+};
+
+#endif // _BKGDLIBRARY_H_
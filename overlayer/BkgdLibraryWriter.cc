@@ -0,0 +1,309 @@
+#include "BkgdLibraryWriter.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <calobase/TowerInfo.h>
+#include <calobase/TowerInfoContainer.h>
+#include <calobase/RawTowerDefs.h>
+#include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeom.h>
+
+#include <globalvertex/GlobalVertex.h>
+#include <globalvertex/GlobalVertexMap.h>
+
+#include <centrality/CentralityInfo.h>
+
+#include <ffaobjects/EventHeader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+BkgdLibraryWriter::~BkgdLibraryWriter()
+{
+  if (_spool)
+  {
+    std::fclose(_spool);
+    std::remove(_spoolname.c_str());
+  }
+}
+
+int BkgdLibraryWriter::Init(PHCompositeNode * /*topNode*/)
+{
+  if (_ncent == 0 || _nzvrtx == 0 || !(_zvrtx_max > _zvrtx_min))
+  {
+    std::cout << PHWHERE << "invalid cent / zvrtx binning, doing nothing." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  std::memset(&_header, 0, sizeof(_header));
+  std::memcpy(_header.magic, BkgdLibrary::kMagic, sizeof(_header.magic));
+  _header.version = BkgdLibrary::kVersion;
+  _header.flags = _fp16 ? BkgdLibrary::kFlagFP16 : 0;
+  _header.nlayers = BkgdLibrary::kNLayers;
+  _header.neta = BkgdLibrary::kNEta;
+  _header.nphi = BkgdLibrary::kNPhi;
+  _header.record_size = BkgdLibrary::record_size(_header.flags);
+  _header.ncent = _ncent;
+  _header.nzvrtx = _nzvrtx;
+  _header.zvrtx_min = _zvrtx_min;
+  _header.zvrtx_max = _zvrtx_max;
+
+  _record.assign(_header.record_size, 0);
+
+  _spoolname = _foutname + ".tmp";
+  _spool = std::fopen(_spoolname.c_str(), "w+b");
+  if (!_spool)
+  {
+    std::cout << PHWHERE << "cannot open spool file " << _spoolname << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  std::cout << "BkgdLibraryWriter: writing " << _foutname << " ( "
+            << (_fp16 ? "fp16" : "float") << ", " << _header.record_size << " bytes / event )" << std::endl;
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int BkgdLibraryWriter::InitRun(PHCompositeNode * /*topNode*/)
+{
+  // node handles and geometry are per run
+  _nodes.clear();
+  _have_geometry = false;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int BkgdLibraryWriter::GetGeometry(PHCompositeNode *topNode)
+{
+  // retowered cemc lives on the hcalin grid at the cemc radius
+  const std::string geom_names[BkgdLibrary::kNLayers] = {"TOWERGEOM_HCALIN", "TOWERGEOM_HCALIN", "TOWERGEOM_HCALOUT"};
+  const RawTowerDefs::CalorimeterId geom_ids[BkgdLibrary::kNLayers] = {RawTowerDefs::CalorimeterId::HCALIN,
+                                                                      RawTowerDefs::CalorimeterId::HCALIN,
+                                                                      RawTowerDefs::CalorimeterId::HCALOUT};
+
+  for (int layer = 0; layer < BkgdLibrary::kNLayers; ++layer)
+  {
+    auto *geom = _nodes.get<RawTowerGeomContainer>(topNode, geom_names[layer]);
+    if (!geom)
+    {
+      std::cout << PHWHERE << "Error: can't find RawTowerGeomContainer node " << geom_names[layer] << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    for (int ieta = 0; ieta < BkgdLibrary::kNEta; ++ieta)
+    {
+      auto *tower_geom = geom->get_tower_geometry(RawTowerDefs::encode_towerid(geom_ids[layer], ieta, 0));
+      if (!tower_geom)
+      {
+        std::cout << PHWHERE << "Error: missing tower geometry in " << geom_names[layer] << " ieta " << ieta << std::endl;
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+      _tower_eta[layer][ieta] = tower_geom->get_eta();
+      _calo_R[layer] = tower_geom->get_center_radius();
+    }
+  }
+
+  auto *geom_EM = _nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+  if (!geom_EM)
+  {
+    std::cout << PHWHERE << "Error: can't find RawTowerGeomContainer node TOWERGEOM_CEMC" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  auto *geom_EM0 = geom_EM->get_tower_geometry(RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0));
+  if (!geom_EM0)
+  {
+    std::cout << PHWHERE << "Error: missing tower geometry in TOWERGEOM_CEMC" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  _calo_R[BkgdLibrary::CEMC] = geom_EM0->get_center_radius();
+
+  _have_geometry = true;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int BkgdLibraryWriter::FillLayer(PHCompositeNode *topNode, const BkgdLibrary::LAYER layer, const std::string &node, const float zvrtx, float &sum_eT)
+{
+  auto *towers = _nodes.get<TowerInfoContainer>(topNode, node);
+  if (!towers)
+  {
+    std::cout << PHWHERE << "Error: can't find TowerInfoContainer node " << node << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  std::memset(_E, 0, sizeof(_E));
+  std::memset(_isgood, 0, sizeof(_isgood));
+
+  float cosh_eta[BkgdLibrary::kNEta];
+  const double R = _calo_R[layer];
+  for (int ieta = 0; ieta < BkgdLibrary::kNEta; ++ieta)
+  {
+    const double z0 = std::sinh(_tower_eta[layer][ieta]) * R;
+    cosh_eta[ieta] = std::cosh(std::asinh((z0 - zvrtx) / R));
+  }
+
+  double sum = 0;
+  const unsigned int nchannels = towers->size();
+  for (unsigned int channel = 0; channel < nchannels; ++channel)
+  {
+    auto *tower = towers->get_tower_at_channel(channel);
+    if (!tower) continue;
+
+    const unsigned int key = towers->encode_key(channel);
+    const int ieta = towers->getTowerEtaBin(key);
+    const int iphi = towers->getTowerPhiBin(key);
+    if (ieta < 0 || ieta >= BkgdLibrary::kNEta || iphi < 0 || iphi >= BkgdLibrary::kNPhi) continue;
+
+    _E[ieta][iphi] = tower->get_energy();
+    _isgood[ieta][iphi] = tower->get_isGood() ? 1 : 0;
+    if (_isgood[ieta][iphi]) sum += _E[ieta][iphi] / cosh_eta[ieta];
+  }
+  sum_eT = static_cast<float>(sum);
+
+  BkgdLibrary::EncodeLayer(_record.data(), _header.flags, layer, _E, _isgood);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int BkgdLibraryWriter::process_event(PHCompositeNode *topNode)
+{
+  ++_event_id;
+
+  if (!_have_geometry)
+  {
+    const int ret = GetGeometry(topNode);
+    if (ret != Fun4AllReturnCodes::EVENT_OK) return ret;
+  }
+
+  auto *vertexmap = _nodes.get<GlobalVertexMap>(topNode, _vertex_node);
+  if (!vertexmap || vertexmap->empty())
+  {
+    std::cout << PHWHERE << _vertex_node << " node missing or empty, skipping event." << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+  auto *vtx = vertexmap->begin()->second;
+  const float zvrtx = vtx ? vtx->get_z() : NAN;
+  if (std::isnan(zvrtx) || std::fabs(zvrtx) > 1e3)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "vertex is " << zvrtx << ", skipping event." << std::endl;
+    }
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  auto *cent_node = _nodes.get<CentralityInfo>(topNode, _cent_node);
+  if (!cent_node)
+  {
+    std::cout << PHWHERE << _cent_node << " node missing, Abort!." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  BkgdLibrary::RecordInfo info {};
+  info.event_id = _event_id;
+  info.cent = static_cast<int>(cent_node->get_centrality_bin(CentralityInfo::PROP::mbd_NS));
+  info.zvrtx = zvrtx;
+
+  if (!_is_data)
+  {
+    auto *eventheader = _nodes.get<EventHeader>(topNode, _eventheader_node);
+    if (!eventheader)
+    {
+      std::cout << PHWHERE << _eventheader_node << " node missing, Abort!." << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    info.b = eventheader->get_ImpactParameter();
+    info.psi2 = eventheader->get_FlowPsiN(2);
+  }
+
+  const std::string nodes[BkgdLibrary::kNLayers] = {_cemc_tower_node, _ihcal_tower_node, _ohcal_tower_node};
+  for (int layer = 0; layer < BkgdLibrary::kNLayers; ++layer)
+  {
+    const int ret = FillLayer(topNode, static_cast<BkgdLibrary::LAYER>(layer), nodes[layer], zvrtx, info.sum_eT[layer]);
+    if (ret != Fun4AllReturnCodes::EVENT_OK) return ret;
+  }
+
+  std::memcpy(_record.data(), &info, sizeof(info));
+  if (std::fwrite(_record.data(), _record.size(), 1, _spool) != 1)
+  {
+    std::cout << PHWHERE << "write to " << _spoolname << " failed" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  const uint32_t bin = BkgdLibrary::cent_bin(_header, info.cent) * _header.nzvrtx + BkgdLibrary::zvrtx_bin(_header, zvrtx);
+  _keys.push_back({bin, zvrtx, static_cast<uint64_t>(_keys.size())});
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "BkgdLibraryWriter: event " << _event_id << " cent / zvrtx = " << info.cent << " / " << zvrtx
+              << ", sum eT cemc / ihcal / ohcal = " << info.sum_eT[0] << " / " << info.sum_eT[1] << " / " << info.sum_eT[2] << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int BkgdLibraryWriter::End(PHCompositeNode * /*topNode*/)
+{
+  if (!_spool) return Fun4AllReturnCodes::EVENT_OK;
+
+  const int ret = WriteLibrary();
+
+  std::fclose(_spool);
+  _spool = nullptr;
+  std::remove(_spoolname.c_str());
+
+  return ret;
+}
+
+int BkgdLibraryWriter::WriteLibrary()
+{
+  std::stable_sort(_keys.begin(), _keys.end(),
+                   [](const RecordKey &a, const RecordKey &b)
+                   { return a.bin != b.bin ? a.bin < b.bin : a.zvrtx < b.zvrtx; });
+
+  const uint64_t nbins = static_cast<uint64_t>(_header.ncent) * _header.nzvrtx;
+  std::vector<uint64_t> index(nbins + 1, 0);
+  for (const auto &key : _keys) index[key.bin + 1]++;
+  for (uint64_t i = 0; i < nbins; ++i) index[i + 1] += index[i];
+
+  const uint64_t page = 4096;
+  _header.nrecords = _keys.size();
+  _header.index_offset = sizeof(BkgdLibrary::Header);
+  _header.data_offset = (_header.index_offset + index.size() * sizeof(uint64_t) + page - 1) / page * page;
+
+  FILE *out = std::fopen(_foutname.c_str(), "wb");
+  if (!out)
+  {
+    std::cout << PHWHERE << "cannot open output " << _foutname << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  bool ok = std::fwrite(&_header, sizeof(_header), 1, out) == 1;
+  ok = ok && std::fwrite(index.data(), sizeof(uint64_t), index.size(), out) == index.size();
+
+  const std::vector<unsigned char> padding(_header.data_offset - _header.index_offset - index.size() * sizeof(uint64_t), 0);
+  ok = ok && std::fwrite(padding.data(), 1, padding.size(), out) == padding.size();
+
+  std::fflush(_spool);
+  for (const auto &key : _keys)
+  {
+    if (!ok) break;
+    ok = std::fseek(_spool, static_cast<long>(key.spool_index * _header.record_size), SEEK_SET) == 0;
+    ok = ok && std::fread(_record.data(), _record.size(), 1, _spool) == 1;
+    ok = ok && std::fwrite(_record.data(), _record.size(), 1, out) == 1;
+  }
+
+  ok = (std::fclose(out) == 0) && ok;
+  if (!ok)
+  {
+    std::cout << PHWHERE << "failed writing " << _foutname << std::endl;
+    std::remove(_foutname.c_str());
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  std::cout << "BkgdLibraryWriter: wrote " << _header.nrecords << " events to " << _foutname << std::endl;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,103 @@
+#ifndef _BKGDLIBRARYWRITER_H_
+#define _BKGDLIBRARYWRITER_H_
+
+#include "BkgdLibrary.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <eventselection/NodeCache.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+
+// Writes the background events it sees into a BkgdLibrary file for
+// OverlayFromTTree::set_emb_library. Records are spooled unsorted to
+// <output>.tmp while running, End() sorts them by ( cent, zvrtx ),
+// writes header + index + records and removes the spool file, so
+// memory use is a few bytes per event.
+class BkgdLibraryWriter : public SubsysReco
+{
+ public:
+
+  BkgdLibraryWriter(const std::string & fname = "bkgd_library.bin")
+    : SubsysReco("BkgdLibraryWriter")
+    , _foutname( fname )
+  {}
+
+  ~BkgdLibraryWriter() override;
+
+  int Init(PHCompositeNode *topNode) override;
+  int InitRun(PHCompositeNode *topNode) override;
+  int process_event(PHCompositeNode *topNode) override;
+  int End(PHCompositeNode *topNode) override;
+
+  // store energies as IEEE fp16 ( ~9 kB instead of ~18 kB per event )
+  void set_fp16(bool val) { _fp16 = val; }
+
+  // data has no EventHeader, b and psi2 are stored as 0
+  void is_data(bool val) { _is_data = val; }
+
+  void set_cent_bins(const unsigned int ncent) { _ncent = ncent; }
+  void set_zvrtx_bins(const unsigned int nz, const float zmin, const float zmax) { _nzvrtx = nz; _zvrtx_min = zmin; _zvrtx_max = zmax; }
+
+  void set_cemc_tower_node(const std::string& s) { _cemc_tower_node = s; }
+  void set_ihcal_tower_node(const std::string& s) { _ihcal_tower_node = s; }
+  void set_ohcal_tower_node(const std::string& s) { _ohcal_tower_node = s; }
+  void set_vertex_node(const std::string& s) { _vertex_node = s; }
+  void set_cent_node(const std::string& s) { _cent_node = s; }
+  void set_event_header_node(const std::string& s) { _eventheader_node = s; }
+
+ private:
+
+  NodeCache _nodes {};
+
+  std::string _foutname {""};
+  std::string _spoolname {""};
+  FILE * _spool {nullptr};
+
+  bool _fp16 {false};
+  bool _is_data {false};
+
+  unsigned int _ncent {100};
+  unsigned int _nzvrtx {20};
+  float _zvrtx_min {-30.0};
+  float _zvrtx_max {30.0};
+
+  std::string _cemc_tower_node {"TOWERINFO_CALIB_CEMC_RETOWER"};
+  std::string _ihcal_tower_node {"TOWERINFO_CALIB_HCALIN"};
+  std::string _ohcal_tower_node {"TOWERINFO_CALIB_HCALOUT"};
+  std::string _vertex_node {"GlobalVertexMap"};
+  std::string _cent_node {"CentralityInfo"};
+  std::string _eventheader_node {"EventHeader"};
+
+  int _event_id {-1};
+
+  // sort key of each spooled record
+  struct RecordKey
+  {
+    uint32_t bin;
+    float zvrtx;
+    uint64_t spool_index;
+  };
+  std::vector<RecordKey> _keys {};
+  BkgdLibrary::Header _header {};
+  std::vector<unsigned char> _record {};
+
+  // per run tower eta at the calo face, filled on the first event
+  bool _have_geometry {false};
+  float _tower_eta[BkgdLibrary::kNLayers][BkgdLibrary::kNEta] {};
+  double _calo_R[BkgdLibrary::kNLayers] {};
+
+  float _E[BkgdLibrary::kNEta][BkgdLibrary::kNPhi] {};
+  int _isgood[BkgdLibrary::kNEta][BkgdLibrary::kNPhi] {};
+
+  int GetGeometry(PHCompositeNode *topNode);
+  int FillLayer(PHCompositeNode *topNode, const BkgdLibrary::LAYER layer, const std::string &node, const float zvrtx, float &sum_eT);
+  int WriteLibrary();
+};
+
+#endif // _BKGDLIBRARYWRITER_H_
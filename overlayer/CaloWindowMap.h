@@ -25,6 +25,15 @@ class CaloWindowMap : public PHObject
     // const expression for masked tower energy
     constexpr static const float kMASK_ENERGY {-99999.0};
 
+    // one window of a hottest window query, iwindow indexes get_calo_windows()
+    struct Window
+    {
+      unsigned int iwindow {0};
+      unsigned int iphi {0}; // first phi bin, the window wraps in phi
+      unsigned int ieta {0}; // first eta bin
+      float energy {0};
+    };
+
     void identify(std::ostream &os = std::cout) const override { os << "CaloWindowMap base class" << std::endl; };
     int isValid() const override { return 0; }
 
@@ -38,11 +47,28 @@ class CaloWindowMap : public PHObject
 
     virtual void clear_towers() { return; }
     virtual void add_tower(const unsigned int /*iphi*/, const unsigned int /*ieta*/, const float /*pt*/, bool /*is_masked*/) { return; }
+    virtual float get_tower_energy(const unsigned int /*iphi*/, const unsigned int /*ieta*/) const { return 0; } // kMASK_ENERGY if masked
+    virtual bool is_tower_masked(const unsigned int /*iphi*/, const unsigned int /*ieta*/) const { return false; }
 
     virtual std::vector<float> get_calo_windows(const unsigned int /*dphi*/, const unsigned int /*deta*/) const { return {}; }
     virtual std::vector< std::pair<unsigned int, unsigned int> > get_window_comps_phieta(const unsigned int /*dphi*/, const unsigned int /*deta*/, const unsigned int /*iwindow*/) const { return {}; }
     virtual std::vector< std::pair<float, unsigned int> > get_window_comps_energy_key(const unsigned int /*dphi*/, const unsigned int /*deta*/, const unsigned int /*iwindow*/) const { return {}; }  
 
+    // the k highest energy windows of size (dphi, deta) that share no tower, highest first.
+    // windows containing a masked tower are skipped, fewer than k are returned if the map runs out
+    virtual std::vector<Window> get_hottest_windows(const unsigned int /*dphi*/, const unsigned int /*deta*/, const unsigned int /*k*/) const { return {}; }
+
+    // get_hottest_windows for each (dphi, deta) in sizes
+    std::vector< std::vector<Window> > get_hottest_windows_per_size(const std::vector< std::pair<unsigned int, unsigned int> > &sizes, const unsigned int k) const
+    {
+      std::vector< std::vector<Window> > hottest {};
+      hottest.reserve(sizes.size());
+      for ( const auto &size : sizes ) {
+        hottest.push_back(get_hottest_windows(size.first, size.second, k));
+      }
+      return hottest;
+    }
+
     ClassDefOverride(CaloWindowMap, 1);
 };
 
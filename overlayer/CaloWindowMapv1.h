@@ -30,11 +30,15 @@ class CaloWindowMapv1 : public CaloWindowMap
 
     void clear_towers() override { m_towers.clear(); m_towers.resize(m_nphi*m_neta, 0); }
     void add_tower(const unsigned int iphi, const unsigned int ieta, const float pt, bool is_masked) override;
+    float get_tower_energy(const unsigned int iphi, const unsigned int ieta) const override;
+    bool is_tower_masked(const unsigned int iphi, const unsigned int ieta) const override;
 
     std::vector<float> get_calo_windows(const unsigned int dphi, const unsigned int deta) const override;
     std::vector< std::pair<unsigned int, unsigned int> > get_window_comps_phieta(const unsigned int dphi, const unsigned int deta, const unsigned int iwindow) const override;
     std::vector< std::pair<float, unsigned int> > get_window_comps_energy_key(const unsigned int dphi, const unsigned int deta, const unsigned int iwindow) const override;
 
+    std::vector<Window> get_hottest_windows(const unsigned int dphi, const unsigned int deta, const unsigned int k) const override;
+
   private:
 
     Jet::SRC m_src {Jet::SRC::VOID};
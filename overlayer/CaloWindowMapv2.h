@@ -0,0 +1,86 @@
+#ifndef UNDERLYINGEVENT_CALOWINDOWMAPV2_H
+#define UNDERLYINGEVENT_CALOWINDOWMAPV2_H
+
+//===========================================================
+/// \file CaloWindowMapv2.h
+/// \brief Compact CaloWindowMap: persistent tower buffer, mask bitset and optional fp16/quantized energies on disk
+/// \author Tanner Mengel
+//===========================================================
+
+#include "CaloWindowMap.h"
+
+#include <cstdint>
+#include <vector>
+
+class CaloWindowMapv2 : public CaloWindowMap
+{
+  public:
+
+    // how energies are written, masks always go to a separate bitset
+    enum STORAGE
+    {
+      kFLOAT = 0,     // 4 bytes per tower, exact
+      kHALF = 1,      // IEEE fp16, 2 bytes per tower, ~1e-3 relative
+      kQUANTIZED = 2  // int16 multiples of the quantization step, 2 bytes per tower
+    };
+
+    CaloWindowMapv2();
+    ~CaloWindowMapv2() override {};
+
+    void identify(std::ostream &os = std::cout) const override;
+    void Reset() override { clear_towers(); }
+    int isValid() const override;
+    void CopyFrom(const PHObject *obj) override;
+
+    void set_src(Jet::SRC src) override { m_src = src; }
+    void set_nphi_neta(unsigned int nphi, unsigned int neta) override;
+
+    // quantization step in GeV, only used with kQUANTIZED. Energies up to
+    // +-kQUANTIZED_MAX * step are representable ( +-327.67 GeV at the
+    // default 0.01 ), larger ones are written clamped and counted
+    static constexpr int kQUANTIZED_MAX = 32767;
+    void set_storage(STORAGE storage, float step = 0.01) { m_storage = storage; m_step = step > 0 ? step : 0.01; }
+    STORAGE get_storage() const { return static_cast<STORAGE>(m_storage); }
+    float get_quantization_step() const { return m_step; }
+    float get_quantization_range() const { return kQUANTIZED_MAX * m_step; }
+    // towers clamped by kQUANTIZED writes of this object so far
+    unsigned long get_saturated_towers() const { return m_nsaturated; }
+
+    Jet::SRC get_src() const override { return m_src; }
+    unsigned int get_nphi() const override { return m_nphi; }
+    unsigned int get_neta() const override { return m_neta; }
+    unsigned int get_ntowers() const override { return m_nphi*m_neta; }
+
+    void clear_towers() override; // zeroes the buffer, never reallocates
+    void add_tower(const unsigned int iphi, const unsigned int ieta, const float pt, bool is_masked) override;
+    float get_tower_energy(const unsigned int iphi, const unsigned int ieta) const override;
+    bool is_tower_masked(const unsigned int iphi, const unsigned int ieta) const override;
+
+    std::vector<float> get_calo_windows(const unsigned int dphi, const unsigned int deta) const override;
+    std::vector< std::pair<unsigned int, unsigned int> > get_window_comps_phieta(const unsigned int dphi, const unsigned int deta, const unsigned int iwindow) const override;
+    std::vector< std::pair<float, unsigned int> > get_window_comps_energy_key(const unsigned int dphi, const unsigned int deta, const unsigned int iwindow) const override;
+
+    std::vector<Window> get_hottest_windows(const unsigned int dphi, const unsigned int deta, const unsigned int k) const override;
+
+  private:
+
+    Jet::SRC m_src {Jet::SRC::VOID};
+    unsigned int m_nphi {0};
+    unsigned int m_neta {0};
+
+    int m_storage {kFLOAT};
+    float m_step {0.01};
+    unsigned long m_nsaturated {0}; //! not written
+
+    // sized by set_nphi_neta only, masked towers hold 0 here
+    std::vector<float> m_towers {};
+    std::vector<uint32_t> m_mask {}; // one bit per tower, index iphi + ieta*nphi
+
+    bool masked(const unsigned int index) const { return (m_mask[index >> 5U] >> (index & 31U)) & 1U; }
+
+    // written by the custom Streamer, see CaloWindowMapv2.cc for the layout
+    ClassDefOverride(CaloWindowMapv2, 1);
+};
+
+
+#endif // UNDERLYINGEVENT_CALOWINDOWMAPV2_H
@@ -1,5 +1,6 @@
 #include "OverlayFromTTree.h"
 
+#include "BkgdLibrary.h"
 #include "EmbedInfo.h"
 #include "EmbedInfov1.h"
 
@@ -17,9 +18,15 @@
 #include <calobase/RawTowerGeomContainer.h>
 #include <calobase/RawTowerGeom.h>
 
+#include <globalvertex/GlobalVertex.h>
+#include <globalvertex/GlobalVertexMap.h>
+
 #include <jetbase/JetContainer.h>
 #include <jetbase/Jet.h>
 
+#include <eventselection/JetSummary.h>
+#include <eventselection/JetSummaryReco.h>
+
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
@@ -38,10 +45,29 @@ double OverlayFromTTree::delta_psi2_phi(const double psi2, const double phi)
   return std::min(std::abs(diffA), std::abs(diffB));
 }
 
+OverlayFromTTree::~OverlayFromTTree()
+{
+  delete _emb_library;
+}
+
 int OverlayFromTTree::Init(PHCompositeNode *topNode)
 {
   _count = 0;
 
+  const int ret = _emb_library_file.empty() ? OpenTree() : OpenLibrary();
+  if (ret != Fun4AllReturnCodes::EVENT_OK) return ret;
+
+  // init TF1
+  if (_jetv2_func) { delete _jetv2_func; _jetv2_func = nullptr; }
+  _jetv2_func = new TF1("jetv2_func", OverlayFromTTree::vn_function, 0.0, TMath::Pi()/2.0, 1);
+  _jetv2_func->SetParameter(0, _jetv2);
+  _jetv2_func->SetNpx(1000);
+
+  return CreateNode(topNode);
+}
+
+int OverlayFromTTree::OpenTree()
+{
   _emb_file = TFile::Open(_emb_input_file.c_str(), "READ");
   if (!_emb_file || _emb_file->IsZombie())
   {
@@ -112,24 +138,117 @@ int OverlayFromTTree::Init(PHCompositeNode *topNode)
 
   std::cout << "OverlayFromTTree: opened emb input file " << _emb_input_file << std::endl;
 
-  // init TF1
-  if (_jetv2_func) { delete _jetv2_func; _jetv2_func = nullptr; }
-  _jetv2_func = new TF1("jetv2_func", OverlayFromTTree::vn_function, 0.0, TMath::Pi()/2.0, 1);
-  _jetv2_func->SetParameter(0, _jetv2);
-  _jetv2_func->SetNpx(1000);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-  return CreateNode(topNode);
+int OverlayFromTTree::OpenLibrary()
+{
+  if (!_emb_library) _emb_library = new BkgdLibraryReader();
+  if (!_emb_library->Open(_emb_library_file))
+  {
+    std::cout << "OverlayFromTTree: ERROR - cannot open emb library " << _emb_library_file << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  const auto &header = _emb_library->header();
+  const uint32_t ncent = (_target_cent >= 0) ? BkgdLibrary::cent_bin(header, _target_cent) + 1 : header.ncent;
+
+  // sorted by cent bin first, so cent <= target is a prefix of the library
+  _emb_library_end = _emb_library->last(ncent - 1, header.nzvrtx - 1);
+
+  _emb_library_records.clear();
+  _emb_library_count.clear();
+  if (_match_zvrtx)
+  {
+    _emb_library_records.resize(header.nzvrtx);
+    _emb_library_count.assign(header.nzvrtx, 0);
+    for (uint32_t icent = 0; icent < ncent; ++icent)
+    {
+      for (uint32_t iz = 0; iz < header.nzvrtx; ++iz)
+      {
+        for (uint64_t irec = _emb_library->first(icent, iz); irec < _emb_library->last(icent, iz); ++irec)
+        {
+          _emb_library_records[iz].push_back(irec);
+        }
+      }
+    }
+  }
+
+  if (_emb_library_end == 0)
+  {
+    std::cout << "OverlayFromTTree: ERROR - emb library " << _emb_library_file
+              << " has no events with cent <= " << _target_cent << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  std::cout << "OverlayFromTTree: opened emb library " << _emb_library_file << " with "
+            << _emb_library->size() << " events ( " << _emb_library_end << " usable"
+            << (_emb_library->is_fp16() ? ", fp16" : "") << " )" << std::endl;
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int OverlayFromTTree::GetLibraryEvent(PHCompositeNode *topNode)
+{
+  uint64_t irec = _count % _emb_library_end;
+
+  if (_match_zvrtx)
+  {
+    auto *vertexmap = _nodes.get<GlobalVertexMap>(topNode, _vertex_node);
+    if (!vertexmap || vertexmap->empty() || !vertexmap->begin()->second)
+    {
+      std::cout << "OverlayFromTTree: ERROR - cannot find vertex node " << _vertex_node << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    const float zvrtx = vertexmap->begin()->second->get_z();
+    const uint32_t iz = BkgdLibrary::zvrtx_bin(_emb_library->header(), zvrtx);
+
+    const auto &records = _emb_library_records[iz];
+    if (records.empty())
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << "OverlayFromTTree: no library events for zvrtx " << zvrtx << ", skipping event" << std::endl;
+      }
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    irec = records[_emb_library_count[iz]++ % records.size()];
+  }
+  ++_count;
+
+  const auto &info = _emb_library->info(irec);
+  _emb_cent = info.cent;
+  _emb_zvrtx = info.zvrtx;
+  _emb_b = info.b;
+  _emb_psi2 = info.psi2;
+  _emb_cemc_sumet = info.sum_eT[BkgdLibrary::CEMC];
+  _emb_ihcal_sumet = info.sum_eT[BkgdLibrary::HCALIN];
+  _emb_ohcal_sumet = info.sum_eT[BkgdLibrary::HCALOUT];
+  _emb_sumet = _emb_cemc_sumet + _emb_ihcal_sumet + _emb_ohcal_sumet;
+
+  _emb_library->DecodeLayer(irec, BkgdLibrary::CEMC, _emb_cemc_E, _emb_cemc_isgood);
+  _emb_library->DecodeLayer(irec, BkgdLibrary::HCALIN, _emb_ihcal_E, _emb_ihcal_isgood);
+  _emb_library->DecodeLayer(irec, BkgdLibrary::HCALOUT, _emb_ohcal_E, _emb_ohcal_isgood);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int OverlayFromTTree::InitRun(PHCompositeNode * /*topNode*/)
+{
+  // node handles and calo radii are per run
+  _nodes.clear();
+  _have_calo_R = false;
+  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int OverlayFromTTree::process_event(PHCompositeNode *topNode)
 {
-  static bool first = true;
-  if (first)
+  if (!_have_calo_R)
   {
     _cemc_R  = getCaloRadius(topNode, RawTowerDefs::CalorimeterId::CEMC);
     _ihcal_R = getCaloRadius(topNode, RawTowerDefs::CalorimeterId::HCALIN);
     _ohcal_R = getCaloRadius(topNode, RawTowerDefs::CalorimeterId::HCALOUT);
-    first = false;
+    _have_calo_R = true;
 
     if (Verbosity() > 0)
     {
@@ -138,19 +257,27 @@ int OverlayFromTTree::process_event(PHCompositeNode *topNode)
     }
   }
 
-  _emb_tree->GetEntry(_count);
-
-  if (_target_cent >= 0)
+  if (_emb_library)
   {
-    while (_emb_cent > _target_cent)
+    const int ret = GetLibraryEvent(topNode);
+    if (ret != Fun4AllReturnCodes::EVENT_OK) return ret;
+  }
+  else
+  {
+    _emb_tree->GetEntry(_count);
+
+    if (_target_cent >= 0)
     {
-      ++_count;
-      _emb_tree->GetEntry(_count);
+      while (_emb_cent > _target_cent)
+      {
+        ++_count;
+        _emb_tree->GetEntry(_count);
+      }
     }
+    ++_count;
   }
-  ++_count;
 
-  auto *laudered_info = findNode::getClass<EmbedInfo>(topNode, "EmbedInfo");
+  auto *laudered_info = _nodes.get<EmbedInfo>(topNode, "EmbedInfo");
   if (!laudered_info)
   {
     std::cout << "OverlayFromTTree: ERROR - cannot find EmbedInfo node" << std::endl;
@@ -207,16 +334,20 @@ int OverlayFromTTree::process_event(PHCompositeNode *topNode)
 
   // }
 
-  auto *truth_jets = findNode::getClass<JetContainer>(topNode, "AntiKt_Truth_r03");
+  auto *truth_jets = _nodes.get<JetContainer>(topNode, "AntiKt_Truth_r03");
   if (!truth_jets)
   {
     std::cout << "OverlayFromTTree: ERROR - cannot find truth jet container node" << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  float lead_jet_phi = 0.0f;
-  float lead_jet_eta = 0.0f;
-  float lead_jet_pT  = -1.0f;
+  // leading truth jet from the per event jet summary
+  int isummary = -1;
+  auto *jet_summary = JetSummaryReco::GetSummary(topNode, "AntiKt_Truth_r03", isummary);
+  const bool has_lead = jet_summary && jet_summary->get_nstored(isummary) > 0;
+  const float lead_jet_phi = has_lead ? jet_summary->get_phi(isummary, 0) : 0.0f;
+  const float lead_jet_eta = has_lead ? jet_summary->get_eta(isummary, 0) : 0.0f;
+  const float lead_jet_pT  = has_lead ? jet_summary->get_pt(isummary, 0) : -1.0f;
 
   for (auto *this_jet : *truth_jets)
   {
@@ -226,13 +357,6 @@ int OverlayFromTTree::process_event(PHCompositeNode *topNode)
     const float eta = this_jet->get_eta();
     const float phi = this_jet->get_phi();
 
-    if (pt > lead_jet_pT)
-    {
-      lead_jet_pT  = pt;
-      lead_jet_eta = eta;
-      lead_jet_phi = phi;
-    }
-
 
     double sum_eTreco_cemc = 0.0, sum_eTreco_ihcal = 0.0, sum_eTreco_ohcal = 0.0;
 
@@ -306,7 +430,7 @@ int OverlayFromTTree::process_event(PHCompositeNode *topNode)
   auto *towers_IH = getTowerInfos(topNode, _ihcal_tower_node);
   auto *towers_OH = getTowerInfos(topNode, _ohcal_tower_node);
 
-  auto *reco_jets = findNode::getClass<JetContainer>(topNode, "AntiKt_Tower_r03_DVP");
+  auto *reco_jets = _nodes.get<JetContainer>(topNode, "AntiKt_Tower_r03_DVP");
   if (!reco_jets)
   {
     std::cout << "OverlayFromTTree: ERROR - cannot find reco jet container node" << std::endl;
@@ -384,6 +508,8 @@ int OverlayFromTTree::End(PHCompositeNode * /*topNode*/)
 {
   if (_jetv2_func) { delete _jetv2_func; _jetv2_func = nullptr; }
 
+  if (_emb_library) _emb_library->Close();
+
   if (_emb_file)
   {
     _emb_file->Close();
@@ -401,7 +527,7 @@ inline double OverlayFromTTree::getCaloRadius(PHCompositeNode *topNode, const Ra
               << RawTowerDefs::convert_caloid_to_name(caloid) << std::endl;
   }
 
-  auto *towgeo = findNode::getClass<RawTowerGeomContainer>(
+  auto *towgeo = _nodes.get<RawTowerGeomContainer>(
       topNode, "TOWERGEOM_" + RawTowerDefs::convert_caloid_to_name(caloid));
 
   if (!towgeo)
@@ -424,7 +550,7 @@ inline double OverlayFromTTree::getCaloRadius(PHCompositeNode *topNode, const Ra
 
 inline TowerInfoContainer* OverlayFromTTree::getTowerInfos(PHCompositeNode *topNode, const std::string &tower_node_name)
 {
-  auto *towerinfo = findNode::getClass<TowerInfoContainer>(topNode, tower_node_name);
+  auto *towerinfo = _nodes.get<TowerInfoContainer>(topNode, tower_node_name);
   if (!towerinfo)
   {
     std::cout << PHWHERE << "Error: can't find TowerInfoContainer node " << tower_node_name << std::endl;
@@ -450,7 +576,7 @@ int OverlayFromTTree::CreateNode(PHCompositeNode *topNode)
     dstNode->addNode(bkgNode);
   }
 
-  auto *embedinfo = findNode::getClass<EmbedInfo>(topNode, "EmbedInfo");
+  auto *embedinfo = _nodes.get<EmbedInfo>(topNode, "EmbedInfo");
   if (!embedinfo)
   {
     embedinfo = new EmbedInfov1();
@@ -463,7 +589,7 @@ int OverlayFromTTree::CreateNode(PHCompositeNode *topNode)
 
 inline RawTowerGeomContainer* OverlayFromTTree::getTowerGeoms(PHCompositeNode *topNode, const std::string &geom_node_name)
 {
-  auto *towgeom = findNode::getClass<RawTowerGeomContainer>(topNode, geom_node_name);
+  auto *towgeom = _nodes.get<RawTowerGeomContainer>(topNode, geom_node_name);
   if (!towgeom)
   {
     std::cout << PHWHERE << "Error: can't find RawTowerGeomContainer node " << geom_node_name << std::endl;
@@ -3,8 +3,11 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -20,6 +23,7 @@ class TF1;
 
 class TowerInfoContainer;
 class RawTowerGeomContainer;
+class BkgdLibraryReader;
 
 class PHCompositeNode;
 
@@ -31,9 +35,10 @@ class OverlayFromTTree : public SubsysReco
     , _emb_input_file(fname)
   {}
 
-  ~OverlayFromTTree() override = default;
+  ~OverlayFromTTree() override;
 
   int Init(PHCompositeNode *topNode) override;
+  int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
   int End(PHCompositeNode *topNode) override;
 
@@ -43,6 +48,20 @@ class OverlayFromTTree : public SubsysReco
     _emb_input_file = emb_input;
   }
 
+  // read background events from a BkgdLibraryWriter file ( mmap'd )
+  // instead of the ROOT tree set with set_emb_input
+  void set_emb_library(const std::string &emb_library, bool is_data_input = false)
+  {
+    _is_data_input = is_data_input;
+    _emb_library_file = emb_library;
+  }
+  // library only: take background events from the zvrtx bin of this event's vertex
+  void set_emb_match_zvrtx(bool val, const std::string &vertex_node = "GlobalVertexMap")
+  {
+    _match_zvrtx = val;
+    _vertex_node = vertex_node;
+  }
+
   void set_target_cent(const int cent) { _target_cent = cent; }
   void set_pT_threshold(const float pT) { _jetpt_thres = pT; }
 
@@ -65,7 +84,12 @@ class OverlayFromTTree : public SubsysReco
   void set_ohcal_tower_node(const std::string& s) { _ohcal_tower_node = s; }
 
  private:
+  NodeCache _nodes {};
+
   int CreateNode(PHCompositeNode *topNode);
+  int OpenTree();
+  int OpenLibrary();
+  int GetLibraryEvent(PHCompositeNode *topNode);
 
   std::string _emb_input_file {""};
   bool _is_data_input {false};
@@ -73,6 +97,16 @@ class OverlayFromTTree : public SubsysReco
   TFile *_emb_file {nullptr};
   TTree *_emb_tree {nullptr};
 
+  std::string _emb_library_file {""};
+  BkgdLibraryReader *_emb_library {nullptr};
+  bool _match_zvrtx {false};
+  std::string _vertex_node {"GlobalVertexMap"};
+  // records with cent <= target are [0, _emb_library_end) since the
+  // library is sorted by cent, with zvrtx matching they are split per zvrtx bin
+  uint64_t _emb_library_end {0};
+  std::vector<std::vector<uint64_t>> _emb_library_records {};
+  std::vector<uint64_t> _emb_library_count {};
+
   float _jetpt_thres {5.0};
   int _target_cent {-1};
 
@@ -126,6 +160,7 @@ class OverlayFromTTree : public SubsysReco
   double _cemc_R {0.0};
   double _ihcal_R {0.0};
   double _ohcal_R {0.0};
+  bool _have_calo_R {false};
 
   int _count {0};
 
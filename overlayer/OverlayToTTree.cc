@@ -33,6 +33,9 @@
 #include <jetbase/JetContainer.h>
 #include <jetbase/Jet.h>
 
+#include <eventselection/JetSummary.h>
+#include <eventselection/JetSummaryReco.h>
+
 #include <TTree.h>
 #include <TF1.h>
 #include <TMath.h>
@@ -46,8 +49,18 @@
 int OverlayToTTree::Init( PHCompositeNode * /*topNode*/ )
 {
 
+  // default r03 set keeps the original branch names
+  if ( _jet_sets.empty() )
+  {
+    add_jet_set("", "AntiKt_Truth_r03", "AntiKt_Tower_r03_DVP", "AntiKt_Tower_r03_Sub1", 0.3);
+  }
+
+  // a new part when resuming
+  _checkpoint.set_verbosity( Verbosity() );
+  _foutname = _checkpoint.begin( _foutname );
   PHTFileServer::get().open( _foutname, "RECREATE" );
   _tree = new TTree("T", "T");
+  _checkpoint.add_tree( _tree );
 
   _tree -> Branch( "event", &_count, "event/I" );
   if ( _target_cent >= 0 )
@@ -77,32 +90,30 @@ int OverlayToTTree::Init( PHCompositeNode * /*topNode*/ )
   _tree -> Branch( "pythia_z",&_pythia_z,"pythia_z/F");
   _tree -> Branch( "pythia_z_reco",&_pythia_z_reco,"pythia_z_reco/F");
 
-  _tree -> Branch( "truth_jet_E",&_truth_jet_E);
-  _tree -> Branch( "truth_jet_pt",&_truth_jet_pt);
-  _tree -> Branch( "truth_jet_eta",&_truth_jet_eta);
-  _tree -> Branch( "truth_jet_phi",&_truth_jet_phi);
-  _tree -> Branch( "truth_jet_recoUE",&_truth_jet_recoUE);
-  _tree -> Branch( "truth_jet_recoUE_cemc",&_truth_jet_recoUE_cemc);
-  _tree -> Branch( "truth_jet_recoUE_ihcal",&_truth_jet_recoUE_ihcal);
-  _tree -> Branch( "truth_jet_recoUE_ohcal",&_truth_jet_recoUE_ohcal);
-  _tree -> Branch( "recoPythia_jet_E",&_recoPythia_jet_E);
-  _tree -> Branch( "recoPythia_jet_pt",&_recoPythia_jet_pt);
-  _tree -> Branch( "recoPythia_jet_eta",&_recoPythia_jet_eta);
-  _tree -> Branch( "recoPythia_jet_phi",&_recoPythia_jet_phi);
-  _tree -> Branch( "recoPythia_jet_EMfrac",&_recoPythia_jet_EMfrac);
-  _tree -> Branch( "recoEmbed_jet_E",&_recoEmbed_jet_E);
-  _tree -> Branch( "recoEmbed_jet_pt",&_recoEmbed_jet_pt);
-  _tree -> Branch( "recoEmbed_jet_eta",&_recoEmbed_jet_eta);
-  _tree -> Branch( "recoEmbed_jet_phi",&_recoEmbed_jet_phi);
-  _tree -> Branch( "recoEmbed_jet_EMfrac",&_recoEmbed_jet_EMfrac);
+  // branches point into _jet_sets, no sets can be added after this
+  for ( auto &set : _jet_sets )
+  {
+    AddBranches(set);
+  }
 
   std::cout << " OverlayToTTree: initialized output tree in file " << _foutname << std::endl;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int OverlayToTTree::InitRun( PHCompositeNode * /*topNode*/ )
+{
+  _nodes.clear();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int OverlayToTTree::process_event(PHCompositeNode *topNode)
 {
-  auto embedinfo = findNode::getClass<EmbedInfov1>(topNode, "EmbedInfo");
+  if ( _checkpoint.skip_event() )
+  { // written by the part we resume from
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  auto embedinfo = _nodes.get<EmbedInfov1>(topNode, "EmbedInfo");
   if ( !embedinfo ) 
   {
     std::cout << " OverlayToTTree: ERROR - cannot find EmbedInfo node " << std::endl;
@@ -140,7 +151,7 @@ int OverlayToTTree::process_event(PHCompositeNode *topNode)
   }
 
 
-  auto genEventMap = findNode::getClass <PHHepMCGenEventMap> (topNode, "PHHepMCGenEventMap");
+  auto genEventMap = _nodes.get<PHHepMCGenEventMap>(topNode, "PHHepMCGenEventMap");
   if ( !genEventMap ) 
   {
     std::cout << " OverlayToTTree: ERROR - cannot find PHHepMCGenEventMap node " << std::endl;
@@ -160,20 +171,153 @@ int OverlayToTTree::process_event(PHCompositeNode *topNode)
     std::cout << " OverlayToTTree: z (truth, reco, emb) = " << _pythia_z << " / " << _pythia_z_reco << " / " << _emb_zvrtx << std::endl;
   }
 
-  auto *truth_jets = findNode::getClass<JetContainer>(topNode, "AntiKt_Truth_r03");
+  for ( auto &set : _jet_sets )
+  {
+    if ( FillTruthJets(topNode, set.truth_node, set.truth) != Fun4AllReturnCodes::EVENT_OK ) return Fun4AllReturnCodes::ABORTRUN;
+
+    int isummary = -1;
+    auto *summary = JetSummaryReco::GetSummary(topNode, set.truth_node, isummary);
+    set.truth_dijet_mass = summary ? summary->get_dijet_mass(isummary) : NAN;
+    set.truth_dijet_dphi = summary ? summary->get_dijet_dphi(isummary) : NAN;
+    set.truth_dijet_xj = summary ? summary->get_dijet_xj(isummary) : NAN;
+
+    if ( FillRecoJets(topNode, set.reco_node, set.recoPythia) != Fun4AllReturnCodes::EVENT_OK ) return Fun4AllReturnCodes::ABORTRUN;
+    if ( FillSub1Jets(topNode, set.sub1_node, set.recoEmbed) != Fun4AllReturnCodes::EVENT_OK ) return Fun4AllReturnCodes::ABORTRUN;
+
+    MatchJets(set);
+
+    if ( Verbosity() > 1 )
+    {
+      std::cout << " OverlayToTTree: set " << set.tag << " (R = " << set.R << ")" << std::endl;
+      std::cout << " OverlayToTTree: truth jets stored: " << set.truth.E.size() << std::endl;
+      std::cout << " OverlayToTTree: recoPythia jets stored: " << set.recoPythia.E.size() << std::endl;
+      std::cout << " OverlayToTTree: recoEmbed jets stored: " << set.recoEmbed.E.size() << std::endl;
+    }
+  }
+
+  _tree->Fill();
+  _checkpoint.filled( _count );
+  if ( Verbosity() > 0 )
+  {
+    std::cout << " OverlayToTTree: filled tree for event " << _count << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+  
+}
+
+int OverlayToTTree::End(PHCompositeNode * /*topNode*/ )
+{
+  if( Verbosity() > 0 ) 
+  {
+    std::cout << " OverlayToTTree: writing output tree to file " << _foutname << std::endl;
+    std::cout << " OverlayToTTree: total events processed: " << _count << std::endl;
+  }
+
+  PHTFileServer::get().cd( _foutname );
+  _tree->Write();
+  PHTFileServer::get().close();
+  _checkpoint.finish();
+ 
+  if ( Verbosity () > 0 ) 
+  {
+    std::cout << " OverlayToTTree: finished writing output file " << _foutname << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void OverlayToTTree::add_jet_set(const std::string &tag, const std::string &truth_node,
+                                 const std::string &reco_node, const std::string &sub1_node, const float R)
+{
+  if ( _tree )
+  {
+    std::cout << PHWHERE << "WARNING: jet sets must be added before Init, ignoring " << tag << std::endl;
+    return;
+  }
+
+  JetSet set {};
+  set.tag = tag;
+  set.truth_node = truth_node;
+  set.reco_node = reco_node;
+  set.sub1_node = sub1_node;
+  set.R = R;
+  _jet_sets.push_back(set);
+}
+
+void OverlayToTTree::JetCollection::clear()
+{
+  E.clear();
+  pt.clear();
+  eta.clear();
+  phi.clear();
+  EMfrac.clear();
+  recoUE.clear();
+  recoUE_cemc.clear();
+  recoUE_ihcal.clear();
+  recoUE_ohcal.clear();
+}
+
+void OverlayToTTree::AddBranches(JetSet &set)
+{
+  const std::string p = set.tag.empty() ? "" : set.tag + "_";
+
+  _tree -> Branch( (p + "truth_jet_E").c_str(), &set.truth.E );
+  _tree -> Branch( (p + "truth_jet_pt").c_str(), &set.truth.pt );
+  _tree -> Branch( (p + "truth_jet_eta").c_str(), &set.truth.eta );
+  _tree -> Branch( (p + "truth_jet_phi").c_str(), &set.truth.phi );
+  _tree -> Branch( (p + "truth_jet_recoUE").c_str(), &set.truth.recoUE );
+  _tree -> Branch( (p + "truth_jet_recoUE_cemc").c_str(), &set.truth.recoUE_cemc );
+  _tree -> Branch( (p + "truth_jet_recoUE_ihcal").c_str(), &set.truth.recoUE_ihcal );
+  _tree -> Branch( (p + "truth_jet_recoUE_ohcal").c_str(), &set.truth.recoUE_ohcal );
+  _tree -> Branch( (p + "truth_jet_unmatched").c_str(), &set.truth_unmatched );
+  _tree -> Branch( (p + "truth_dijet_mass").c_str(), &set.truth_dijet_mass, (p + "truth_dijet_mass/F").c_str() );
+  _tree -> Branch( (p + "truth_dijet_dphi").c_str(), &set.truth_dijet_dphi, (p + "truth_dijet_dphi/F").c_str() );
+  _tree -> Branch( (p + "truth_dijet_xj").c_str(), &set.truth_dijet_xj, (p + "truth_dijet_xj/F").c_str() );
+
+  if ( !set.reco_node.empty() )
+  {
+    _tree -> Branch( (p + "recoPythia_jet_E").c_str(), &set.recoPythia.E );
+    _tree -> Branch( (p + "recoPythia_jet_pt").c_str(), &set.recoPythia.pt );
+    _tree -> Branch( (p + "recoPythia_jet_eta").c_str(), &set.recoPythia.eta );
+    _tree -> Branch( (p + "recoPythia_jet_phi").c_str(), &set.recoPythia.phi );
+    _tree -> Branch( (p + "recoPythia_jet_EMfrac").c_str(), &set.recoPythia.EMfrac );
+    _tree -> Branch( (p + "recoPythia_jet_truth_idx").c_str(), &set.recoPythia_truth_idx );
+    _tree -> Branch( (p + "truth_jet_recoPythia_idx").c_str(), &set.truth_recoPythia_idx );
+    _tree -> Branch( (p + "truth_jet_recoPythia_dR").c_str(), &set.truth_recoPythia_dR );
+  }
+
+  if ( !set.sub1_node.empty() )
+  {
+    _tree -> Branch( (p + "recoEmbed_jet_E").c_str(), &set.recoEmbed.E );
+    _tree -> Branch( (p + "recoEmbed_jet_pt").c_str(), &set.recoEmbed.pt );
+    _tree -> Branch( (p + "recoEmbed_jet_eta").c_str(), &set.recoEmbed.eta );
+    _tree -> Branch( (p + "recoEmbed_jet_phi").c_str(), &set.recoEmbed.phi );
+    _tree -> Branch( (p + "recoEmbed_jet_EMfrac").c_str(), &set.recoEmbed.EMfrac );
+    _tree -> Branch( (p + "recoEmbed_jet_truth_idx").c_str(), &set.recoEmbed_truth_idx );
+    _tree -> Branch( (p + "truth_jet_recoEmbed_idx").c_str(), &set.truth_recoEmbed_idx );
+    _tree -> Branch( (p + "truth_jet_recoEmbed_dR").c_str(), &set.truth_recoEmbed_dR );
+  }
+}
+
+int OverlayToTTree::FillTruthJets(PHCompositeNode *topNode, const std::string &node, JetCollection &jets)
+{
+  jets.clear();
+
+  auto *truth_jets = _nodes.get<JetContainer>(topNode, node);
   if (!truth_jets)
   {
-    std::cout << "OverlayFromTTree: ERROR - cannot find truth jet container node" << std::endl;
+    std::cout << "OverlayToTTree: ERROR - cannot find truth jet container node " << node << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
-  } 
-  _truth_jet_E.clear();
-  _truth_jet_pt.clear();
-  _truth_jet_eta.clear();
-  _truth_jet_phi.clear();
-  _truth_jet_recoUE.clear();
-  _truth_jet_recoUE_cemc.clear();
-  _truth_jet_recoUE_ihcal.clear();
-  _truth_jet_recoUE_ohcal.clear();
+  }
+
+  // reco UE sums are only set by OverlayFromTTree on the jets it embeds into
+  const bool has_recoUE = truth_jets->has_property(Jet::PROPERTY::prop_JetCharge);
+  const unsigned int iUE = has_recoUE ? truth_jets->property_index(Jet::PROPERTY::prop_JetCharge) : 0;
+  const unsigned int iUE_cemc = has_recoUE ? truth_jets->property_index(Jet::PROPERTY::prop_BFrac) : 0;
+  const unsigned int iUE_ihcal = has_recoUE ? truth_jets->property_index(Jet::PROPERTY::prop_area) : 0;
+  const unsigned int iUE_ohcal = has_recoUE ? truth_jets->property_index(Jet::PROPERTY::prop_zg) : 0;
+
   for (auto *this_jet : *truth_jets)
   {
     if (!this_jet) continue;
@@ -182,19 +326,16 @@ int OverlayToTTree::process_event(PHCompositeNode *topNode)
     const float eta = this_jet->get_eta();
     const float phi = this_jet->get_phi();
     const float e   = this_jet->get_e();
-    const float UE = this_jet->get_property(truth_jets->property_index(Jet::PROPERTY::prop_JetCharge));
-    const float UE_cemc = this_jet->get_property(truth_jets->property_index(Jet::PROPERTY::prop_BFrac));
-    const float UE_ihcal = this_jet->get_property(truth_jets->property_index(Jet::PROPERTY::prop_area));
-    const float UE_ohcal = this_jet->get_property(truth_jets->property_index(Jet::PROPERTY::prop_zg));
-  
-    _truth_jet_E.push_back(e);
-    _truth_jet_pt.push_back(pt);
-    _truth_jet_eta.push_back(eta);
-    _truth_jet_phi.push_back(phi);
-    _truth_jet_recoUE.push_back(UE);
-    _truth_jet_recoUE_cemc.push_back(UE_cemc);
-    _truth_jet_recoUE_ihcal.push_back(UE_ihcal);
-    _truth_jet_recoUE_ohcal.push_back(UE_ohcal);
+    const float UE = has_recoUE ? this_jet->get_property(iUE) : NAN;
+
+    jets.E.push_back(e);
+    jets.pt.push_back(pt);
+    jets.eta.push_back(eta);
+    jets.phi.push_back(phi);
+    jets.recoUE.push_back(UE);
+    jets.recoUE_cemc.push_back(has_recoUE ? this_jet->get_property(iUE_cemc) : NAN);
+    jets.recoUE_ihcal.push_back(has_recoUE ? this_jet->get_property(iUE_ihcal) : NAN);
+    jets.recoUE_ohcal.push_back(has_recoUE ? this_jet->get_property(iUE_ohcal) : NAN);
     if ( Verbosity() > 1 )
     {
       std::cout << " OverlayToTTree: truth jet E / pt / eta / phi = "
@@ -204,59 +345,62 @@ int OverlayToTTree::process_event(PHCompositeNode *topNode)
     }
 
   } // end for truth_jets
-  
 
-  auto *reco_jets = findNode::getClass<JetContainer>(topNode, "AntiKt_Tower_r03_DVP");
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int OverlayToTTree::FillRecoJets(PHCompositeNode *topNode, const std::string &node, JetCollection &jets)
+{
+  jets.clear();
+  if ( node.empty() ) return Fun4AllReturnCodes::EVENT_OK;
+
+  auto *reco_jets = _nodes.get<JetContainer>(topNode, node);
   if (!reco_jets)
   {
-    std::cout << "OverlayFromTTree: ERROR - cannot find reco jet container node" << std::endl;
+    std::cout << "OverlayToTTree: ERROR - cannot find reco jet container node " << node << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
-  _recoPythia_jet_E.clear();
-  _recoPythia_jet_pt.clear();
-  _recoPythia_jet_eta.clear();
-  _recoPythia_jet_phi.clear();
-  _recoPythia_jet_EMfrac.clear();
+
+  // EM fraction is set by OverlayFromTTree on the pythia reco jets
+  const bool has_EMfrac = reco_jets->has_property(Jet::PROPERTY::prop_JetCharge);
+  const unsigned int iEMfrac = has_EMfrac ? reco_jets->property_index(Jet::PROPERTY::prop_JetCharge) : 0;
+
   for (auto *this_jet : *reco_jets)
   {
     if (!this_jet) continue;
 
     const float pt = this_jet->get_pt();
-    const float eta = this_jet->get_eta();
-    const float phi = this_jet->get_phi();
-    const float e = this_jet->get_e();
     if ( pt < _jetpt_thres ) continue;
-    const float EMfrac = this_jet->get_property(reco_jets->property_index(Jet::PROPERTY::prop_JetCharge));
-  
-    _recoPythia_jet_E.push_back(e);
-    _recoPythia_jet_pt.push_back(pt);
-    _recoPythia_jet_eta.push_back(eta);
-    _recoPythia_jet_phi.push_back(phi);
-    _recoPythia_jet_EMfrac.push_back(EMfrac);
+
+    jets.E.push_back(this_jet->get_e());
+    jets.pt.push_back(pt);
+    jets.eta.push_back(this_jet->get_eta());
+    jets.phi.push_back(this_jet->get_phi());
+    jets.EMfrac.push_back(has_EMfrac ? this_jet->get_property(iEMfrac) : NAN);
 
   } // end for reco_jets
 
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int OverlayToTTree::FillSub1Jets(PHCompositeNode *topNode, const std::string &node, JetCollection &jets)
+{
+  jets.clear();
+  if ( node.empty() ) return Fun4AllReturnCodes::EVENT_OK;
 
-  auto *towers_EM = getTowerInfos(topNode, "TOWERINFO_CALIB_CEMC_RETOWER_SUB1");
-  auto *sub_jets = findNode::getClass<JetContainer>(topNode,"AntiKt_Tower_r03_Sub1");
+  auto *sub_jets = _nodes.get<JetContainer>(topNode, node);
   if (!sub_jets)
   {
-    std::cout << "OverlayFromTTree: ERROR - cannot find Sub1 jet container node" << std::endl;
+    std::cout << "OverlayToTTree: ERROR - cannot find Sub1 jet container node " << node << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
+  auto *towers_EM = getTowerInfos(topNode, _sub1_cemc_tower_node);
 
-  _recoEmbed_jet_E.clear();  
-  _recoEmbed_jet_pt.clear();
-  _recoEmbed_jet_eta.clear();
-  _recoEmbed_jet_phi.clear();
-  _recoEmbed_jet_EMfrac.clear();
   for (auto *this_jet : *sub_jets)
   {
     if (!this_jet) continue;
 
     const float pt = this_jet->get_pt();
-    const float eta = this_jet->get_eta();
-    const float phi = this_jet->get_phi();
     const float e = this_jet->get_e();
     if ( pt < _jetpt_thres ) continue;
     float EMfrac = 0.0;
@@ -269,55 +413,39 @@ int OverlayToTTree::process_event(PHCompositeNode *topNode)
       }
     }
     if ( e > 0 ) EMfrac /= e;
-  
-    _recoEmbed_jet_E.push_back(e);
-    _recoEmbed_jet_pt.push_back(pt);
-    _recoEmbed_jet_eta.push_back(eta);
-    _recoEmbed_jet_phi.push_back(phi);
-    _recoEmbed_jet_EMfrac.push_back(EMfrac);
 
-  } // end for sub_jets
-   
-  if ( Verbosity() > 1 )
-  {
-    std::cout << " OverlayToTTree: truth jets stored: " << _truth_jet_E.size() << std::endl;
-    std::cout << " OverlayToTTree: recoPythia jets stored: " << _recoPythia_jet_E.size() << std::endl;
-    std::cout << " OverlayToTTree: recoEmbed jets stored: " << _recoEmbed_jet_E.size() << std::endl;
-  }
+    jets.E.push_back(e);
+    jets.pt.push_back(pt);
+    jets.eta.push_back(this_jet->get_eta());
+    jets.phi.push_back(this_jet->get_phi());
+    jets.EMfrac.push_back(EMfrac);
 
-  _tree->Fill();
-  if ( Verbosity() > 0 )
-  {
-    std::cout << " OverlayToTTree: filled tree for event " << _count << std::endl;
-  }
+  } // end for sub_jets
 
   return Fun4AllReturnCodes::EVENT_OK;
-  
 }
 
-int OverlayToTTree::End(PHCompositeNode * /*topNode*/ )
+void OverlayToTTree::MatchJets(JetSet &set)
 {
-  if( Verbosity() > 0 ) 
-  {
-    std::cout << " OverlayToTTree: writing output tree to file " << _foutname << std::endl;
-    std::cout << " OverlayToTTree: total events processed: " << _count << std::endl;
-  }
+  _matcher.set_dR_max(_match_dR_frac * set.R);
 
-  PHTFileServer::get().cd( _foutname );
-  _tree->Write();
-  PHTFileServer::get().close();
- 
-  if ( Verbosity () > 0 ) 
+  _matcher.Match(set.truth.eta, set.truth.phi, set.recoPythia.eta, set.recoPythia.phi,
+                 set.truth_recoPythia_idx, set.truth_recoPythia_dR, set.recoPythia_truth_idx);
+  _matcher.Match(set.truth.eta, set.truth.phi, set.recoEmbed.eta, set.recoEmbed.phi,
+                 set.truth_recoEmbed_idx, set.truth_recoEmbed_dR, set.recoEmbed_truth_idx);
+
+  const size_t ntruth = set.truth.E.size();
+  set.truth_unmatched.assign(ntruth, 0);
+  for ( size_t i = 0; i < ntruth; ++i )
   {
-    std::cout << " OverlayToTTree: finished writing output file " << _foutname << std::endl;
+    if ( !set.reco_node.empty() && set.truth_recoPythia_idx[i] < 0 ) set.truth_unmatched[i] |= 0x1;
+    if ( !set.sub1_node.empty() && set.truth_recoEmbed_idx[i] < 0 ) set.truth_unmatched[i] |= 0x2;
   }
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 inline TowerInfoContainer * OverlayToTTree::getTowerInfos(PHCompositeNode *topNode, const std::string &tower_node_name)
 {
-  auto *towerinfo = findNode::getClass<TowerInfoContainer>(topNode, tower_node_name);
+  auto *towerinfo = _nodes.get<TowerInfoContainer>(topNode, tower_node_name);
   if (!towerinfo)
   {
     std::cout << PHWHERE << "Error: can't find TowerInfoContainer node " << tower_node_name << std::endl;
@@ -337,7 +465,7 @@ int OverlayToTTree::getZvertex( PHCompositeNode *topNode )
 
   _pythia_z_reco = 0.0;
 
-  auto vrtxmap = findNode::getClass< GlobalVertexMap >( topNode, "GlobalVertexMap");
+  auto vrtxmap = _nodes.get<GlobalVertexMap>( topNode, "GlobalVertexMap");
   if ( !vrtxmap )
   {
     std::cerr << PHWHERE \
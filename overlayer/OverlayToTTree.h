@@ -3,6 +3,12 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+#include <eventselection/TreeCheckpoint.h>
+
+#include <commonutils/JetMatcher.h>
+
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -10,6 +16,7 @@ class TFile;
 class TTree;
 class TF1;
 
+class JetContainer;
 class TowerInfoContainer;
 
 class PHCompositeNode;
@@ -25,6 +32,7 @@ class OverlayToTTree : public SubsysReco
   ~OverlayToTTree() override = default;
 
   int Init(PHCompositeNode *topNode) override;
+  int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
   int End(PHCompositeNode *topNode) override;
 
@@ -43,8 +51,27 @@ class OverlayToTTree : public SubsysReco
   float get_ihcal_scale() const { return _ihcal_scale; }
   float get_ohcal_scale() const { return _ohcal_scale; }
 
+  // truth / pythia reco / embedded sub1 jets of one radius. Branches
+  // are named <tag>_truth_jet_*, <tag>_recoPythia_jet_*, ... and an
+  // empty reco or sub1 node skips that collection. Without any set the
+  // r03 nodes are written under the unprefixed names.
+  void add_jet_set(const std::string &tag, const std::string &truth_node,
+                   const std::string &reco_node, const std::string &sub1_node, const float R);
+
+  // truth and reco jets are matched if dR < frac * R
+  void set_match_dR_frac(const float frac) { _match_dR_frac = frac; }
+  void set_sub1_cemc_tower_node(const std::string &s) { _sub1_cemc_tower_node = s; }
+
+  // AutoSave the tree every nevents ( or nseconds ), see TreeCheckpoint
+  void set_checkpoint(const unsigned int nevents, const unsigned int nseconds = 0) { _checkpoint.set_interval(nevents, nseconds); }
+  // continue a killed job from its last checkpoint
+  void set_resume(const bool b) { _checkpoint.set_resume(b); }
+
  private:
 
+  NodeCache _nodes {};
+  TreeCheckpoint _checkpoint {};
+
   std::string _foutname {""};
   bool _is_data {false};
 
@@ -65,7 +92,7 @@ class OverlayToTTree : public SubsysReco
   float _ohcal_scale {1.0};
 
   int   _emb_cent { -1 };
-  int   _emb_zvrtx { 0 };
+  float _emb_zvrtx { 0 };
   float _emb_b {0.0f};
   float _emb_psi2 {0.0f};
 
@@ -82,26 +109,62 @@ class OverlayToTTree : public SubsysReco
 
   float _pythia_z {0.0f};
   float _pythia_z_reco {0.0f};
-  std::vector<float> _truth_jet_E{};
-  std::vector<float> _truth_jet_pt{};
-  std::vector<float> _truth_jet_eta{};
-  std::vector<float> _truth_jet_phi{};
-  std::vector<float> _truth_jet_recoUE{};
-  std::vector<float> _truth_jet_recoUE_cemc{};
-  std::vector<float> _truth_jet_recoUE_ihcal{};
-  std::vector<float> _truth_jet_recoUE_ohcal{};
-
-  std::vector<float> _recoPythia_jet_E{};
-  std::vector<float> _recoPythia_jet_pt{};
-  std::vector<float> _recoPythia_jet_eta{};
-  std::vector<float> _recoPythia_jet_phi{};
-  std::vector<float> _recoPythia_jet_EMfrac{};
-
-  std::vector<float> _recoEmbed_jet_E{};
-  std::vector<float> _recoEmbed_jet_pt{};
-  std::vector<float> _recoEmbed_jet_eta{};
-  std::vector<float> _recoEmbed_jet_phi{};
-  std::vector<float> _recoEmbed_jet_EMfrac{};
+  float _match_dR_frac {0.75};
+  std::string _sub1_cemc_tower_node {"TOWERINFO_CALIB_CEMC_RETOWER_SUB1"};
+
+  struct JetCollection
+  {
+    std::vector<float> E{};
+    std::vector<float> pt{};
+    std::vector<float> eta{};
+    std::vector<float> phi{};
+    std::vector<float> EMfrac{};       // reco only
+    std::vector<float> recoUE{};       // truth only, from OverlayFromTTree
+    std::vector<float> recoUE_cemc{};
+    std::vector<float> recoUE_ihcal{};
+    std::vector<float> recoUE_ohcal{};
+
+    void clear();
+  };
+
+  struct JetSet
+  {
+    std::string tag{""};
+    std::string truth_node{""};
+    std::string reco_node{""};
+    std::string sub1_node{""};
+    float R{0.3};
+
+    JetCollection truth{};
+    JetCollection recoPythia{};
+    JetCollection recoEmbed{};
+
+    // index of the matched jet in the other collection, -1 if none,
+    // dR is -1 for unmatched truth jets
+    std::vector<int> truth_recoPythia_idx{};
+    std::vector<float> truth_recoPythia_dR{};
+    std::vector<int> truth_recoEmbed_idx{};
+    std::vector<float> truth_recoEmbed_dR{};
+    std::vector<int> recoPythia_truth_idx{};
+    std::vector<int> recoEmbed_truth_idx{};
+
+    // bit 0: no recoPythia match, bit 1: no recoEmbed match
+    std::vector<int> truth_unmatched{};
+
+    // leading truth dijet, from the JetSummary node
+    float truth_dijet_mass{NAN};
+    float truth_dijet_dphi{NAN};
+    float truth_dijet_xj{NAN};
+  };
+  std::vector<JetSet> _jet_sets{};
+
+  JetMatcher _matcher{};
+
+  void AddBranches(JetSet &set);
+  int FillTruthJets(PHCompositeNode *topNode, const std::string &node, JetCollection &jets);
+  int FillRecoJets(PHCompositeNode *topNode, const std::string &node, JetCollection &jets);
+  int FillSub1Jets(PHCompositeNode *topNode, const std::string &node, JetCollection &jets);
+  void MatchJets(JetSet &set);
 
   inline TowerInfoContainer* getTowerInfos(PHCompositeNode *topNode, const std::string &tower_node_name);
   int getZvertex(PHCompositeNode *topNode);
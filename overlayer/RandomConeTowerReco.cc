@@ -9,8 +9,8 @@
 #include <calobase/TowerInfoDefs.h>
 #include <calobase/RawTowerDefs.h>
 
-#include <globalvertex/GlobalVertex.h>
-#include <globalvertex/GlobalVertexMap.h>
+#include <eventselection/EventSummary.h>
+#include <eventselection/EventSummaryReco.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/Fun4AllServer.h>
@@ -30,8 +30,9 @@
 #include <jetbase/Jet.h>
 #include <jetbase/JetContainer.h>
 #include <jetbase/JetContainerv1.h>
-#include <jetbase/JetMap.h>
-#include <jetbase/JetMapv1.h>
+
+#include <eventselection/JetSummary.h>
+#include <eventselection/JetSummaryReco.h>
 
 // standard includes
 #include <cstdlib> 
@@ -120,36 +121,29 @@ int RandomConeTowerReco::Init(PHCompositeNode *topNode)
 
 }
 
+int RandomConeTowerReco::InitRun(PHCompositeNode * /*topNode*/)
+{
+  // node handles and geometry are per run
+  m_nodes.clear();
+  m_tower_eta.assign(m_inputs.size(), {});
+  m_tower_phi.assign(m_inputs.size(), {});
+  m_tower_r.assign(m_inputs.size(), {});
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int RandomConeTowerReco::process_event(PHCompositeNode *topNode)
 {
 
-  auto vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
+  // vertex decoded once per event by EventSummaryReco, missing or bad
+  // vertices (reported there) are set to 0
+  auto summary = EventSummaryReco::GetSummary(topNode, m_nodes);
   float z_vrtx {0};
-  if ( !vertexmap  || vertexmap->empty() ) 
+  if ( summary && summary->has_good_vertex() ) 
   {
-    std::cout << PHWHERE << "GlobalVertexMap node is missing, setting to 0." << std::endl;
-    // return Fun4AllReturnCodes::EVENT_OK;
-  }
-  else 
-  {
-    auto vtx = vertexmap->begin()->second;
-    if ( vtx ) 
-    {
-      z_vrtx = vtx->get_z();
-    } 
-    if ( std::isnan(z_vrtx) || z_vrtx > 1e3) 
-    {
-      static bool once = true;
-      if (once) 
-      {
-        once = false;
-        std::cout << PHWHERE << "vertex is " << z_vrtx << ". Drop all tower inputs (further vertex warning will be suppressed)." << std::endl;
-      }
-      z_vrtx = 0;
-    }
+    z_vrtx = summary->get_zvtx();
   }
 
-  auto cone = findNode::getClass<RandomConev1>(topNode, m_output_node);
+  auto cone = m_nodes.get<RandomConev1>(topNode, m_output_node);
   if ( !cone ) {
     std::cout << PHWHERE << "RandomConev1 node " << m_output_node << " is missing, doing nothing." << std::endl;
     exit(-1); // fatal error
@@ -174,54 +168,26 @@ int RandomConeTowerReco::process_event(PHCompositeNode *topNode)
 
     for ( unsigned int in = 0; in < m_inputs.size(); in++){
       
-      TowerInfoContainer * towerinfos {nullptr};
-      RawTowerGeomContainer * geom {nullptr};
-      RawTowerDefs::CalorimeterId geocaloid {RawTowerDefs::CalorimeterId::NONE};
-
-      towerinfos = findNode::getClass<TowerInfoContainer>(topNode, m_inputs[in]);
-      geom = findNode::getClass<RawTowerGeomContainer>(topNode, m_geom_names[in]);
-      if ( !towerinfos || !geom ) {
-        std::cout << PHWHERE << "Can't find TowerInfoContainer or RawTowerGeomContainer node " << m_inputs[in] << " " << m_geom_names[in] << std::endl;
+      auto towerinfos = m_nodes.get<TowerInfoContainer>(topNode, m_inputs[in]);
+      if ( !towerinfos ) {
+        std::cout << PHWHERE << "Can't find TowerInfoContainer node " << m_inputs[in] << std::endl;
         exit(-1); // fatal error
       }
-
-      if ( m_geom_names[in] == "TOWERGEOM_CEMC" ) {
-        geocaloid = RawTowerDefs::CalorimeterId::CEMC;
+      if ( m_tower_eta[in].size() != towerinfos->size() ) {
+        CacheGeometry(topNode, in, towerinfos);
       }
-      else if ( m_geom_names[in] == "TOWERGEOM_HCALIN" ) {
-        geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
-      }
-      else if ( m_geom_names[in] == "TOWERGEOM_HCALOUT" ) {
-        geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
-      } else {
-        std::cout << PHWHERE << "Unknown calorimeter name " << m_geom_names[in] << std::endl;
-        exit(-1); // fatal error
-      } // end of calorimeter id
 
+      const auto &tower_eta = m_tower_eta[in];
+      const auto &tower_phi = m_tower_phi[in];
+      const auto &tower_r = m_tower_r[in];
       unsigned int nchannels = towerinfos->size();
       for (unsigned int channel = 0; channel < nchannels; channel++) {
         auto tower = towerinfos->get_tower_at_channel(channel);
         assert(tower);
-        unsigned int calokey = towerinfos->encode_key(channel);
-        int ieta = towerinfos->getTowerEtaBin(calokey);
-        int iphi = towerinfos->getTowerPhiBin(calokey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
         bool is_masked = tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2() || std::isnan(tower->get_energy());
-        RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
-        assert(tower_geom);
-        // find if input has RETOWER and CEMC in the name
-        double r = tower_geom->get_center_radius();
-        if (m_inputs[in].find("RETOWER") != std::string::npos && m_geom_names[in].find("CEMC") != std::string::npos) {
-          auto EMCal_geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
-          assert(EMCal_geom);
-          const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-          RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
-          assert(EMCal_tower_geom);
-          r = EMCal_tower_geom->get_center_radius();
-        }
-
-        double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-        double towereta = tower_geom->get_eta();
+        const double r = tower_r[channel];
+        const double phi = tower_phi[channel];
+        const double towereta = tower_eta[channel];
         double z0 = sinh(towereta) * r;
         double z = z0 - z_vrtx;
         double eta = asinh(z / r);  // eta after shift from vertex
@@ -282,6 +248,59 @@ int RandomConeTowerReco::process_event(PHCompositeNode *topNode)
 
 }
 
+int RandomConeTowerReco::CacheGeometry( PHCompositeNode *topNode, unsigned int in, TowerInfoContainer *towerinfos )
+{
+  auto geom = m_nodes.get<RawTowerGeomContainer>(topNode, m_geom_names[in]);
+  if ( !geom ) {
+    std::cout << PHWHERE << "Can't find RawTowerGeomContainer node " << m_geom_names[in] << std::endl;
+    exit(-1); // fatal error
+  }
+
+  RawTowerDefs::CalorimeterId geocaloid {RawTowerDefs::CalorimeterId::NONE};
+  if ( m_geom_names[in] == "TOWERGEOM_CEMC" ) {
+    geocaloid = RawTowerDefs::CalorimeterId::CEMC;
+  }
+  else if ( m_geom_names[in] == "TOWERGEOM_HCALIN" ) {
+    geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
+  }
+  else if ( m_geom_names[in] == "TOWERGEOM_HCALOUT" ) {
+    geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
+  } else {
+    std::cout << PHWHERE << "Unknown calorimeter name " << m_geom_names[in] << std::endl;
+    exit(-1); // fatal error
+  } // end of calorimeter id
+
+  // retowered cemc sits at the cemc radius
+  double retower_r {NAN};
+  if (m_inputs[in].find("RETOWER") != std::string::npos && m_geom_names[in].find("CEMC") != std::string::npos) {
+    auto EMCal_geom = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+    assert(EMCal_geom);
+    const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
+    RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
+    assert(EMCal_tower_geom);
+    retower_r = EMCal_tower_geom->get_center_radius();
+  }
+
+  unsigned int nchannels = towerinfos->size();
+  m_tower_eta[in].resize(nchannels);
+  m_tower_phi[in].resize(nchannels);
+  m_tower_r[in].resize(nchannels);
+  for (unsigned int channel = 0; channel < nchannels; channel++) {
+    unsigned int calokey = towerinfos->encode_key(channel);
+    int ieta = towerinfos->getTowerEtaBin(calokey);
+    int iphi = towerinfos->getTowerPhiBin(calokey);
+    const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
+    RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
+    assert(tower_geom);
+
+    m_tower_eta[in][channel] = tower_geom->get_eta();
+    m_tower_phi[in][channel] = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
+    m_tower_r[in][channel] = std::isnan(retower_r) ? tower_geom->get_center_radius() : retower_r;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int RandomConeTowerReco::CreateNode( PHCompositeNode *topNode )
 {
   PHNodeIterator iter(topNode);
@@ -308,39 +327,22 @@ void RandomConeTowerReco::GetConeAxis(PHCompositeNode *topNode, float &cone_eta,
 
   if( m_avoid_lead_jet ) {
     if ( std::isnan(m_lead_jet_eta) || std::isnan(m_lead_jet_phi) ) {
-      float lead_eta = NAN, lead_phi = NAN, lead_pt = -1; 
-      auto jetcont = findNode::getClass<JetContainer>(topNode, m_lead_jet_node);
-      if( !jetcont ) {
-        // could be a jetmap
-        auto jetmap = findNode::getClass<JetMap>(topNode, m_lead_jet_node);
-        if( !jetmap ) {
-          std::cout << PHWHERE << "Could not find leading jet node " << m_lead_jet_node << std::endl;
-          std::cout << PHWHERE << "Disabling avoid leading jet mode for this event" << std::endl;
-          m_avoid_lead_jet = false;          
-          cone_eta = m_random->Uniform(-m_max_abs_eta, m_max_abs_eta);
-          cone_phi = m_random->Uniform(-M_PI, M_PI);
-          return;
-        } // end of !jetmap
-        
-        for(JetMap::Iter iter = jetmap->begin(); iter != jetmap->end(); ++iter) {
-          auto jet = iter->second;
-          if(jet->get_pt() > lead_pt) {
-            lead_pt = jet->get_pt();
-            lead_eta = jet->get_eta();
-            lead_phi = jet->get_phi();
-          }
-        } // end of loop over jets
-        
-      } else { // jet container
-        for ( unsigned int ijet = 0; ijet < jetcont->size(); ijet++) {
-          auto jet = jetcont->get_jet(ijet);
-          if ( jet->get_pt() > lead_pt ) {
-            lead_pt = jet->get_pt();
-            lead_eta = jet->get_eta();
-            lead_phi = jet->get_phi();
-          }
-        } // end of loop over jets
-      } // end of jet container
+      // leading jet from the per event jet summary, JetContainer or JetMap
+      int inode = -1;
+      auto summary = JetSummaryReco::GetSummary(topNode, m_lead_jet_node, inode);
+      if( !summary ) {
+        std::cout << PHWHERE << "Could not find leading jet node " << m_lead_jet_node << std::endl;
+        std::cout << PHWHERE << "Disabling avoid leading jet mode for this event" << std::endl;
+        m_avoid_lead_jet = false;          
+        cone_eta = m_random->Uniform(-m_max_abs_eta, m_max_abs_eta);
+        cone_phi = m_random->Uniform(-M_PI, M_PI);
+        return;
+      }
+
+      const bool has_lead = summary->get_nstored(inode) > 0;
+      const float lead_pt = has_lead ? summary->get_pt(inode, 0) : -1;
+      const float lead_eta = has_lead ? summary->get_eta(inode, 0) : NAN;
+      const float lead_phi = has_lead ? summary->get_phi(inode, 0) : NAN;
 
       if ( lead_pt < 0 || std::isnan(lead_eta) || std::isnan(lead_phi) ) {
         std::cout << PHWHERE << "Could not find leading jet" << std::endl;
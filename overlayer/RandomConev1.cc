@@ -2,13 +2,26 @@
 
 #include <jetbase/Jet.h>
 
+#include <TBuffer.h>
+
+#include <algorithm>
+#include <bitset>
 #include <iostream>
 #include <vector>
 #include <utility> 
 
+// On disk ( custom Streamer, class version 3 ):
+//   RandomCone base
+//   unsigned int id, float fixed eta, float fixed phi, float R
+//   uint64 source mask, then per source in the mask, ascending:
+//     float px, py, pz, e, unsigned int n_comps, n_masked
+//   float sum px, py, pz, e
+//   unsigned int ncomp, then ncomp x ( int src, unsigned int channel )
+// The per source arrays and the counters are rebuilt on read.
+
 void RandomConev1::identify(std::ostream& os) const
 {
-  os << "RandomConesv1: (eta, phi, R) = (" << m_feta << ", " << m_fphi << ", " << m_R << ")" << " n_comp = " << m_n_comps.size() << std::endl; 
+  os << "RandomConesv1: (eta, phi, R) = (" << m_feta << ", " << m_fphi << ", " << m_R << ")" << " n_comp = " << std::bitset<kMAX_SRC>(m_src_mask).count() << std::endl; 
   return ;
 }
 
@@ -18,12 +31,24 @@ void RandomConev1::Reset()
   m_feta = NAN;
   m_fphi = NAN;
   m_R = NAN;
-  m_px_map.clear();
-  m_py_map.clear();
-  m_pz_map.clear();
-  m_e_map.clear();
-  m_n_comps.clear();
-  m_n_masked_comps.clear();
+  // only sources in the mask were touched
+  for ( uint64_t mask = m_src_mask; mask; mask &= mask - 1 )
+  {
+    const unsigned int isrc = __builtin_ctzll(mask);
+    m_px_src[isrc] = 0;
+    m_py_src[isrc] = 0;
+    m_pz_src[isrc] = 0;
+    m_e_src[isrc] = 0;
+    m_n_comps_src[isrc] = 0;
+    m_n_masked_src[isrc] = 0;
+  }
+  m_sum_px = 0;
+  m_sum_py = 0;
+  m_sum_pz = 0;
+  m_sum_e = 0;
+  m_n_total = 0;
+  m_n_masked_total = 0;
+  m_src_mask = 0;
   m_comp_src_vec.clear();
   return ;
 }
@@ -37,6 +62,38 @@ int RandomConev1::isValid() const
   return 1;
 }
 
+bool RandomConev1::add_src( Jet::SRC src )
+{
+  unsigned int isrc = static_cast<unsigned int>(src);
+  if ( isrc >= kMAX_SRC )
+  {
+    std::cout << "Random Cone: source " << isrc << " out of range, max " << kMAX_SRC << std::endl;
+    return false;
+  }
+  m_src_mask |= (uint64_t{1} << isrc);
+  return true;
+}
+
+bool RandomConev1::has_src( Jet::SRC src ) const
+{
+  unsigned int isrc = static_cast<unsigned int>(src);
+  return isrc < kMAX_SRC && ( (m_src_mask >> isrc) & 1U );
+}
+
+void RandomConev1::update_totals()
+{
+  // counters from the per source arrays, the float sums are written as they are
+  m_n_total = 0;
+  m_n_masked_total = 0;
+  for ( uint64_t mask = m_src_mask; mask; mask &= mask - 1 )
+  {
+    const unsigned int isrc = __builtin_ctzll(mask);
+    m_n_total += m_n_comps_src[isrc];
+    m_n_masked_total += m_n_masked_src[isrc];
+  }
+  return ;
+}
+
 void RandomConev1::add_comp( Jet* particle , bool is_masked)
 {
   if ( !particle )
@@ -50,15 +107,7 @@ void RandomConev1::add_comp( Jet* particle , bool is_masked)
   for ( auto comp : comps ) 
   {
 
-    if ( m_n_comps.find(comp.first) == m_n_comps.end() )
-    { 
-      m_n_comps[comp.first] = 0; 
-      m_n_masked_comps[comp.first] = 0;
-      m_px_map[comp.first] = 0;
-      m_py_map[comp.first] = 0;
-      m_pz_map[comp.first] = 0;
-      m_e_map[comp.first] = 0;
-    }
+    if ( !add_src(comp.first) ) { continue; }
 
     float _px = particle->get_px();
     float _py = particle->get_py();
@@ -75,18 +124,25 @@ void RandomConev1::add_comp( Jet* particle , bool is_masked)
       _py = 0; 
       _pz = 0; 
       _e = 0; 
-      m_n_masked_comps[comp.first]++;
+      m_n_masked_src[comp.first]++;
+      m_n_masked_total++;
     }
     else 
     {
       m_comp_src_vec.push_back(comp); 
     }
 
-    m_px_map[comp.first] += _px;
-    m_py_map[comp.first] += _py;
-    m_pz_map[comp.first] += _pz;
-    m_e_map[comp.first] += _e;
-    m_n_comps[comp.first]++;
+    m_px_src[comp.first] += _px;
+    m_py_src[comp.first] += _py;
+    m_pz_src[comp.first] += _pz;
+    m_e_src[comp.first] += _e;
+    m_n_comps_src[comp.first]++;
+    m_n_total++;
+
+    m_sum_px += _px;
+    m_sum_py += _py;
+    m_sum_pz += _pz;
+    m_sum_e += _e;
     
   }
 
@@ -101,15 +157,7 @@ void RandomConev1::add_tower(Jet::SRC src, float E, float eta, float phi, unsign
     std::cout << "Random Cone: add_tower - tower with NaN in E, eta, or phi" << std::endl;
     return ;
   }
-  if ( m_n_comps.find(src) == m_n_comps.end() )
-  { 
-    m_n_comps[src] = 0; 
-    m_n_masked_comps[src] = 0;
-    m_px_map[src] = 0;
-    m_py_map[src] = 0;
-    m_pz_map[src] = 0;
-    m_e_map[src] = 0;
-  }
+  if ( !add_src(src) ) { return ; }
 
   float pt = E / cosh(eta);
   float px = pt * cos(phi);
@@ -127,71 +175,57 @@ void RandomConev1::add_tower(Jet::SRC src, float E, float eta, float phi, unsign
     py = 0; 
     pz = 0; 
     E = 0; 
-    m_n_masked_comps[src]++;
+    m_n_masked_src[src]++;
+    m_n_masked_total++;
   }
   else 
   {
     m_comp_src_vec.push_back(std::make_pair(src, ch)); 
   }
 
-  m_px_map[src] += px;
-  m_py_map[src] += py;
-  m_pz_map[src] += pz;
-  m_e_map[src] += E;
-  m_n_comps[src]++;
+  m_px_src[src] += px;
+  m_py_src[src] += py;
+  m_pz_src[src] += pz;
+  m_e_src[src] += E;
+  m_n_comps_src[src]++;
+  m_n_total++;
 
+  m_sum_px += px;
+  m_sum_py += py;
+  m_sum_pz += pz;
+  m_sum_e += E;
 
   return ;
 }
 
 float RandomConev1::sum_px() const
 {
-  float sum = 0;
-  for ( auto comp : m_px_map ) 
-  {
-    sum += comp.second;
-  }
-  return sum;
+  return m_sum_px;
 }
 
 float RandomConev1::sum_py() const
 {
-  float sum = 0;
-  for ( auto comp : m_py_map ) 
-  {
-    sum += comp.second;
-  }
-  return sum;
+  return m_sum_py;
 }
 
 float RandomConev1::sum_pz() const
 {
-  float sum = 0;
-  for ( auto comp : m_pz_map ) 
-  {
-    sum += comp.second;
-  }
-  return sum;
+  return m_sum_pz;
 }
 
 float RandomConev1::sum_e() const
 {
-  float sum = 0;
-  for ( auto comp : m_e_map ) 
-  {
-    sum += comp.second;
-  }
-  return sum;
+  return m_sum_e;
 }
 
 float RandomConev1::sum_p() const
 {
-  return std::sqrt( (sum_px() * sum_px()) + (sum_py() * sum_py()) + (sum_pz() * sum_pz()) );
+  return std::sqrt( (m_sum_px * m_sum_px) + (m_sum_py * m_sum_py) + (m_sum_pz * m_sum_pz) );
 }
 
 float RandomConev1::sum_pt() const
 {
-  return std::sqrt( (sum_px() * sum_px()) + (sum_py() * sum_py()) );
+  return std::sqrt( (m_sum_px * m_sum_px) + (m_sum_py * m_sum_py) );
 }
 
 float RandomConev1::sum_et() const
@@ -201,7 +235,7 @@ float RandomConev1::sum_et() const
   {
     return 0;
   }
-  return sum_pt() / p * sum_e();
+  return sum_pt() / p * m_sum_e;
 }
 
 float RandomConev1::sum_eta() const
@@ -211,12 +245,12 @@ float RandomConev1::sum_eta() const
   {
     return NAN;
   }
-  return std::asinh( sum_pz() / pt );
+  return std::asinh( m_sum_pz / pt );
 }
 
 float RandomConev1::sum_phi() const
 {
-  return std::atan2( sum_py(), sum_px() );
+  return std::atan2( m_sum_py, m_sum_px );
 }
 
 float RandomConev1::get_pt(Jet::SRC src) const
@@ -225,14 +259,11 @@ float RandomConev1::get_pt(Jet::SRC src) const
   {
     return sum_pt();
   } 
-  else 
+  if ( !has_src(src) ) 
   {
-    if ( m_px_map.find(src) != m_px_map.end() && m_py_map.find(src) != m_py_map.end() ) 
-    {
-      return std::sqrt( (m_px_map.at(src) * m_px_map.at(src)) + (m_py_map.at(src) * m_py_map.at(src)) );
-    }
+    return 0;
   }
-  return 0;
+  return std::sqrt( (m_px_src[src] * m_px_src[src]) + (m_py_src[src] * m_py_src[src]) );
 }
 
 float RandomConev1::get_eta(Jet::SRC src) const
@@ -241,19 +272,16 @@ float RandomConev1::get_eta(Jet::SRC src) const
   {
     return sum_eta();
   } 
-  else 
+  if ( !has_src(src) ) 
   {
-    if ( m_px_map.find(src) != m_px_map.end() && m_py_map.find(src) != m_py_map.end() && m_pz_map.find(src) != m_pz_map.end() ) 
-    {
-      float pt = std::sqrt( (m_px_map.at(src) * m_px_map.at(src)) + (m_py_map.at(src) * m_py_map.at(src)) );
-      if ( pt == 0 ) 
-      {
-        return NAN;
-      }
-      return std::asinh( m_pz_map.at(src) / pt );
-    }
+    return NAN;
   }
-  return NAN;
+  float pt = get_pt(src);
+  if ( pt == 0 ) 
+  {
+    return NAN;
+  }
+  return std::asinh( m_pz_src[src] / pt );
 }
 
 float RandomConev1::get_phi(Jet::SRC src) const
@@ -262,78 +290,47 @@ float RandomConev1::get_phi(Jet::SRC src) const
   {
     return sum_phi();
   } 
-  else 
+  if ( !has_src(src) ) 
   {
-    if ( m_px_map.find(src) != m_px_map.end() && m_py_map.find(src) != m_py_map.end() ) 
-    {
-      return std::atan2( m_py_map.at(src), m_px_map.at(src) );
-    }
+    return NAN;
   }
-  return NAN;
+  return std::atan2( m_py_src[src], m_px_src[src] );
 }
 
 float RandomConev1::get_px(Jet::SRC src) const
 {
   if ( src == Jet::SRC::VOID ) 
   {
-    return sum_px();
+    return m_sum_px;
   } 
-  else 
-  {
-    if ( m_px_map.find(src) != m_px_map.end() ) 
-    {
-      return m_px_map.at(src);
-    }
-  }
-  return 0;
+  return has_src(src) ? m_px_src[src] : 0;
 }
 
 float RandomConev1::get_py(Jet::SRC src) const
 {
   if ( src == Jet::SRC::VOID ) 
   {
-    return sum_py();
+    return m_sum_py;
   } 
-  else 
-  {
-    if ( m_py_map.find(src) != m_py_map.end() ) 
-    {
-      return m_py_map.at(src);
-    }
-  }
-  return 0;
+  return has_src(src) ? m_py_src[src] : 0;
 }
 
 float RandomConev1::get_pz(Jet::SRC src) const
 {
   if ( src == Jet::SRC::VOID ) 
   {
-    return sum_pz();
+    return m_sum_pz;
   } 
-  else 
-  {
-    if ( m_pz_map.find(src) != m_pz_map.end() ) 
-    {
-      return m_pz_map.at(src);
-    }
-  }
-  return 0;
+  return has_src(src) ? m_pz_src[src] : 0;
 }
 
 float RandomConev1::get_e(Jet::SRC src) const
 {
   if ( src == Jet::SRC::VOID ) 
   {
-    return sum_e();
+    return m_sum_e;
   } 
-  else 
-  {
-    if ( m_e_map.find(src) != m_e_map.end() ) 
-    {
-      return m_e_map.at(src);
-    }
-  }
-  return 0;
+  return has_src(src) ? m_e_src[src] : 0;
 }
 
 float RandomConev1::get_et(Jet::SRC src) const
@@ -358,42 +355,20 @@ float RandomConev1::get_et(Jet::SRC src) const
 
 unsigned int RandomConev1::n_clustered(Jet::SRC src) const
 {
-  unsigned int n = 0;
   if ( src == Jet::SRC::VOID ) 
   {
-    for (auto comp : m_n_comps)
-    {
-      n += comp.second;
-    }
+    return m_n_total;
   } 
-  else 
-  {
-    if ( m_n_comps.find(src) != m_n_comps.end() ) 
-    {
-      n = m_n_comps.at(src);
-    }
-  }
-  return n;
+  return has_src(src) ? m_n_comps_src[src] : 0;
 }
 
 unsigned int RandomConev1::n_masked(Jet::SRC src) const
 {
-  unsigned int n = 0;
   if ( src == Jet::SRC::VOID ) 
   {
-    for (auto comp : m_n_masked_comps)
-    {
-      n += comp.second;
-    }
+    return m_n_masked_total;
   } 
-  else 
-  {
-    if ( m_n_masked_comps.find(src) != m_n_masked_comps.end() ) 
-    {
-      n = m_n_masked_comps.at(src);
-    }
-  }
-  return n;
+  return has_src(src) ? m_n_masked_src[src] : 0;
 }
 
 float RandomConev1::masked_fraction(Jet::SRC src) const
@@ -409,10 +384,14 @@ float RandomConev1::masked_fraction(Jet::SRC src) const
 
 std::vector<Jet::SRC> RandomConev1::get_src_vec()
 {
+  // ascending enum order, same as the old std::map keys
   std::vector<Jet::SRC> srcs {};
-  for (auto comp : m_n_comps)
+  for ( unsigned int isrc = 0; isrc < kMAX_SRC; ++isrc )
   {
-    srcs.push_back(comp.first);
+    if ( (m_src_mask >> isrc) & 1U )
+    {
+      srcs.push_back(static_cast<Jet::SRC>(isrc));
+    }
   }
   return srcs;
 }
@@ -437,10 +416,89 @@ std::vector<std::pair<Jet::SRC, unsigned int>> RandomConev1::get_comp_src_vec(Je
   return comp_srcs;
 }
 
+void RandomConev1::Streamer(TBuffer &R__b)
+{
+  if ( R__b.IsReading() )
+  {
+    UInt_t R__s, R__c;
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+    if ( R__v < 3 )
+    { // version 1, member wise, the read rule fills the arrays
+      R__b.ReadClassBuffer(RandomConev1::Class(), this, R__v, R__s, R__c);
+      return ;
+    }
 
+    Reset();
+    RandomCone::Streamer(R__b);
+    R__b >> m_id;
+    R__b >> m_feta;
+    R__b >> m_fphi;
+    R__b >> m_R;
+
+    ULong64_t mask = 0;
+    R__b >> mask;
+    m_src_mask = mask;
+    for ( uint64_t bits = m_src_mask; bits; bits &= bits - 1 )
+    {
+      const unsigned int isrc = __builtin_ctzll(bits);
+      R__b >> m_px_src[isrc];
+      R__b >> m_py_src[isrc];
+      R__b >> m_pz_src[isrc];
+      R__b >> m_e_src[isrc];
+      R__b >> m_n_comps_src[isrc];
+      R__b >> m_n_masked_src[isrc];
+    }
+    R__b >> m_sum_px;
+    R__b >> m_sum_py;
+    R__b >> m_sum_pz;
+    R__b >> m_sum_e;
+    update_totals();
+
+    UInt_t ncomp = 0;
+    R__b >> ncomp;
+    m_comp_src_vec.resize(ncomp);
+    for ( auto & comp : m_comp_src_vec )
+    {
+      Int_t src = 0;
+      R__b >> src;
+      R__b >> comp.second;
+      comp.first = static_cast<Jet::SRC>(src);
+    }
 
+    R__b.CheckByteCount(R__s, R__c, RandomConev1::IsA());
+  }
+  else
+  {
+    UInt_t R__c = R__b.WriteVersion(RandomConev1::IsA(), kTRUE);
+    RandomCone::Streamer(R__b);
+    R__b << m_id;
+    R__b << m_feta;
+    R__b << m_fphi;
+    R__b << m_R;
 
+    R__b << static_cast<ULong64_t>(m_src_mask);
+    for ( uint64_t bits = m_src_mask; bits; bits &= bits - 1 )
+    {
+      const unsigned int isrc = __builtin_ctzll(bits);
+      R__b << m_px_src[isrc];
+      R__b << m_py_src[isrc];
+      R__b << m_pz_src[isrc];
+      R__b << m_e_src[isrc];
+      R__b << m_n_comps_src[isrc];
+      R__b << m_n_masked_src[isrc];
+    }
+    R__b << m_sum_px;
+    R__b << m_sum_py;
+    R__b << m_sum_pz;
+    R__b << m_sum_e;
 
+    R__b << static_cast<UInt_t>(m_comp_src_vec.size());
+    for ( const auto & comp : m_comp_src_vec )
+    {
+      R__b << static_cast<Int_t>(comp.first);
+      R__b << comp.second;
+    }
 
-
-
+    R__b.SetByteCount(R__c, kTRUE);
+  }
+}
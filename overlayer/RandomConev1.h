@@ -4,7 +4,7 @@
 #include "RandomCone.h"
 
 #include <cmath>
-#include <map>
+#include <cstdint>
 
 class RandomConev1 : public RandomCone
 {
@@ -56,22 +56,44 @@ class RandomConev1 : public RandomCone
     std::vector < std::pair < Jet::SRC, unsigned int > > get_comp_src_vec( Jet::SRC src = Jet::SRC::VOID) const override;
 
     
+    // sources are stored by enum value, anything at or above this is rejected
+    static const unsigned int kMAX_SRC = 64;
+
   private:
 
     unsigned int m_id {0};
-    std::map < Jet::SRC, float > m_px_map {};
-    std::map < Jet::SRC, float > m_py_map {};
-    std::map < Jet::SRC, float > m_pz_map {};
-    std::map < Jet::SRC, float > m_e_map {};
     float m_feta {NAN};
     float m_fphi {NAN};
     float m_R {NAN};
 
-    std::map< Jet::SRC, unsigned int> m_n_comps {};
-    std::map< Jet::SRC, unsigned int> m_n_masked_comps {};
+    // per source, indexed by Jet::SRC. Only the sources in m_src_mask are
+    // written, see the Streamer in RandomConev1.cc
+    float m_px_src[kMAX_SRC] {}; //!
+    float m_py_src[kMAX_SRC] {}; //!
+    float m_pz_src[kMAX_SRC] {}; //!
+    float m_e_src[kMAX_SRC] {}; //!
+    unsigned int m_n_comps_src[kMAX_SRC] {}; //!
+    unsigned int m_n_masked_src[kMAX_SRC] {}; //!
+
+    // running totals over all sources
+    float m_sum_px {0}; //!
+    float m_sum_py {0}; //!
+    float m_sum_pz {0}; //!
+    float m_sum_e {0}; //!
+    unsigned int m_n_total {0}; //!
+    unsigned int m_n_masked_total {0}; //!
+    uint64_t m_src_mask {0}; //! bit src set once src has a component
+
     std::vector < std::pair < Jet::SRC, unsigned int > > m_comp_src_vec {};
 
-    ClassDefOverride(RandomConev1, 1);
+    bool add_src( Jet::SRC src );
+    bool has_src( Jet::SRC src ) const;
+    void update_totals();
+
+    // version 3: custom Streamer writing the populated sources only.
+    // Version 1 ( maps ) is converted by the read rule in
+    // RandomConev1LinkDef.h
+    ClassDefOverride(RandomConev1, 3);
 };
 
 #endif // UNDERLYINGEVENT_RANDOMCONEV1_H
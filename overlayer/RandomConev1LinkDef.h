@@ -1,5 +1,20 @@
 #ifdef __CINT__
 
-#pragma link C++ class RandomConev1 + ;
+#pragma link C++ class RandomConev1 - ;
+
+// version 1 kept the per source sums in std::map, fill the arrays and totals from them
+#pragma read sourceClass="RandomConev1" version="[1]" targetClass="RandomConev1" \
+  source="std::map<Jet::SRC,float> m_px_map; std::map<Jet::SRC,float> m_py_map; std::map<Jet::SRC,float> m_pz_map; std::map<Jet::SRC,float> m_e_map; std::map<Jet::SRC,unsigned int> m_n_comps; std::map<Jet::SRC,unsigned int> m_n_masked_comps" \
+  target="m_px_src, m_py_src, m_pz_src, m_e_src, m_n_comps_src, m_n_masked_src, m_sum_px, m_sum_py, m_sum_pz, m_sum_e, m_n_total, m_n_masked_total, m_src_mask" \
+  code="{ \
+    m_sum_px = 0; m_sum_py = 0; m_sum_pz = 0; m_sum_e = 0; m_n_total = 0; m_n_masked_total = 0; m_src_mask = 0; \
+    for ( unsigned int i = 0; i < RandomConev1::kMAX_SRC; ++i ) { m_px_src[i] = 0; m_py_src[i] = 0; m_pz_src[i] = 0; m_e_src[i] = 0; m_n_comps_src[i] = 0; m_n_masked_src[i] = 0; } \
+    for ( const auto &p : onfile.m_n_comps ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_n_comps_src[p.first] = p.second; m_n_total += p.second; m_src_mask |= ( uint64_t{1} << p.first ); } } \
+    for ( const auto &p : onfile.m_n_masked_comps ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_n_masked_src[p.first] = p.second; m_n_masked_total += p.second; } } \
+    for ( const auto &p : onfile.m_px_map ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_px_src[p.first] = p.second; m_sum_px += p.second; } } \
+    for ( const auto &p : onfile.m_py_map ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_py_src[p.first] = p.second; m_sum_py += p.second; } } \
+    for ( const auto &p : onfile.m_pz_map ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_pz_src[p.first] = p.second; m_sum_pz += p.second; } } \
+    for ( const auto &p : onfile.m_e_map ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_e_src[p.first] = p.second; m_sum_e += p.second; } } \
+  }"
 
 #endif /* __CINT__ */
@@ -46,6 +46,18 @@ void CaloWindowMapv1::add_tower(const unsigned int iphi, const unsigned int ieta
     return;
 }
 
+float CaloWindowMapv1::get_tower_energy(const unsigned int iphi, const unsigned int ieta) const
+{
+    unsigned int index = iphi + ieta * m_nphi;
+    if (iphi >= m_nphi || ieta >= m_neta || index >= m_towers.size()) { return 0; }
+    return m_towers[index];
+}
+
+bool CaloWindowMapv1::is_tower_masked(const unsigned int iphi, const unsigned int ieta) const
+{
+    return get_tower_energy(iphi, ieta) == kMASK_ENERGY;
+}
+
 std::vector<float> CaloWindowMapv1::get_calo_windows(const unsigned int dphi, const unsigned int deta) const
 {
     
@@ -159,3 +171,118 @@ std::vector< std::pair<float, unsigned int> > CaloWindowMapv1::get_window_comps_
 }
 
 
+
+std::vector<CaloWindowMap::Window> CaloWindowMapv1::get_hottest_windows(const unsigned int dphi, const unsigned int deta, const unsigned int k) const
+{
+    if (dphi == 0 || dphi > m_nphi || deta == 0 || deta > m_neta) {
+        std::cerr << "CaloWindowMapv1::get_hottest_windows - invalid dphi or deta: " 
+                  << dphi << ", " << deta << std::endl;
+        return {};
+    }
+
+    if (k == 0 || m_towers.size() < m_nphi * m_neta) { return {}; }
+
+    // a chosen window overlaps at most noverlap windows (itself included), so
+    // the k greedily chosen windows are always among the best (k-1)*noverlap+1
+    const unsigned int neta_windows = m_neta - deta + 1;
+    const unsigned int noverlap = std::min(m_nphi, 2 * dphi - 1) * std::min(neta_windows, 2 * deta - 1);
+    const std::size_t ncandidates = std::min(static_cast<std::size_t>(k - 1) * noverlap + 1, 
+                                             static_cast<std::size_t>(neta_windows) * m_nphi);
+
+    // higher energy first, lower window index on ties
+    auto better = [](const Window &a, const Window &b) {
+        return a.energy > b.energy || (a.energy == b.energy && a.iwindow < b.iwindow);
+    };
+
+    // bounded heap with the worst candidate on top
+    std::vector<Window> candidates;
+    candidates.reserve(ncandidates);
+    auto push_candidate = [&](const Window &window) {
+        if (candidates.size() < ncandidates) {
+            candidates.push_back(window);
+            std::push_heap(candidates.begin(), candidates.end(), better);
+        } else if (better(window, candidates.front())) {
+            std::pop_heap(candidates.begin(), candidates.end(), better);
+            candidates.back() = window;
+            std::push_heap(candidates.begin(), candidates.end(), better);
+        }
+    };
+
+    // deta tall column sums, slid up in eta one row at a time
+    std::vector<double> column(m_nphi, 0);
+    std::vector<int> column_masked(m_nphi, 0);
+    auto add_row = [&](const unsigned int eta, const int sign) {
+        for (unsigned int phi = 0; phi < m_nphi; ++phi) {
+            const float e = m_towers[phi + eta * m_nphi];
+            if (e == kMASK_ENERGY) {
+                column_masked[phi] += sign;
+            } else {
+                column[phi] += sign * e;
+            }
+        }
+    };
+    for (unsigned int eta = 0; eta < deta; ++eta) { add_row(eta, 1); }
+
+    for (unsigned int eta_start = 0; eta_start < neta_windows; ++eta_start) {
+        if (eta_start > 0) {
+            add_row(eta_start - 1, -1);
+            add_row(eta_start + deta - 1, 1);
+        }
+
+        // dphi wide sum of the columns, slid around in phi
+        double window_sum = 0;
+        int window_masked = 0;
+        for (unsigned int dphi_idx = 0; dphi_idx < dphi; ++dphi_idx) {
+            window_sum += column[dphi_idx];
+            window_masked += column_masked[dphi_idx];
+        }
+
+        for (unsigned int phi_start = 0; phi_start < m_nphi; ++phi_start) {
+            if (phi_start > 0) {
+                const unsigned int phi_in = (phi_start + dphi - 1) % m_nphi;
+                window_sum += column[phi_in] - column[phi_start - 1];
+                window_masked += column_masked[phi_in] - column_masked[phi_start - 1];
+            }
+            if (window_masked > 0) { continue; }
+
+            Window window;
+            window.iwindow = phi_start + eta_start * m_nphi;
+            window.iphi = phi_start;
+            window.ieta = eta_start;
+            window.energy = static_cast<float>(window_sum);
+            push_candidate(window);
+        }
+    }
+
+    // best first, then keep each one that shares no tower with those already taken
+    std::sort_heap(candidates.begin(), candidates.end(), better);
+
+    std::vector<Window> hottest;
+    hottest.reserve(k);
+    for (const auto &candidate : candidates) {
+        bool overlaps = false;
+        for (const auto &taken : hottest) {
+            const unsigned int dphi_diff = (candidate.iphi + m_nphi - taken.iphi) % m_nphi;
+            const bool phi_overlap = dphi_diff < dphi || dphi_diff > m_nphi - dphi;
+            const unsigned int deta_diff = candidate.ieta > taken.ieta ? candidate.ieta - taken.ieta : taken.ieta - candidate.ieta;
+            if (phi_overlap && deta_diff < deta) {
+                overlaps = true;
+                break;
+            }
+        }
+        if (overlaps) { continue; }
+
+        // same summation order as get_calo_windows so the energies agree exactly
+        Window window = candidate;
+        window.energy = 0;
+        for (unsigned int deta_idx = 0; deta_idx < deta; ++deta_idx) {
+            for (unsigned int dphi_idx = 0; dphi_idx < dphi; ++dphi_idx) {
+                window.energy += m_towers[(window.iphi + dphi_idx) % m_nphi + (window.ieta + deta_idx) * m_nphi];
+            }
+        }
+        hottest.push_back(window);
+        if (hottest.size() == k) { break; }
+    }
+
+    return hottest;
+}
@@ -0,0 +1,409 @@
+#include "CaloWindowMapv2.h"
+
+#include <jetbase/Jet.h>
+
+#include <commonutils/HalfFloat.h>
+
+#include <TBuffer.h>
+
+#include <iostream>
+#include <utility>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// On disk ( custom Streamer, class version 1 ):
+//   CaloWindowMap base
+//   int src, unsigned int nphi, unsigned int neta, int storage, float step
+//   unsigned int nmask_words, then nmask_words x uint32 mask bits ( 0 if nothing is masked )
+//   nphi*neta energies: float ( kFLOAT ), fp16 ( kHALF ) or int16 multiples of step ( kQUANTIZED,
+//   clamped to +-kQUANTIZED_MAX )
+// Masked towers are written as 0, the bitset carries the mask.
+
+CaloWindowMapv2::CaloWindowMapv2()
+  : m_src(Jet::SRC::VOID)
+  , m_nphi(0)
+  , m_neta(0)
+  , m_towers()
+  , m_mask()
+{
+}
+
+void CaloWindowMapv2::identify(std::ostream &os) const
+{
+    os << "CaloWindowMapv2: (nphi, neta) = (" << m_nphi << ", " << m_neta << ") with " << m_towers.size() << " towers"
+       << ", storage " << m_storage << (m_storage == kQUANTIZED ? " step " + std::to_string(m_step) : "")
+       << (m_nsaturated > 0 ? ", " + std::to_string(m_nsaturated) + " towers saturated" : "") << std::endl;
+}
+
+int CaloWindowMapv2::isValid() const
+{
+    if (m_src == Jet::SRC::VOID || m_nphi == 0 || m_neta == 0) { return 0; }
+    return 1;
+}
+
+void CaloWindowMapv2::CopyFrom(const PHObject *obj)
+{
+    auto *map = dynamic_cast<const CaloWindowMap *>(obj);
+    if (!map) {
+        std::cerr << "CaloWindowMapv2::CopyFrom - not a CaloWindowMap" << std::endl;
+        return;
+    }
+
+    // any version, masked towers come back as kMASK_ENERGY
+    set_src(map->get_src());
+    if (auto *map_v2 = dynamic_cast<const CaloWindowMapv2 *>(obj)) {
+        set_storage(map_v2->get_storage(), map_v2->get_quantization_step());
+    }
+    set_nphi_neta(map->get_nphi(), map->get_neta());
+    for (unsigned int ieta = 0; ieta < m_neta; ++ieta) {
+        for (unsigned int iphi = 0; iphi < m_nphi; ++iphi) {
+            add_tower(iphi, ieta, map->get_tower_energy(iphi, ieta), map->is_tower_masked(iphi, ieta));
+        }
+    }
+}
+
+void CaloWindowMapv2::set_nphi_neta(unsigned int nphi, unsigned int neta)
+{
+    if (nphi != m_nphi || neta != m_neta || m_towers.size() != nphi * neta) {
+        m_nphi = nphi;
+        m_neta = neta;
+        m_towers.assign(m_nphi * m_neta, 0);
+        m_mask.assign((m_nphi * m_neta + 31) / 32, 0);
+        return;
+    }
+    clear_towers();
+}
+
+void CaloWindowMapv2::clear_towers()
+{
+    std::fill(m_towers.begin(), m_towers.end(), 0);
+    std::fill(m_mask.begin(), m_mask.end(), 0);
+}
+
+void CaloWindowMapv2::add_tower(const unsigned int iphi, const unsigned int ieta, const float pt, bool is_masked)
+{
+    if (iphi >= m_nphi || ieta >= m_neta) {
+        std::cerr << "CaloWindowMapv2::add_tower - invalid iphi or ieta: "
+                    << iphi << ", " << ieta << std::endl;
+        return;
+    }
+
+    unsigned int index = iphi + ieta * m_nphi;
+    if (is_masked) {
+        m_towers[index] = 0;
+        m_mask[index >> 5U] |= (1U << (index & 31U));
+    } else {
+        m_towers[index] = pt;
+        m_mask[index >> 5U] &= ~(1U << (index & 31U));
+    }
+    return;
+}
+
+float CaloWindowMapv2::get_tower_energy(const unsigned int iphi, const unsigned int ieta) const
+{
+    if (iphi >= m_nphi || ieta >= m_neta) { return 0; }
+    const unsigned int index = iphi + ieta * m_nphi;
+    return masked(index) ? kMASK_ENERGY : m_towers[index];
+}
+
+bool CaloWindowMapv2::is_tower_masked(const unsigned int iphi, const unsigned int ieta) const
+{
+    if (iphi >= m_nphi || ieta >= m_neta) { return false; }
+    return masked(iphi + ieta * m_nphi);
+}
+
+std::vector<float> CaloWindowMapv2::get_calo_windows(const unsigned int dphi, const unsigned int deta) const
+{
+    if (dphi == 0 || dphi > m_nphi || deta == 0 || deta > m_neta) {
+        std::cout << "CaloWindowMapv2::get_calowindows - invalid dphi or deta: " << dphi << ", " << deta << std::endl;
+        return std::vector<float>();
+    }
+
+    unsigned int num_windows = (m_neta - deta + 1) * m_nphi;
+    std::vector<float> calo_windows(num_windows, 0);
+
+    for (unsigned int window_idx = 0; window_idx < num_windows; ++window_idx) {
+        unsigned int eta_start = window_idx / m_nphi;
+        unsigned int phi_start = window_idx % m_nphi;
+
+        bool is_masked = false;
+        float window_sum = 0;
+
+        for (unsigned int deta_idx = 0; deta_idx < deta; ++deta_idx) {
+            unsigned int eta = eta_start + deta_idx;
+
+            for (unsigned int dphi_idx = 0; dphi_idx < dphi; ++dphi_idx) {
+                unsigned int phi = (phi_start + dphi_idx) % m_nphi;
+                unsigned int tower_idx = phi + eta * m_nphi;
+
+                is_masked |= masked(tower_idx);
+                window_sum += m_towers[tower_idx];
+            }
+        }
+
+        calo_windows[window_idx] = is_masked ? kMASK_ENERGY : window_sum;
+    }
+
+    return calo_windows;
+}
+
+std::vector< std::pair<unsigned int, unsigned int> > CaloWindowMapv2::get_window_comps_phieta(const unsigned int dphi, const unsigned int deta, const unsigned int iwindow) const
+{
+    if (dphi == 0 || dphi > m_nphi || deta == 0 || deta > m_neta) {
+        std::cerr << "CaloWindowMapv2::get_window_comps_phieta - invalid dphi or deta: "
+                  << dphi << ", " << deta << std::endl;
+        return {};
+    }
+
+    unsigned int nwindows = (m_neta - deta + 1) * m_nphi;
+    if (iwindow >= nwindows) {
+        std::cerr << "CaloWindowMapv2::get_window_comps_phieta - invalid iwindow: "
+                  << iwindow << std::endl;
+        return {};
+    }
+
+    unsigned int eta_start = iwindow / m_nphi;
+    unsigned int phi_start = iwindow % m_nphi;
+
+    std::vector<std::pair<unsigned int, unsigned int>> window_comps;
+    window_comps.reserve(dphi * deta);
+
+    for (unsigned int deta_idx = 0; deta_idx < deta; ++deta_idx) {
+        unsigned int eta = eta_start + deta_idx;
+
+        for (unsigned int dphi_idx = 0; dphi_idx < dphi; ++dphi_idx) {
+            unsigned int phi = (phi_start + dphi_idx) % m_nphi;
+            window_comps.emplace_back(phi, eta);
+        }
+    }
+
+    return window_comps;
+}
+
+std::vector< std::pair<float, unsigned int> > CaloWindowMapv2::get_window_comps_energy_key(const unsigned int dphi, const unsigned int deta, const unsigned int iwindow) const
+{
+    if (dphi == 0 || dphi > m_nphi || deta == 0 || deta > m_neta) {
+        std::cerr << "CaloWindowMapv2::get_window_comps_energy_key - invalid dphi or deta: "
+                  << dphi << ", " << deta << std::endl;
+        return {};
+    }
+
+    unsigned int nwindows = (m_neta - deta + 1) * m_nphi;
+    if (iwindow >= nwindows) {
+        std::cerr << "CaloWindowMapv2::get_window_comps_energy_key - invalid iwindow: "
+                  << iwindow << std::endl;
+        return {};
+    }
+
+    unsigned int eta_start = iwindow / m_nphi;
+    unsigned int phi_start = iwindow % m_nphi;
+
+    // key is phi + (eta << 16), masked towers have kMASK_ENERGY
+    std::vector<std::pair<float, unsigned int>> window_comps;
+    window_comps.reserve(dphi * deta);
+
+    for (unsigned int deta_idx = 0; deta_idx < deta; ++deta_idx) {
+        unsigned int eta = eta_start + deta_idx;
+
+        for (unsigned int dphi_idx = 0; dphi_idx < dphi; ++dphi_idx) {
+            unsigned int phi = (phi_start + dphi_idx) % m_nphi;
+            unsigned int key = phi + (eta << 16U);
+            window_comps.emplace_back(get_tower_energy(phi, eta), key);
+        }
+    }
+
+    return window_comps;
+}
+
+std::vector<CaloWindowMap::Window> CaloWindowMapv2::get_hottest_windows(const unsigned int dphi, const unsigned int deta, const unsigned int k) const
+{
+    if (dphi == 0 || dphi > m_nphi || deta == 0 || deta > m_neta) {
+        std::cerr << "CaloWindowMapv2::get_hottest_windows - invalid dphi or deta: "
+                  << dphi << ", " << deta << std::endl;
+        return {};
+    }
+
+    if (k == 0 || m_towers.size() < m_nphi * m_neta) { return {}; }
+
+    // same selection as CaloWindowMapv1::get_hottest_windows, masks from the bitset
+    const unsigned int neta_windows = m_neta - deta + 1;
+    const unsigned int noverlap = std::min(m_nphi, 2 * dphi - 1) * std::min(neta_windows, 2 * deta - 1);
+    const std::size_t ncandidates = std::min(static_cast<std::size_t>(k - 1) * noverlap + 1,
+                                             static_cast<std::size_t>(neta_windows) * m_nphi);
+
+    auto better = [](const Window &a, const Window &b) {
+        return a.energy > b.energy || (a.energy == b.energy && a.iwindow < b.iwindow);
+    };
+
+    std::vector<Window> candidates;
+    candidates.reserve(ncandidates);
+    auto push_candidate = [&](const Window &window) {
+        if (candidates.size() < ncandidates) {
+            candidates.push_back(window);
+            std::push_heap(candidates.begin(), candidates.end(), better);
+        } else if (better(window, candidates.front())) {
+            std::pop_heap(candidates.begin(), candidates.end(), better);
+            candidates.back() = window;
+            std::push_heap(candidates.begin(), candidates.end(), better);
+        }
+    };
+
+    std::vector<double> column(m_nphi, 0);
+    std::vector<int> column_masked(m_nphi, 0);
+    auto add_row = [&](const unsigned int eta, const int sign) {
+        for (unsigned int phi = 0; phi < m_nphi; ++phi) {
+            const unsigned int index = phi + eta * m_nphi;
+            column[phi] += sign * m_towers[index];
+            column_masked[phi] += sign * static_cast<int>(masked(index));
+        }
+    };
+    for (unsigned int eta = 0; eta < deta; ++eta) { add_row(eta, 1); }
+
+    for (unsigned int eta_start = 0; eta_start < neta_windows; ++eta_start) {
+        if (eta_start > 0) {
+            add_row(eta_start - 1, -1);
+            add_row(eta_start + deta - 1, 1);
+        }
+
+        double window_sum = 0;
+        int window_masked = 0;
+        for (unsigned int dphi_idx = 0; dphi_idx < dphi; ++dphi_idx) {
+            window_sum += column[dphi_idx];
+            window_masked += column_masked[dphi_idx];
+        }
+
+        for (unsigned int phi_start = 0; phi_start < m_nphi; ++phi_start) {
+            if (phi_start > 0) {
+                const unsigned int phi_in = (phi_start + dphi - 1) % m_nphi;
+                window_sum += column[phi_in] - column[phi_start - 1];
+                window_masked += column_masked[phi_in] - column_masked[phi_start - 1];
+            }
+            if (window_masked > 0) { continue; }
+
+            Window window;
+            window.iwindow = phi_start + eta_start * m_nphi;
+            window.iphi = phi_start;
+            window.ieta = eta_start;
+            window.energy = static_cast<float>(window_sum);
+            push_candidate(window);
+        }
+    }
+
+    std::sort_heap(candidates.begin(), candidates.end(), better);
+
+    std::vector<Window> hottest;
+    hottest.reserve(k);
+    for (const auto &candidate : candidates) {
+        bool overlaps = false;
+        for (const auto &taken : hottest) {
+            const unsigned int dphi_diff = (candidate.iphi + m_nphi - taken.iphi) % m_nphi;
+            const bool phi_overlap = dphi_diff < dphi || dphi_diff > m_nphi - dphi;
+            const unsigned int deta_diff = candidate.ieta > taken.ieta ? candidate.ieta - taken.ieta : taken.ieta - candidate.ieta;
+            if (phi_overlap && deta_diff < deta) {
+                overlaps = true;
+                break;
+            }
+        }
+        if (overlaps) { continue; }
+
+        Window window = candidate;
+        window.energy = 0;
+        for (unsigned int deta_idx = 0; deta_idx < deta; ++deta_idx) {
+            for (unsigned int dphi_idx = 0; dphi_idx < dphi; ++dphi_idx) {
+                window.energy += m_towers[(window.iphi + dphi_idx) % m_nphi + (window.ieta + deta_idx) * m_nphi];
+            }
+        }
+        hottest.push_back(window);
+        if (hottest.size() == k) { break; }
+    }
+
+    return hottest;
+}
+
+void CaloWindowMapv2::Streamer(TBuffer &R__b)
+{
+    if (R__b.IsReading()) {
+        UInt_t R__s, R__c;
+        R__b.ReadVersion(&R__s, &R__c); // only version 1 so far
+        CaloWindowMap::Streamer(R__b);
+
+        Int_t src = 0;
+        UInt_t nphi = 0, neta = 0, nmask_words = 0;
+        R__b >> src;
+        R__b >> nphi;
+        R__b >> neta;
+        R__b >> m_storage;
+        R__b >> m_step;
+        m_src = static_cast<Jet::SRC>(src);
+        set_nphi_neta(nphi, neta);
+
+        R__b >> nmask_words;
+        if (nmask_words == m_mask.size()) {
+            R__b.ReadFastArray(m_mask.data(), nmask_words);
+        } else if (nmask_words > 0) {
+            std::vector<UInt_t> words(nmask_words);
+            R__b.ReadFastArray(words.data(), nmask_words);
+            std::copy_n(words.begin(), std::min<std::size_t>(nmask_words, m_mask.size()), m_mask.begin());
+        }
+
+        const UInt_t ntowers = m_towers.size();
+        if (m_storage == kHALF) {
+            std::vector<UShort_t> packed(ntowers);
+            R__b.ReadFastArray(packed.data(), ntowers);
+            for (UInt_t i = 0; i < ntowers; ++i) { m_towers[i] = HalfFloat::half_to_float(packed[i]); }
+        } else if (m_storage == kQUANTIZED) {
+            std::vector<Short_t> packed(ntowers);
+            R__b.ReadFastArray(packed.data(), ntowers);
+            for (UInt_t i = 0; i < ntowers; ++i) { m_towers[i] = packed[i] * m_step; }
+        } else {
+            R__b.ReadFastArray(m_towers.data(), ntowers);
+        }
+
+        R__b.CheckByteCount(R__s, R__c, CaloWindowMapv2::IsA());
+    } else {
+        UInt_t R__c = R__b.WriteVersion(CaloWindowMapv2::IsA(), kTRUE);
+        CaloWindowMap::Streamer(R__b);
+
+        R__b << static_cast<Int_t>(m_src);
+        R__b << m_nphi;
+        R__b << m_neta;
+        R__b << m_storage;
+        R__b << m_step;
+
+        const bool any_masked = std::any_of(m_mask.begin(), m_mask.end(), [](uint32_t word) { return word != 0; });
+        const UInt_t nmask_words = any_masked ? m_mask.size() : 0;
+        R__b << nmask_words;
+        if (nmask_words > 0) {
+            R__b.WriteFastArray(m_mask.data(), nmask_words);
+        }
+
+        const UInt_t ntowers = m_towers.size();
+        if (m_storage == kHALF) {
+            std::vector<UShort_t> packed(ntowers);
+            for (UInt_t i = 0; i < ntowers; ++i) { packed[i] = HalfFloat::float_to_half(m_towers[i]); }
+            R__b.WriteFastArray(packed.data(), ntowers);
+        } else if (m_storage == kQUANTIZED) {
+            std::vector<Short_t> packed(ntowers);
+            unsigned long nsaturated = 0;
+            for (UInt_t i = 0; i < ntowers; ++i) {
+                const float q = std::round(m_towers[i] / m_step);
+                if (std::fabs(q) > kQUANTIZED_MAX) { ++nsaturated; }
+                packed[i] = static_cast<Short_t>(std::max<float>(-kQUANTIZED_MAX, std::min<float>(kQUANTIZED_MAX, q)));
+            }
+            R__b.WriteFastArray(packed.data(), ntowers);
+            if (nsaturated > 0) {
+                // warn once per object, the total is kept in m_nsaturated
+                if (m_nsaturated == 0) {
+                    std::cout << "CaloWindowMapv2::Streamer - " << nsaturated << " tower energies beyond +-" << get_quantization_range()
+                              << " GeV clamped by the quantization step " << m_step << ", use a larger step or kHALF" << std::endl;
+                }
+                m_nsaturated += nsaturated;
+            }
+        } else {
+            R__b.WriteFastArray(m_towers.data(), ntowers);
+        }
+
+        R__b.SetByteCount(R__c, kTRUE);
+    }
+}
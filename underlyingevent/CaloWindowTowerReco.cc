@@ -1,5 +1,5 @@
 #include "CaloWindowTowerReco.h"
-#include "CaloWindowMapv1.h"
+#include "CaloWindowMapv2.h"
 
 #include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
@@ -9,8 +9,8 @@
 #include <calobase/TowerInfoDefs.h>
 #include <calobase/RawTowerDefs.h>
 
-#include <globalvertex/GlobalVertex.h>
-#include <globalvertex/GlobalVertexMap.h>
+#include <eventselection/EventSummary.h>
+#include <eventselection/EventSummaryReco.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/Fun4AllServer.h>
@@ -83,70 +83,56 @@ int CaloWindowTowerReco::Init(PHCompositeNode *topNode)
 
 }
 
+int CaloWindowTowerReco::InitRun(PHCompositeNode * /*topNode*/)
+{
+  // node handles and geometry are per run
+  m_nodes.clear();
+  m_tower_eta.assign(m_inputs.size(), {});
+  m_tower_r.assign(m_inputs.size(), {});
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int CaloWindowTowerReco::process_event(PHCompositeNode *topNode)
 {
 
-  auto vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
-  if ( !vertexmap  || vertexmap->empty() ) {
+  // vertex decoded once per event by EventSummaryReco
+  auto summary = EventSummaryReco::GetSummary(topNode, m_nodes);
+  if ( !summary || summary->get_vertex_status() == EventSummary::kVERTEX_MISSING ) {
     std::cout << PHWHERE << "GlobalVertexMap node is missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
- 
-  auto vtx = vertexmap->begin()->second;
-  float z_vrtx {NAN};
-  if ( vtx ) {
-    z_vrtx = vtx->get_z();
-  } 
-  if ( std::isnan(z_vrtx) || z_vrtx > 1e3) {
-    static bool once = true;
-    if (once) {
-      once = false;
-      std::cout << PHWHERE << "vertex is " << z_vrtx << ". Drop all tower inputs (further vertex warning will be suppressed)." << std::endl;
-    }
-    return Fun4AllReturnCodes::ABORTEVENT;
+  if ( !summary->has_good_vertex() ) {
+    return Fun4AllReturnCodes::ABORTEVENT; // drop all tower inputs
   }
+  const float z_vrtx = summary->get_zvtx();
   
   for ( unsigned int in = 0; in < m_inputs.size(); in++ ) {
       
-    TowerInfoContainer * towerinfos {nullptr};
-    RawTowerGeomContainer * geom {nullptr};
-    RawTowerDefs::CalorimeterId geocaloid {RawTowerDefs::CalorimeterId::NONE};
-
-    towerinfos = findNode::getClass<TowerInfoContainer>(topNode, m_inputs[in]);
-    geom = findNode::getClass<RawTowerGeomContainer>(topNode, m_geom_names[in]);
-    if ( !towerinfos || !geom ) {
-      std::cout << PHWHERE << "Can't find TowerInfoContainer or RawTowerGeomContainer node " << m_inputs[in] << " " << m_geom_names[in] << std::endl;
+    auto towerinfos = m_nodes.get<TowerInfoContainer>(topNode, m_inputs[in]);
+    if ( !towerinfos ) {
+      std::cout << PHWHERE << "Can't find TowerInfoContainer node " << m_inputs[in] << std::endl;
       exit(-1); // fatal error
     }
-
-    if ( m_geom_names[in] == "TOWERGEOM_CEMC" ) {
-      geocaloid = RawTowerDefs::CalorimeterId::CEMC;
-    }
-    else if ( m_geom_names[in] == "TOWERGEOM_HCALIN" ) {
-      geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
+    if ( m_tower_eta[in].size() != towerinfos->size() ) {
+      CacheGeometry(topNode, in, towerinfos);
     }
-    else if ( m_geom_names[in] == "TOWERGEOM_HCALOUT" ) {
-      geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
-    } else {
-      std::cout << PHWHERE << "Unknown calorimeter name " << m_geom_names[in] << std::endl;
-      exit(-1); // fatal error
-    } // end of calorimeter id
 
-    CaloWindowMap *window = findNode::getClass<CaloWindowMap>(topNode, m_window_names[in]);
+    CaloWindowMap *window = m_nodes.get<CaloWindowMap>(topNode, m_window_names[in]);
     if ( !window ) {
       std::cout << PHWHERE << "CaloWindowMap node " << m_window_names[in] << " is missing, doing nothing." << std::endl;
       exit(-1); // fatal error
     }
 
-    window -> Reset();
     window -> set_src(m_srcs[in]);
     if ( m_geom_names[in].find("CEMC") != std::string::npos ) {
       window -> set_nphi_neta(CaloWindowTowerReco::nphi_emcal , CaloWindowTowerReco::neta_emcal);
     } else {
       window -> set_nphi_neta(CaloWindowTowerReco::nphi_ihcal , CaloWindowTowerReco::neta_ihcal);
     }
-    window -> clear_towers(); // sets length of m_towers to m_nphi*m_neta and sets all elements to 0
+    window -> clear_towers(); // v2 keeps its buffer, only zeroes it (v1 resizes here)
 
+    const auto &tower_eta = m_tower_eta[in];
+    const auto &tower_r = m_tower_r[in];
     unsigned int nchannels = towerinfos->size();
     for (unsigned int channel = 0; channel < nchannels; channel++) {
       auto tower = towerinfos->get_tower_at_channel(channel);
@@ -157,22 +143,8 @@ int CaloWindowTowerReco::process_event(PHCompositeNode *topNode)
 
       bool is_masked = tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2() || std::isnan(tower->get_energy());
       
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
-      auto tower_geom = geom->get_tower_geometry(key);
-      assert(tower_geom);
-
-      // find if input has RETOWER and CEMC in the name
-      double r = tower_geom->get_center_radius();
-      if (m_inputs[in].find("RETOWER") != std::string::npos && m_geom_names[in].find("CEMC") != std::string::npos) {
-        auto EMCal_geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
-        assert(EMCal_geom);
-        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-        auto EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
-        assert(EMCal_tower_geom);
-        r = EMCal_tower_geom->get_center_radius();
-      }
-
-      double towereta = tower_geom->get_eta();
+      const double r = tower_r[channel];
+      const double towereta = tower_eta[channel];
       double z0 = sinh(towereta) * r;
       double z = z0 - z_vrtx;
       double eta = asinh(z / r);  
@@ -186,6 +158,58 @@ int CaloWindowTowerReco::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int CaloWindowTowerReco::CacheGeometry( PHCompositeNode *topNode, unsigned int in, TowerInfoContainer *towerinfos )
+{
+  auto geom = m_nodes.get<RawTowerGeomContainer>(topNode, m_geom_names[in]);
+  if ( !geom ) {
+    std::cout << PHWHERE << "Can't find RawTowerGeomContainer node " << m_geom_names[in] << std::endl;
+    exit(-1); // fatal error
+  }
+
+  RawTowerDefs::CalorimeterId geocaloid {RawTowerDefs::CalorimeterId::NONE};
+  if ( m_geom_names[in] == "TOWERGEOM_CEMC" ) {
+    geocaloid = RawTowerDefs::CalorimeterId::CEMC;
+  }
+  else if ( m_geom_names[in] == "TOWERGEOM_HCALIN" ) {
+    geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
+  }
+  else if ( m_geom_names[in] == "TOWERGEOM_HCALOUT" ) {
+    geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
+  } else {
+    std::cout << PHWHERE << "Unknown calorimeter name " << m_geom_names[in] << std::endl;
+    exit(-1); // fatal error
+  } // end of calorimeter id
+
+  // retowered cemc sits at the cemc radius
+  double retower_r {NAN};
+  if (m_inputs[in].find("RETOWER") != std::string::npos && m_geom_names[in].find("CEMC") != std::string::npos) {
+    auto EMCal_geom = m_nodes.get<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+    assert(EMCal_geom);
+    const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
+    auto EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
+    assert(EMCal_tower_geom);
+    retower_r = EMCal_tower_geom->get_center_radius();
+  }
+
+  unsigned int nchannels = towerinfos->size();
+  m_tower_eta[in].resize(nchannels);
+  m_tower_r[in].resize(nchannels);
+  for (unsigned int channel = 0; channel < nchannels; channel++) {
+    unsigned int calokey = towerinfos->encode_key(channel);
+    unsigned int ieta = towerinfos->getTowerEtaBin(calokey);
+    unsigned int iphi = towerinfos->getTowerPhiBin(calokey);
+
+    const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
+    auto tower_geom = geom->get_tower_geometry(key);
+    assert(tower_geom);
+
+    m_tower_eta[in][channel] = tower_geom->get_eta();
+    m_tower_r[in][channel] = std::isnan(retower_r) ? tower_geom->get_center_radius() : retower_r;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int CaloWindowTowerReco::CreateNodes( PHCompositeNode *topNode )
 {
   PHNodeIterator iter(topNode);
@@ -204,7 +228,9 @@ int CaloWindowTowerReco::CreateNodes( PHCompositeNode *topNode )
   for ( auto &window_name : m_window_names ) {
     CaloWindowMap *window = findNode::getClass<CaloWindowMap>(topNode, window_name);
     if ( !window ) {
-      window = new CaloWindowMapv1();
+      CaloWindowMapv2 *window_v2 = new CaloWindowMapv2();
+      window_v2->set_storage(m_window_storage, m_window_step);
+      window = window_v2;
       PHIODataNode<PHObject> *node = new PHIODataNode<PHObject>(window, window_name, "PHObject");
       windowNode->addNode(node);
     }
@@ -8,9 +8,12 @@
 //===========================================================
 
 #include "UEDefs.h"
+#include "CaloWindowMapv2.h"
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+
 #include <string>
 #include <vector>
 #include <iostream> 
@@ -18,6 +21,7 @@
 #include <jetbase/Jet.h>
 
 class PHCompositeNode;
+class TowerInfoContainer;
 
 class CaloWindowTowerReco : public SubsysReco
 {
@@ -28,6 +32,7 @@ class CaloWindowTowerReco : public SubsysReco
 
     // standard Fun4All methods
     int Init(PHCompositeNode * topNode) override;
+    int InitRun(PHCompositeNode * topNode) override;
     int process_event(PHCompositeNode * topNode) override;
 
     void add_input( Jet::SRC src, const std::string & prefix = "TOWERINFO_CALIB" ) {
@@ -44,6 +49,9 @@ class CaloWindowTowerReco : public SubsysReco
     }
 
     void set_window_prefix( const std::string &prefix ) { m_window_prefix = prefix; }
+    // on-disk precision of the window maps, step in GeV for kQUANTIZED
+    // ( tower energies beyond +-32767 * step are clamped, see CaloWindowMapv2 )
+    void set_window_storage( CaloWindowMapv2::STORAGE storage, float step = 0.01 ) { m_window_storage = storage; m_window_step = step; }
 
   private:
 
@@ -52,13 +60,22 @@ class CaloWindowTowerReco : public SubsysReco
     std::vector<Jet::SRC> m_srcs {}; // source of input
     std::string m_window_prefix {"CaloWindowMap"}; // prefix for window nodes
     std::vector<std::string> m_window_names {}; // window names
+    CaloWindowMapv2::STORAGE m_window_storage {CaloWindowMapv2::kFLOAT};
+    float m_window_step {0.01};
 
     static const int neta_ihcal = 24;
     static const int neta_emcal = 96;
     static const int nphi_ihcal = 64;
     static const int nphi_emcal = 256;
 
+    NodeCache m_nodes {};
+
+    // per run tower eta and radius of each input, [input][channel]
+    std::vector< std::vector<double> > m_tower_eta {};
+    std::vector< std::vector<double> > m_tower_r {};
+
     int CreateNodes(PHCompositeNode *topNode);
+    int CacheGeometry(PHCompositeNode *topNode, unsigned int in, TowerInfoContainer *towerinfos);
 
 };
 
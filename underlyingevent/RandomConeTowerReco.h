@@ -11,6 +11,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <eventselection/NodeCache.h>
+
 #include <string>
 #include <vector>
 #include <iostream> 
@@ -20,6 +22,7 @@
 #include <jetbase/Jet.h>
 
 class PHCompositeNode;
+class TowerInfoContainer;
 class TRandom3;
 
 class RandomConeTowerReco : public SubsysReco
@@ -31,6 +34,7 @@ class RandomConeTowerReco : public SubsysReco
 
     // standard Fun4All methods
     int Init(PHCompositeNode * topNode) override;
+    int InitRun(PHCompositeNode * topNode) override;
     int process_event(PHCompositeNode * topNode) override;
 
     void add_input( Jet::SRC src, const std::string & prefix = "TOWERINFO_CALIB" ) {
@@ -84,7 +88,15 @@ class RandomConeTowerReco : public SubsysReco
     unsigned int m_seed{0}; 
     TRandom3 *m_random {nullptr};
 
+    NodeCache m_nodes {};
+
+    // per run tower eta, phi and radius of each input, [input][channel]
+    std::vector< std::vector<double> > m_tower_eta {};
+    std::vector< std::vector<double> > m_tower_phi {};
+    std::vector< std::vector<double> > m_tower_r {};
+
     int CreateNode(PHCompositeNode *topNode);
+    int CacheGeometry(PHCompositeNode *topNode, unsigned int in, TowerInfoContainer *towerinfos);
     void GetConeAxis(PHCompositeNode *topNode, float &cone_eta, float &cone_phi); // get random cone axis
 };
 
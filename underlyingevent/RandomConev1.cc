@@ -2,10 +2,21 @@
 
 #include <jetbase/Jet.h>
 
+#include <TBuffer.h>
+
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <utility> 
 
+// On disk ( custom Streamer, class version 3 ):
+//   RandomCone base
+//   unsigned int id, float pt, eta, phi, R
+//   uint64 source mask, then per source in the mask, ascending:
+//     float pt, unsigned int n_comps, n_masked
+//   unsigned int ncomp, then ncomp x ( int src, unsigned int channel )
+// The per source arrays and the counters are rebuilt on read.
+
 void RandomConev1::identify(std::ostream& os) const
 {
   os << "RandomConesv1: (pt, eta, phi, R) = (" << m_pt << ", " << m_eta << ", " << m_phi << ", " << m_R << ")" << std::endl;
@@ -19,9 +30,16 @@ void RandomConev1::Reset()
   m_eta = NAN;
   m_phi = NAN;
   m_R = NAN;
-  n_comps.clear();
-  n_masked_comps.clear();
-  m_pt_map.clear();
+  // only sources in the mask were touched
+  for ( uint64_t mask = m_src_mask; mask; mask &= mask - 1 ) {
+    const unsigned int isrc = __builtin_ctzll(mask);
+    m_pt_src[isrc] = 0;
+    m_n_comps_src[isrc] = 0;
+    m_n_masked_src[isrc] = 0;
+  }
+  m_n_total = 0;
+  m_n_masked_total = 0;
+  m_src_mask = 0;
   m_comp_src_vec.clear();
   return ;
 }
@@ -34,6 +52,17 @@ int RandomConev1::isValid() const
   return 1;
 }
 
+bool RandomConev1::add_src( Jet::SRC src )
+{
+  unsigned int isrc = static_cast<unsigned int>(src);
+  if ( isrc >= kMAX_SRC ) {
+    std::cout << "Random Cone: source " << isrc << " out of range, max " << kMAX_SRC << std::endl;
+    return false;
+  }
+  m_src_mask |= (uint64_t{1} << isrc);
+  return true;
+}
+
 void RandomConev1::add_comp( Jet* particle , bool is_masked)
 {
   if ( !particle ) {
@@ -46,12 +75,11 @@ void RandomConev1::add_comp( Jet* particle , bool is_masked)
 
   auto comps = particle->get_comp_vec();
   for ( auto comp : comps ) {
-    if ( n_comps.find(comp.first) == n_comps.end() ) { n_comps[comp.first] = 0; }
-    if ( m_pt_map.find(comp.first) == m_pt_map.end() ) { m_pt_map[comp.first] = 0; }
-    if ( n_masked_comps.find(comp.first) == n_masked_comps.end() ) { n_masked_comps[comp.first] = 0; }
-    n_comps[comp.first]++;
-    m_pt_map[comp.first] += is_masked ? 0 : pt;
-    if ( is_masked ) { n_masked_comps[comp.first]++; }
+    if ( !add_src(comp.first) ) { continue; }
+    m_n_comps_src[comp.first]++;
+    m_n_total++;
+    m_pt_src[comp.first] += is_masked ? 0 : pt;
+    if ( is_masked ) { m_n_masked_src[comp.first]++; m_n_masked_total++; }
     else { m_comp_src_vec.push_back(comp); }
   }
   return ;
@@ -60,14 +88,13 @@ void RandomConev1::add_comp( Jet* particle , bool is_masked)
 
 void RandomConev1::add_tower(Jet::SRC src, float pt, unsigned int ch, bool is_masked)
 {
-  if ( n_comps.find(src) == n_comps.end() ) { n_comps[src] = 0; }
-  if ( m_pt_map.find(src) == m_pt_map.end() ) { m_pt_map[src] = 0; }
-  if ( n_masked_comps.find(src) == n_masked_comps.end() ) { n_masked_comps[src] = 0; }
+  if ( !add_src(src) ) { return ; }
 
-  n_comps[src]++;
+  m_n_comps_src[src]++;
+  m_n_total++;
   m_pt += is_masked ? 0 : pt;
-  m_pt_map[src] += is_masked ? 0 : pt;
-  if ( is_masked ) { n_masked_comps[src]++; }
+  m_pt_src[src] += is_masked ? 0 : pt;
+  if ( is_masked ) { m_n_masked_src[src]++; m_n_masked_total++; }
   else { m_comp_src_vec.push_back(std::make_pair(src, ch)); }
   return ;
 }
@@ -77,74 +104,46 @@ float RandomConev1::get_pt(Jet::SRC src) const
 {
   if ( src == Jet::SRC::VOID ) {
     return m_pt;
-  } else {
-    if ( m_pt_map.find(src) != m_pt_map.end() ) {
-      return m_pt_map.at(src);
-    }
   }
-  return 0;
+  unsigned int isrc = static_cast<unsigned int>(src);
+  return isrc < kMAX_SRC ? m_pt_src[isrc] : 0;
 }
 
 unsigned int RandomConev1::n_clustered(Jet::SRC src) const
 {
-  unsigned int n = 0;
   if ( src == Jet::SRC::VOID ) {
-    for (auto comp : n_comps) {
-      n += comp.second;
-    }
-  } else {
-    if ( n_comps.find(src) != n_comps.end() ) {
-      n = n_comps.at(src);
-    }
+    return m_n_total;
   }
-  return n;
+  unsigned int isrc = static_cast<unsigned int>(src);
+  return isrc < kMAX_SRC ? m_n_comps_src[isrc] : 0;
 }
 
 unsigned int RandomConev1::n_masked(Jet::SRC src) const
 {
-  unsigned int n = 0;
   if ( src == Jet::SRC::VOID ) {
-    for (auto comp : n_masked_comps) {
-      n += comp.second;
-    }
-  } else {
-    if ( n_masked_comps.find(src) != n_masked_comps.end() ) {
-      n = n_masked_comps.at(src);
-    }
+    return m_n_masked_total;
   }
-  return n;
+  unsigned int isrc = static_cast<unsigned int>(src);
+  return isrc < kMAX_SRC ? m_n_masked_src[isrc] : 0;
 }
 
 float RandomConev1::masked_fraction(Jet::SRC src) const
 {
-  unsigned int n_masked = 0;
-  unsigned int n_total = 0;
-  if ( src == Jet::SRC::VOID ) {
-    for (auto comp : n_masked_comps) {
-      n_masked += comp.second;
-    }
-    for (auto comp : n_comps) {
-      n_total += comp.second;
-    }
-  } else {
-    if ( n_masked_comps.find(src) != n_masked_comps.end() ) {
-      n_masked = n_masked_comps.at(src);
-    }
-    if ( n_comps.find(src) != n_comps.end() ) {
-      n_total = n_comps.at(src);
-    }
-  }
+  unsigned int n_total = n_clustered(src);
   if ( n_total == 0 ) {
     return 0;
   }
-  return static_cast<float>(n_masked)/static_cast<float>(n_total);
+  return static_cast<float>(n_masked(src))/static_cast<float>(n_total);
 }
 
 std::vector<Jet::SRC> RandomConev1::get_src_vec()
 {
+  // ascending enum order, same as the old std::map keys
   std::vector<Jet::SRC> srcs {};
-  for (auto comp : n_comps) {
-    srcs.push_back(comp.first);
+  for ( unsigned int isrc = 0; isrc < kMAX_SRC; ++isrc ) {
+    if ( (m_src_mask >> isrc) & 1U ) {
+      srcs.push_back(static_cast<Jet::SRC>(isrc));
+    }
   }
   return srcs;
 }
@@ -165,10 +164,70 @@ std::vector<std::pair<Jet::SRC, unsigned int>> RandomConev1::get_comp_src_vec(Je
   return comp_srcs;
 }
 
+void RandomConev1::Streamer(TBuffer &R__b)
+{
+  if ( R__b.IsReading() ) {
+    UInt_t R__s, R__c;
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+    if ( R__v < 3 ) { // version 1, member wise, the read rule fills the arrays
+      R__b.ReadClassBuffer(RandomConev1::Class(), this, R__v, R__s, R__c);
+      return ;
+    }
 
+    Reset();
+    RandomCone::Streamer(R__b);
+    R__b >> m_id;
+    R__b >> m_pt;
+    R__b >> m_eta;
+    R__b >> m_phi;
+    R__b >> m_R;
+
+    ULong64_t mask = 0;
+    R__b >> mask;
+    m_src_mask = mask;
+    for ( uint64_t bits = m_src_mask; bits; bits &= bits - 1 ) {
+      const unsigned int isrc = __builtin_ctzll(bits);
+      R__b >> m_pt_src[isrc];
+      R__b >> m_n_comps_src[isrc];
+      R__b >> m_n_masked_src[isrc];
+      m_n_total += m_n_comps_src[isrc];
+      m_n_masked_total += m_n_masked_src[isrc];
+    }
 
+    UInt_t ncomp = 0;
+    R__b >> ncomp;
+    m_comp_src_vec.resize(ncomp);
+    for ( auto & comp : m_comp_src_vec ) {
+      Int_t src = 0;
+      R__b >> src;
+      R__b >> comp.second;
+      comp.first = static_cast<Jet::SRC>(src);
+    }
 
+    R__b.CheckByteCount(R__s, R__c, RandomConev1::IsA());
+  } else {
+    UInt_t R__c = R__b.WriteVersion(RandomConev1::IsA(), kTRUE);
+    RandomCone::Streamer(R__b);
+    R__b << m_id;
+    R__b << m_pt;
+    R__b << m_eta;
+    R__b << m_phi;
+    R__b << m_R;
+
+    R__b << static_cast<ULong64_t>(m_src_mask);
+    for ( uint64_t bits = m_src_mask; bits; bits &= bits - 1 ) {
+      const unsigned int isrc = __builtin_ctzll(bits);
+      R__b << m_pt_src[isrc];
+      R__b << m_n_comps_src[isrc];
+      R__b << m_n_masked_src[isrc];
+    }
 
+    R__b << static_cast<UInt_t>(m_comp_src_vec.size());
+    for ( const auto & comp : m_comp_src_vec ) {
+      R__b << static_cast<Int_t>(comp.first);
+      R__b << comp.second;
+    }
 
-
-
+    R__b.SetByteCount(R__c, kTRUE);
+  }
+}
@@ -4,7 +4,7 @@
 #include "RandomCone.h"
 
 #include <cmath>
-#include <map>
+#include <cstdint>
 
 class RandomConev1 : public RandomCone
 {
@@ -38,20 +38,36 @@ class RandomConev1 : public RandomCone
     std::vector < std::pair < Jet::SRC, unsigned int > > get_comp_src_vec( Jet::SRC src = Jet::SRC::VOID) const override;
 
     
+    // sources are stored by enum value, anything at or above this is rejected
+    static const unsigned int kMAX_SRC = 64;
+
   private:
 
     unsigned int m_id {0};
     float m_pt {0};
-    std::map < Jet::SRC, float > m_pt_map {};
     float m_eta {NAN};
     float m_phi {NAN};
     float m_R {NAN};
 
-    std::map< Jet::SRC, unsigned int> n_comps {};
-    std::map< Jet::SRC, unsigned int> n_masked_comps {};
+    // per source, indexed by Jet::SRC. Only the sources in m_src_mask are
+    // written, see the Streamer in RandomConev1.cc
+    float m_pt_src[kMAX_SRC] {}; //!
+    unsigned int m_n_comps_src[kMAX_SRC] {}; //!
+    unsigned int m_n_masked_src[kMAX_SRC] {}; //!
+
+    // running totals over all sources
+    unsigned int m_n_total {0}; //!
+    unsigned int m_n_masked_total {0}; //!
+    uint64_t m_src_mask {0}; //! bit src set once src has a component
+
     std::vector < std::pair < Jet::SRC, unsigned int > > m_comp_src_vec {};
 
-    ClassDefOverride(RandomConev1, 1);
+    bool add_src( Jet::SRC src );
+
+    // version 3: custom Streamer writing the populated sources only.
+    // Version 1 ( maps ) is converted by the read rule in
+    // RandomConev1LinkDef.h
+    ClassDefOverride(RandomConev1, 3);
 };
 
 #endif // UNDERLYINGEVENT_RANDOMCONEV1_H
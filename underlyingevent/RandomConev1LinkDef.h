@@ -1,5 +1,17 @@
 #ifdef __CINT__
 
-#pragma link C++ class RandomConev1 + ;
+#pragma link C++ class RandomConev1 - ;
+
+// version 1 kept the per source counters in std::map, fill the arrays and totals from them
+#pragma read sourceClass="RandomConev1" version="[1]" targetClass="RandomConev1" \
+  source="std::map<Jet::SRC,float> m_pt_map; std::map<Jet::SRC,unsigned int> n_comps; std::map<Jet::SRC,unsigned int> n_masked_comps" \
+  target="m_pt_src, m_n_comps_src, m_n_masked_src, m_n_total, m_n_masked_total, m_src_mask" \
+  code="{ \
+    m_n_total = 0; m_n_masked_total = 0; m_src_mask = 0; \
+    for ( unsigned int i = 0; i < RandomConev1::kMAX_SRC; ++i ) { m_pt_src[i] = 0; m_n_comps_src[i] = 0; m_n_masked_src[i] = 0; } \
+    for ( const auto &p : onfile.m_pt_map ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_pt_src[p.first] = p.second; } } \
+    for ( const auto &p : onfile.n_comps ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_n_comps_src[p.first] = p.second; m_n_total += p.second; m_src_mask |= ( uint64_t{1} << p.first ); } } \
+    for ( const auto &p : onfile.n_masked_comps ) { if ( static_cast<unsigned int>(p.first) < RandomConev1::kMAX_SRC ) { m_n_masked_src[p.first] = p.second; m_n_masked_total += p.second; } } \
+  }"
 
 #endif /* __CINT__ */